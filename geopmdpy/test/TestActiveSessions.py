@@ -381,7 +381,7 @@ class TestActiveSessions(unittest.TestCase):
             mock_process.assert_has_calls(calls)
 
             calls = [mock.call('status', 64 * os.cpu_count(), client_pid, client_uid, client_gid),
-                     mock.call('record-log', 57384, client_pid, client_uid, client_gid)]
+                     mock.call('record-log', 114816, client_pid, client_uid, client_gid)]
             mock_shmem_create.assert_has_calls(calls)
             self.assertEqual({client_pid}, act_sess.get_profile_pids(profile_name))
             updated_json_contents = dict(self.json_good_example)
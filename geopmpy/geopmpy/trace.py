@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2015 - 2024 Intel Corporation
+#  SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Read binary and compressed GEOPM trace files and render them as CSV.
+
+When the GEOPM_TRACE_FORMAT environment variable is set to "binary"
+the GEOPM Runtime writes trace and profile trace files in a binary
+columnar format instead of text.  When GEOPM_TRACE_COMPRESSION is set
+to "zstd" or "lz4" the trace files are written as a sequence of
+independently compressed frames.  Either kind of file can be
+converted to the equivalent CSV file with:
+
+    python3 -m geopmpy.trace INPUT [OUTPUT]
+
+Decoding compressed files requires the zstandard or lz4 Python
+package.
+
+"""
+
+import math
+import struct
+import sys
+from argparse import ArgumentParser
+
+import numpy
+
+MAGIC = b'GEOPMTRB'
+VERSION = 1
+FRAMES_MAGIC = b'GEOPMTRZ'
+FRAMES_VERSION = 1
+
+_CODEC_ZSTD = 1
+_CODEC_LZ4 = 2
+
+_EVENT_NAMES = {0: 'REGION_ENTRY',
+                1: 'REGION_EXIT',
+                2: 'EPOCH_COUNT',
+                3: 'EVENT_SHORT_REGION',
+                9: 'EVENT_AFFINITY',
+                10: 'EVENT_START_PROFILE',
+                11: 'EVENT_STOP_PROFILE',
+                12: 'EVENT_OVERHEAD'}
+
+_EVENT_SIGNAL_FORMATS = {0: 'hex',
+                         1: 'hex',
+                         2: 'integer',
+                         3: 'hex',
+                         9: 'integer',
+                         10: 'hex',
+                         11: 'hex'}
+
+
+def _decompress_zstd(data, size):
+    import zstandard
+    return zstandard.ZstdDecompressor().decompress(data, max_output_size=size)
+
+
+def _decompress_lz4(data, size):
+    import lz4.block
+    return lz4.block.decompress(data, uncompressed_size=size)
+
+
+class TraceFrames(object):
+    """Index of the compressed frames of a trace file
+
+    The frames are located without decompressing them, and each frame
+    can be decoded independently of the others.
+
+    Attributes:
+        codec (str): Either 'zstd' or 'lz4'.
+    """
+    def __init__(self, path):
+        with open(path, 'rb') as fid:
+            buffer = fid.read()
+        if buffer[:len(FRAMES_MAGIC)] != FRAMES_MAGIC:
+            raise RuntimeError('<geopm> geopmpy.trace: Not a compressed trace file: {}'.format(path))
+        offset = len(FRAMES_MAGIC)
+        version, codec = struct.unpack_from('<II', buffer, offset)
+        offset += 8
+        if version != FRAMES_VERSION:
+            raise RuntimeError('<geopm> geopmpy.trace: Unsupported compressed trace version: {}'.format(version))
+        if codec == _CODEC_ZSTD:
+            self.codec = 'zstd'
+            self._decompress = _decompress_zstd
+        elif codec == _CODEC_LZ4:
+            self.codec = 'lz4'
+            self._decompress = _decompress_lz4
+        else:
+            raise RuntimeError('<geopm> geopmpy.trace: Unknown compression codec: {}'.format(codec))
+        self._buffer = buffer
+        self._index = []
+        while offset < len(buffer):
+            compressed_size, size = struct.unpack_from('<II', buffer, offset)
+            offset += 8
+            if offset + compressed_size > len(buffer):
+                raise RuntimeError('<geopm> geopmpy.trace: Truncated frame in compressed trace: {}'.format(path))
+            self._index.append((offset, compressed_size, size))
+            offset += compressed_size
+
+    def __len__(self):
+        return len(self._index)
+
+    def frame(self, index):
+        """Decode one frame
+
+        Args:
+            index (int): Index of the frame
+
+        Returns:
+            bytes: Contents of the frame before compression
+
+        """
+        offset, compressed_size, size = self._index[index]
+        return self._decompress(self._buffer[offset:offset + compressed_size], size)
+
+    def read(self):
+        """Decode all frames
+
+        Returns:
+            bytes: Contents of the trace file before compression
+
+        """
+        return b''.join(self.frame(idx) for idx in range(len(self)))
+
+
+def is_compressed_trace(path):
+    """Check if a file is a compressed trace file
+
+    Args:
+        path (str): Path to the file
+
+    Returns:
+        bool: True if the file begins with the compressed trace magic
+
+    """
+    with open(path, 'rb') as fid:
+        return fid.read(len(FRAMES_MAGIC)) == FRAMES_MAGIC
+
+
+def read_trace(path):
+    """Read the contents of a trace file, decompressing it if required
+
+    Args:
+        path (str): Path to the file
+
+    Returns:
+        bytes: Contents of the trace file before compression
+
+    """
+    if is_compressed_trace(path):
+        return TraceFrames(path).read()
+    with open(path, 'rb') as fid:
+        return fid.read()
+
+
+def is_binary_trace(path):
+    """Check if a file is a binary trace file
+
+    Args:
+        path (str): Path to the file, which may be compressed
+
+    Returns:
+        bool: True if the file begins with the binary trace magic
+
+    """
+    if is_compressed_trace(path):
+        frames = TraceFrames(path)
+        head = frames.frame(0) if len(frames) != 0 else b''
+    else:
+        with open(path, 'rb') as fid:
+            head = fid.read(len(MAGIC))
+    return head[:len(MAGIC)] == MAGIC
+
+
+class BinaryTrace(object):
+    """Contents of a binary trace file
+
+    Attributes:
+        metadata (str): The '#' prefixed header lines of the equivalent
+                        CSV file.
+        columns (list(str)): Name of each column.
+        formats (list(str)): Format name of each column.
+        data (numpy.ndarray): Two dimensional array of values indexed
+                              by row and then column.
+    """
+    def __init__(self, path):
+        buffer = read_trace(path)
+        if buffer[:len(MAGIC)] != MAGIC:
+            raise RuntimeError('<geopm> geopmpy.trace: Not a binary trace file: {}'.format(path))
+        self._buffer = buffer
+        self._offset = len(MAGIC)
+        version = self._read_uint32()
+        if version != VERSION:
+            raise RuntimeError('<geopm> geopmpy.trace: Unsupported binary trace version: {}'.format(version))
+        num_column = self._read_uint32()
+        self.metadata = self._read_string()
+        self.columns = []
+        self.formats = []
+        for _ in range(num_column):
+            self.columns.append(self._read_string())
+            self.formats.append(self._read_string())
+        blocks = []
+        while self._offset < len(buffer):
+            num_row = self._read_uint32()
+            count = num_row * num_column
+            block = numpy.frombuffer(buffer, dtype='<f8', count=count, offset=self._offset)
+            self._offset += count * 8
+            blocks.append(block.reshape(num_column, num_row).transpose())
+        if blocks:
+            self.data = numpy.concatenate(blocks)
+        else:
+            self.data = numpy.empty((0, num_column))
+
+    def _read_uint32(self):
+        result = struct.unpack_from('<I', self._buffer, self._offset)[0]
+        self._offset += 4
+        return result
+
+    def _read_string(self):
+        size = self._read_uint32()
+        result = self._buffer[self._offset:self._offset + size].decode()
+        self._offset += size
+        return result
+
+    def rows(self):
+        """Generate the rows of the trace formatted as they are in the CSV
+        trace
+
+        Yields:
+            list(str): Formatted values for each column
+
+        """
+        for row in self.data:
+            result = []
+            event = None
+            for fmt, value in zip(self.formats, row):
+                if fmt == 'event':
+                    event = int(value)
+                    result.append(_EVENT_NAMES.get(event, 'INVALID'))
+                elif fmt == 'event_signal':
+                    result.append(format_event_signal(event, value))
+                else:
+                    result.append(format_value(fmt, value))
+            yield result
+
+    def write_csv(self, fid):
+        """Write the trace in the CSV trace format
+
+        Args:
+            fid (file): Text file to write
+
+        """
+        fid.write(self.metadata)
+        fid.write('|'.join(self.columns) + '\n')
+        for row in self.rows():
+            fid.write('|'.join(row) + '\n')
+
+
+def _format_nan(value):
+    return '-nan' if math.copysign(1.0, value) < 0 else 'nan'
+
+
+def _to_uint64(value):
+    return int(value) & 0xFFFFFFFFFFFFFFFF
+
+
+def format_value(fmt, value):
+    """Format a value in the same way as the C++ string_format functions
+
+    Args:
+        fmt (str): One of 'double', 'float', 'integer', 'hex' or
+                   'raw64'.
+        value (float): Value to format
+
+    Returns:
+        str: Formatted value
+
+    """
+    value = float(value)
+    if fmt == 'raw64':
+        return '0x{:016x}'.format(struct.unpack('<Q', struct.pack('<d', value))[0])
+    if math.isnan(value):
+        return 'NAN' if fmt == 'hex' else _format_nan(value)
+    if fmt == 'double':
+        return '%.16g' % value
+    if fmt == 'float':
+        return '%g' % value
+    if fmt == 'integer':
+        if math.isinf(value):
+            return '%g' % value
+        return '%d' % int(value)
+    if fmt == 'hex':
+        return '0x{:08x}'.format(_to_uint64(value))
+    raise ValueError('<geopm> geopmpy.trace: Unknown format: {}'.format(fmt))
+
+
+def format_event_signal(event, value):
+    """Format the signal column of a profile trace based on the event
+
+    Args:
+        event (int): Value of the event column in the same row
+        value (float): Value of the signal column
+
+    Returns:
+        str: Formatted value
+
+    """
+    if event == 12:
+        # Overhead is stored as the bits of a double
+        bits = _to_uint64(value)
+        value = struct.unpack('<d', struct.pack('<Q', bits))[0]
+        return format_value('double', value)
+    fmt = _EVENT_SIGNAL_FORMATS.get(event)
+    if fmt is None:
+        return 'INVALID'
+    return format_value(fmt, value)
+
+
+def main():
+    parser = ArgumentParser(description='Convert a binary or compressed GEOPM trace file to CSV')
+    parser.add_argument('input', help='Path to the trace file')
+    parser.add_argument('output', nargs='?', default=None,
+                        help='Path to the CSV file, standard output if not provided')
+    args = parser.parse_args()
+    if is_binary_trace(args.input):
+        write = BinaryTrace(args.input).write_csv
+    else:
+        text = read_trace(args.input).decode()
+        write = lambda fid: fid.write(text)
+    if args.output is None:
+        write(sys.stdout)
+    else:
+        with open(args.output, 'w') as fid:
+            write(fid)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
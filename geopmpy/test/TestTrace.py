@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2015 - 2024 Intel Corporation
+#  SPDX-License-Identifier: BSD-3-Clause
+#
+
+import io
+import os
+import struct
+import tempfile
+import unittest
+
+import geopmpy.trace
+
+try:
+    import zstandard
+except ImportError:
+    zstandard = None
+try:
+    import lz4.block
+except ImportError:
+    lz4 = None
+
+
+def _pack_string(value):
+    data = value.encode()
+    return struct.pack('<I', len(data)) + data
+
+
+def _write_trace(path, metadata, columns, formats, blocks):
+    with open(path, 'wb') as fid:
+        fid.write(b'GEOPMTRB')
+        fid.write(struct.pack('<II', 1, len(columns)))
+        fid.write(_pack_string(metadata))
+        for name, fmt in zip(columns, formats):
+            fid.write(_pack_string(name))
+            fid.write(_pack_string(fmt))
+        for rows in blocks:
+            fid.write(struct.pack('<I', len(rows)))
+            for col_idx in range(len(columns)):
+                for row in rows:
+                    fid.write(struct.pack('<d', row[col_idx]))
+
+
+def _write_frames(path, codec, chunks):
+    with open(path, 'wb') as fid:
+        fid.write(b'GEOPMTRZ')
+        fid.write(struct.pack('<II', 1, codec))
+        for chunk in chunks:
+            if codec == 1:
+                data = zstandard.ZstdCompressor().compress(chunk)
+            else:
+                data = lz4.block.compress(chunk, store_size=False)
+            fid.write(struct.pack('<II', len(data), len(chunk)))
+            fid.write(data)
+
+
+class TestTrace(unittest.TestCase):
+    def setUp(self):
+        self._tmp_dir = tempfile.TemporaryDirectory('TestTrace')
+        self._path = os.path.join(self._tmp_dir.name, 'trace-host')
+        self._metadata = '# geopm_version: 3.0\n# start_time: now\n# profile_name: prof\n# node_name: host\n# agent: monitor\n'
+
+    def tearDown(self):
+        self._tmp_dir.cleanup()
+
+    def test_format_value(self):
+        self.assertEqual('0.000244140625', geopmpy.trace.format_value('double', 0.000244140625))
+        self.assertEqual('0.3333333333333333', geopmpy.trace.format_value('double', 1.0 / 3.0))
+        self.assertEqual('0.333333', geopmpy.trace.format_value('float', 1.0 / 3.0))
+        self.assertEqual('1024', geopmpy.trace.format_value('integer', 1024.9))
+        self.assertEqual('-3', geopmpy.trace.format_value('integer', -3.5))
+        self.assertEqual('0x20000000000000', geopmpy.trace.format_value('hex', 2.0 ** 53))
+        self.assertEqual('0x00000020', geopmpy.trace.format_value('hex', 32.0))
+        self.assertEqual('0x3ff0000000000000', geopmpy.trace.format_value('raw64', 1.0))
+        self.assertEqual('nan', geopmpy.trace.format_value('double', float('nan')))
+        self.assertEqual('-nan', geopmpy.trace.format_value('integer', -float('nan')))
+        self.assertEqual('NAN', geopmpy.trace.format_value('hex', float('nan')))
+        self.assertEqual('inf', geopmpy.trace.format_value('double', float('inf')))
+        self.assertEqual('inf', geopmpy.trace.format_value('integer', float('inf')))
+        self.assertEqual('-inf', geopmpy.trace.format_value('integer', -float('inf')))
+        with self.assertRaisesRegex(ValueError, 'Unknown format'):
+            geopmpy.trace.format_value('bad', 1.0)
+
+    def test_trace_csv(self):
+        columns = ['TIME', 'REGION_HASH', 'CPU_POWER', 'EPOCH_COUNT']
+        formats = ['double', 'hex', 'float', 'integer']
+        blocks = [[(0.005, 0x8a7c1f4f, 100.25, 1), (0.010, 0x8a7c1f4f, 99.5, float('inf'))],
+                  [(0.015, 0x725e8066, float('nan'), -float('inf'))]]
+        _write_trace(self._path, self._metadata, columns, formats, blocks)
+        self.assertTrue(geopmpy.trace.is_binary_trace(self._path))
+        trace = geopmpy.trace.BinaryTrace(self._path)
+        self.assertEqual(columns, trace.columns)
+        self.assertEqual(formats, trace.formats)
+        self.assertEqual((3, 4), trace.data.shape)
+        output = io.StringIO()
+        trace.write_csv(output)
+        expected = self._metadata + ('TIME|REGION_HASH|CPU_POWER|EPOCH_COUNT\n'
+                                     '0.005|0x8a7c1f4f|100.25|1\n'
+                                     '0.01|0x8a7c1f4f|99.5|inf\n'
+                                     '0.015|0x725e8066|nan|-inf\n')
+        self.assertEqual(expected, output.getvalue())
+
+    def test_profile_trace_csv(self):
+        columns = ['TIME', 'PROCESS', 'EVENT', 'SIGNAL']
+        formats = ['double', 'integer', 'event', 'event_signal']
+        overhead_bits = struct.unpack('<Q', struct.pack('<d', 0.125))[0]
+        rows = [(10, 0, 0, 0xfa5920d6),
+                (37, 0, 1, 0xfa5920d6),
+                (40, 0, 3, 0xdeadbeef),
+                (41, 1, 2, 1),
+                (42, 1, 12, float(overhead_bits))]
+        _write_trace(self._path, self._metadata, columns, formats, [rows])
+        output = io.StringIO()
+        geopmpy.trace.BinaryTrace(self._path).write_csv(output)
+        expected = self._metadata + ('TIME|PROCESS|EVENT|SIGNAL\n'
+                                     '10|0|REGION_ENTRY|0xfa5920d6\n'
+                                     '37|0|REGION_EXIT|0xfa5920d6\n'
+                                     '40|0|EVENT_SHORT_REGION|0xdeadbeef\n'
+                                     '41|1|EPOCH_COUNT|1\n'
+                                     '42|1|EVENT_OVERHEAD|0.125\n')
+        self.assertEqual(expected, output.getvalue())
+
+    def test_not_binary(self):
+        with open(self._path, 'w') as fid:
+            fid.write(self._metadata)
+        self.assertFalse(geopmpy.trace.is_binary_trace(self._path))
+        with self.assertRaisesRegex(RuntimeError, 'Not a binary trace file'):
+            geopmpy.trace.BinaryTrace(self._path)
+
+    @unittest.skipIf(zstandard is None, 'zstandard module is not installed')
+    def test_compressed_csv(self):
+        chunks = [(self._metadata + 'TIME|CPU_POWER\n').encode(),
+                  b'0.005|100.25\n0.01|99.5\n',
+                  b'0.015|nan\n']
+        _write_frames(self._path, 1, chunks)
+        self.assertTrue(geopmpy.trace.is_compressed_trace(self._path))
+        self.assertFalse(geopmpy.trace.is_binary_trace(self._path))
+        frames = geopmpy.trace.TraceFrames(self._path)
+        self.assertEqual('zstd', frames.codec)
+        self.assertEqual(3, len(frames))
+        self.assertEqual(chunks[2], frames.frame(2))
+        self.assertEqual(b''.join(chunks), geopmpy.trace.read_trace(self._path))
+
+    @unittest.skipIf(lz4 is None, 'lz4 module is not installed')
+    def test_compressed_binary(self):
+        columns = ['TIME', 'REGION_HASH']
+        formats = ['double', 'hex']
+        blocks = [[(0.005, 0x8a7c1f4f)], [(0.010, 0x725e8066)]]
+        _write_trace(self._path, self._metadata, columns, formats, blocks)
+        with open(self._path, 'rb') as fid:
+            data = fid.read()
+        # Header frame followed by one frame per block
+        block_size = 4 + 8 * len(columns)
+        header_size = len(data) - 2 * block_size
+        chunks = [data[:header_size],
+                  data[header_size:header_size + block_size],
+                  data[header_size + block_size:]]
+        _write_frames(self._path, 2, chunks)
+        self.assertTrue(geopmpy.trace.is_binary_trace(self._path))
+        self.assertEqual('lz4', geopmpy.trace.TraceFrames(self._path).codec)
+        output = io.StringIO()
+        geopmpy.trace.BinaryTrace(self._path).write_csv(output)
+        expected = self._metadata + ('TIME|REGION_HASH\n'
+                                     '0.005|0x8a7c1f4f\n'
+                                     '0.01|0x725e8066\n')
+        self.assertEqual(expected, output.getvalue())
+
+    def test_not_compressed(self):
+        with open(self._path, 'w') as fid:
+            fid.write(self._metadata)
+        self.assertFalse(geopmpy.trace.is_compressed_trace(self._path))
+        self.assertEqual(self._metadata.encode(), geopmpy.trace.read_trace(self._path))
+        with self.assertRaisesRegex(RuntimeError, 'Not a compressed trace file'):
+            geopmpy.trace.TraceFrames(self._path)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,27 @@
+#  Copyright (c) 2015 - 2024 Intel Corporation
+#  SPDX-License-Identifier: BSD-3-Clause
+#
+
+# Microbenchmarks are built with "make checkprogs" and are run by hand,
+# they are not part of "make check".
+check_PROGRAMS += benchmark/record_log_bench \
+                  benchmark/trace_format_bench \
+                  benchmark/waiter_bench \
+                  # end
+
+benchmark_record_log_bench_SOURCES = benchmark/record_log_bench.cpp
+benchmark_record_log_bench_LDADD = libgeopm.la
+
+benchmark_trace_format_bench_SOURCES = benchmark/trace_format_bench.cpp
+benchmark_trace_format_bench_LDADD = libgeopm.la
+
+benchmark_waiter_bench_SOURCES = benchmark/waiter_bench.cpp
+benchmark_waiter_bench_LDADD = libgeopm.la
+
+if ENABLE_MPI
+    check_PROGRAMS += benchmark/tree_comm_bench
+    benchmark_tree_comm_bench_SOURCES = benchmark/tree_comm_bench.cpp
+    benchmark_tree_comm_bench_LDADD = libgeopm.la $(MPI_CLIBS)
+else
+    EXTRA_DIST += benchmark/tree_comm_bench.cpp
+endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Measure the cost of ApplicationRecordLog::enter() followed by
+/// ApplicationRecordLog::exit() as seen by a profiled application.
+/// The log is drained with dump() every DUMP_PERIOD region calls to
+/// emulate the Controller sampling the log.  Each case cycles
+/// through a different number of distinct region hashes so that both
+/// the short region fast path and the insertion of new regions are
+/// measured.
+///
+/// Usage: record_log_bench [NUM_CALL [DUMP_PERIOD]]
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm_hash.h"
+#include "geopm_time.h"
+#include "geopm/SharedMemory.hpp"
+#include "ApplicationRecordLog.hpp"
+#include "record.hpp"
+
+using geopm::ApplicationRecordLog;
+
+static void bench_regions(ApplicationRecordLog &record_log, int num_region,
+                          int num_call, int dump_period)
+{
+    std::vector<uint64_t> hashes(num_region);
+    for (int region_idx = 0; region_idx != num_region; ++region_idx) {
+        std::string name = "region-" + std::to_string(region_idx);
+        hashes[region_idx] = geopm_crc32_str(name.c_str());
+    }
+    std::vector<geopm::record_s> records;
+    std::vector<geopm::short_region_s> short_regions;
+    records.reserve(ApplicationRecordLog::max_record());
+    short_regions.reserve(ApplicationRecordLog::max_region());
+    record_log.dump(records, short_regions);
+
+    geopm_time_s time;
+    geopm_time(&time);
+    double dump_time = 0.0;
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int call_idx = 0; call_idx != num_call; ++call_idx) {
+        uint64_t hash = hashes[call_idx % num_region];
+        record_log.enter(hash, time);
+        record_log.exit(hash, time);
+        if ((call_idx + 1) % dump_period == 0) {
+            geopm_time_s dump_begin;
+            geopm_time(&dump_begin);
+            record_log.dump(records, short_regions);
+            dump_time += geopm_time_since(&dump_begin);
+        }
+    }
+    double elapsed = geopm_time_since(&begin) - dump_time;
+    std::cout << std::setw(8) << num_region << " regions"
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << 1e9 * elapsed / num_call << " ns/enter+exit"
+              << std::setw(12) << 1e6 * dump_time * dump_period / num_call << " us/dump"
+              << std::setw(12) << record_log.num_overflow() << " overflow\n";
+}
+
+int main(int argc, char **argv)
+{
+    int num_call = argc > 1 ? std::stoi(argv[1]) : 10000000;
+    int dump_period = argc > 2 ? std::stoi(argv[2]) : 500;
+    if (num_call <= 0 || dump_period <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [NUM_CALL [DUMP_PERIOD]]\n";
+        return -1;
+    }
+    std::string shm_key = "/geopm-record-log-bench-" + std::to_string(getpid());
+    auto shmem = geopm::SharedMemory::make_unique_owner(shm_key, ApplicationRecordLog::buffer_size());
+    shmem->unlink();
+    std::shared_ptr<geopm::SharedMemory> shmem_shared(std::move(shmem));
+
+    std::cout << num_call << " region calls, dump every " << dump_period << " calls\n";
+    for (int num_region : {1, 16, 256}) {
+        auto record_log = ApplicationRecordLog::make_unique(shmem_shared);
+        bench_regions(*record_log, num_region, num_call, dump_period);
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Measure the throughput of formatting one trace row of NUM_COLUMN
+/// values.  The columns cycle through the formats used by the Tracer:
+/// mostly "double", with some "integer", "hex" and "float" columns.
+/// Each case formats the same rows:
+///
+///   - snprintf: per value snprintf() into a std::string streamed into
+///     a std::ostringstream, as CSVImp did before the buffer functions
+///     were added.
+///   - string: the geopm::string_format_*() functions appended to a
+///     std::string.
+///   - buffer: the geopm::string_format_*_buffer() functions writing
+///     into a preallocated row.
+///   - CSVImp: CSVImp::update() writing to /dev/null.
+///
+/// Usage: trace_format_bench [NUM_ROW [NUM_COLUMN]]
+
+#include <climits>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm/Helper.hpp"
+#include "CSV.hpp"
+
+static std::string legacy_format_double(double signal)
+{
+    char result[NAME_MAX];
+    snprintf(result, NAME_MAX, "%.16g", signal);
+    return result;
+}
+
+static std::string legacy_format_float(double signal)
+{
+    char result[NAME_MAX];
+    snprintf(result, NAME_MAX, "%g", signal);
+    return result;
+}
+
+static std::string legacy_format_integer(double signal)
+{
+    char result[NAME_MAX];
+    snprintf(result, NAME_MAX, "%lld", (long long)signal);
+    return result;
+}
+
+static std::string legacy_format_hex(double signal)
+{
+    char result[NAME_MAX];
+    snprintf(result, NAME_MAX, "0x%08" PRIx64, (uint64_t)signal);
+    return result;
+}
+
+static void report(const std::string &name, double elapsed, int num_row, size_t num_byte)
+{
+    std::cout << std::setw(10) << name
+              << std::setw(12) << std::fixed << std::setprecision(2)
+              << 1e6 * elapsed / num_row << " us/row"
+              << std::setw(12) << std::setprecision(1)
+              << num_byte / elapsed / 1e6 << " MB/s\n";
+}
+
+int main(int argc, char **argv)
+{
+    int num_row = argc > 1 ? std::stoi(argv[1]) : 20000;
+    int num_column = argc > 2 ? std::stoi(argv[2]) : 300;
+    if (num_row <= 0 || num_column <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [NUM_ROW [NUM_COLUMN]]\n";
+        return -1;
+    }
+    const std::vector<std::string> format_names = {"double", "double", "double",
+                                                   "integer", "hex", "float"};
+    const std::vector<std::function<std::string(double)> > legacy_functions = {
+        legacy_format_double, legacy_format_double, legacy_format_double,
+        legacy_format_integer, legacy_format_hex, legacy_format_float};
+    const std::vector<std::function<std::string(double)> > functions = {
+        geopm::string_format_double, geopm::string_format_double, geopm::string_format_double,
+        geopm::string_format_integer, geopm::string_format_hex, geopm::string_format_float};
+    std::vector<std::function<std::string(double)> > column_legacy;
+    std::vector<std::function<std::string(double)> > column_function;
+    std::vector<geopm::string_format_buffer_f> column_buffer;
+    for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+        int format_idx = col_idx % format_names.size();
+        column_legacy.push_back(legacy_functions[format_idx]);
+        column_function.push_back(functions[format_idx]);
+        column_buffer.push_back(geopm::string_format_function_to_buffer(functions[format_idx]));
+    }
+
+    // Signal values that look like a trace: times, energies,
+    // frequencies, counts and region hashes
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> real(0.0, 1.0);
+    std::vector<std::vector<double> > rows(64, std::vector<double>(num_column));
+    for (auto &row : rows) {
+        for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+            const std::string &format = format_names[col_idx % format_names.size()];
+            if (format == "integer") {
+                row[col_idx] = std::floor(real(generator) * 1e6);
+            }
+            else if (format == "hex") {
+                row[col_idx] = std::floor(real(generator) * 4294967295.0);
+            }
+            else {
+                row[col_idx] = std::ldexp(real(generator), col_idx % 40);
+            }
+        }
+    }
+    std::cout << num_row << " rows of " << num_column << " columns\n";
+
+    size_t num_byte = 0;
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int row_idx = 0; row_idx != num_row; ++row_idx) {
+        const auto &row = rows[row_idx % rows.size()];
+        std::ostringstream buffer;
+        for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+            if (col_idx) {
+                buffer << '|';
+            }
+            buffer << column_legacy[col_idx](row[col_idx]);
+        }
+        buffer << "\n";
+        num_byte += buffer.tellp();
+    }
+    report("snprintf", geopm_time_since(&begin), num_row, num_byte);
+
+    num_byte = 0;
+    geopm_time(&begin);
+    std::string line;
+    for (int row_idx = 0; row_idx != num_row; ++row_idx) {
+        const auto &row = rows[row_idx % rows.size()];
+        line.clear();
+        for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+            if (col_idx) {
+                line += '|';
+            }
+            line += column_function[col_idx](row[col_idx]);
+        }
+        line += '\n';
+        num_byte += line.size();
+    }
+    report("string", geopm_time_since(&begin), num_row, num_byte);
+
+    num_byte = 0;
+    std::vector<char> row_buffer(num_column * (geopm::string_format_buffer_size + 1) + 1);
+    geopm_time(&begin);
+    for (int row_idx = 0; row_idx != num_row; ++row_idx) {
+        const auto &row = rows[row_idx % rows.size()];
+        char *row_ptr = row_buffer.data();
+        for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+            if (col_idx) {
+                *row_ptr = '|';
+                ++row_ptr;
+            }
+            row_ptr = column_buffer[col_idx](row[col_idx], row_ptr);
+        }
+        *row_ptr = '\n';
+        ++row_ptr;
+        num_byte += row_ptr - row_buffer.data();
+    }
+    report("buffer", geopm_time_since(&begin), num_row, num_byte);
+
+    geopm::CSVImp csv("/dev/null", "", "", 1024 * 1024);
+    for (int col_idx = 0; col_idx != num_column; ++col_idx) {
+        csv.add_column("column-" + std::to_string(col_idx), column_function[col_idx]);
+    }
+    csv.activate();
+    geopm_time(&begin);
+    for (int row_idx = 0; row_idx != num_row; ++row_idx) {
+        csv.update(rows[row_idx % rows.size()]);
+    }
+    csv.flush();
+    report("CSVImp", geopm_time_since(&begin), num_row, num_byte);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Measure the round trip latency of one level of the TreeComm for
+/// each TreeCommLevel implementation.  Rank zero of MPI_COMM_WORLD is
+/// the parent and every rank is a child, so the fan-out is the number
+/// of processes.  Each iteration the parent sends a new policy down,
+/// every child polls receive_down() until the policy arrives and
+/// replies with send_up(), and the parent polls receive_up() until
+/// the samples of all children are received.  The round trip time
+/// percentiles are reported by rank zero.  The polling loops yield
+/// the CPU so that the benchmark can be run with more processes than
+/// cores on a single node.
+///
+/// Usage: mpiexec -n FAN_OUT tree_comm_bench [NUM_ITER [NUM_VALUE]]
+
+#include <mpi.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm/Helper.hpp"
+#include "Comm.hpp"
+#include "TreeCommLevel.hpp"
+
+static std::unique_ptr<geopm::TreeCommLevel> make_level(const std::string &name,
+                                                        std::shared_ptr<geopm::Comm> comm,
+                                                        int num_value)
+{
+    std::unique_ptr<geopm::TreeCommLevel> result;
+    if (name == "lock") {
+        result = geopm::make_unique<geopm::TreeCommLevelImp>(comm, num_value, num_value);
+    }
+    else {
+        result = geopm::make_unique<geopm::MailboxTreeCommLevel>(comm, num_value, num_value);
+    }
+    return result;
+}
+
+static void bench_level(const std::string &name, std::shared_ptr<geopm::Comm> comm,
+                        int num_iter, int num_value)
+{
+    int rank = comm->rank();
+    int num_rank = comm->num_rank();
+    auto level = make_level(name, comm, num_value);
+    std::vector<std::vector<double> > policy(num_rank, std::vector<double>(num_value));
+    std::vector<std::vector<double> > sample(num_rank, std::vector<double>(num_value));
+    std::vector<double> policy_in(num_value);
+    std::vector<double> sample_out(num_value);
+    std::vector<double> round_trip(num_iter);
+    comm->barrier();
+    for (int iter = 0; iter != num_iter; ++iter) {
+        geopm_time_s begin;
+        geopm_time(&begin);
+        if (rank == 0) {
+            for (auto &child_policy : policy) {
+                std::fill(child_policy.begin(), child_policy.end(), iter);
+            }
+            level->send_down(policy);
+        }
+        while (!level->receive_down(policy_in) || policy_in[0] != iter) {
+            sched_yield();
+        }
+        std::fill(sample_out.begin(), sample_out.end(), iter);
+        level->send_up(sample_out);
+        if (rank == 0) {
+            while (!level->receive_up(sample) ||
+                   std::any_of(sample.begin(), sample.end(),
+                               [iter](const std::vector<double> &child_sample)
+                               {
+                                   return child_sample[0] != iter;
+                               })) {
+                sched_yield();
+            }
+            round_trip[iter] = geopm_time_since(&begin);
+        }
+    }
+    comm->barrier();
+    if (rank == 0) {
+        std::sort(round_trip.begin(), round_trip.end());
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(1)
+                  << std::setw(10) << 1e6 * round_trip[num_iter / 2]
+                  << std::setw(10) << 1e6 * round_trip[(num_iter * 9) / 10]
+                  << std::setw(10) << 1e6 * round_trip[(num_iter * 99) / 100]
+                  << std::setw(10) << 1e6 * round_trip.back()
+                  << std::setw(12) << level->overhead_send() / num_iter << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int num_iter = argc > 1 ? std::stoi(argv[1]) : 10000;
+    int num_value = argc > 2 ? std::stoi(argv[2]) : 8;
+    int err = 0;
+    if (num_iter <= 0 || num_value <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [NUM_ITER [NUM_VALUE]]\n";
+        err = -1;
+    }
+    else {
+        std::shared_ptr<geopm::Comm> comm = geopm::Comm::make_unique("MPIComm");
+        if (comm->rank() == 0) {
+            std::cout << "Round trip latency in microseconds, fan-out " << comm->num_rank()
+                      << ", " << num_value << " values, " << num_iter << " iterations\n"
+                      << std::setw(10) << "level" << std::setw(10) << "p50"
+                      << std::setw(10) << "p90" << std::setw(10) << "p99"
+                      << std::setw(10) << "max" << std::setw(12) << "B/iter\n";
+        }
+        for (const std::string name : {"lock", "mailbox"}) {
+            bench_level(name, comm, num_iter, num_value);
+        }
+        comm->tear_down();
+    }
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Measure the wakeup latency of each Waiter implementation.  Every
+/// call to Waiter::wait() is expected to return at the start time
+/// plus a whole number of periods; the latency is how long after that
+/// deadline the call returned.  The latency percentiles are reported
+/// along with the CPU time used per wait, which shows the cost of
+/// polling in the hybrid waiter.  Run on a loaded system to see the
+/// tail latency that the control loop is exposed to.
+///
+/// Usage: waiter_bench [PERIOD [NUM_WAIT]]
+
+#include <time.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm/Waiter.hpp"
+
+static double monotonic_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+static double cpu_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+static double percentile(const std::vector<double> &sorted, double fraction)
+{
+    size_t idx = fraction * (sorted.size() - 1);
+    return sorted[idx];
+}
+
+static void bench_waiter(const std::string &name, geopm::Waiter &waiter,
+                         double period, int num_wait)
+{
+    std::vector<double> latency(num_wait);
+    double cpu_begin = cpu_time();
+    waiter.reset();
+    double deadline = monotonic_time();
+    for (int wait_idx = 0; wait_idx != num_wait; ++wait_idx) {
+        deadline += period;
+        waiter.wait();
+        latency[wait_idx] = monotonic_time() - deadline;
+    }
+    double cpu_per_wait = (cpu_time() - cpu_begin) / num_wait;
+    std::sort(latency.begin(), latency.end());
+    std::cout << std::setw(16) << name << std::fixed << std::setprecision(1)
+              << std::setw(10) << 1e6 * percentile(latency, 0.5)
+              << std::setw(10) << 1e6 * percentile(latency, 0.9)
+              << std::setw(10) << 1e6 * percentile(latency, 0.99)
+              << std::setw(10) << 1e6 * latency.back()
+              << std::setw(12) << 1e6 * cpu_per_wait << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    double period = argc > 1 ? std::stod(argv[1]) : 0.005;
+    int num_wait = argc > 2 ? std::stoi(argv[2]) : 1000;
+    if (period <= 0.0 || num_wait <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [PERIOD [NUM_WAIT]]\n";
+        return -1;
+    }
+    std::cout << "Wakeup latency in microseconds, period " << period
+              << " s, " << num_wait << " waits\n"
+              << std::setw(16) << "waiter" << std::setw(10) << "p50"
+              << std::setw(10) << "p90" << std::setw(10) << "p99"
+              << std::setw(10) << "max" << std::setw(12) << "cpu/wait\n";
+    for (const std::string strategy : {"sleep", "timer", "hybrid"}) {
+        auto waiter = geopm::Waiter::make_unique(period, strategy);
+        bench_waiter(strategy, *waiter, period, num_wait);
+    }
+    for (double slack : {20e-6, 500e-6}) {
+        geopm::HybridWaiter waiter(period, slack);
+        bench_waiter("hybrid " + std::to_string((int)(1e6 * slack)) + "us",
+                     waiter, period, num_wait);
+    }
+    return 0;
+}
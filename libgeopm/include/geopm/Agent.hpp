@@ -9,6 +9,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "geopm/PluginFactory.hpp"
@@ -86,6 +87,29 @@ namespace geopm
             ///        to elapse.  This controls the cadence of the
             ///        Controller main loop.
             virtual void wait(void) = 0;
+            /// @brief Get the period enforced by wait().  Used by the
+            ///        Controller to count iterations that took longer
+            ///        than the period.
+            /// @return Period in seconds, the default implementation
+            ///         returns NAN which means that the period is not
+            ///         known.
+            virtual double wait_period(void) const;
+            /// @brief Range of periods that the agent will accept in a
+            ///        call to reset_wait_period().  When
+            ///        GEOPM_PERIOD_ADAPT is set the Controller may
+            ///        lengthen the period up to the maximum while the
+            ///        control loop is expensive or the application is
+            ///        idle, and return to the minimum when the
+            ///        application is active.
+            /// @return Minimum and maximum period in seconds.  The
+            ///         default implementation returns {0.0, 0.0}
+            ///         which means that the period may not be changed.
+            virtual std::pair<double, double> wait_period_range(void) const;
+            /// @brief Change the period enforced by wait().  Only
+            ///        called with a period inside of the range
+            ///        returned by wait_period_range().
+            /// @param [in] period New period in seconds.
+            virtual void reset_wait_period(double period);
             /// @brief Custom fields that will be added to the report
             ///        header when this agent is used.
             virtual std::vector<std::pair<std::string, std::string> > report_header(void) const = 0;
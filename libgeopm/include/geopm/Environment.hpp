@@ -40,6 +40,9 @@ namespace geopm
             virtual std::string endpoint(void) const = 0;
             virtual std::string trace(void) const = 0;
             virtual std::string trace_profile(void) const = 0;
+            virtual std::string trace_format(void) const = 0;
+            virtual std::string trace_writer(void) const = 0;
+            virtual std::string trace_compression(void) const = 0;
             virtual std::string trace_endpoint_policy(void) const = 0;
             virtual std::string profile(void) const = 0;
             virtual std::string frequency_map(void) const = 0;
@@ -66,6 +69,10 @@ namespace geopm
             virtual int debug_attach_process(void) const = 0;
             virtual std::string init_control(void) const = 0;
             virtual double period(double default_period) const = 0;
+            virtual bool do_period_adapt(void) const = 0;
+            virtual std::string wait_strategy(void) const = 0;
+            virtual double wait_slack(double default_slack) const = 0;
+            virtual std::string tree_comm(void) const = 0;
             virtual int num_proc(void) const = 0;
             virtual bool do_ctl_local(void) const = 0;
             static std::map<std::string, std::string> parse_environment_file(const std::string &env_file_path);
@@ -84,6 +91,9 @@ namespace geopm
             std::string endpoint(void) const override;
             std::string trace(void) const override;
             std::string trace_profile(void) const override;
+            std::string trace_format(void) const override;
+            std::string trace_writer(void) const override;
+            std::string trace_compression(void) const override;
             std::string trace_endpoint_policy(void) const override;
             std::string profile(void) const override;
             std::string frequency_map(void) const override;
@@ -115,6 +125,10 @@ namespace geopm
             int debug_attach_process(void) const override;
             std::string init_control(void) const override;
             double period(double default_period) const override;
+            bool do_period_adapt(void) const override;
+            std::string wait_strategy(void) const override;
+            double wait_slack(double default_slack) const override;
+            std::string tree_comm(void) const override;
             int num_proc(void) const override;
             bool do_ctl_local(void) const override;
         protected:
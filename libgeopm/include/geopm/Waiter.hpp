@@ -7,6 +7,8 @@
 #define WAITER_HPP_INCLUDE
 
 #include <memory>
+#include <string>
+
 #include "geopm_time.h"
 #include "geopm_public.h"
 
@@ -16,14 +18,29 @@ namespace geopm
     class GEOPM_PUBLIC Waiter
     {
         public:
-            /// @brief Create a Waiter with "sleep" strategy
+            /// @brief Create a Waiter with the strategy selected by
+            ///        the GEOPM_WAIT_STRATEGY environment variable,
+            ///        "sleep" if it is not set, and the slack of the
+            ///        "hybrid" strategy selected by GEOPM_WAIT_SLACK.
             /// @param [in] period Duration in seconds to wait
             static std::unique_ptr<Waiter> make_unique(double period);
-            /// @brief Create a Waiter
+            /// @brief Create a Waiter, the "hybrid" strategy uses
+            ///        the default slack.
             /// @param [in] period Duration in seconds to wait
-            /// @param [in] strategy Wait algorithm ("sleep")
+            /// @param [in] strategy Wait algorithm ("sleep", "timer"
+            ///        or "hybrid")
             static std::unique_ptr<Waiter> make_unique(double period,
                                                        std::string strategy);
+            /// @brief Create a Waiter
+            /// @param [in] period Duration in seconds to wait
+            /// @param [in] strategy Wait algorithm ("sleep", "timer"
+            ///        or "hybrid")
+            /// @param [in] slack Duration in seconds before each
+            ///        deadline that the "hybrid" strategy spends
+            ///        polling the clock, ignored by the others
+            static std::unique_ptr<Waiter> make_unique(double period,
+                                                       std::string strategy,
+                                                       double slack);
             Waiter() = default;
             virtual ~Waiter() = default;
             /// @brief Reset the timer for next wait
@@ -55,6 +72,54 @@ namespace geopm
             geopm_time_s m_time_target;
             bool m_is_first_time;
     };
+
+    /// @brief Class to support a periodic wait loop based on a
+    ///        timerfd using CLOCK_MONOTONIC.  The deadlines are not
+    ///        moved by changes to the system time.
+    class GEOPM_PUBLIC TimerWaiter : public Waiter
+    {
+        public:
+            TimerWaiter(double period);
+            virtual ~TimerWaiter();
+            TimerWaiter(const TimerWaiter &other) = delete;
+            TimerWaiter &operator=(const TimerWaiter &other) = delete;
+            void reset(void) override;
+            void reset(double period) override;
+            void wait(void) override;
+            double period(void) const override;
+        private:
+            double m_period;
+            geopm_time_s m_time_target;
+            bool m_is_first_time;
+            int m_timer_fd;
+    };
+
+    /// @brief Class to support a periodic wait loop that sleeps with
+    ///        clock_nanosleep() using CLOCK_MONOTONIC until a slack
+    ///        time before the deadline, and then polls the clock
+    ///        until the deadline.  This trades CPU time for a lower
+    ///        wakeup latency.
+    class GEOPM_PUBLIC HybridWaiter : public Waiter
+    {
+        public:
+            /// @brief Slack used by the "hybrid" strategy in seconds
+            static constexpr double M_DEFAULT_SLACK = 100e-6;
+            HybridWaiter(double period);
+            /// @param [in] period Duration in seconds to wait
+            /// @param [in] slack Duration in seconds before each
+            ///        deadline that is spent polling the clock
+            HybridWaiter(double period, double slack);
+            virtual ~HybridWaiter() = default;
+            void reset(void) override;
+            void reset(double period) override;
+            void wait(void) override;
+            double period(void) const override;
+        private:
+            double m_period;
+            double m_slack;
+            geopm_time_s m_time_target;
+            bool m_is_first_time;
+    };
 }
 
 #endif
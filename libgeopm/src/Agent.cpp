@@ -106,6 +106,22 @@ namespace geopm
         return {};
     }
 
+    double Agent::wait_period(void) const
+    {
+        return NAN;
+    }
+
+    std::pair<double, double> Agent::wait_period_range(void) const
+    {
+        return {0.0, 0.0};
+    }
+
+    void Agent::reset_wait_period(double period)
+    {
+        throw Exception("Agent::reset_wait_period(): the agent does not support changing the period",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+
     int Agent::num_sample(const std::map<std::string, std::string> &dictionary)
     {
         auto it = dictionary.find(m_num_sample_string);
@@ -28,11 +28,34 @@ namespace geopm
         return M_LAYOUT_SIZE;
     }
 
+    size_t ApplicationRecordLog::buffer_size(int max_record)
+    {
+        return sizeof(m_header_s) + 2 * buffer_stride(max_record);
+    }
+
+    size_t ApplicationRecordLog::buffer_stride(int max_record)
+    {
+        return sizeof(m_buffer_s) +
+               max_record * sizeof(record_s) +
+               (max_record + 1) * sizeof(short_region_s);
+    }
+
     size_t ApplicationRecordLog::max_record(void)
     {
         return M_MAX_RECORD;
     }
 
+    int ApplicationRecordLog::max_record(size_t buffer_size)
+    {
+        int result = 0;
+        size_t min_size = ApplicationRecordLog::buffer_size(0);
+        if (buffer_size >= min_size) {
+            result = (buffer_size - min_size) /
+                     (2 * (sizeof(record_s) + sizeof(short_region_s)));
+        }
+        return result;
+    }
+
     size_t ApplicationRecordLog::max_region(void)
     {
         return M_MAX_REGION;
@@ -48,51 +71,86 @@ namespace geopm
                                                      std::shared_ptr<Scheduler> scheduler)
         : m_process(process)
         , m_shmem(std::move(shmem))
+        , m_max_record(max_record(m_shmem->size()))
+        , m_header(nullptr)
+        , m_buffer{}
+        , m_generation(UINT64_MAX)
+        , m_table_generation(0)
+        , m_table_shift(64)
         , m_epoch_count(0)
         , m_entered_region_hash(GEOPM_REGION_HASH_INVALID)
         , m_scheduler(std::move(scheduler))
     {
+        static_assert(sizeof(m_header_s) == 64,
+                      "ApplicationRecordLog header must fill one cache line");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                      "ApplicationRecordLog requires lock free 64-bit atomics");
         if (m_shmem->size() < buffer_size()) {
             throw Exception("ApplicationRecordLog: Shared memory provided in constructor is too small",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        GEOPM_DEBUG_ASSERT(buffer_size(M_MAX_RECORD) == M_LAYOUT_SIZE,
+                           "Layout size used in geopmdpy/system_files.py to create shared memory footprint does not match the C++ code");
+        char *ptr = (char *)(m_shmem->pointer());
+        m_header = (m_header_s *)ptr;
+        ptr += sizeof(m_header_s);
+        for (auto &buffer : m_buffer) {
+            buffer.buffer = (m_buffer_s *)ptr;
+            buffer.record_table = (record_s *)(buffer.buffer + 1);
+            buffer.region_table = (short_region_s *)(buffer.record_table + m_max_record);
+            ptr += buffer_stride(m_max_record);
+        }
+    }
+
+    ApplicationRecordLogImp::m_buffer_ptr_s &ApplicationRecordLogImp::begin_write(void)
+    {
+        // Setting the write bit prevents the consumer from swapping
+        // the buffers until end_write() is called.
+        uint64_t state = m_header->state.fetch_or(M_STATE_WRITE, std::memory_order_acquire);
+        uint64_t generation = state >> 1;
+        check_reset(generation);
+        return m_buffer[generation % 2];
+    }
+
+    void ApplicationRecordLogImp::end_write(void)
+    {
+        m_header->state.fetch_and(~M_STATE_WRITE, std::memory_order_release);
     }
 
     void ApplicationRecordLogImp::enter(uint64_t hash, const geopm_time_s &time)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
-        auto emplace_pair = m_hash_region_enter_map.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(hash),
-            std::forward_as_tuple());
-        bool is_new  = emplace_pair.second;
-        m_region_enter_s &region_enter = emplace_pair.first->second;
-        region_enter.enter_time = time;
-        if (is_new) {
-            region_enter.record_idx = layout.num_record;
-            region_enter.region_idx = -1; // Not a short region yet
-            region_enter.is_short = false;
+        m_buffer_ptr_s &layout = begin_write();
+        m_region_enter_s *region_enter = find_region_enter(hash);
+        if (region_enter == nullptr) {
+            int record_idx = layout.buffer->num_record;
             record_s enter_record = {
                .time = time,
                .process = m_process,
                .event = EVENT_REGION_ENTRY,
                .signal = hash,
             };
-            append_record(layout, enter_record);
+            // If the entry is dropped the region is not tracked and
+            // the exit will be sent as a normal exit event.
+            if (append_record(layout, enter_record)) {
+                region_enter = &insert_region_enter(hash);
+                region_enter->record_idx = record_idx;
+                region_enter->region_idx = -1; // Not a short region yet
+                region_enter->is_short = false;
+            }
+        }
+        if (region_enter != nullptr) {
+            region_enter->enter_time = time;
         }
         m_entered_region_hash = hash;
+        end_write();
     }
 
     void ApplicationRecordLogImp::exit(uint64_t hash, const geopm_time_s &time)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
+        m_buffer_ptr_s &layout = begin_write();
 
-        auto region_it = m_hash_region_enter_map.find(hash);
-        if (region_it == m_hash_region_enter_map.end()) {
+        m_region_enter_s *region_enter = find_region_enter(hash);
+        if (region_enter == nullptr) {
             // No short region info; send a normal exit event
             record_s exit_record = {
                .time = time,
@@ -105,8 +163,9 @@ namespace geopm
         else {
             // This region was previous marked short or an entry
             // occurred in the same control loop.
-            auto &enter_info = region_it->second;
+            auto &enter_info = *region_enter;
             enter_info.is_short = true;
+            bool is_recorded = true;
             if (enter_info.record_idx == -1) {
                 GEOPM_DEBUG_ASSERT(enter_info.region_idx == -1,
                                    "Short region in list with no matching record");
@@ -119,48 +178,51 @@ namespace geopm
                     .event = EVENT_REGION_ENTRY,
                     .signal = hash,
                 };
-                enter_info.record_idx = layout.num_record;
-                append_record(layout, enter_record);
+                enter_info.record_idx = layout.buffer->num_record;
+                is_recorded = append_record(layout, enter_record);
+                if (!is_recorded) {
+                    enter_info.record_idx = -1;
+                }
             }
-            GEOPM_DEBUG_ASSERT(enter_info.record_idx >= 0 && enter_info.record_idx < layout.num_record,
-                               "Invalid record index");
+            if (is_recorded) {
+                GEOPM_DEBUG_ASSERT(enter_info.record_idx >= 0 && enter_info.record_idx < layout.buffer->num_record,
+                                   "Invalid record index");
 
-            // find or add the region in short regions array
-            int region_idx = enter_info.region_idx;
-            if (region_idx == -1) {
-                region_idx = layout.num_region;
-                enter_info.region_idx = region_idx;
-                ++(layout.num_region);
-                GEOPM_DEBUG_ASSERT(layout.num_region <= M_MAX_REGION,
-                                   "ApplicationRecordLogImp::exit(): too many regions entered and exited within one control loop");
-                // Add a new short region
-                layout.region_table[region_idx] = {
-                    .hash = hash,
-                    .num_complete = 0,
-                    .total_time = 0.0,
-                };
-                GEOPM_DEBUG_ASSERT(layout.record_table[enter_info.record_idx].event == EVENT_REGION_ENTRY,
-                                   "ApplicationRegionLog::exit(): adding a new short region when existing was not an entry.");
-                // Convert the region entry event into a short region event
-                layout.record_table[enter_info.record_idx].event = EVENT_SHORT_REGION;
-                layout.record_table[enter_info.record_idx].signal = region_idx;
+                // find or add the region in short regions array
+                int region_idx = enter_info.region_idx;
+                if (region_idx == -1) {
+                    region_idx = layout.buffer->num_region;
+                    enter_info.region_idx = region_idx;
+                    ++(layout.buffer->num_region);
+                    GEOPM_DEBUG_ASSERT(layout.buffer->num_region <= m_max_record + 1,
+                                       "ApplicationRecordLogImp::exit(): too many regions entered and exited within one control loop");
+                    // Add a new short region
+                    layout.region_table[region_idx] = {
+                        .hash = hash,
+                        .num_complete = 0,
+                        .total_time = 0.0,
+                    };
+                    GEOPM_DEBUG_ASSERT(layout.record_table[enter_info.record_idx].event == EVENT_REGION_ENTRY,
+                                       "ApplicationRegionLog::exit(): adding a new short region when existing was not an entry.");
+                    // Convert the region entry event into a short region event
+                    layout.record_table[enter_info.record_idx].event = EVENT_SHORT_REGION;
+                    layout.record_table[enter_info.record_idx].signal = region_idx;
+                }
+                GEOPM_DEBUG_ASSERT(region_idx >= 0 && region_idx < layout.buffer->num_region,
+                                   "Invalid region index");
+                // Update the count and total time for the short region
+                auto &region = layout.region_table[region_idx];
+                ++(region.num_complete);
+                region.total_time += geopm_time_diff(&(enter_info.enter_time), &time);
             }
-            GEOPM_DEBUG_ASSERT(region_idx >= 0 && region_idx < layout.num_region,
-                               "Invalid region index");
-            // Update the count and total time for the short region
-            auto &region = layout.region_table[region_idx];
-            ++(region.num_complete);
-            region.total_time += geopm_time_diff(&(enter_info.enter_time), &time);
         }
         m_entered_region_hash = GEOPM_REGION_HASH_INVALID;
+        end_write();
     }
 
     void ApplicationRecordLogImp::epoch(const geopm_time_s &time)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
-
+        m_buffer_ptr_s &layout = begin_write();
         ++m_epoch_count;
         record_s epoch_record = {
            .time = time,
@@ -169,6 +231,7 @@ namespace geopm
            .signal = m_epoch_count,
         };
         append_record(layout, epoch_record);
+        end_write();
     }
 
     void ApplicationRecordLogImp::cpuset_changed(const geopm_time_s &time)
@@ -184,9 +247,7 @@ namespace geopm
 
     void ApplicationRecordLogImp::affinity(const geopm_time_s &time, int cpu_idx)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
+        m_buffer_ptr_s &layout = begin_write();
         record_s affinity_record = {
            .time = time,
            .process = m_process,
@@ -194,13 +255,12 @@ namespace geopm
            .signal = (uint64_t)cpu_idx,
         };
         append_record(layout, affinity_record);
+        end_write();
     }
 
     void ApplicationRecordLogImp::start_profile(const geopm_time_s &time, const std::string &profile_name)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
+        m_buffer_ptr_s &layout = begin_write();
         uint64_t profile_hash = geopm_crc32_str(profile_name.c_str());
         record_s profile_start_record = {
            .time = time,
@@ -209,13 +269,12 @@ namespace geopm
            .signal = profile_hash,
         };
         append_record(layout, profile_start_record);
+        end_write();
     }
 
     void ApplicationRecordLogImp::stop_profile(const geopm_time_s &time, const std::string &profile_name)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
+        m_buffer_ptr_s &layout = begin_write();
         uint64_t profile_hash = geopm_crc32_str(profile_name.c_str());
         record_s profile_stop_record = {
            .time = time,
@@ -224,13 +283,12 @@ namespace geopm
            .signal = profile_hash,
         };
         append_record(layout, profile_stop_record);
+        end_write();
     }
 
     void ApplicationRecordLogImp::overhead(const geopm_time_s &time, double overhead_sec)
     {
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        check_reset(layout);
+        m_buffer_ptr_s &layout = begin_write();
         uint64_t field = geopm_signal_to_field(overhead_sec);
         record_s overhead_record = {
            .time = time,
@@ -239,57 +297,131 @@ namespace geopm
            .signal = field,
         };
         append_record(layout, overhead_record);
+        end_write();
     }
 
     void ApplicationRecordLogImp::dump(std::vector<record_s> &records,
                                        std::vector<short_region_s> &short_regions)
     {
-        // this function should not do anything with m_hash_region_enter_map
-        std::unique_ptr<SharedMemoryScopedLock> lock = m_shmem->get_scoped_lock();
-        m_layout_s &layout = *((m_layout_s *)(m_shmem->pointer()));
-        records.assign(layout.record_table, layout.record_table + layout.num_record);
-        short_regions.assign(layout.region_table, layout.region_table + layout.num_region);
-        layout.num_record = 0;
-        layout.num_region = 0;
+        // this function should not do anything with m_region_enter_table
+        records.clear();
+        short_regions.clear();
+        // Swap the active buffer by incrementing the generation.  The
+        // swap fails while the producer is writing, in which case the
+        // records are left for the next call.
+        uint64_t state = m_header->state.load(std::memory_order_relaxed) & ~M_STATE_WRITE;
+        bool is_swapped = false;
+        for (int attempt = 0; !is_swapped && attempt < M_MAX_SWAP_ATTEMPT; ++attempt) {
+            state &= ~M_STATE_WRITE;
+            is_swapped = m_header->state.compare_exchange_weak(state, state + 2,
+                                                               std::memory_order_acq_rel,
+                                                               std::memory_order_relaxed);
+        }
+        if (is_swapped) {
+            // The producer has moved on to the other buffer, so the
+            // previous one is owned by the consumer until the next swap.
+            m_buffer_ptr_s &layout = m_buffer[(state >> 1) % 2];
+            records.assign(layout.record_table, layout.record_table + layout.buffer->num_record);
+            short_regions.assign(layout.region_table, layout.region_table + layout.buffer->num_region);
+            layout.buffer->num_record = 0;
+            layout.buffer->num_region = 0;
+        }
+    }
+
+    uint64_t ApplicationRecordLogImp::num_overflow(void) const
+    {
+        return m_header->num_overflow.load(std::memory_order_relaxed);
     }
 
-    void ApplicationRecordLogImp::check_reset(m_layout_s &layout)
+    void ApplicationRecordLogImp::check_reset(uint64_t generation)
     {
-        if (layout.num_record == 0) {
+        if (generation != m_generation) {
+            m_generation = generation;
+            if (m_region_enter_table.empty()) {
+                // First update by the producer: m_generation was
+                // initialized to an invalid value so that the table
+                // is only allocated by the producer side.
+                int table_bits = 1;
+                while ((1 << table_bits) < 2 * (m_max_record + 1)) {
+                    ++table_bits;
+                }
+                m_region_enter_table.resize(1 << table_bits);
+                m_table_shift = 64 - table_bits;
+                m_table_generation = 1;
+                return;
+            }
             // Other side has cleared the records.
             // If currently in a short region, keep track of any short region data.
-            auto region_enter_it = m_hash_region_enter_map.find(m_entered_region_hash);
-            if (region_enter_it != m_hash_region_enter_map.end()) {
-                auto &entry_info = region_enter_it->second;
-                if (entry_info.is_short) {
-                    // the current region was previous marked as short;
-                    // maintain entry to convert a future exit
-                    entry_info.record_idx = -1;
-                    entry_info.region_idx = -1;
-                    m_hash_region_enter_map = {*region_enter_it};
-                }
-                else {
-                    // never marked as short region so an exit event will be sent
-                    m_hash_region_enter_map.clear();
-                }
+            m_region_enter_s *region_enter = find_region_enter(m_entered_region_hash);
+            ++m_table_generation;
+            if (region_enter != nullptr && region_enter->is_short) {
+                // the current region was previous marked as short;
+                // maintain entry to convert a future exit
+                geopm_time_s enter_time = region_enter->enter_time;
+                m_region_enter_s &entry_info = insert_region_enter(m_entered_region_hash);
+                entry_info.enter_time = enter_time;
+                entry_info.record_idx = -1;
+                entry_info.region_idx = -1;
+                entry_info.is_short = true;
+            }
+            // otherwise never marked as short region so an exit event will be sent
+        }
+    }
+
+    size_t ApplicationRecordLogImp::region_enter_slot(uint64_t hash) const
+    {
+        // Fibonacci hashing spreads sequential and CRC32 based
+        // hashes over the table.
+        return (hash * 0x9E3779B97F4A7C15ULL) >> m_table_shift;
+    }
+
+    ApplicationRecordLogImp::m_region_enter_s *ApplicationRecordLogImp::find_region_enter(uint64_t hash)
+    {
+        m_region_enter_s *result = nullptr;
+        size_t mask = m_region_enter_table.size() - 1;
+        for (size_t slot = region_enter_slot(hash); result == nullptr; slot = (slot + 1) & mask) {
+            m_region_enter_s &region_enter = m_region_enter_table[slot];
+            if (region_enter.table_generation != m_table_generation) {
+                break;
             }
-            else {
-                m_hash_region_enter_map.clear();
+            if (region_enter.hash == hash) {
+                result = &region_enter;
             }
         }
+        return result;
+    }
+
+    ApplicationRecordLogImp::m_region_enter_s &ApplicationRecordLogImp::insert_region_enter(uint64_t hash)
+    {
+        // There is at most one entry per record in the active buffer
+        // plus the one carried over by check_reset(), so the table is
+        // never more than half full and an empty slot is always found.
+        size_t mask = m_region_enter_table.size() - 1;
+        size_t slot = region_enter_slot(hash);
+        while (m_region_enter_table[slot].table_generation == m_table_generation) {
+            GEOPM_DEBUG_ASSERT(m_region_enter_table[slot].hash != hash,
+                               "ApplicationRecordLogImp::insert_region_enter(): hash is already in the table");
+            slot = (slot + 1) & mask;
+        }
+        m_region_enter_s &result = m_region_enter_table[slot];
+        result.hash = hash;
+        result.table_generation = m_table_generation;
+        return result;
     }
 
-    void ApplicationRecordLogImp::append_record(m_layout_s &layout, const record_s &record)
+    bool ApplicationRecordLogImp::append_record(m_buffer_ptr_s &layout, const record_s &record)
     {
-        int record_idx = layout.num_record;
+        bool result = false;
+        int record_idx = layout.buffer->num_record;
         // Don't overrun the buffer
-        if (record_idx < M_MAX_RECORD) {
+        if (record_idx < m_max_record) {
             layout.record_table[record_idx] = record;
-            ++(layout.num_record);
+            ++(layout.buffer->num_record);
+            result = true;
         }
         else {
-            throw Exception("ApplicationRecordLog: maximum number of records reached.",
-                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            m_header->num_overflow.fetch_add(1, std::memory_order_relaxed);
         }
+        return result;
     }
 }
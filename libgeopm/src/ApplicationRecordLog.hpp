@@ -6,9 +6,10 @@
 #ifndef APPLICATIONRECORDLOG_HPP_INCLUDE
 #define APPLICATIONRECORDLOG_HPP_INCLUDE
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
-#include <map>
+#include <array>
 #include <vector>
 #include <memory>
 
@@ -18,13 +19,22 @@
 namespace geopm
 {
     class SharedMemory;
-    class SharedMemoryScopedLock;
     class Scheduler;
 
     /// @brief Provides an abstraction for a shared memory buffer that
     ///        can be used to pass entry, exit, epoch and short region
     ///        events from Profile to ApplicationSampler.
     ///
+    /// The shared memory is written by a single producer (the
+    /// Profile of one application process) and read by a single
+    /// consumer (the ApplicationSampler) without locking.  Two record
+    /// buffers are kept in the shared memory: the producer appends to
+    /// the active buffer while the consumer swaps the active buffer
+    /// with an atomic compare-and-swap in dump() and then drains the
+    /// inactive one.  The producer never waits on the consumer.  If
+    /// the active buffer fills before the next dump() call, further
+    /// records are dropped and counted by num_overflow().
+    ///
     /// This class provides a compression of short running regions to
     /// avoid overwhelming the controller with too many records.
     ///
@@ -58,7 +68,10 @@ namespace geopm
         public:
             /// @brief Factory constructor
             /// @param [in] shmem Shared memory object of at least the
-            ///        size returned by buffer_size().
+            ///        size returned by buffer_size().  The number of
+            ///        records that can be stored between calls to
+            ///        dump() is derived from the size of the shared
+            ///        memory, see max_record(size_t).
             static std::unique_ptr<ApplicationRecordLog> make_unique(std::shared_ptr<SharedMemory> shmem);
             /// @brief Destructor for pure virtual base class.
             virtual ~ApplicationRecordLog() = default;
@@ -140,14 +153,30 @@ namespace geopm
             virtual void start_profile(const geopm_time_s &time, const std::string &profile_name) = 0;
             virtual void stop_profile(const geopm_time_s &time, const std::string &profile_name) = 0;
             virtual void overhead(const geopm_time_s &time, double overhead_sec) = 0;
+            /// @brief Get the number of records that were dropped
+            ///        because the log was full.
+            ///
+            /// The count is stored in the shared memory and is
+            /// cumulative over the lifetime of the log.
+            ///
+            /// @return Total number of dropped records.
+            virtual uint64_t num_overflow(void) const = 0;
             /// @brief Gets the shared memory size requirement.
             ///
             /// This method returns the value to use when sizing the
             /// SharedMemory object used to construct the
-            /// ApplicationRecordLog.
+            /// ApplicationRecordLog with the default capacity.
             ///
             /// @return Size requirement for SharedMemory object.
             static size_t buffer_size(void);
+            /// @brief Gets the shared memory size required to store
+            ///        a given number of records between calls to
+            ///        dump().
+            ///
+            /// @param [in] max_record Capacity of the log in records.
+            ///
+            /// @return Size requirement for SharedMemory object.
+            static size_t buffer_size(int max_record);
             /// @brief Gets the maximum number of records.
             ///
             /// This method returns the value to use when reserving
@@ -156,6 +185,14 @@ namespace geopm
             /// @return The maximum length of the records vector after
             ///         a call to dump().
             static size_t max_record(void);
+            /// @brief Gets the number of records that fit in a shared
+            ///        memory region of the given size.
+            ///
+            /// @param [in] buffer_size Size of the SharedMemory object
+            ///        in bytes.
+            ///
+            /// @return The capacity of the log in records.
+            static int max_record(size_t buffer_size);
             /// @brief Gets the maximum number of short region events.
             ///
             /// This method returns the value to use when reserving
@@ -166,9 +203,29 @@ namespace geopm
             static size_t max_region(void);
         protected:
             ApplicationRecordLog() = default;
-            static constexpr size_t M_LAYOUT_SIZE = 57384;
+            static constexpr size_t M_LAYOUT_SIZE = 114816;
             static constexpr int M_MAX_RECORD = 1024;
             static constexpr int M_MAX_REGION = M_MAX_RECORD + 1;
+            /// @brief Header at the beginning of the shared memory.
+            ///
+            /// The state holds the generation count shifted left by
+            /// one with the lowest bit set while the producer is
+            /// writing.  The active buffer is the generation modulo
+            /// two.
+            struct m_header_s {
+                std::atomic<uint64_t> state;
+                std::atomic<uint64_t> num_overflow;
+                char padding[64 - 2 * sizeof(uint64_t)];
+            };
+            /// @brief Header of each of the two buffers.  It is
+            ///        followed by max_record record_s structures and
+            ///        then by max_record + 1 short_region_s
+            ///        structures.
+            struct m_buffer_s {
+                int32_t num_record;
+                int32_t num_region;
+            };
+            static size_t buffer_stride(int max_record);
     };
     class ApplicationRecordLogImp : public ApplicationRecordLog
     {
@@ -188,27 +245,64 @@ namespace geopm
             void start_profile(const geopm_time_s &time, const std::string &profile_name) override;
             void stop_profile(const geopm_time_s &time, const std::string &profile_name) override;
             void overhead(const geopm_time_s &time, double overhead_sec) override;
+            uint64_t num_overflow(void) const override;
         private:
-            struct m_layout_s {
-                int32_t num_record;
-                record_s record_table[M_MAX_RECORD];
-                int32_t num_region;
-                short_region_s region_table[M_MAX_REGION];
+            static constexpr uint64_t M_STATE_WRITE = 1;
+            /// @brief Number of attempts dump() makes to swap buffers
+            ///        while the producer is writing before giving up
+            ///        until the next call.
+            static constexpr int M_MAX_SWAP_ATTEMPT = 1000;
+            /// @brief Pointers into one of the two buffers in shared
+            ///        memory.
+            struct m_buffer_ptr_s {
+                m_buffer_s *buffer;
+                record_s *record_table;
+                short_region_s *region_table;
             };
-            static_assert(sizeof(m_layout_s) <= M_LAYOUT_SIZE,
-                          "Layout size used in geopmdpy/system_files.py to create shared memory footprint is smaller than required by C++ code");
-
+            /// @brief Slot in the open addressing table that tracks
+            ///        regions entered since the last dump().
+            ///
+            /// A slot is in use only if its table_generation matches
+            /// m_table_generation, so the table is cleared in
+            /// constant time by incrementing m_table_generation.
             struct m_region_enter_s {
+                uint64_t hash;
+                uint64_t table_generation;
                 int record_idx;
                 int region_idx;
                 geopm_time_s enter_time;
                 bool is_short;
             };
-            void check_reset(m_layout_s &layout);
-            void append_record(m_layout_s &layout, const record_s &record);
+            /// @brief Mark the start of a producer update and return
+            ///        the active buffer.
+            m_buffer_ptr_s &begin_write(void);
+            /// @brief Mark the end of a producer update.
+            void end_write(void);
+            void check_reset(uint64_t generation);
+            /// @return Pointer to the table slot for the hash, or
+            ///         nullptr if the region was not entered since
+            ///         the last dump().
+            m_region_enter_s *find_region_enter(uint64_t hash);
+            /// @brief Claim the table slot for a hash that is not in
+            ///        the table.
+            m_region_enter_s &insert_region_enter(uint64_t hash);
+            /// @return Index of the first slot to probe for the hash.
+            size_t region_enter_slot(uint64_t hash) const;
+            bool append_record(m_buffer_ptr_s &layout, const record_s &record);
             int m_process;
             std::shared_ptr<SharedMemory> m_shmem;
-            std::map<uint64_t, m_region_enter_s> m_hash_region_enter_map;
+            const int m_max_record;
+            m_header_s *m_header;
+            std::array<m_buffer_ptr_s, 2> m_buffer;
+            /// @brief Generation observed by the producer on its
+            ///        last update.
+            uint64_t m_generation;
+            /// @brief Regions entered since the last dump(), sized
+            ///        on first use to hold at least twice the number
+            ///        of regions that can be recorded in one buffer.
+            std::vector<m_region_enter_s> m_region_enter_table;
+            uint64_t m_table_generation;
+            int m_table_shift;
             uint64_t m_epoch_count;
             uint64_t m_entered_region_hash;
             std::shared_ptr<Scheduler> m_scheduler;
@@ -454,6 +454,15 @@ namespace geopm
         return result;
     }
 
+    uint64_t ApplicationSamplerImp::record_log_overflow(void) const
+    {
+        uint64_t result = 0;
+        for (const auto &proc_it : m_process_map) {
+            result += proc_it.second.record_log->num_overflow();
+        }
+        return result;
+    }
+
     int ApplicationSamplerImp::sampler_cpu(void)
     {
         int result = m_num_cpu - 1;
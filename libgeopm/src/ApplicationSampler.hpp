@@ -115,6 +115,12 @@ namespace geopm
             virtual bool do_shutdown(void) const = 0;
             virtual double total_time(void) const = 0;
             virtual double overhead_time(void) const = 0;
+            /// @brief Get the number of application records that
+            ///        were dropped because a record log was full.
+            ///
+            /// @return Sum of the overflow counts over all connected
+            ///         processes.
+            virtual uint64_t record_log_overflow(void) const = 0;
         protected:
             ApplicationSampler() = default;
         private:
@@ -54,6 +54,7 @@ namespace geopm
             bool do_shutdown(void) const override;
             double total_time(void) const override;
             double overhead_time(void) const override;
+            uint64_t record_log_overflow(void) const override;
             int sampler_cpu(void);
         private:
             std::map<int, m_process_s> connect_record_log(const std::vector<int> &client_pids);
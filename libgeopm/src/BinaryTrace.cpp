@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "BinaryTrace.hpp"
+
+#include <cstring>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include "geopm_version.h"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Environment.hpp"
+#include "TraceWriter.hpp"
+
+namespace geopm
+{
+    static uint64_t binary_trace_little_endian(uint64_t value)
+    {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap64(value);
+#endif
+        return value;
+    }
+
+    BinaryTraceImp::BinaryTraceImp(const std::string &file_path,
+                                   const std::string &host_name,
+                                   const std::string &start_time,
+                                   size_t buffer_size)
+        : BinaryTraceImp(file_path, host_name, start_time, buffer_size, "sync", "none")
+    {
+
+    }
+
+    BinaryTraceImp::BinaryTraceImp(const std::string &file_path,
+                                   const std::string &host_name,
+                                   const std::string &start_time,
+                                   size_t buffer_size,
+                                   const std::string &writer_policy,
+                                   const std::string &compression)
+        : m_file_path(file_path)
+        , m_buffer_size(buffer_size)
+        , m_num_row(0)
+        , m_max_row(0)
+        , m_is_active(false)
+    {
+        if (host_name.size()) {
+            m_file_path += "-" + host_name;
+        }
+        m_writer = TraceWriter::make_unique(m_file_path, writer_policy, compression);
+        std::ostringstream metadata;
+        metadata << "# geopm_version: " << geopm_version() << "\n"
+                 << "# start_time: " << start_time << "\n"
+                 << "# profile_name: " << environment().profile() << "\n"
+                 << "# node_name: " << host_name << "\n"
+                 << "# agent: " << environment().agent() << "\n";
+        m_metadata = metadata.str();
+    }
+
+    BinaryTraceImp::~BinaryTraceImp()
+    {
+        if (m_is_active) {
+            // An error deferred by the writer thread must not escape
+            // the destructor.
+            try {
+                flush();
+            }
+            catch (const std::exception &ex) {
+                std::cerr << "Warning: <geopm> BinaryTraceImp: Unable to write " << m_file_path
+                          << ": " << ex.what() << "\n";
+            }
+        }
+    }
+
+    void BinaryTraceImp::add_column(const std::string &name)
+    {
+        add_column(name, "double");
+    }
+
+    void BinaryTraceImp::add_column(const std::string &name, const std::string &format)
+    {
+        static const std::vector<std::string> format_names = {
+            "double", "float", "integer", "hex", "raw64", "event", "event_signal"
+        };
+        if (m_is_active) {
+            throw Exception("BinaryTraceImp::add_column() cannot be called after activate()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (std::find(format_names.begin(), format_names.end(), format) == format_names.end()) {
+            throw Exception("BinaryTraceImp::add_column(), format is unknown: " + format,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_column_name.push_back(name);
+        m_column_format.push_back(format);
+    }
+
+    void BinaryTraceImp::add_column(const std::string &name, std::function<std::string(double)> format)
+    {
+        static const std::map<decltype(&string_format_double), std::string> function_names = {
+            {string_format_double, "double"},
+            {string_format_float, "float"},
+            {string_format_integer, "integer"},
+            {string_format_hex, "hex"},
+            {string_format_raw64, "raw64"},
+        };
+        std::string format_name = "double";
+        auto f_ptr = format.target<decltype(&string_format_double)>();
+        if (f_ptr != nullptr) {
+            auto it = function_names.find(*f_ptr);
+            if (it != function_names.end()) {
+                format_name = it->second;
+            }
+        }
+        add_column(name, format_name);
+    }
+
+    void BinaryTraceImp::activate(void)
+    {
+        if (!m_is_active) {
+            m_is_active = true;
+            size_t row_size = sizeof(double) * m_column_name.size();
+            size_t block_size = std::min({m_buffer_size, M_MAX_BLOCK_SIZE,
+                                          m_writer->max_buffer_size()});
+            m_max_row = std::max(block_size / std::max(row_size, (size_t)1), (size_t)1);
+            m_block.resize(m_max_row * m_column_name.size());
+            write_header();
+        }
+    }
+
+    void BinaryTraceImp::update(const std::vector<double> &sample)
+    {
+        if (!m_is_active) {
+            throw Exception("BinaryTraceImp::activate() must be called prior to update",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (sample.size() != m_column_name.size()) {
+            throw Exception("BinaryTraceImp::update(): Input vector incorrectly sized",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::memcpy(m_block.data() + m_num_row * sample.size(),
+                    sample.data(), sample.size() * sizeof(double));
+        ++m_num_row;
+        if (m_num_row == m_max_row) {
+            write_block();
+        }
+    }
+
+    void BinaryTraceImp::flush(void)
+    {
+        if (m_num_row != 0) {
+            write_block();
+        }
+        m_writer->flush();
+    }
+
+    uint64_t BinaryTraceImp::num_flush_overrun(void) const
+    {
+        return m_writer->num_flush_overrun();
+    }
+
+    double BinaryTraceImp::write_time(void) const
+    {
+        return m_writer->write_time();
+    }
+
+    void BinaryTraceImp::write_header(void)
+    {
+        std::string header(M_MAGIC);
+        append_uint32(header, M_VERSION);
+        append_uint32(header, m_column_name.size());
+        append_string(header, m_metadata);
+        for (size_t col_idx = 0; col_idx != m_column_name.size(); ++col_idx) {
+            append_string(header, m_column_name[col_idx]);
+            append_string(header, m_column_format[col_idx]);
+        }
+        m_writer->write(std::move(header));
+    }
+
+    void BinaryTraceImp::write_block(void)
+    {
+        size_t num_column = m_column_name.size();
+        std::string block;
+        append_uint32(block, m_num_row);
+        size_t offset = block.size();
+        block.resize(offset + m_num_row * num_column * sizeof(uint64_t));
+        char *column = &block[offset];
+        for (size_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            const double *value = m_block.data() + col_idx;
+            for (size_t row_idx = 0; row_idx != m_num_row; ++row_idx) {
+                uint64_t bits;
+                std::memcpy(&bits, value, sizeof(bits));
+                bits = binary_trace_little_endian(bits);
+                std::memcpy(column, &bits, sizeof(bits));
+                column += sizeof(bits);
+                value += num_column;
+            }
+        }
+        m_writer->write(std::move(block));
+        m_num_row = 0;
+    }
+
+    void BinaryTraceImp::append_uint32(std::string &buffer, uint32_t value)
+    {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap32(value);
+#endif
+        buffer.append((const char *)&value, sizeof(value));
+    }
+
+    void BinaryTraceImp::append_string(std::string &buffer, const std::string &str)
+    {
+        append_uint32(buffer, str.size());
+        buffer.append(str);
+    }
+}
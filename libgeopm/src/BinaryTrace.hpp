@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BINARYTRACE_HPP_INCLUDE
+#define BINARYTRACE_HPP_INCLUDE
+
+#include <cstdint>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CSV.hpp"
+
+namespace geopm
+{
+    class TraceWriter;
+
+    /// @brief Implementation of the CSV interface that writes a
+    ///        binary columnar trace file instead of text.
+    ///
+    /// Values are not formatted when they are written: update()
+    /// copies the row into a block buffer and full blocks are
+    /// written column by column.  The geopmpy.trace Python module
+    /// renders the file as the equivalent CSV file.  All fields are
+    /// little-endian.  The file begins with a header:
+    ///
+    ///     char[8]  magic "GEOPMTRB"
+    ///     uint32   version (1)
+    ///     uint32   number of columns
+    ///     string   metadata: the "# key: value" lines of a CSV trace
+    ///     string   name and string format for each column
+    ///
+    /// where each string is a uint32 byte count followed by the
+    /// bytes.  The header is followed by blocks until the end of the
+    /// file:
+    ///
+    ///     uint32   number of rows in the block
+    ///     float64  values of the first column for each row, then
+    ///              the values of the second column, and so on
+    ///
+    /// The column format is the name of the CSV format function:
+    /// "double", "float", "integer", "hex" or "raw64", or one of
+    /// "event" and "event_signal" used by the profile trace.  Columns
+    /// added with a format function that is not one of these are
+    /// stored with the "double" format.
+    class BinaryTraceImp : public CSV
+    {
+        public:
+            BinaryTraceImp(const std::string &file_path,
+                           const std::string &host_name,
+                           const std::string &start_time,
+                           size_t buffer_size);
+            BinaryTraceImp(const std::string &file_path,
+                           const std::string &host_name,
+                           const std::string &start_time,
+                           size_t buffer_size,
+                           const std::string &writer_policy,
+                           const std::string &compression);
+            BinaryTraceImp(const BinaryTraceImp &other) = delete;
+            BinaryTraceImp &operator=(const BinaryTraceImp &other) = delete;
+            virtual ~BinaryTraceImp();
+            void add_column(const std::string &name) override;
+            void add_column(const std::string &name,
+                            const std::string &format) override;
+            void add_column(const std::string &name,
+                            std::function<std::string(double)> format) override;
+            void activate(void) override;
+            void update(const std::vector<double> &sample) override;
+            void flush(void) override;
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
+            static constexpr const char *M_MAGIC = "GEOPMTRB";
+            static constexpr uint32_t M_VERSION = 1;
+        private:
+            void write_header(void);
+            void write_block(void);
+            static void append_uint32(std::string &buffer, uint32_t value);
+            static void append_string(std::string &buffer, const std::string &str);
+
+            /// @brief Upper limit on the size of a block in bytes
+            static constexpr size_t M_MAX_BLOCK_SIZE = 1024 * 1024;
+            std::string m_file_path;
+            std::string m_metadata;
+            size_t m_buffer_size;
+            std::vector<std::string> m_column_name;
+            std::vector<std::string> m_column_format;
+            std::unique_ptr<TraceWriter> m_writer;
+            /// @brief Rows of the current block, row major
+            std::vector<double> m_block;
+            size_t m_num_row;
+            size_t m_max_row;
+            bool m_is_active;
+    };
+}
+
+#endif
@@ -443,6 +443,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double CPUActivityAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     // Adds the wait time to the top of the report
     std::vector<std::pair<std::string, std::string> > CPUActivityAgent::report_header(void) const
     {
@@ -5,11 +5,14 @@
 
 #include <climits>
 #include <cinttypes>
+#include <iostream>
 
 #include "geopm_version.h"
 #include "geopm_hash.h"
 #include "geopm/Helper.hpp"
 #include "CSV.hpp"
+#include "BinaryTrace.hpp"
+#include "TraceWriter.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Environment.hpp"
 
@@ -19,6 +22,17 @@ namespace geopm
                    const std::string &host_name,
                    const std::string &start_time,
                    size_t buffer_size)
+        : CSVImp(file_path, host_name, start_time, buffer_size, "sync", "none")
+    {
+
+    }
+
+    CSVImp::CSVImp(const std::string &file_path,
+                   const std::string &host_name,
+                   const std::string &start_time,
+                   size_t buffer_size,
+                   const std::string &writer_policy,
+                   const std::string &compression)
         : M_NAME_FORMAT_MAP {{"double", string_format_double},
                              {"float", string_format_float},
                              {"integer", string_format_integer},
@@ -32,17 +46,26 @@ namespace geopm
         if (host_name.size()) {
             m_file_path += "-" + host_name;
         }
-        m_stream.open(m_file_path);
-        if (!m_stream.good()) {
-            throw Exception("Unable to open CSV file '" + m_file_path + "'",
-                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        m_writer = TraceWriter::make_unique(m_file_path, writer_policy, compression);
+        // Each compressed buffer can be decoded on its own, so hand
+        // off buffers that end on a row at the requested frame size.
+        if (m_buffer_limit > m_writer->max_buffer_size()) {
+            m_buffer_limit = m_writer->max_buffer_size();
         }
         write_header(host_name, start_time);
     }
 
     CSVImp::~CSVImp()
     {
-        flush();
+        // An error deferred by the writer thread must not escape the
+        // destructor.
+        try {
+            flush();
+        }
+        catch (const std::exception &ex) {
+            std::cerr << "Warning: <geopm> CSVImp: Unable to write " << m_file_path
+                      << ": " << ex.what() << "\n";
+        }
     }
 
     void CSVImp::add_column(const std::string &name)
@@ -63,6 +86,7 @@ namespace geopm
         }
         m_column_name.push_back(name);
         m_column_format.push_back(it->second);
+        m_column_format_buffer.push_back(string_format_function_to_buffer(it->second));
     }
 
     void CSVImp::add_column(const std::string &name, std::function<std::string(double)> format)
@@ -73,6 +97,7 @@ namespace geopm
         }
         m_column_name.push_back(name);
         m_column_format.push_back(format);
+        m_column_format_buffer.push_back(string_format_function_to_buffer(format));
     }
 
     void CSVImp::update(const std::vector<double> &sample)
@@ -85,40 +110,76 @@ namespace geopm
             throw Exception("CSVImp::update(): Input vector incorrectly sized",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        // Format the row into m_row and append it to the buffer in
+        // one copy.  Columns with a custom format function flush the
+        // row formatted so far and append the returned string.
+        char *row_begin = m_row.data();
+        char *row_ptr = row_begin;
         for (size_t sample_idx = 0; sample_idx != sample.size(); ++sample_idx) {
             if (sample_idx) {
-                m_buffer << M_SEPARATOR;
+                *row_ptr = M_SEPARATOR;
+                ++row_ptr;
+            }
+            string_format_buffer_f format_buffer = m_column_format_buffer[sample_idx];
+            if (format_buffer != nullptr) {
+                row_ptr = format_buffer(sample[sample_idx], row_ptr);
+            }
+            else {
+                m_buffer.append(row_begin, row_ptr - row_begin);
+                m_buffer += m_column_format[sample_idx](sample[sample_idx]);
+                row_ptr = row_begin;
             }
-            m_buffer << m_column_format[sample_idx](sample[sample_idx]);
         }
-        m_buffer << "\n";
+        *row_ptr = '\n';
+        ++row_ptr;
+        m_buffer.append(row_begin, row_ptr - row_begin);
 
-        // if buffer is full, flush to file
-        if (m_buffer.tellp() > m_buffer_limit) {
-            flush();
+        // if buffer is full, pass it to the writer
+        if (m_buffer.size() > m_buffer_limit) {
+            write_buffer();
         }
     }
 
     void CSVImp::flush(void)
     {
-        m_stream << m_buffer.str();
-        m_stream.flush();
-        m_buffer.str("");
+        write_buffer();
+        m_writer->flush();
+    }
+
+    uint64_t CSVImp::num_flush_overrun(void) const
+    {
+        return m_writer->num_flush_overrun();
+    }
+
+    double CSVImp::write_time(void) const
+    {
+        return m_writer->write_time();
+    }
+
+    void CSVImp::write_buffer(void)
+    {
+        if (!m_buffer.empty()) {
+            m_writer->write(std::move(m_buffer));
+            m_buffer.clear();
+        }
     }
 
     void CSVImp::write_header(const std::string &host_name, const std::string &start_time)
     {
-        m_buffer << "# geopm_version: " << geopm_version() << "\n"
-                 << "# start_time: " << start_time << "\n"
-                 << "# profile_name: " << environment().profile() << "\n"
-                 << "# node_name: " << host_name << "\n"
-                 << "# agent: " << environment().agent() << "\n";
+        m_buffer += "# geopm_version: " + std::string(geopm_version()) + "\n" +
+                    "# start_time: " + start_time + "\n" +
+                    "# profile_name: " + environment().profile() + "\n" +
+                    "# node_name: " + host_name + "\n" +
+                    "# agent: " + environment().agent() + "\n";
     }
 
     void CSVImp::activate(void)
     {
         if (m_is_active == false) {
             m_is_active = true;
+            // Each column needs at most one separator and one value,
+            // plus the newline at the end of the row
+            m_row.resize(m_column_name.size() * (string_format_buffer_size + 1) + 1);
             write_names();
         }
     }
@@ -131,10 +192,35 @@ namespace geopm
                is_once = false;
             }
             else {
-                m_buffer << M_SEPARATOR;
+                m_buffer += M_SEPARATOR;
             }
-            m_buffer << it;
+            m_buffer += it;
+        }
+        m_buffer += '\n';
+    }
+
+    std::unique_ptr<CSV> CSV::make_unique(const std::string &file_path,
+                                          const std::string &host_name,
+                                          const std::string &start_time,
+                                          size_t buffer_size,
+                                          const std::string &format,
+                                          const std::string &writer_policy,
+                                          const std::string &compression)
+    {
+        std::unique_ptr<CSV> result;
+        if (format == "" || format == "csv") {
+            result = geopm::make_unique<CSVImp>(file_path, host_name, start_time,
+                                                buffer_size, writer_policy, compression);
+        }
+        else if (format == "binary") {
+            result = geopm::make_unique<BinaryTraceImp>(file_path, host_name, start_time,
+                                                        buffer_size, writer_policy, compression);
+        }
+        else {
+            throw Exception("CSV::make_unique(): unknown trace format: \"" + format +
+                            "\", expected \"csv\" or \"binary\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        m_buffer << '\n';
+        return result;
     }
 }
@@ -6,15 +6,19 @@
 #ifndef CSV_HPP_INCLUDE
 #define CSV_HPP_INCLUDE
 
+#include <cstdint>
 #include <vector>
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
-#include <fstream>
-#include <sstream>
+
+#include "geopm/Helper.hpp"
 
 namespace geopm
 {
+    class TraceWriter;
+
     /// @brief CSV class provides the GEOPM interface for creation of
     ///        character separated value tabular data files.  These
     ///        CSV formatted files are created with a header
@@ -71,6 +75,39 @@ namespace geopm
             virtual void update(const std::vector<double> &sample) = 0;
             /// @brief Flush all output to the CSV file.
             virtual void flush(void) = 0;
+            /// @brief Get the number of full buffers that could not
+            ///        be handed to the trace writer without waiting
+            ///        or dropping the buffer.
+            /// @return Number of overruns reported by the
+            ///         TraceWriter.
+            virtual uint64_t num_flush_overrun(void) const = 0;
+            /// @brief Get the time the caller spent passing buffers
+            ///        to the trace writer.
+            /// @return Time in seconds reported by the TraceWriter.
+            virtual double write_time(void) const = 0;
+            /// @brief Create a trace file writer.
+            /// @param [in] file_path Path to the file, the host name
+            ///        is appended if it is not empty.
+            /// @param [in] host_name Name of the host written to the
+            ///        file header.
+            /// @param [in] start_time Start time written to the file
+            ///        header.
+            /// @param [in] buffer_size Size of the output buffer in
+            ///        bytes.
+            /// @param [in] format Either "csv" or the empty string
+            ///        for a CSVImp text file, or "binary" for a
+            ///        BinaryTraceImp binary file.
+            /// @param [in] writer_policy TraceWriter policy used to
+            ///        write full buffers: "block", "drop" or "sync".
+            /// @param [in] compression TraceWriter compression:
+            ///        "none", "zstd" or "lz4".
+            static std::unique_ptr<CSV> make_unique(const std::string &file_path,
+                                                    const std::string &host_name,
+                                                    const std::string &start_time,
+                                                    size_t buffer_size,
+                                                    const std::string &format,
+                                                    const std::string &writer_policy,
+                                                    const std::string &compression);
     };
 
     class CSVImp : public CSV
@@ -80,6 +117,12 @@ namespace geopm
                    const std::string &host_name,
                    const std::string &start_time,
                    size_t buffer_size);
+            CSVImp(const std::string &file_path,
+                   const std::string &host_name,
+                   const std::string &start_time,
+                   size_t buffer_size,
+                   const std::string &writer_policy,
+                   const std::string &compression);
             CSVImp(const CSVImp &other) = delete;
             CSVImp & operator=(const CSVImp &other) = delete;
             virtual ~CSVImp();
@@ -91,18 +134,29 @@ namespace geopm
             void activate(void) override;
             void update(const std::vector<double> &sample) override;
             void flush(void) override;
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
         private:
             void write_header(const std::string &host_name, const std::string &start_time);
             void write_names(void);
+            /// @brief Hand the buffer to the writer without waiting
+            ///        for it to reach the file.
+            void write_buffer(void);
 
             const std::map<std::string, std::function<std::string(double)> > M_NAME_FORMAT_MAP;
             const char M_SEPARATOR;
             std::string m_file_path;
             std::vector<std::string> m_column_name;
             std::vector<std::function<std::string(double)> > m_column_format;
-            std::ofstream m_stream;
-            std::ostringstream m_buffer;
-            off_t m_buffer_limit;
+            /// @brief Buffer function for each column, or nullptr if
+            ///        the format function has no buffer equivalent
+            std::vector<string_format_buffer_f> m_column_format_buffer;
+            std::unique_ptr<TraceWriter> m_writer;
+            std::string m_buffer;
+            /// @brief Space for one row of columns that have buffer
+            ///        functions, sized by activate()
+            std::vector<char> m_row;
+            size_t m_buffer_limit;
             bool m_is_active;
     };
 }
@@ -210,6 +210,42 @@ namespace geopm
         }
     }
 
+    void NullComm::window_lock_all(size_t window_id) const
+    {
+        if (window_id >= m_window_buffers.size()) {
+            throw Exception("NullComm::" + std::string(__func__) + "(): window_id is out of bounds",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void NullComm::window_unlock_all(size_t window_id) const
+    {
+        if (window_id >= m_window_buffers.size()) {
+            throw Exception("NullComm::" + std::string(__func__) + "(): window_id is out of bounds",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void NullComm::window_flush(size_t window_id, int rank) const
+    {
+        if (window_id >= m_window_buffers.size()) {
+            throw Exception("NullComm::" + std::string(__func__) + "(): window_id is out of bounds",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (rank != 0) {
+            throw Exception("NullComm::" + std::string(__func__) + "(): NullComm is only valid with one rank",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void NullComm::window_sync(size_t window_id) const
+    {
+        if (window_id >= m_window_buffers.size()) {
+            throw Exception("NullComm::" + std::string(__func__) + "(): window_id is out of bounds",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
     void NullComm::coordinate(int rank, std::vector<int> &coord) const
     {
         if (rank != 0) {
@@ -302,6 +338,11 @@ namespace geopm
         std::copy((char *)send_buf, (char*)send_buf + send_size, data_ptr);
     }
 
+    void NullComm::window_replace(const double *send_buf, size_t count, int rank, off_t disp, size_t window_id) const
+    {
+        window_put(send_buf, count * sizeof(double), rank, disp, window_id);
+    }
+
     void NullComm::tear_down(void)
     {
 
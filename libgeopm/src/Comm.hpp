@@ -105,6 +105,29 @@ namespace geopm
             ///
             /// @param [in] rank Rank of the locked window.
             virtual void window_unlock(size_t window_id, int rank) const = 0;
+            /// @brief Begin an epoch for RMA to every rank of the
+            ///        window with a shared lock that is held until
+            ///        window_unlock_all() is called.
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_lock_all(size_t window_id) const = 0;
+            /// @brief End the epoch started by window_lock_all().
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_unlock_all(size_t window_id) const = 0;
+            /// @brief Complete all RMA operations issued to a rank
+            ///        within an epoch started by window_lock_all().
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            ///
+            /// @param [in] rank Rank targeted by the operations.
+            virtual void window_flush(size_t window_id, int rank) const = 0;
+            /// @brief Synchronize the memory of the local window so
+            ///        that the calling rank observes the completed RMA
+            ///        operations of other ranks.
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_sync(size_t window_id) const = 0;
             /// @brief Coordinate in Cartesian grid for specified rank
             ///
             /// @param [in] rank Rank for which coordinates should be calculated
@@ -179,6 +202,26 @@ namespace geopm
             ///
             /// @param [in] window_id The window handle for the target window.
             virtual void window_put(const void *send_buf, size_t send_size, int rank, off_t disp, size_t window_id) const = 0;
+            /// @brief Replace values in a window with an RMA
+            ///        accumulate.  Unlike window_put(), the replace
+            ///        operations issued by one rank to overlapping
+            ///        locations of another are applied in the order
+            ///        they were issued.  Operations on locations that
+            ///        do not overlap may be applied in any order
+            ///        unless window_flush() is called between them.
+            ///
+            /// @param [in] send_buf Starting address of values to be
+            ///        transmitted via window.
+            ///
+            /// @param [in] count Number of values to be sent.
+            ///
+            /// @param [in] rank Target rank of the transmission.
+            ///
+            /// @param [in] disp Displacement in bytes from start of
+            ///        window.
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_replace(const double *send_buf, size_t count, int rank, off_t disp, size_t window_id) const = 0;
             /// @brief Clean up resources held by the comm.  This
             ///        allows static global objects to be cleaned up
             ///        before the destructor is called.
@@ -218,6 +261,10 @@ namespace geopm
             void window_destroy(size_t window_id) override;
             void window_lock(size_t window_id, bool is_exclusive, int rank, int assert) const override;
             void window_unlock(size_t window_id, int rank) const override;
+            void window_lock_all(size_t window_id) const override;
+            void window_unlock_all(size_t window_id) const override;
+            void window_flush(size_t window_id, int rank) const override;
+            void window_sync(size_t window_id) const override;
             void coordinate(int rank, std::vector<int> &coord) const override;
             std::vector<int> coordinate(int rank) const override;
             void barrier(void) const override;
@@ -229,6 +276,7 @@ namespace geopm
             void gatherv(const void *send_buf, size_t send_size, void *recv_buf,
                                  const std::vector<size_t> &recv_sizes, const std::vector<off_t> &rank_offset, int root) const override;
             void window_put(const void *send_buf, size_t send_size, int rank, off_t disp, size_t window_id) const override;
+            void window_replace(const double *send_buf, size_t count, int rank, off_t disp, size_t window_id) const override;
             void tear_down(void) override;
             static std::string plugin_name(void);
             static std::unique_ptr<Comm> make_plugin();
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ControlLoop.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+
+#include "geopm_time.h"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+
+namespace geopm
+{
+    static const std::array<std::string, ControlLoop::M_NUM_PHASE> control_loop_phase_names = {
+        "read", "agent", "write", "comm", "trace", "wait"
+    };
+
+    ControlLoopImp::ControlLoopImp(bool do_adapt)
+        : ControlLoopImp(do_adapt,
+                         [](void)
+                         {
+                             geopm_time_s zero = geopm::time_zero();
+                             return geopm_time_since(&zero);
+                         })
+    {
+
+    }
+
+    ControlLoopImp::ControlLoopImp(bool do_adapt, std::function<double(void)> time)
+        : m_do_adapt(do_adapt)
+        , m_time(time)
+        , m_period(NAN)
+        , m_min_period(0.0)
+        , m_max_period(0.0)
+        , m_last_time(m_time())
+        , m_iteration_time{}
+        , m_phase{}
+        , m_num_iteration(0)
+        , m_num_overrun(0)
+        , m_num_period_change(0)
+        , m_busy_average(0.0)
+        , m_num_idle(0)
+    {
+
+    }
+
+    void ControlLoopImp::init(double period, double min_period, double max_period)
+    {
+        if (!(min_period <= max_period)) {
+            throw Exception("ControlLoopImp::init(): minimum period is larger than maximum period",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_period = period;
+        m_min_period = min_period;
+        m_max_period = max_period;
+    }
+
+    void ControlLoopImp::begin(void)
+    {
+        m_last_time = m_time();
+        m_iteration_time.fill(0.0);
+    }
+
+    void ControlLoopImp::mark(int phase)
+    {
+#ifdef GEOPM_DEBUG
+        if (phase < 0 || phase >= M_NUM_PHASE) {
+            throw Exception("ControlLoopImp::mark(): phase out of range: " + std::to_string(phase),
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        double curr_time = m_time();
+        m_iteration_time[phase] += curr_time - m_last_time;
+        m_last_time = curr_time;
+    }
+
+    bool ControlLoopImp::end(bool is_active)
+    {
+        double busy_time = 0.0;
+        for (int phase = 0; phase != M_NUM_PHASE; ++phase) {
+            double time = m_iteration_time[phase];
+            auto &stats = m_phase[phase];
+            stats.total += time;
+            stats.max = std::max(stats.max, time);
+            ++stats.histogram[histogram_bin(time)];
+            if (phase != M_PHASE_WAIT) {
+                busy_time += time;
+            }
+        }
+        ++m_num_iteration;
+        // A period that is not known is NAN, and the comparison fails
+        if (busy_time > m_period) {
+            ++m_num_overrun;
+        }
+        bool result = false;
+        if (m_do_adapt && m_max_period > m_min_period) {
+            double period = next_period(busy_time, is_active);
+            if (period != m_period) {
+                m_period = period;
+                ++m_num_period_change;
+                result = true;
+            }
+        }
+        return result;
+    }
+
+    double ControlLoopImp::next_period(double busy_time, bool is_active)
+    {
+        m_busy_average += M_BUSY_WEIGHT * (busy_time - m_busy_average);
+        if (is_active) {
+            m_num_idle = 0;
+        }
+        else if (m_num_idle < M_NUM_IDLE_ITERATION) {
+            ++m_num_idle;
+        }
+        // Shortest period that keeps the loop from spending more than
+        // the allowed fraction of its time outside of wait().  Use the
+        // latest iteration as well as the average so that a single
+        // overrun is acted on immediately.
+        double result = std::max(m_busy_average, busy_time) / M_MAX_BUSY_FRACTION;
+        if (m_num_idle == M_NUM_IDLE_ITERATION && !std::isnan(m_period)) {
+            // The application has been idle, back off geometrically
+            result = std::max(result, 2.0 * m_period);
+        }
+        return std::min(std::max(result, m_min_period), m_max_period);
+    }
+
+    double ControlLoopImp::period(void) const
+    {
+        return m_period;
+    }
+
+    uint64_t ControlLoopImp::num_overrun(void) const
+    {
+        return m_num_overrun;
+    }
+
+    int ControlLoopImp::histogram_bin(double time)
+    {
+        int result = 0;
+        double time_us = time * 1e6;
+        if (time_us > 1.0) {
+            result = std::min((int)std::ceil(std::log2(time_us)), M_NUM_BIN - 1);
+        }
+        return result;
+    }
+
+    std::string ControlLoopImp::histogram_string(const std::array<uint64_t, M_NUM_BIN> &histogram)
+    {
+        // YAML flow mapping from the upper bound of each non-empty bin
+        // in microseconds to the number of samples in the bin.
+        std::string result = "{";
+        for (int bin_idx = 0; bin_idx != M_NUM_BIN; ++bin_idx) {
+            if (histogram[bin_idx] != 0) {
+                if (result.size() > 1) {
+                    result += ", ";
+                }
+                if (bin_idx == M_NUM_BIN - 1) {
+                    result += ".inf";
+                }
+                else {
+                    result += std::to_string(1ULL << bin_idx);
+                }
+                result += ": " + std::to_string(histogram[bin_idx]);
+            }
+        }
+        result += "}";
+        return result;
+    }
+
+    std::vector<std::pair<std::string, std::string> > ControlLoopImp::report(void) const
+    {
+        std::vector<std::pair<std::string, std::string> > result {
+            {"iterations", std::to_string(m_num_iteration)},
+            {"overrun", std::to_string(m_num_overrun)},
+            {"period (s)", string_format_float(m_period)},
+        };
+        if (m_do_adapt && m_max_period > m_min_period) {
+            result.emplace_back("period changes", std::to_string(m_num_period_change));
+        }
+        for (int phase = 0; phase != M_NUM_PHASE; ++phase) {
+            const auto &stats = m_phase[phase];
+            const std::string &name = control_loop_phase_names[phase];
+            result.emplace_back(name + " (s)", string_format_float(stats.total));
+            result.emplace_back(name + " max (s)", string_format_float(stats.max));
+            result.emplace_back(name + " histogram (us)", histogram_string(stats.histogram));
+        }
+        return result;
+    }
+
+    std::unique_ptr<ControlLoop> ControlLoop::make_unique(bool do_adapt)
+    {
+        return geopm::make_unique<ControlLoopImp>(do_adapt);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONTROLLOOP_HPP_INCLUDE
+#define CONTROLLOOP_HPP_INCLUDE
+
+#include <cstdint>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Measures the phases of each iteration of the
+    ///        Controller loop, counts iterations that do not fit in
+    ///        the period of the Agent, and optionally chooses a new
+    ///        period.
+    ///
+    /// The Controller calls begin() at the start of each iteration,
+    /// mark() at the end of each phase with the phase that just
+    /// completed, and end() when the iteration is complete.  The
+    /// time between two marks is added to the phase passed to the
+    /// second mark.
+    class ControlLoop
+    {
+        public:
+            enum m_phase_e {
+                /// @brief Reading signals and application records
+                M_PHASE_READ,
+                /// @brief Agent policy, sample and platform methods
+                M_PHASE_AGENT,
+                /// @brief Writing controls
+                M_PHASE_WRITE,
+                /// @brief Tree and endpoint communication
+                M_PHASE_COMM,
+                /// @brief Report and trace updates
+                M_PHASE_TRACE,
+                /// @brief Agent::wait()
+                M_PHASE_WAIT,
+                M_NUM_PHASE,
+            };
+            ControlLoop() = default;
+            virtual ~ControlLoop() = default;
+            /// @brief Set the period of the Agent.
+            /// @param [in] period Current period of the Agent in
+            ///        seconds, NAN if it is not known.
+            /// @param [in] min_period Shortest period the Agent
+            ///        accepts.
+            /// @param [in] max_period Longest period the Agent
+            ///        accepts.  The period is not adapted unless this
+            ///        is greater than min_period.
+            virtual void init(double period, double min_period, double max_period) = 0;
+            /// @brief Start timing an iteration.
+            virtual void begin(void) = 0;
+            /// @brief Add the time since the last call to begin() or
+            ///        mark() to a phase.
+            /// @param [in] phase One of the m_phase_e values.
+            virtual void mark(int phase) = 0;
+            /// @brief Complete the iteration.
+            /// @param [in] is_active True if the application produced
+            ///        records during the iteration.
+            /// @return True if the period was changed, the new value
+            ///         is returned by period().
+            virtual bool end(bool is_active) = 0;
+            /// @brief Get the current period.
+            /// @return Period in seconds, NAN if it is not known.
+            virtual double period(void) const = 0;
+            /// @brief Get the number of iterations where the time
+            ///        outside of Agent::wait() was longer than the
+            ///        period.
+            virtual uint64_t num_overrun(void) const = 0;
+            /// @brief Fields for the "Control Loop" section of the
+            ///        report.
+            virtual std::vector<std::pair<std::string, std::string> > report(void) const = 0;
+            /// @brief Create a ControlLoop.
+            /// @param [in] do_adapt Change the period based on the
+            ///        cost of the loop and on application activity.
+            static std::unique_ptr<ControlLoop> make_unique(bool do_adapt);
+    };
+
+    class ControlLoopImp : public ControlLoop
+    {
+        public:
+            ControlLoopImp(bool do_adapt);
+            /// @brief Constructor for testing.
+            /// @param [in] time Returns the current time in seconds.
+            ControlLoopImp(bool do_adapt, std::function<double(void)> time);
+            virtual ~ControlLoopImp() = default;
+            void init(double period, double min_period, double max_period) override;
+            void begin(void) override;
+            void mark(int phase) override;
+            bool end(bool is_active) override;
+            double period(void) const override;
+            uint64_t num_overrun(void) const override;
+            std::vector<std::pair<std::string, std::string> > report(void) const override;
+            /// @brief Number of histogram bins.  Bin i counts phases
+            ///        that took at most 2^i microseconds, the last
+            ///        bin counts all longer phases.
+            static constexpr int M_NUM_BIN = 22;
+        private:
+            /// @brief Choose the period for the next iteration.
+            double next_period(double busy_time, bool is_active);
+            static int histogram_bin(double time);
+            static std::string histogram_string(const std::array<uint64_t, M_NUM_BIN> &histogram);
+
+            /// @brief Largest fraction of the period that may be
+            ///        spent outside of Agent::wait()
+            static constexpr double M_MAX_BUSY_FRACTION = 0.5;
+            /// @brief Weight of the latest iteration in the moving
+            ///        average of the busy time
+            static constexpr double M_BUSY_WEIGHT = 0.125;
+            /// @brief Number of iterations without application
+            ///        activity before the period is lengthened
+            static constexpr int M_NUM_IDLE_ITERATION = 10;
+
+            struct m_phase_s {
+                double total;
+                double max;
+                std::array<uint64_t, M_NUM_BIN> histogram;
+            };
+
+            const bool m_do_adapt;
+            std::function<double(void)> m_time;
+            double m_period;
+            double m_min_period;
+            double m_max_period;
+            double m_last_time;
+            /// @brief Time of each phase in the current iteration
+            std::array<double, M_NUM_PHASE> m_iteration_time;
+            std::array<m_phase_s, M_NUM_PHASE> m_phase;
+            uint64_t m_num_iteration;
+            uint64_t m_num_overrun;
+            uint64_t m_num_period_change;
+            double m_busy_average;
+            int m_num_idle;
+    };
+}
+
+#endif
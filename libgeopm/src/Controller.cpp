@@ -34,6 +34,7 @@
 #include "record.hpp"
 #include "geopm/PlatformIOProf.hpp"
 #include "InitControl.hpp"
+#include "ControlLoop.hpp"
 
 #include "EpochIOGroup.hpp"
 #include "ProfileIOGroup.hpp"
@@ -207,7 +208,8 @@ namespace geopm
                      environment().endpoint(),
                      environment().do_endpoint(),
                      InitControl::make_unique(),
-                     environment().do_init_control())
+                     environment().do_init_control(),
+                     ControlLoop::make_unique(environment().do_period_adapt()))
     {
 
     }
@@ -231,7 +233,8 @@ namespace geopm
                            const std::string &endpoint_path,
                            bool do_endpoint,
                            std::shared_ptr<InitControl> init_control,
-                           bool do_init_control)
+                           bool do_init_control,
+                           std::unique_ptr<ControlLoop> control_loop)
         : m_comm(std::move(comm))
         , m_platform_io(plat_io)
         , m_agent_name(agent_name)
@@ -260,6 +263,8 @@ namespace geopm
         , m_init_control(std::move(init_control))
         , m_do_init_control(do_init_control)
         , m_do_restore(false)
+        , m_control_loop(std::move(control_loop))
+        , m_is_application_active(false)
     {
         if (m_num_send_down > 0 && !(m_do_policy || m_do_endpoint)) {
             throw Exception("Controller(): at least one of policy or endpoint path"
@@ -380,6 +385,9 @@ namespace geopm
         m_do_restore = true;
         m_init_control->write_controls();
         init_agents();
+        auto period_range = m_agent[0]->wait_period_range();
+        m_control_loop->init(m_agent[0]->wait_period(),
+                             period_range.first, period_range.second);
         m_reporter->init();
         setup_trace();
         m_platform_io.read_batch();
@@ -400,6 +408,18 @@ namespace geopm
         m_reporter->total_time(m_application_sampler.total_time());
         m_reporter->overhead(m_application_sampler.overhead_time(),
                              sample_delay);
+        m_reporter->record_log_overflow(m_application_sampler.record_log_overflow());
+        uint64_t num_trace_overrun = m_tracer->num_flush_overrun() +
+                                     m_profile_tracer->num_flush_overrun();
+        double trace_write_time = m_tracer->write_time() +
+                                  m_profile_tracer->write_time();
+        if (m_policy_tracer != nullptr) {
+            num_trace_overrun += m_policy_tracer->num_flush_overrun();
+            trace_write_time += m_policy_tracer->write_time();
+        }
+        m_reporter->trace_flush_overrun(num_trace_overrun);
+        m_reporter->trace_write_time(trace_write_time);
+        m_reporter->control_loop(m_control_loop->report());
         generate();
         m_platform_io.restore_control();
     }
@@ -425,9 +445,14 @@ namespace geopm
 
     void Controller::step(void)
     {
+        m_control_loop->begin();
         walk_down();
         m_agent[0]->wait();
+        m_control_loop->mark(ControlLoop::M_PHASE_WAIT);
         walk_up();
+        if (m_control_loop->end(m_is_application_active)) {
+            m_agent[0]->reset_wait_period(m_control_loop->period());
+        }
     }
 
     void Controller::walk_down(void)
@@ -461,22 +486,27 @@ namespace geopm
         else {
             do_send = m_tree_comm->receive_down(m_num_level_ctl, m_in_policy);
         }
+        m_control_loop->mark(ControlLoop::M_PHASE_COMM);
         for (int level = m_num_level_ctl - 1; level > -1; --level) {
             if (do_send) {
                 m_agent[level + 1]->validate_policy(m_in_policy);
                 m_agent[level + 1]->split_policy(m_in_policy, m_out_policy[level]);
                 do_send = m_agent[level + 1]->do_send_policy();
             }
+            m_control_loop->mark(ControlLoop::M_PHASE_AGENT);
             if (do_send) {
                 m_tree_comm->send_down(level, m_out_policy[level]);
             }
             do_send = m_tree_comm->receive_down(level, m_in_policy);
+            m_control_loop->mark(ControlLoop::M_PHASE_COMM);
         }
         m_agent[0]->validate_policy(m_in_policy);
         m_agent[0]->adjust_platform(m_in_policy);
+        m_control_loop->mark(ControlLoop::M_PHASE_AGENT);
         if (m_agent[0]->do_write_batch()) {
             m_platform_io.write_batch();
         }
+        m_control_loop->mark(ControlLoop::M_PHASE_WRITE);
     }
 
     void Controller::walk_up(void)
@@ -485,22 +515,29 @@ namespace geopm
         geopm_time(&curr_time);
         m_application_sampler.update(curr_time);
         m_platform_io.read_batch();
+        m_control_loop->mark(ControlLoop::M_PHASE_READ);
         m_agent[0]->sample_platform(m_out_sample);
         bool do_send = m_agent[0]->do_send_sample();
+        m_control_loop->mark(ControlLoop::M_PHASE_AGENT);
         m_reporter->update();
         m_agent[0]->trace_values(m_trace_sample);
         m_tracer->update(m_trace_sample);
-        m_profile_tracer->update(m_application_sampler.get_records());
+        std::vector<record_s> records = m_application_sampler.get_records();
+        m_profile_tracer->update(records);
+        m_is_application_active = !records.empty();
+        m_control_loop->mark(ControlLoop::M_PHASE_TRACE);
 
         for (int level = 0; level < m_num_level_ctl; ++level) {
             if (do_send) {
                 m_tree_comm->send_up(level, m_out_sample);
             }
             do_send = m_tree_comm->receive_up(level, m_in_sample[level]);
+            m_control_loop->mark(ControlLoop::M_PHASE_COMM);
             if (do_send) {
                 m_agent[level + 1]->aggregate_sample(m_in_sample[level], m_out_sample);
                 do_send = m_agent[level + 1]->do_send_sample();
             }
+            m_control_loop->mark(ControlLoop::M_PHASE_AGENT);
         }
         if (do_send) {
             if (!m_is_root) {
@@ -512,6 +549,7 @@ namespace geopm
                 }
             }
         }
+        m_control_loop->mark(ControlLoop::M_PHASE_COMM);
     }
 
     void Controller::pthread(const pthread_attr_t *attr, pthread_t *thread)
@@ -29,6 +29,7 @@ namespace geopm
     class ProfileTracer;
     class ApplicationSampler;
     class InitControl;
+    class ControlLoop;
 
     class Controller
     {
@@ -61,7 +62,8 @@ namespace geopm
                        const std::string &endpoint_path,
                        bool do_endpoint,
                        std::shared_ptr<InitControl> init_control,
-                       bool do_init_control);
+                       bool do_init_control,
+                       std::unique_ptr<ControlLoop> control_loop);
 
             Controller(const Controller &other) = delete;
             Controller &operator=(const Controller &other) = delete;
@@ -172,6 +174,10 @@ namespace geopm
             std::shared_ptr<InitControl> m_init_control;
             bool m_do_init_control;
             bool m_do_restore;
+            std::unique_ptr<ControlLoop> m_control_loop;
+            /// @brief True if the last walk_up() received records
+            ///        from the application
+            bool m_is_application_active;
     };
 }
 #endif
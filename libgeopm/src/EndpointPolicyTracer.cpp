@@ -31,6 +31,8 @@ namespace geopm
         : EndpointPolicyTracerImp(1024 * 1024 * sizeof(char),
                                   environment().do_trace_endpoint_policy(),
                                   environment().trace_endpoint_policy(),
+                                  environment().trace_writer(),
+                                  environment().trace_compression(),
                                   PlatformIOProf::platform_io(),
                                   Agent::policy_names(environment().agent()))
     {
@@ -40,6 +42,8 @@ namespace geopm
     EndpointPolicyTracerImp::EndpointPolicyTracerImp(size_t buffer_size,
                                                      bool is_trace_enabled,
                                                      const std::string &file_name,
+                                                     const std::string &trace_writer,
+                                                     const std::string &trace_compression,
                                                      PlatformIO &platform_io,
                                                      const std::vector<std::string> &policy_names)
         : m_is_trace_enabled(is_trace_enabled && policy_names.size() > 0)
@@ -55,7 +59,8 @@ namespace geopm
                 throw Exception("geopm_time_to_string() failed",
                                 err, __FILE__, __LINE__);
             }
-            m_csv = geopm::make_unique<CSVImp>(file_name, "", time_cstr, buffer_size);
+            m_csv = CSV::make_unique(file_name, "", time_cstr, buffer_size,
+                                     "csv", trace_writer, trace_compression);
 
             m_csv->add_column("timestamp", "double");
             for (const auto &col : policy_names) {
@@ -88,4 +93,22 @@ namespace geopm
             m_csv->update(m_values);
         }
     }
+
+    uint64_t EndpointPolicyTracerImp::num_flush_overrun(void) const
+    {
+        uint64_t result = 0;
+        if (m_is_trace_enabled) {
+            result = m_csv->num_flush_overrun();
+        }
+        return result;
+    }
+
+    double EndpointPolicyTracerImp::write_time(void) const
+    {
+        double result = 0.0;
+        if (m_is_trace_enabled) {
+            result = m_csv->write_time();
+        }
+        return result;
+    }
 }
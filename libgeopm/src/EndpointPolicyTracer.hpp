@@ -6,6 +6,7 @@
 #ifndef ENDPOINTPOLICYTRACER_HPP_INCLUDE
 #define ENDPOINTPOLICYTRACER_HPP_INCLUDE
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -17,6 +18,14 @@ namespace geopm
             EndpointPolicyTracer() = default;
             virtual ~EndpointPolicyTracer() = default;
             virtual void update(const std::vector<double> &policy) = 0;
+            /// @brief Get the number of trace buffers that found the
+            ///        trace writer busy.
+            /// @return Number of stalled or dropped buffers.
+            virtual uint64_t num_flush_overrun(void) const = 0;
+            /// @brief Get the time spent passing trace buffers to
+            ///        the trace writer.
+            /// @return Time in seconds.
+            virtual double write_time(void) const = 0;
             static std::unique_ptr<EndpointPolicyTracer> make_unique(void);
     };
 }
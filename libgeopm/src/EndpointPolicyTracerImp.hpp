@@ -23,10 +23,14 @@ namespace geopm
             EndpointPolicyTracerImp(size_t buffer_size,
                                     bool is_trace_enabled,
                                     const std::string &file_name,
+                                    const std::string &trace_writer,
+                                    const std::string &trace_compression,
                                     PlatformIO &platform_io,
                                     const std::vector<std::string> &policy_names);
             virtual ~EndpointPolicyTracerImp();
             void update(const std::vector<double> &policy);
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
         private:
             bool m_is_trace_enabled;
             std::unique_ptr<CSV> m_csv;
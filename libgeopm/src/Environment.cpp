@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <errno.h>
 
+#include <cmath>
 #include <iostream>
 #include <algorithm>
 #include <string>
@@ -120,6 +121,9 @@ namespace geopm
                 "GEOPM_TRACE",
                 "GEOPM_TRACE_SIGNALS",
                 "GEOPM_TRACE_PROFILE",
+                "GEOPM_TRACE_FORMAT",
+                "GEOPM_TRACE_WRITER",
+                "GEOPM_TRACE_COMPRESSION",
                 "GEOPM_TRACE_ENDPOINT_POLICY",
                 "GEOPM_TIMEOUT",
                 "GEOPM_DEBUG_ATTACH",
@@ -131,6 +135,10 @@ namespace geopm
                 "GEOPM_RECORD_FILTER",
                 "GEOPM_INIT_CONTROL",
                 "GEOPM_PERIOD",
+                "GEOPM_PERIOD_ADAPT",
+                "GEOPM_WAIT_STRATEGY",
+                "GEOPM_WAIT_SLACK",
+                "GEOPM_TREE_COMM",
                 "GEOPM_NUM_PROC",
                 "GEOPM_PROGRAM_FILTER",
                 "GEOPM_CTL_LOCAL"};
@@ -258,6 +266,45 @@ namespace geopm
         return result;
     }
 
+    bool EnvironmentImp::do_period_adapt(void) const
+    {
+        return is_set("GEOPM_PERIOD_ADAPT");
+    }
+
+    std::string EnvironmentImp::wait_strategy(void) const
+    {
+        return lookup("GEOPM_WAIT_STRATEGY");
+    }
+
+    double EnvironmentImp::wait_slack(double default_slack) const
+    {
+        double result = default_slack;
+        std::string slack_str = lookup("GEOPM_WAIT_SLACK");
+        if (slack_str.size() != 0) {
+            try {
+                result = std::stod(slack_str);
+            }
+            catch (const std::invalid_argument &conv_ex) {
+                throw geopm::Exception("EnvironmentImp::wait_slack(): GEOPM_WAIT_SLACK environment variable could not be converted into a double: \"" + slack_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            catch (const std::out_of_range &range_ex) {
+                throw geopm::Exception("EnvironmentImp::wait_slack(): GEOPM_WAIT_SLACK environment variable could not be converted into a double, out of range: \"" + slack_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (!(result >= 0.0) || std::isinf(result)) {
+                throw geopm::Exception("EnvironmentImp::wait_slack(): GEOPM_WAIT_SLACK environment variable must be a finite non-negative number of seconds: \"" + slack_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        return result;
+    }
+
+    std::string EnvironmentImp::tree_comm(void) const
+    {
+        return lookup("GEOPM_TREE_COMM");
+    }
+
     std::string EnvironmentImp::trace(void) const
     {
         return lookup("GEOPM_TRACE");
@@ -268,6 +315,21 @@ namespace geopm
         return lookup("GEOPM_TRACE_PROFILE");
     }
 
+    std::string EnvironmentImp::trace_format(void) const
+    {
+        return lookup("GEOPM_TRACE_FORMAT");
+    }
+
+    std::string EnvironmentImp::trace_writer(void) const
+    {
+        return lookup("GEOPM_TRACE_WRITER");
+    }
+
+    std::string EnvironmentImp::trace_compression(void) const
+    {
+        return lookup("GEOPM_TRACE_COMPRESSION");
+    }
+
     std::string EnvironmentImp::trace_endpoint_policy(void) const
     {
         return lookup("GEOPM_TRACE_ENDPOINT_POLICY");
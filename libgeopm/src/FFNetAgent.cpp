@@ -246,6 +246,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double FFNetAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     // Describes expected policies to be provided by the resource manager or user
     std::vector<std::string> FFNetAgent::policy_names(void)
     {
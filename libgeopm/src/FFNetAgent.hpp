@@ -56,6 +56,7 @@ namespace geopm
             bool do_write_batch(void) const override;
             void sample_platform(std::vector<double> &out_sample) override;
             void wait(void) override;
+            double wait_period(void) const override;
             std::vector<std::pair<std::string, std::string> > report_header(void) const override;
             std::vector<std::pair<std::string, std::string> > report_host(void) const override;
             std::map<uint64_t, std::vector<std::pair<std::string, std::string> > >
@@ -360,6 +360,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double FrequencyMapAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     std::vector<std::string> FrequencyMapAgent::policy_names(void)
     {
 
@@ -380,6 +380,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double GPUActivityAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     // Adds the wait time to the top of the report
     std::vector<std::pair<std::string, std::string> > GPUActivityAgent::report_header(void) const
     {
@@ -27,7 +27,12 @@ namespace geopm
             CommWindow &operator=(const CommWindow &other) = delete;
             void lock(bool is_exclusive, int rank, int assert);
             void unlock(int rank);
+            void lock_all(void);
+            void unlock_all(void);
+            void flush(int rank);
+            void sync(void);
             void put(const void *send_buf, size_t send_size, int rank, off_t disp);
+            void replace(const double *send_buf, size_t count, int rank, off_t disp);
 #ifndef GEOPM_TEST
         private:
 #endif
@@ -291,6 +296,30 @@ namespace geopm
         ((CommWindow *) window_id)->unlock(rank);
     }
 
+    void MPIComm::window_lock_all(size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->lock_all();
+    }
+
+    void MPIComm::window_unlock_all(size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->unlock_all();
+    }
+
+    void MPIComm::window_flush(size_t window_id, int rank) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->flush(rank);
+    }
+
+    void MPIComm::window_sync(size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->sync();
+    }
+
     void MPIComm::coordinate(int rank, std::vector<int> &coord) const
     {
         size_t in_size = coord.size();
@@ -382,6 +411,12 @@ namespace geopm
         ((CommWindow *) window_id)->put(send_buf, send_size, rank, disp);
     }
 
+    void MPIComm::window_replace(const double *send_buf, size_t count, int rank, off_t disp, size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->replace(send_buf, count, rank, disp);
+    }
+
     CommWindow::CommWindow(MPI_Comm comm, void *base, size_t size)
     {
         check_mpi(PMPI_Win_create(base, (MPI_Aint) size, 1, MPI_INFO_NULL, comm, &m_window));
@@ -402,9 +437,61 @@ namespace geopm
         check_mpi(PMPI_Win_unlock(rank, m_window));
     }
 
+#ifdef GEOPM_ENABLE_MPI3
+    void CommWindow::lock_all(void)
+    {
+        check_mpi(PMPI_Win_lock_all(0, m_window));
+    }
+
+    void CommWindow::unlock_all(void)
+    {
+        check_mpi(PMPI_Win_unlock_all(m_window));
+    }
+
+    void CommWindow::flush(int rank)
+    {
+        check_mpi(PMPI_Win_flush(rank, m_window));
+    }
+
+    void CommWindow::sync(void)
+    {
+        check_mpi(PMPI_Win_sync(m_window));
+    }
+#else
+    void CommWindow::lock_all(void)
+    {
+        throw Exception("CommWindow::lock_all(): requires MPI-3",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+
+    void CommWindow::unlock_all(void)
+    {
+        throw Exception("CommWindow::unlock_all(): requires MPI-3",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+
+    void CommWindow::flush(int rank)
+    {
+        throw Exception("CommWindow::flush(): requires MPI-3",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+
+    void CommWindow::sync(void)
+    {
+        throw Exception("CommWindow::sync(): requires MPI-3",
+                        GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+    }
+#endif
+
     void CommWindow::put(const void *send_buf, size_t send_size, int rank, off_t disp)
     {
         check_mpi(PMPI_Put(GEOPM_MPI_CONST_CAST(void *)(send_buf), send_size, MPI_BYTE, rank, disp,
                            send_size, MPI_BYTE, m_window));
     }
+
+    void CommWindow::replace(const double *send_buf, size_t count, int rank, off_t disp)
+    {
+        check_mpi(PMPI_Accumulate(GEOPM_MPI_CONST_CAST(double *)(send_buf), count, MPI_DOUBLE, rank, disp,
+                                  count, MPI_DOUBLE, MPI_REPLACE, m_window));
+    }
 }
@@ -58,6 +58,10 @@ namespace geopm
             virtual std::vector<int> coordinate(int rank) const override;
             virtual void window_lock(size_t window_id, bool is_exclusive, int rank, int assert) const override;
             virtual void window_unlock(size_t window_id, int rank) const override;
+            virtual void window_lock_all(size_t window_id) const override;
+            virtual void window_unlock_all(size_t window_id) const override;
+            virtual void window_flush(size_t window_id, int rank) const override;
+            virtual void window_sync(size_t window_id) const override;
             virtual void barrier(void) const override;
             virtual void broadcast(void *buffer, size_t size, int root) const override;
             virtual bool test(bool is_true) const override;
@@ -67,6 +71,7 @@ namespace geopm
             virtual void gatherv(const void *send_buf, size_t send_size, void *recv_buf,
                                  const std::vector<size_t> &recv_sizes, const std::vector<off_t> &rank_offset, int root) const override;
             virtual void window_put(const void *send_buf, size_t send_size, int rank, off_t disp, size_t window_id) const override;
+            virtual void window_replace(const double *send_buf, size_t count, int rank, off_t disp, size_t window_id) const override;
 
             void tear_down(void) override;
         protected:
@@ -25,6 +25,7 @@ namespace geopm
     MonitorAgent::MonitorAgent(PlatformIO &plat_io, const PlatformTopo &topo,
                                std::shared_ptr<Waiter> waiter)
         : m_waiter(std::move(waiter))
+        , m_min_period(m_waiter->period())
     {
 
     }
@@ -91,6 +92,23 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double MonitorAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
+    std::pair<double, double> MonitorAgent::wait_period_range(void) const
+    {
+        // The monitor does not make decisions, so a longer period only
+        // reduces the resolution of the trace.
+        return {m_min_period, M_MAX_WAIT_FACTOR * m_min_period};
+    }
+
+    void MonitorAgent::reset_wait_period(double period)
+    {
+        m_waiter->reset(period);
+    }
+
     std::vector<std::string> MonitorAgent::policy_names(void)
     {
         return {};
@@ -40,6 +40,9 @@ namespace geopm
             bool do_write_batch(void) const override;
             void sample_platform(std::vector<double> &out_sample) override;
             void wait(void) override;
+            double wait_period(void) const override;
+            std::pair<double, double> wait_period_range(void) const override;
+            void reset_wait_period(double period) override;
             std::vector<std::pair<std::string, std::string> > report_header(void) const override;
             std::vector<std::pair<std::string, std::string> > report_host(void) const override;
             std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > report_region(void) const override;
@@ -56,8 +59,12 @@ namespace geopm
             /// @return a list of sample names
             static std::vector<std::string> sample_names(void);
             static constexpr double M_WAIT_SEC = 0.2; // 200 msec
+            /// @brief Longest period allowed when the period is
+            ///        adapted, as a multiple of the configured period
+            static constexpr double M_MAX_WAIT_FACTOR = 5.0;
         private:
             std::shared_ptr<Waiter> m_waiter;
+            const double m_min_period;
 
     };
 }
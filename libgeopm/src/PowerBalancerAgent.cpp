@@ -695,6 +695,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double PowerBalancerAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     std::vector<std::pair<std::string, std::string> > PowerBalancerAgent::report_header(void) const
     {
         return {};
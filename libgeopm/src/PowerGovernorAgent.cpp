@@ -263,6 +263,11 @@ namespace geopm
         m_waiter->wait();
     }
 
+    double PowerGovernorAgent::wait_period(void) const
+    {
+        return m_waiter->period();
+    }
+
     std::vector<std::pair<std::string, std::string> > PowerGovernorAgent::report_header(void) const
     {
         return {};
@@ -35,6 +35,9 @@ namespace geopm
                            environment().do_trace_profile(),
                            environment().trace_profile(),
                            hostname(),
+                           environment().trace_format(),
+                           environment().trace_writer(),
+                           environment().trace_compression(),
                            ApplicationSampler::application_sampler())
     {
 
@@ -46,18 +49,29 @@ namespace geopm
                                        bool is_trace_enabled,
                                        const std::string &file_name,
                                        const std::string &host_name,
+                                       const std::string &trace_format,
+                                       const std::string &trace_writer,
+                                       const std::string &trace_compression,
                                        ApplicationSampler& application_sampler)
         : m_is_trace_enabled(is_trace_enabled)
+        , m_is_binary(trace_format == "binary")
         , m_time_zero(time_zero)
     {
         m_application_sampler = &application_sampler;
         if (m_is_trace_enabled) {
-            m_csv = geopm::make_unique<CSVImp>(file_name, host_name, start_time, buffer_size);
+            m_csv = CSV::make_unique(file_name, host_name, start_time, buffer_size,
+                                     trace_format, trace_writer, trace_compression);
 
             m_csv->add_column("TIME", "double");
             m_csv->add_column("PROCESS", "integer");
-            m_csv->add_column("EVENT", event_format);
-            m_csv->add_column("SIGNAL", event_format);
+            if (m_is_binary) {
+                m_csv->add_column("EVENT", "event");
+                m_csv->add_column("SIGNAL", "event_signal");
+            }
+            else {
+                m_csv->add_column("EVENT", event_format);
+                m_csv->add_column("SIGNAL", event_format);
+            }
             m_csv->activate();
         }
     }
@@ -127,11 +141,32 @@ namespace geopm
                 sample[M_COLUMN_PROCESS] = it.process;
                 sample[M_COLUMN_EVENT] = it.event;
                 sample[M_COLUMN_SIGNAL] = it.signal;
+                if (m_is_binary && it.event == EVENT_SHORT_REGION) {
+                    sample[M_COLUMN_SIGNAL] = m_application_sampler->get_short_region(it.signal).hash;
+                }
                 m_csv->update(sample);
             }
         }
     }
 
+    uint64_t ProfileTracerImp::num_flush_overrun(void) const
+    {
+        uint64_t result = 0;
+        if (m_is_trace_enabled) {
+            result = m_csv->num_flush_overrun();
+        }
+        return result;
+    }
+
+    double ProfileTracerImp::write_time(void) const
+    {
+        double result = 0.0;
+        if (m_is_trace_enabled) {
+            result = m_csv->write_time();
+        }
+        return result;
+    }
+
     std::unique_ptr<ProfileTracer> ProfileTracer::make_unique(const std::string &start_time)
     {
         return geopm::make_unique<ProfileTracerImp>(start_time);
@@ -6,6 +6,7 @@
 #ifndef PROFILETRACER_HPP_INCLUDE
 #define PROFILETRACER_HPP_INCLUDE
 
+#include <cstdint>
 #include <vector>
 #include <utility>
 #include <fstream>
@@ -24,6 +25,14 @@ namespace geopm
             static std::unique_ptr<ProfileTracer> make_unique(const std::string &start_time);
             virtual ~ProfileTracer() = default;
             virtual void update(const std::vector<record_s> &records) = 0;
+            /// @brief Get the number of trace buffers that found the
+            ///        trace writer busy.
+            /// @return Number of stalled or dropped buffers.
+            virtual uint64_t num_flush_overrun(void) const = 0;
+            /// @brief Get the time spent passing trace buffers to
+            ///        the trace writer.
+            /// @return Time in seconds.
+            virtual double write_time(void) const = 0;
     };
 }
 
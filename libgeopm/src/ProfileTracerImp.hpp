@@ -26,9 +26,14 @@ namespace geopm
                              bool is_trace_enabled,
                              const std::string &file_name,
                              const std::string &host_name,
+                             const std::string &trace_format,
+                             const std::string &trace_writer,
+                             const std::string &trace_compression,
                              ApplicationSampler& application_sampler = ApplicationSampler::application_sampler());
             virtual ~ProfileTracerImp();
             void update(const std::vector<record_s> &records);
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
          private:
              enum m_column_e {
                 M_COLUMN_TIME,
@@ -38,6 +43,9 @@ namespace geopm
                 M_NUM_COLUMN
             };
             bool m_is_trace_enabled;
+            /// @brief The binary trace stores short region hashes
+            ///        rather than formatting them with event_format().
+            bool m_is_binary;
             std::unique_ptr<CSV> m_csv;
             geopm_time_s m_time_zero;
             static ApplicationSampler* m_application_sampler;
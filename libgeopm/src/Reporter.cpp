@@ -86,6 +86,9 @@ namespace geopm
         , m_total_time(0.0)
         , m_overhead_time(0.0)
         , m_sample_delay(0.0)
+        , m_num_record_overflow(0)
+        , m_num_trace_overrun(0)
+        , m_trace_write_time(0.0)
         , m_profile_name(profile_name)
         , m_do_ctl_local(do_ctl_local)
     {
@@ -120,8 +123,10 @@ namespace geopm
         if (m_do_init) {
             // ProcessRegionAggregator should not be constructed until
             // application connection is established.
-            init_sync_fields();
+            auto all_names = m_platform_io.signal_names();
+            init_sync_fields(all_names);
             init_environment_signals();
+            init_batch_time_signals(all_names);
             m_epoch_count_idx = m_platform_io.push_signal("EPOCH_COUNT", GEOPM_DOMAIN_BOARD, 0);
             if (m_proc_region_agg == nullptr) {
                 m_proc_region_agg = ProcessRegionAggregator::make_unique();
@@ -149,6 +154,26 @@ namespace geopm
         m_sample_delay = sample_delay;
     }
 
+    void ReporterImp::record_log_overflow(uint64_t num_overflow)
+    {
+        m_num_record_overflow = num_overflow;
+    }
+
+    void ReporterImp::trace_flush_overrun(uint64_t num_overrun)
+    {
+        m_num_trace_overrun = num_overrun;
+    }
+
+    void ReporterImp::trace_write_time(double write_time)
+    {
+        m_trace_write_time = write_time;
+    }
+
+    void ReporterImp::control_loop(const std::vector<std::pair<std::string, std::string> > &control_loop)
+    {
+        m_control_loop = control_loop;
+    }
+
     void ReporterImp::generate(const std::string &agent_name,
                                const std::vector<std::pair<std::string, std::string> > &agent_report_header,
                                const std::vector<std::pair<std::string, std::string> > &agent_host_report,
@@ -174,6 +199,7 @@ namespace geopm
         std::string host_report = create_report(application_io.region_name_set(),
                                                 get_max_memory(),
                                                 tree_comm.overhead_send(),
+                                                tree_comm.overhead_save(),
                                                 agent_host_report,
                                                 agent_region_report);
         std::string full_report = gather_report(host_report, std::move(comm));
@@ -197,6 +223,7 @@ namespace geopm
         common_report << create_report({},
                                        get_max_memory(),
                                        0.0,
+                                       0.0,
                                        agent_host_report,
                                        agent_region_report);
         common_report << std::endl;
@@ -237,6 +264,7 @@ namespace geopm
 
 
     std::string ReporterImp::create_report(const std::set<std::string> &region_name_set, double max_memory, double comm_overhead,
+                                           double comm_save,
                                            const std::vector<std::pair<std::string, std::string> > &agent_host_report,
                                            const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report)
     {
@@ -345,14 +373,26 @@ namespace geopm
             {"GEOPM startup (s)", m_sample_delay},
             {"GEOPM overhead (s)", m_overhead_time},
             {"geopmctl memory HWM (B)", max_memory},
-            {"geopmctl network BW (B/s)", comm_overhead / m_total_time}
+            {"geopmctl network BW (B/s)", comm_overhead / m_total_time},
+            {"geopmctl network saved (B)", comm_save},
+            {"GEOPM record log overflow", (double)m_num_record_overflow},
+            {"GEOPM trace flush overrun", (double)m_num_trace_overrun},
+            {"GEOPM trace write (s)", m_trace_write_time}
         };
         if (mpi_startup != 0.0) {
             overhead.insert(overhead.begin(),
                             {"MPI startup (s)", mpi_startup});
         }
+        for (const auto &batch_time : m_batch_time_name_idx) {
+            overhead.emplace_back(batch_time.first,
+                                  m_platform_io.sample(batch_time.second));
+        }
 
         yaml_write(report, M_INDENT_TOTALS_FIELD, overhead);
+        if (!m_control_loop.empty()) {
+            yaml_write(report, M_INDENT_CONTROL_LOOP, "Control Loop:");
+            yaml_write(report, M_INDENT_CONTROL_LOOP_FIELD, m_control_loop);
+        }
         return report.str();
     }
 
@@ -389,7 +429,7 @@ namespace geopm
         return report_buffer.data();
     }
 
-    void ReporterImp::init_sync_fields(void)
+    void ReporterImp::init_sync_fields(const std::set<std::string> &all_names)
     {
         auto sample_only = [this](uint64_t hash, const std::vector<std::string> &sig) -> double
         {
@@ -437,7 +477,6 @@ namespace geopm
             {"time-hint-spin (s)", {"TIME_HINT_SPIN"}, sample_only},
         };
 
-        auto all_names = m_platform_io.signal_names();
         std::vector<m_sync_field_s> conditional_sync_fields = {
             {"gpu-energy (J)", {"GPU_ENERGY"}, sample_only},
             {"gpu-power (W)", {"GPU_POWER"}, sample_only},
@@ -486,6 +525,24 @@ namespace geopm
         }
     }
 
+    void ReporterImp::init_batch_time_signals(const std::set<std::string> &all_names)
+    {
+        // Provided by PlatformIO when GEOPM_PIO_BATCH_TIMING is set
+        const std::vector<std::pair<std::string, std::string> > prefix_label {
+            {"PLATFORMIO::READ_BATCH_TIME@", "read-batch-time@"},
+            {"PLATFORMIO::WRITE_BATCH_TIME@", "write-batch-time@"},
+        };
+        for (const auto &name : all_names) {
+            for (const auto &pl : prefix_label) {
+                if (string_begins_with(name, pl.first)) {
+                    std::string label = pl.second + name.substr(pl.first.size()) + " (s)";
+                    m_batch_time_name_idx.emplace_back(
+                        label, m_platform_io.push_signal(name, GEOPM_DOMAIN_BOARD, 0));
+                }
+            }
+        }
+    }
+
     std::vector<std::pair<std::string, double> > ReporterImp::get_region_data(uint64_t region_hash)
     {
         std::vector<std::pair<std::string, double> > result;
@@ -566,7 +623,7 @@ namespace geopm
                                  const std::string &val)
     {
         std::string indent(indent_level * M_SPACES_INDENT, ' ');
-        os << indent << val << std::endl;
+        os << indent << val << '\n';
     }
 
     void ReporterImp::yaml_write(std::ostream &os, int indent_level,
@@ -574,7 +631,7 @@ namespace geopm
     {
         std::string indent(indent_level * M_SPACES_INDENT, ' ');
         for (const auto &kv : data) {
-            os << indent << kv.first << ": " << kv.second << std::endl;
+            os << indent << kv.first << ": " << kv.second << '\n';
         }
     }
 
@@ -582,8 +639,13 @@ namespace geopm
                                  const std::vector<std::pair<std::string, double> > &data)
     {
         std::string indent(indent_level * M_SPACES_INDENT, ' ');
+        // Same output as operator<<() with the default precision of
+        // six digits, without going through the stream locale.
+        char value[string_format_buffer_size];
         for (const auto &kv: data) {
-            os << indent << kv.first << ": " << kv.second << std::endl;
+            os << indent << kv.first << ": ";
+            os.write(value, string_format_float_buffer(kv.second, value) - value);
+            os << '\n';
         }
     }
 }
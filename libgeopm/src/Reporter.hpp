@@ -76,6 +76,34 @@ namespace geopm
                                          const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report) = 0;
             virtual void total_time(double total) = 0;
             virtual void overhead(double overhead_sec, double sample_delay) = 0;
+            /// @brief Set the number of application records dropped
+            ///        because the record log was full.
+            ///
+            /// @param [in] num_overflow Number of dropped records
+            ///             reported by the ApplicationSampler.
+            virtual void record_log_overflow(uint64_t num_overflow) = 0;
+            /// @brief Set the number of trace buffers that stalled the
+            ///        Controller or were dropped because the trace
+            ///        writer thread was busy.
+            ///
+            /// @param [in] num_overrun Number of overruns summed
+            ///             over the tracers.
+            virtual void trace_flush_overrun(uint64_t num_overrun) = 0;
+            /// @brief Set the time the Controller spent passing trace
+            ///        buffers to the trace writers, including any
+            ///        compression done by the Controller thread.
+            ///
+            /// @param [in] write_time Time in seconds summed over the
+            ///             tracers.
+            virtual void trace_write_time(double write_time) = 0;
+            /// @brief Set the fields of the "Control Loop" section
+            ///        of the host report, which describe the timing of
+            ///        the Controller loop.  The section is omitted if
+            ///        this is not called.
+            ///
+            /// @param [in] control_loop Report fields from the
+            ///             ControlLoop.
+            virtual void control_loop(const std::vector<std::pair<std::string, std::string> > &control_loop) = 0;
     };
 
     class PlatformIO;
@@ -119,6 +147,10 @@ namespace geopm
                                  const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report) override;
             void total_time(double total) override;
             void overhead(double overhead_sec, double sample_delay) override;
+            void record_log_overflow(uint64_t num_overflow) override;
+            void trace_flush_overrun(uint64_t num_overrun) override;
+            void trace_write_time(double write_time) override;
+            void control_loop(const std::vector<std::pair<std::string, std::string> > &control_loop) override;
 
         private:
             /// @brief number of spaces for each indentation
@@ -136,11 +168,16 @@ namespace geopm
             static constexpr int M_INDENT_EPOCH_FIELD = M_INDENT_EPOCH + 1;
             static constexpr int M_INDENT_TOTALS = M_INDENT_HOST_NAME + 1;
             static constexpr int M_INDENT_TOTALS_FIELD = M_INDENT_TOTALS + 1;
+            static constexpr int M_INDENT_CONTROL_LOOP = M_INDENT_HOST_NAME + 1;
+            static constexpr int M_INDENT_CONTROL_LOOP_FIELD = M_INDENT_CONTROL_LOOP + 1;
             /// @brief Set up structures used to calculate region-synchronous
             ///        field data to be sampled from SampleAggregator.
-            void init_sync_fields(void);
+            void init_sync_fields(const std::set<std::string> &all_names);
             /// @brief Set up signals added by the user through the environment.
             void init_environment_signals(void);
+            /// @brief Push the PlatformIO batch timing signals if
+            ///        they are provided.
+            void init_batch_time_signals(const std::set<std::string> &all_names);
             /// @brief Samples values for fields common to all
             ///        regions, epoch data, and application totals.
             ///        The vector returned by this method is intended
@@ -160,6 +197,7 @@ namespace geopm
                                       const std::string &profile_name,
                                       const std::vector<std::pair<std::string, std::string> > &agent_report_header);
             std::string create_report(const std::set<std::string> &region_name_set, double max_memory, double comm_overhead,
+                                      double comm_save,
                                       const std::vector<std::pair<std::string, std::string> > &agent_host_report,
                                       const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report);
             std::string gather_report(const std::string &host_report, std::shared_ptr<Comm> comm);
@@ -193,10 +231,17 @@ namespace geopm
 
             // Signals added through environment
             std::vector<std::pair<std::string, int> > m_env_signal_name_idx;
+            // Report field label and PlatformIO index of each batch
+            // timing signal
+            std::vector<std::pair<std::string, int> > m_batch_time_name_idx;
             bool m_do_init;
             double m_total_time;
             double m_overhead_time;
             double m_sample_delay;
+            uint64_t m_num_record_overflow;
+            uint64_t m_num_trace_overrun;
+            double m_trace_write_time;
+            std::vector<std::pair<std::string, std::string> > m_control_loop;
             const std::string m_profile_name;
             bool m_do_ctl_local;
     };
@@ -12,7 +12,6 @@
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
-#include "Accumulator.hpp"
 #include "geopm/PlatformIOProf.hpp"
 #include "geopm/IOGroup.hpp"
 
@@ -35,6 +34,7 @@ namespace geopm
         , m_is_updated(false)
         , m_period_duration(0.0)
         , m_period_last(0)
+        , m_time_last(0.0)
     {
 
     }
@@ -79,25 +79,13 @@ namespace geopm
                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         int result = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
-        auto bad_it = m_avg_signal.find(result);
-        if (bad_it != m_avg_signal.end()) {
+        int column = find_column(result);
+        if (column != -1 && !m_column_is_total[column]) {
            throw Exception("SampleAggregatorImp::push_signal_total(): signal already pushed for average",
                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        auto signal_it = m_sum_signal.find(result);
-        if (signal_it == m_sum_signal.end()) {
-            m_sum_signal[result] = {
-                NAN,
-                m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx),
-                GEOPM_REGION_HASH_INVALID,
-                m_platform_io.push_signal("EPOCH_COUNT", domain_type, domain_idx),
-                0,
-                SumAccumulator::make_unique(),
-                SumAccumulator::make_unique(),
-                SumAccumulator::make_unique(),
-                {},
-                {},
-           };
+        if (column == -1) {
+            push_column(result, domain_type, domain_idx, true);
         }
         return result;
     }
@@ -111,86 +99,105 @@ namespace geopm
                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         int result = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
-        auto bad_it = m_sum_signal.find(result);
-        if (bad_it != m_sum_signal.end()) {
+        int column = find_column(result);
+        if (column != -1 && m_column_is_total[column]) {
            throw Exception("SampleAggregatorImp::push_signal_average(): signal already pushed for total",
                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        auto signal_it = m_avg_signal.find(result);
-        if (signal_it == m_avg_signal.end()) {
-            m_avg_signal[result] = {
-                NAN,
-                m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx),
-                GEOPM_REGION_HASH_INVALID,
-                m_platform_io.push_signal("EPOCH_COUNT", domain_type, domain_idx),
-                0,
-                AvgAccumulator::make_unique(),
-                AvgAccumulator::make_unique(),
-                AvgAccumulator::make_unique(),
-                {},
-                {},
-           };
+        if (column == -1) {
+            push_column(result, domain_type, domain_idx, false);
         }
         return result;
     }
 
-    template<typename type>
-    typename std::map<uint64_t, std::shared_ptr<type> >::iterator
-    sample_aggregator_emplace_hash(
-        std::map<uint64_t, std::shared_ptr<type> > &hash_accum_map,
-        uint64_t hash)
+    void SampleAggregatorImp::push_column(int signal_idx, int domain_type,
+                                          int domain_idx, bool is_total)
     {
-        typename std::map<uint64_t, std::shared_ptr<type> >::iterator result;
-        result = hash_accum_map.find(hash);
-        if (result == hash_accum_map.end()) {
-            auto empl_ret = hash_accum_map.emplace(hash, type::make_unique());
-            result = empl_ret.first;
+        int region_hash_idx = m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx);
+        int epoch_count_idx = m_platform_io.push_signal("EPOCH_COUNT", domain_type, domain_idx);
+        auto domain_it = m_domain_idx.find(region_hash_idx);
+        if (domain_it == m_domain_idx.end()) {
+            domain_it = m_domain_idx.emplace(region_hash_idx, m_domain.size()).first;
+            m_domain.push_back({region_hash_idx, epoch_count_idx,
+                                GEOPM_REGION_HASH_INVALID, -1, 0});
+        }
+        if (signal_idx >= (int)m_signal_column.size()) {
+            m_signal_column.resize(signal_idx + 1, -1);
+        }
+        m_signal_column[signal_idx] = m_column_signal.size();
+        m_column_signal.push_back(signal_idx);
+        m_column_domain.push_back(domain_it->second);
+        m_column_is_total.push_back(is_total);
+    }
+
+    int SampleAggregatorImp::find_column(int signal_idx) const
+    {
+        int result = -1;
+        if (signal_idx >= 0 && signal_idx < (int)m_signal_column.size()) {
+            result = m_signal_column[signal_idx];
         }
         return result;
     }
 
-    template <typename type>
-    void sample_aggregator_update_epoch(type &signal, int epoch_count)
+    int SampleAggregatorImp::column(int signal_idx, const std::string &func_name) const
     {
-        // If the epoch count has changed, call the exit/enter
-        if (epoch_count != signal.epoch_count_last) {
-            if (signal.epoch_count_last != 0) {
-                signal.epoch_accum->exit();
-            }
-            signal.epoch_accum->enter();
-            signal.epoch_count_last = epoch_count;
+        int result = find_column(signal_idx);
+        if (result == -1) {
+            throw Exception("SampleAggregator::" + func_name + "(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        return result;
     }
 
-    template <typename type>
-    void sample_aggregator_update_hash_exit(type &signal, uint64_t hash)
+    int SampleAggregatorImp::region_index(uint64_t region_hash)
     {
-        if (signal.region_hash_last != hash) {
-            // If we have exited a valid region, call exit()
-            if (signal.region_hash_last != GEOPM_REGION_HASH_UNMARKED) {
-                signal.region_accum_it->second->exit();
-            }
-        }
+        auto region_it = m_region_idx.find(region_hash);
+        if (region_it == m_region_idx.end()) {
+            // Add a row of accumulators for every column.  The number
+            // of columns is fixed once update() has been called.
+            region_it = m_region_idx.emplace(region_hash, m_region_hash.size()).first;
+            m_region_hash.push_back(region_hash);
+            size_t size = m_region_hash.size() * m_column_signal.size();
+            accum_resize(m_region_accum, size);
+            m_is_region_seen.resize(size, false);
+        }
+        return region_it->second;
     }
 
-    template <typename type>
-    void sample_aggregator_update_hash_enter(type &signal, uint64_t hash)
+    void SampleAggregatorImp::accum_resize(m_accum_s &accum, size_t size)
     {
-        if (signal.region_hash_last != hash) {
-            // If we have entered a valid region, call enter()
-            if (hash != GEOPM_REGION_HASH_UNMARKED) {
-                signal.region_accum_it->second->enter();
-            }
+        accum.total.resize(size, 0.0);
+        accum.weight.resize(size, 0.0);
+        accum.curr_total.resize(size, 0.0);
+        accum.curr_weight.resize(size, 0.0);
+        accum.last.resize(size, 0.0);
+    }
+
+    void SampleAggregatorImp::accum_enter(m_accum_s &accum, int idx)
+    {
+        accum.curr_total[idx] = 0.0;
+        accum.curr_weight[idx] = 0.0;
+    }
+
+    void SampleAggregatorImp::accum_exit(m_accum_s &accum, int idx, int column)
+    {
+        if (m_column_is_total[column]) {
+            accum.last[idx] = accum.curr_total[idx];
+        }
+        else {
+            accum.last[idx] = accum.curr_weight[idx] == 0.0 ? 0.0 :
+                              accum.curr_total[idx] / accum.curr_weight[idx];
         }
     }
 
-    template <typename type>
-    void sample_aggregator_update_period(type &signal, int period)
+    double SampleAggregatorImp::accum_value(const m_accum_s &accum, int idx, int column) const
     {
-        if (period != 0) {
-            signal.period_accum->exit();
+        double result = accum.total[idx];
+        if (!m_column_is_total[column]) {
+            result = accum.weight[idx] == 0.0 ? 0.0 :
+                     accum.total[idx] / accum.weight[idx];
         }
-        signal.period_accum->enter();
+        return result;
     }
 
     uint64_t SampleAggregatorImp::sample_to_hash(double sample)
@@ -211,119 +218,187 @@ namespace geopm
         m_period_duration = duration;
     }
 
-    int SampleAggregatorImp::get_period(void)
+    int SampleAggregatorImp::period_index(double time) const
     {
         int result = 0;
         if (m_period_duration) {
-            double time = m_platform_io.sample(m_time_idx);
             result = static_cast<int>(time / m_period_duration);
         }
         return result;
     }
 
-    void SampleAggregatorImp::update_total(void)
+    int SampleAggregatorImp::get_period(void)
+    {
+        int result = 0;
+        if (m_period_duration) {
+            result = period_index(m_platform_io.sample(m_time_idx));
+        }
+        return result;
+    }
+
+    void SampleAggregatorImp::init_columns(void)
     {
-        int period = get_period();
-        // Update all of the sum aggregators
-        for (auto &signal_it : m_sum_signal) {
-            int signal_idx = signal_it.first;
-            m_sum_signal_s &signal = signal_it.second;
-            double sample = m_platform_io.sample(signal_idx);
-            uint64_t hash = sample_to_hash(m_platform_io.sample(signal.region_hash_idx));
-            int epoch_count = m_platform_io.sample(signal.epoch_count_idx);
-            if (!m_is_updated) {
-                // On first call just initialize the signal values
-                signal.sample_last = sample;
-                signal.region_hash_last = hash;
-                signal.epoch_count_last = epoch_count;
-                signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
+        size_t num_column = m_column_signal.size();
+        m_sample_last.resize(num_column, NAN);
+        m_region_idx_last.resize(num_column);
+        m_epoch_count_last.resize(num_column);
+        m_update.resize(num_column);
+        m_update_weight.resize(num_column);
+        m_is_skipped.resize(num_column);
+        accum_resize(m_app_accum, num_column);
+        accum_resize(m_epoch_accum, num_column);
+        accum_resize(m_period_accum, num_column);
+        // On first call just initialize the signal values
+        for (size_t col = 0; col != num_column; ++col) {
+            const m_domain_s &domain = m_domain[m_column_domain[col]];
+            if (m_column_is_total[col]) {
+                m_sample_last[col] = m_platform_io.sample(m_column_signal[col]);
             }
-            else {
+            m_region_idx_last[col] = domain.region_idx;
+            m_epoch_count_last[col] = domain.epoch_count;
+            m_is_region_seen[domain.region_idx * num_column + col] = true;
+        }
+    }
+
+    void SampleAggregatorImp::sample_columns(double time)
+    {
+        size_t num_column = m_column_signal.size();
+        double delta_time = time - m_time_last;
+        for (size_t col = 0; col != num_column; ++col) {
+            double sample = m_platform_io.sample(m_column_signal[col]);
+            double update = 0.0;
+            double weight = 0.0;
+            bool is_skipped = false;
+            if (m_column_is_total[col]) {
                 if (std::isnan(sample)) {
-                    continue;
-                }
-                // Measure the change since the last update
-                double delta = 0;
-                if (!std::isnan(signal.sample_last)) {
-                    delta = sample - signal.sample_last;
+                    // Nothing is updated for the signal until it has
+                    // a valid sample
+                    is_skipped = true;
                 }
-                // Update that application totals
-                signal.app_accum->update(delta);
-                // If we have observed our first epoch, update epoch totals
-                if (signal.epoch_count_last != 0) {
-                    signal.epoch_accum->update(delta);
-                }
-                // Update the periodic totals
-                signal.period_accum->update(delta);
-                // Update region totals
-                signal.region_accum_it->second->update(delta);
-                sample_aggregator_update_epoch(signal, epoch_count);
-                sample_aggregator_update_hash_exit(signal, hash);
-                if (signal.region_hash_last != hash) {
-                    signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
-                }
-                sample_aggregator_update_hash_enter(signal, hash);
-                if (period != m_period_last) {
-                    sample_aggregator_update_period(signal, period);
+                else {
+                    // Measure the change since the last update
+                    if (!std::isnan(m_sample_last[col])) {
+                        update = sample - m_sample_last[col];
+                    }
+                    m_sample_last[col] = sample;
                 }
-                signal.region_hash_last = hash;
-                signal.sample_last = sample;
             }
+            else if (!std::isnan(sample) && !std::isnan(delta_time)) {
+                update = delta_time * sample;
+                weight = delta_time;
+            }
+            m_update[col] = update;
+            m_update_weight[col] = weight;
+            m_is_skipped[col] = is_skipped;
+        }
+    }
+
+    void SampleAggregatorImp::accumulate(void)
+    {
+        size_t num_column = m_column_signal.size();
+        const double *update = m_update.data();
+        const double *weight = m_update_weight.data();
+        const int *epoch_count_last = m_epoch_count_last.data();
+        double *app_total = m_app_accum.total.data();
+        double *app_weight = m_app_accum.weight.data();
+        double *epoch_total = m_epoch_accum.total.data();
+        double *epoch_weight = m_epoch_accum.weight.data();
+        double *epoch_curr_total = m_epoch_accum.curr_total.data();
+        double *epoch_curr_weight = m_epoch_accum.curr_weight.data();
+        double *period_total = m_period_accum.total.data();
+        double *period_weight = m_period_accum.weight.data();
+        double *period_curr_total = m_period_accum.curr_total.data();
+        double *period_curr_weight = m_period_accum.curr_weight.data();
+        // Skipped columns have zero update and weight, so every
+        // column can be updated in the same branch free pass.
+        for (size_t col = 0; col != num_column; ++col) {
+            app_total[col] += update[col];
+            app_weight[col] += weight[col];
+            // Epoch totals are updated after the first epoch is observed
+            bool is_epoch = epoch_count_last[col] != 0;
+            double epoch_update = is_epoch ? update[col] : 0.0;
+            double epoch_update_weight = is_epoch ? weight[col] : 0.0;
+            epoch_total[col] += epoch_update;
+            epoch_weight[col] += epoch_update_weight;
+            epoch_curr_total[col] += epoch_update;
+            epoch_curr_weight[col] += epoch_update_weight;
+            period_total[col] += update[col];
+            period_weight[col] += weight[col];
+            period_curr_total[col] += update[col];
+            period_curr_weight[col] += weight[col];
+        }
+        // Region totals for the region that each column was in
+        for (size_t col = 0; col != num_column; ++col) {
+            size_t idx = m_region_idx_last[col] * num_column + col;
+            m_region_accum.total[idx] += update[col];
+            m_region_accum.weight[idx] += weight[col];
+            m_region_accum.curr_total[idx] += update[col];
+            m_region_accum.curr_weight[idx] += weight[col];
         }
     }
 
-    void SampleAggregatorImp::update_average(void)
+    void SampleAggregatorImp::update_intervals(int period)
     {
-        int period = get_period();
-        // Update all of the average aggregators
-        for (auto &signal_it : m_avg_signal) {
-            int signal_idx = signal_it.first;
-            m_avg_signal_s &signal = signal_it.second;
-            double time = m_platform_io.sample(m_time_idx);
-            double sample = m_platform_io.sample(signal_idx);
-            uint64_t hash = sample_to_hash(m_platform_io.sample(signal.region_hash_idx));
-            int epoch_count = m_platform_io.sample(signal.epoch_count_idx);
-            if (!m_is_updated) {
-                // On first call just initialize the signal values
-                signal.time_last = 0.0;
-                signal.region_hash_last = hash;
-                signal.epoch_count_last = epoch_count;
-                signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
+        int num_column = m_column_signal.size();
+        for (int col = 0; col != num_column; ++col) {
+            if (m_is_skipped[col]) {
+                continue;
             }
-            else {
-                // Measure the time change since the last update
-                double delta = time - signal.time_last;
-                // Update that application totals
-                signal.app_accum->update(delta, sample);
-                // If we have observed our first epoch, update epoch totals
-                if (signal.epoch_count_last != 0) {
-                    signal.epoch_accum->update(delta, sample);
+            const m_domain_s &domain = m_domain[m_column_domain[col]];
+            // If the epoch count has changed, call the exit/enter
+            if (domain.epoch_count != m_epoch_count_last[col]) {
+                if (m_epoch_count_last[col] != 0) {
+                    accum_exit(m_epoch_accum, col, col);
                 }
-                // Update the periodic totals
-                signal.period_accum->update(delta, sample);
-                // Update region totals
-                signal.region_accum_it->second->update(delta, sample);
-
-                sample_aggregator_update_epoch(signal, epoch_count);
-                sample_aggregator_update_hash_exit(signal, hash);
-                if (signal.region_hash_last != hash) {
-                    signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
+                accum_enter(m_epoch_accum, col);
+                m_epoch_count_last[col] = domain.epoch_count;
+            }
+            int region_idx_last = m_region_idx_last[col];
+            if (domain.region_idx != region_idx_last) {
+                // If we have exited a valid region, call exit()
+                if (m_region_hash[region_idx_last] != GEOPM_REGION_HASH_UNMARKED) {
+                    accum_exit(m_region_accum, region_idx_last * num_column + col, col);
                 }
-                sample_aggregator_update_hash_enter(signal, hash);
-                if (period != m_period_last) {
-                    sample_aggregator_update_period(signal, period);
+                int idx = domain.region_idx * num_column + col;
+                m_is_region_seen[idx] = true;
+                // If we have entered a valid region, call enter()
+                if (domain.region_hash != GEOPM_REGION_HASH_UNMARKED) {
+                    accum_enter(m_region_accum, idx);
                 }
-                signal.region_hash_last = hash;
-                signal.time_last = time;
+                m_region_idx_last[col] = domain.region_idx;
+            }
+            if (period != m_period_last) {
+                if (period != 0) {
+                    accum_exit(m_period_accum, col, col);
+                }
+                accum_enter(m_period_accum, col);
             }
         }
     }
 
     void SampleAggregatorImp::update(void)
     {
-        update_total();
-        update_average();
-        m_period_last = get_period();
+        double time = m_platform_io.sample(m_time_idx);
+        int period = period_index(time);
+        // Sample the region hash and epoch count once for each domain
+        for (auto &domain : m_domain) {
+            uint64_t hash = sample_to_hash(m_platform_io.sample(domain.region_hash_idx));
+            if (domain.region_idx == -1 || hash != domain.region_hash) {
+                domain.region_hash = hash;
+                domain.region_idx = region_index(hash);
+            }
+            domain.epoch_count = m_platform_io.sample(domain.epoch_count_idx);
+        }
+        if (!m_is_updated) {
+            init_columns();
+        }
+        else {
+            sample_columns(time);
+            accumulate();
+            update_intervals(period);
+            m_time_last = time;
+        }
+        m_period_last = period;
         m_is_updated = true;
     }
 
@@ -332,86 +407,38 @@ namespace geopm
         if (!m_is_updated) {
             return NAN;
         }
-
-        double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            result = sum_it->second.app_accum->total();
-        }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_application(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            result = avg_it->second.app_accum->average();
-        }
-        return result;
+        int col = column(signal_idx, "sample_application");
+        return accum_value(m_app_accum, col, col);
     }
 
     double SampleAggregatorImp::sample_epoch_helper(int signal_idx, bool is_last)
     {
+        int col = column(signal_idx, "sample_epoch");
         double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            if (is_last) {
-                result = sum_it->second.epoch_accum->interval_total();
-            }
-            else {
-                result = sum_it->second.epoch_accum->total();
-            }
+        if (is_last) {
+            result = m_epoch_accum.last[col];
         }
         else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_epoch(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            if (is_last) {
-                result = avg_it->second.epoch_accum->interval_average();
-            }
-            else {
-                result = avg_it->second.epoch_accum->average();
-            }
+            result = accum_value(m_epoch_accum, col, col);
         }
         return result;
     }
 
     double SampleAggregatorImp::sample_region_helper(int signal_idx, uint64_t region_hash, bool is_last)
     {
-        double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            const auto &region_accum = sum_it->second.region_accum;
-            auto region_accum_it = region_accum.find(region_hash);
-            if (region_accum_it == region_accum.end()) {
-                result = 0.0;
-            }
-            else {
-                auto accum_ptr = region_accum_it->second;
-                if (is_last) {
-                    result = accum_ptr->interval_total();
-                }
-                else {
-                    result = accum_ptr->total();
-                }
-            }
-        }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_region(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            const auto &region_accum = avg_it->second.region_accum;
-            auto region_accum_it = region_accum.find(region_hash);
-            if (region_accum_it != region_accum.end()) {
-                auto accum_ptr = region_accum_it->second;
+        int col = column(signal_idx, "sample_region");
+        // A region that was never entered is zero for totals and
+        // unknown for averages
+        double result = m_column_is_total[col] ? 0.0 : NAN;
+        auto region_it = m_region_idx.find(region_hash);
+        if (region_it != m_region_idx.end()) {
+            int idx = region_it->second * m_column_signal.size() + col;
+            if (m_is_region_seen[idx]) {
                 if (is_last) {
-                    result = accum_ptr->interval_average();
+                    result = m_region_accum.last[idx];
                 }
                 else {
-                    result = accum_ptr->average();
+                    result = accum_value(m_region_accum, idx, col);
                 }
             }
         }
@@ -464,21 +491,7 @@ namespace geopm
         if (!m_is_updated || m_period_duration == 0.0) {
             return NAN;
         }
-
-        double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            result = sum_it->second.period_accum->interval_total();
-        }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_period(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            result = avg_it->second.period_accum->interval_average();
-        }
-        return result;
+        int col = column(signal_idx, "sample_period");
+        return m_period_accum.last[col];
     }
-
 }
@@ -9,15 +9,22 @@
 #include <cmath>
 
 #include <map>
+#include <vector>
 
 #include "geopm/SampleAggregator.hpp"
 
 namespace geopm
 {
     class PlatformIO;
-    class SumAccumulator;
-    class AvgAccumulator;
 
+    /// @brief SampleAggregator that stores the accumulators for all
+    ///        pushed signals in contiguous arrays.
+    ///
+    /// Each pushed signal is a column.  The region hash and epoch
+    /// count are sampled once per domain in each update and shared
+    /// by the columns of that domain.  Region hashes are mapped to a
+    /// dense index, and the accumulators for all columns are updated
+    /// in a single pass over the arrays.
     class SampleAggregatorImp : public SampleAggregator
     {
         public:
@@ -43,56 +50,57 @@ namespace geopm
             double sample_period_last(int signal_idx) override;
 
         private:
-            // All of the data relating to a pushed "total" signal
-            struct m_sum_signal_s {
-                // Value of the signal from last control interval
-                double sample_last;
-                // PlatformIO signal index to get the region hash
-                int region_hash_idx;
-                // Value of the hash from last control interval
-                uint64_t region_hash_last;
-                // PlatformIO signal index to get the epoch count
-                int epoch_count_idx;
-                // Value of the epoch count from last control interval
-                int epoch_count_last;
-                // Accumulator for application totals (always updated)
-                std::shared_ptr<SumAccumulator> app_accum;
-                // Accumulator for epoch totals (updated after first epoch call)
-                std::shared_ptr<SumAccumulator> epoch_accum;
-                // Accumulator for periodic totals (always updated)
-                std::shared_ptr<SumAccumulator> period_accum;
-                // Map from region hash to an accumulator for that region
-                std::map<uint64_t, std::shared_ptr<SumAccumulator> > region_accum;
-                // Iterator pointing to the region_hash_last map location
-                std::map<uint64_t, std::shared_ptr<SumAccumulator> >::iterator region_accum_it;
+            // Columnar storage for one kind of accumulator.  Element
+            // i of each vector belongs to column i, and the region
+            // accumulators hold one row of columns for each region.
+            struct m_accum_s {
+                // Sum of updates for totals, or of time weighted
+                // samples for averages
+                std::vector<double> total;
+                // Sum of time deltas for averages
+                std::vector<double> weight;
+                // Sums since the last call to enter()
+                std::vector<double> curr_total;
+                std::vector<double> curr_weight;
+                // Interval value computed by the last call to exit()
+                std::vector<double> last;
             };
 
-            // All of the data relating to each pushed "average" signal
-            struct m_avg_signal_s {
-                // Time stamp from last control interval
-                double time_last;
+            // State shared by all signals pushed for one domain
+            struct m_domain_s {
                 // PlatformIO signal index to get the region hash
                 int region_hash_idx;
-                // Value of the hash from last control interval
-                uint64_t region_hash_last;
                 // PlatformIO signal index to get the epoch count
                 int epoch_count_idx;
-                // Value of the epoch count from last control interval
-                int epoch_count_last;
-                // Accumulator for application totals (always updated)
-                std::shared_ptr<AvgAccumulator> app_accum;
-                // Accumulator for epoch totals (updated after first epoch call)
-                std::shared_ptr<AvgAccumulator> epoch_accum;
-                // Accumulator for periodic totals (always updated)
-                std::shared_ptr<AvgAccumulator> period_accum;
-                // Map from region hash to an accumulator for that region
-                std::map<uint64_t, std::shared_ptr<AvgAccumulator> > region_accum;
-                // Iterator pointing to the region_hash_last map location
-                std::map<uint64_t, std::shared_ptr<AvgAccumulator> >::iterator region_accum_it;
+                // Region hash sampled in the current update
+                uint64_t region_hash;
+                // Dense index of region_hash, or -1 before the first
+                // update
+                int region_idx;
+                // Epoch count sampled in the current update
+                int epoch_count;
             };
 
-            void update_total(void);
-            void update_average(void);
+            void push_column(int signal_idx, int domain_type, int domain_idx,
+                             bool is_total);
+            // Returns the column for a PlatformIO signal index, or -1
+            // if the signal was not pushed.
+            int find_column(int signal_idx) const;
+            // Returns the column for a PlatformIO signal index, or
+            // throws if the signal was not pushed.
+            int column(int signal_idx, const std::string &func_name) const;
+            // Returns the dense index for a region hash, adding a row
+            // of region accumulators if the hash is new.
+            int region_index(uint64_t region_hash);
+            int period_index(double time) const;
+            void init_columns(void);
+            void sample_columns(double time);
+            void accumulate(void);
+            void update_intervals(int period);
+            static void accum_resize(m_accum_s &accum, size_t size);
+            static void accum_enter(m_accum_s &accum, int idx);
+            void accum_exit(m_accum_s &accum, int idx, int column);
+            double accum_value(const m_accum_s &accum, int idx, int column) const;
             double sample_epoch_helper(int signal_idx, bool is_last);
             double sample_region_helper(int signal_idx, uint64_t region_hash, bool is_last);
             uint64_t sample_to_hash(double sample);
@@ -101,14 +109,42 @@ namespace geopm
             // PlatformIO signal index for time of last sample
             int m_time_idx;
             bool m_is_updated;
-            // Map from index returned by push_signal_total() to the
-            // signal structure
-            std::map<int, m_sum_signal_s> m_sum_signal;
-            // Map from index returned by push_signal_average() to the
-            // signal structure
-            std::map<int, m_avg_signal_s> m_avg_signal;
             double m_period_duration;
             int m_period_last;
+            // Time of the last update used for averages
+            double m_time_last;
+            // Map from PlatformIO signal index to column, -1 for
+            // signals that were not pushed
+            std::vector<int> m_signal_column;
+            std::vector<m_domain_s> m_domain;
+            // Map from region hash signal index to element of m_domain
+            std::map<int, int> m_domain_idx;
+            // Map from region hash to dense region index
+            std::map<uint64_t, int> m_region_idx;
+            std::vector<uint64_t> m_region_hash;
+            // Per column configuration
+            std::vector<int> m_column_signal;
+            std::vector<int> m_column_domain;
+            std::vector<bool> m_column_is_total;
+            // Per column state from the last update
+            std::vector<double> m_sample_last;
+            std::vector<int> m_region_idx_last;
+            std::vector<int> m_epoch_count_last;
+            // Per column values for the current update
+            std::vector<double> m_update;
+            std::vector<double> m_update_weight;
+            std::vector<bool> m_is_skipped;
+            // Accumulators for application, epoch and periodic totals
+            // with one element per column
+            m_accum_s m_app_accum;
+            m_accum_s m_epoch_accum;
+            m_accum_s m_period_accum;
+            // Region accumulators, element region_idx * num_column +
+            // column
+            m_accum_s m_region_accum;
+            // True if the region of each region accumulator has been
+            // entered by its column
+            std::vector<bool> m_is_region_seen;
     };
 }
 
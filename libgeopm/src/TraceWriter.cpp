@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "TraceWriter.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#ifdef GEOPM_HAS_ZSTD
+#include <zstd.h>
+#endif
+#ifdef GEOPM_HAS_LZ4
+#include <lz4.h>
+#endif
+
+#include "geopm_time.h"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+
+namespace geopm
+{
+    static void trace_writer_store_uint32(char *dest, uint32_t value)
+    {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap32(value);
+#endif
+        std::memcpy(dest, &value, sizeof(value));
+    }
+
+    TraceWriterImp::TraceWriterImp(const std::string &file_path,
+                                   const std::string &policy,
+                                   const std::string &compression)
+        : TraceWriterImp([this](const std::string &buffer)
+                         {
+                             m_stream.write(buffer.data(), buffer.size());
+                             m_stream.flush();
+                         },
+                         [this](void)
+                         {
+                             m_stream.flush();
+                         },
+                         policy,
+                         compression,
+                         M_MAX_QUEUE)
+    {
+        // The sinks are only called after the constructor returns
+        m_stream.open(file_path, std::ios::binary);
+        if (!m_stream.good()) {
+            throw Exception("Unable to open trace file '" + file_path + "'",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    TraceWriterImp::TraceWriterImp(std::function<void(const std::string &)> sink,
+                                   std::function<void(void)> sink_flush,
+                                   const std::string &policy,
+                                   const std::string &compression,
+                                   size_t max_queue)
+        : m_sink(sink)
+        , m_sink_flush(sink_flush)
+        , m_policy(TraceWriterImp::policy(policy))
+        , m_codec(TraceWriterImp::codec(compression))
+        , m_max_queue(max_queue)
+        , m_is_header_written(false)
+        , m_write_time(0.0)
+        , m_num_pending(0)
+        , m_num_overrun(0)
+        , m_is_shutdown(false)
+    {
+        if (m_max_queue == 0) {
+            throw Exception("TraceWriterImp: max_queue must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    TraceWriterImp::~TraceWriterImp()
+    {
+        if (m_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_is_shutdown = true;
+            }
+            m_queue_cv.notify_one();
+            // The thread writes all queued buffers before it exits
+            m_thread.join();
+        }
+    }
+
+    int TraceWriterImp::policy(const std::string &name)
+    {
+        int result = M_POLICY_BLOCK;
+        if (name == "sync") {
+            result = M_POLICY_SYNC;
+        }
+        else if (name == "drop") {
+            result = M_POLICY_DROP;
+        }
+        else if (name != "" && name != "block") {
+            throw Exception("TraceWriterImp: unknown trace writer policy: \"" + name +
+                            "\", expected \"block\", \"drop\" or \"sync\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    int TraceWriterImp::codec(const std::string &name)
+    {
+        int result = M_CODEC_NONE;
+        if (name == "zstd") {
+#ifdef GEOPM_HAS_ZSTD
+            result = M_CODEC_ZSTD;
+#else
+            throw Exception("TraceWriterImp: GEOPM was built without zstd, see the --with-zstd configure option",
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+#endif
+        }
+        else if (name == "lz4") {
+#ifdef GEOPM_HAS_LZ4
+            result = M_CODEC_LZ4;
+#else
+            throw Exception("TraceWriterImp: GEOPM was built without lz4, see the --with-lz4 configure option",
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+#endif
+        }
+        else if (name != "" && name != "none") {
+            throw Exception("TraceWriterImp: unknown trace compression: \"" + name +
+                            "\", expected \"none\", \"zstd\" or \"lz4\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    void TraceWriterImp::write(std::string &&buffer)
+    {
+        geopm_time_s begin;
+        geopm_time(&begin);
+        if (m_policy == M_POLICY_SYNC) {
+            write_frame(buffer);
+        }
+        else {
+            if (!m_thread.joinable()) {
+                // Started by the first write so that the thread
+                // inherits the CPU affinity the caller has by then
+                m_thread = std::thread(&TraceWriterImp::run, this);
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            check_error();
+            bool do_queue = true;
+            if (m_num_pending == m_max_queue) {
+                ++m_num_overrun;
+                if (m_policy == M_POLICY_DROP) {
+                    do_queue = false;
+                }
+                else {
+                    m_write_cv.wait(lock, [this] {
+                        return m_num_pending < m_max_queue;
+                    });
+                }
+            }
+            if (do_queue) {
+                m_queue.push_back(std::move(buffer));
+                ++m_num_pending;
+                lock.unlock();
+                m_queue_cv.notify_one();
+            }
+        }
+        m_write_time += geopm_time_since(&begin);
+    }
+
+    void TraceWriterImp::flush(void)
+    {
+        geopm_time_s begin;
+        geopm_time(&begin);
+        if (m_policy != M_POLICY_SYNC) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_write_cv.wait(lock, [this] {
+                return m_num_pending == 0;
+            });
+            check_error();
+        }
+        // The writer thread is idle until the next call to write()
+        m_sink_flush();
+        m_write_time += geopm_time_since(&begin);
+    }
+
+    double TraceWriterImp::write_time(void) const
+    {
+        return m_write_time;
+    }
+
+    size_t TraceWriterImp::max_buffer_size(void) const
+    {
+        size_t result = SIZE_MAX;
+        if (m_codec != M_CODEC_NONE) {
+            result = M_MAX_FRAME_SIZE;
+        }
+        return result;
+    }
+
+    void TraceWriterImp::write_frame(const std::string &buffer)
+    {
+        if (m_codec == M_CODEC_NONE) {
+            m_sink(buffer);
+            return;
+        }
+        if (!m_is_header_written) {
+            std::string header(M_MAGIC);
+            size_t offset = header.size();
+            header.resize(offset + 2 * sizeof(uint32_t));
+            trace_writer_store_uint32(&header[offset], M_VERSION);
+            trace_writer_store_uint32(&header[offset + sizeof(uint32_t)], m_codec);
+            m_sink(header);
+            m_is_header_written = true;
+        }
+        if (buffer.size() > INT_MAX) {
+            throw Exception("TraceWriterImp::write_frame(): buffer is too large to compress",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const size_t offset = 2 * sizeof(uint32_t);
+        size_t compressed_size = 0;
+        switch (m_codec) {
+#ifdef GEOPM_HAS_ZSTD
+            case M_CODEC_ZSTD:
+                {
+                    m_frame.resize(offset + ZSTD_compressBound(buffer.size()));
+                    size_t ret = ZSTD_compress(&m_frame[offset], m_frame.size() - offset,
+                                               buffer.data(), buffer.size(), M_ZSTD_LEVEL);
+                    if (ZSTD_isError(ret)) {
+                        throw Exception("TraceWriterImp::write_frame(): zstd compression failed: " +
+                                        std::string(ZSTD_getErrorName(ret)),
+                                        GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                    }
+                    compressed_size = ret;
+                }
+                break;
+#endif
+#ifdef GEOPM_HAS_LZ4
+            case M_CODEC_LZ4:
+                {
+                    int bound = LZ4_compressBound(buffer.size());
+                    m_frame.resize(offset + bound);
+                    int ret = LZ4_compress_default(buffer.data(), &m_frame[offset],
+                                                   buffer.size(), bound);
+                    if (ret <= 0) {
+                        throw Exception("TraceWriterImp::write_frame(): lz4 compression failed",
+                                        GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                    }
+                    compressed_size = ret;
+                }
+                break;
+#endif
+            default:
+                throw Exception("TraceWriterImp::write_frame(): unsupported codec",
+                                GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+        m_frame.resize(offset + compressed_size);
+        trace_writer_store_uint32(&m_frame[0], compressed_size);
+        trace_writer_store_uint32(&m_frame[sizeof(uint32_t)], buffer.size());
+        m_sink(m_frame);
+    }
+
+    uint64_t TraceWriterImp::num_flush_overrun(void) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_overrun;
+    }
+
+    void TraceWriterImp::check_error(void)
+    {
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void TraceWriterImp::run(void)
+    {
+        // Yield to every other thread on the CPU, failure to lower
+        // the priority is not an error.
+        struct sched_param param = {};
+        (void)pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_queue_cv.wait(lock, [this] {
+                return !m_queue.empty() || m_is_shutdown;
+            });
+            if (m_queue.empty()) {
+                break;
+            }
+            std::string buffer = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                write_frame(buffer);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_error) {
+                m_error = error;
+            }
+            --m_num_pending;
+            m_write_cv.notify_all();
+        }
+    }
+
+    std::unique_ptr<TraceWriter> TraceWriter::make_unique(const std::string &file_path,
+                                                          const std::string &policy,
+                                                          const std::string &compression)
+    {
+        return geopm::make_unique<TraceWriterImp>(file_path, policy, compression);
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TRACEWRITER_HPP_INCLUDE
+#define TRACEWRITER_HPP_INCLUDE
+
+#include <cstdint>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace geopm
+{
+    /// @brief Appends buffers of trace data to a file.
+    ///
+    /// Unless the policy is "sync", the buffers are written by a
+    /// dedicated low priority thread so that the control loop does
+    /// not wait on the file system.  The thread is created by the
+    /// first call to write() and inherits the CPU affinity of the
+    /// caller at that time.  The Controller makes its first write
+    /// after the ApplicationSampler has pinned the Controller thread
+    /// to a CPU that is not used by the application, even when the
+    /// writer was constructed before that.
+    ///
+    /// If compression is enabled, each buffer is compressed by the
+    /// writing thread into an independent frame, so a reader can
+    /// seek to any frame and decode it without the others.  The
+    /// compressed file begins with a header:
+    ///
+    ///     char[8]  magic "GEOPMTRZ"
+    ///     uint32   version (1)
+    ///     uint32   codec: 1 for zstd, 2 for lz4 block format
+    ///
+    /// and each frame that follows is:
+    ///
+    ///     uint32   number of compressed bytes
+    ///     uint32   number of bytes before compression
+    ///     bytes    compressed data
+    ///
+    /// All integers are little-endian.  Concatenating the decoded
+    /// frames gives the file that would have been written without
+    /// compression.
+    class TraceWriter
+    {
+        public:
+            TraceWriter() = default;
+            virtual ~TraceWriter() = default;
+            /// @brief Append a buffer to the file.  With an
+            ///        asynchronous policy the buffer is queued and
+            ///        the call returns without waiting for the file
+            ///        system unless the queue is full.
+            /// @param [in] buffer Data to append, ownership of the
+            ///        contents is taken.
+            virtual void write(std::string &&buffer) = 0;
+            /// @brief Wait until all buffers passed to write() have
+            ///        been written and flush the file.
+            virtual void flush(void) = 0;
+            /// @brief Get the number of calls to write() that found
+            ///        the queue full.  With the "block" policy each
+            ///        of these stalled the caller, and with the
+            ///        "drop" policy the buffer was discarded.
+            /// @return Number of overruns since construction.
+            virtual uint64_t num_flush_overrun(void) const = 0;
+            /// @brief Get the time spent by the caller in write()
+            ///        and flush().  This includes compression when
+            ///        the policy is "sync" and waiting for the queue
+            ///        when the policy is "block".
+            /// @return Total time in seconds.
+            virtual double write_time(void) const = 0;
+            /// @brief Get the size of the largest buffer that should
+            ///        be passed to write().  Larger buffers are
+            ///        accepted, but with compression each buffer is
+            ///        one frame, so smaller buffers give finer
+            ///        grained seeking.
+            /// @return Size in bytes.
+            virtual size_t max_buffer_size(void) const = 0;
+            /// @brief Create a trace writer.
+            /// @param [in] file_path Path to the file that is
+            ///        created.
+            /// @param [in] policy One of "block" (the default if
+            ///        empty), "drop" or "sync".
+            /// @param [in] compression One of "none" (the default
+            ///        if empty), "zstd" or "lz4".  The codec must
+            ///        have been found when GEOPM was built.
+            static std::unique_ptr<TraceWriter> make_unique(const std::string &file_path,
+                                                            const std::string &policy,
+                                                            const std::string &compression);
+            static constexpr const char *M_MAGIC = "GEOPMTRZ";
+            static constexpr uint32_t M_VERSION = 1;
+    };
+
+    class TraceWriterImp : public TraceWriter
+    {
+        public:
+            TraceWriterImp(const std::string &file_path,
+                           const std::string &policy,
+                           const std::string &compression);
+            TraceWriterImp(std::function<void(const std::string &)> sink,
+                           std::function<void(void)> sink_flush,
+                           const std::string &policy,
+                           const std::string &compression,
+                           size_t max_queue);
+            TraceWriterImp(const TraceWriterImp &other) = delete;
+            TraceWriterImp &operator=(const TraceWriterImp &other) = delete;
+            virtual ~TraceWriterImp();
+            void write(std::string &&buffer) override;
+            void flush(void) override;
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
+            size_t max_buffer_size(void) const override;
+        private:
+            enum m_policy_e {
+                M_POLICY_SYNC,
+                M_POLICY_BLOCK,
+                M_POLICY_DROP,
+            };
+            enum m_codec_e {
+                M_CODEC_NONE,
+                M_CODEC_ZSTD,
+                M_CODEC_LZ4,
+            };
+            static int policy(const std::string &name);
+            static int codec(const std::string &name);
+            /// @brief Body of the writer thread, started by the
+            ///        first call to write()
+            void run(void);
+            /// @brief Write the buffer to the sink, compressing it
+            ///        if required.  Called by only one thread: the
+            ///        writer thread or the caller if the policy is
+            ///        "sync".
+            void write_frame(const std::string &buffer);
+            /// @brief Throw the error raised by the writer thread if
+            ///        there is one, must be called with the mutex
+            ///        held.
+            void check_error(void);
+
+            /// @brief Maximum number of buffers held by the writer
+            ///        thread (queued or being written)
+            static constexpr size_t M_MAX_QUEUE = 2;
+            /// @brief Largest buffer size requested when compressing
+            static constexpr size_t M_MAX_FRAME_SIZE = 1024 * 1024;
+            /// @brief zstd compression level
+            static constexpr int M_ZSTD_LEVEL = 3;
+            std::ofstream m_stream;
+            std::function<void(const std::string &)> m_sink;
+            std::function<void(void)> m_sink_flush;
+            const int m_policy;
+            const int m_codec;
+            const size_t m_max_queue;
+            bool m_is_header_written;
+            /// @brief Output of the compressor, reused for each frame
+            std::string m_frame;
+            double m_write_time;
+            mutable std::mutex m_mutex;
+            /// @brief Signaled when a buffer is queued or on shutdown
+            std::condition_variable m_queue_cv;
+            /// @brief Signaled when a buffer has been written
+            std::condition_variable m_write_cv;
+            std::deque<std::string> m_queue;
+            /// @brief Number of buffers held by the writer thread
+            size_t m_num_pending;
+            uint64_t m_num_overrun;
+            bool m_is_shutdown;
+            std::exception_ptr m_error;
+            std::thread m_thread;
+    };
+}
+
+#endif
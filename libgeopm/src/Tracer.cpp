@@ -30,7 +30,9 @@ namespace geopm
 {
     TracerImp::TracerImp(const std::string &start_time)
         : TracerImp(start_time, environment().trace(), hostname(),
-                    environment().do_trace(), PlatformIOProf::platform_io(), platform_topo(),
+                    environment().do_trace(), environment().trace_format(),
+                    environment().trace_writer(), environment().trace_compression(),
+                    PlatformIOProf::platform_io(), platform_topo(),
                     environment_signal_parser(PlatformIOProf::platform_io().signal_names(), environment().trace_signals()))
     {
 
@@ -40,6 +42,9 @@ namespace geopm
                          const std::string &file_path,
                          const std::string &hostname,
                          bool do_trace,
+                         const std::string &trace_format,
+                         const std::string &trace_writer,
+                         const std::string &trace_compression,
                          PlatformIO &platform_io,
                          const PlatformTopo &platform_topo,
                          const std::vector<std::pair<std::string, int> > &env_column)
@@ -54,7 +59,8 @@ namespace geopm
         , m_region_runtime_idx(-1)
     {
         if (m_is_trace_enabled) {
-            m_csv = geopm::make_unique<CSVImp>(file_path, hostname, start_time, M_BUFFER_SIZE);
+            m_csv = CSV::make_unique(file_path, hostname, start_time, M_BUFFER_SIZE,
+                                     trace_format, trace_writer, trace_compression);
         }
     }
 
@@ -175,6 +181,24 @@ namespace geopm
         }
     }
 
+    uint64_t TracerImp::num_flush_overrun(void) const
+    {
+        uint64_t result = 0;
+        if (m_is_trace_enabled) {
+            result = m_csv->num_flush_overrun();
+        }
+        return result;
+    }
+
+    double TracerImp::write_time(void) const
+    {
+        double result = 0.0;
+        if (m_is_trace_enabled) {
+            result = m_csv->write_time();
+        }
+        return result;
+    }
+
     std::vector<std::string> TracerImp::env_signals(void)
     {
         std::vector<std::string> result;
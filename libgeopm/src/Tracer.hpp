@@ -6,6 +6,7 @@
 #ifndef TRACER_HPP_INCLUDE
 #define TRACER_HPP_INCLUDE
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -40,6 +41,15 @@ namespace geopm
             /// @brief Write the remaining trace data to the file and
             ///        stop tracing.
             virtual void flush(void) = 0;
+            /// @brief Get the number of trace buffers that found the
+            ///        trace writer busy.  See
+            ///        TraceWriter::num_flush_overrun().
+            /// @return Number of stalled or dropped buffers.
+            virtual uint64_t num_flush_overrun(void) const = 0;
+            /// @brief Get the time spent passing trace buffers to
+            ///        the trace writer.
+            /// @return Time in seconds.
+            virtual double write_time(void) const = 0;
     };
 
     class PlatformIO;
@@ -56,6 +66,9 @@ namespace geopm
                       const std::string &file_path,
                       const std::string &hostname,
                       bool do_trace,
+                      const std::string &trace_format,
+                      const std::string &trace_writer,
+                      const std::string &trace_compression,
                       PlatformIO &platform_io,
                       const PlatformTopo &platform_topo,
                       const std::vector<std::pair<std::string, int> > &env_column);
@@ -65,6 +78,8 @@ namespace geopm
                          const std::vector<std::function<std::string(double)> > &agent_formats) override;
             void update(const std::vector<double> &agent_signals) override;
             void flush(void) override;
+            uint64_t num_flush_overrun(void) const override;
+            double write_time(void) const override;
         private:
             struct m_request_s {
                 std::string name;
@@ -87,9 +87,9 @@ namespace geopm
         for (; level < m_max_level; ++level) {
             parent_coords[root_level - 1 - level] = 0;
             result.emplace_back(
-                std::make_shared<TreeCommLevelImp>(comm_cart->split(
-                                                   comm_cart->cart_rank(parent_coords), rank_cart),
-                                                   m_num_send_up, m_num_send_down));
+                TreeCommLevel::make_unique(comm_cart->split(
+                                           comm_cart->cart_rank(parent_coords), rank_cart),
+                                           m_num_send_up, m_num_send_down));
         }
         for (; level < root_level; ++level) {
             comm_cart->split(Comm::M_SPLIT_COLOR_UNDEFINED, 0);
@@ -175,6 +175,15 @@ namespace geopm
         return result;
     }
 
+    size_t TreeCommImp::overhead_save(void) const
+    {
+        size_t result = 0;
+        for (const auto &level : m_level_ctl) {
+            result += level->overhead_save();
+        }
+        return result;
+    }
+
     std::vector<int> TreeComm::fan_out(const std::shared_ptr<Comm> &comm)
     {
         std::vector<int> fan_out;
@@ -51,6 +51,10 @@ namespace geopm
             /// @brief Returns the total number of bytes sent from the
             ///        entire tree.
             virtual size_t overhead_send(void) const = 0;
+            /// @brief Returns the total number of bytes that were not
+            ///        sent from the entire tree because a sample was
+            ///        unchanged.
+            virtual size_t overhead_save(void) const = 0;
             /// @brief Returns the number of children at each level.
             static std::vector<int> fan_out(const std::shared_ptr<Comm> &comm);
     };
@@ -80,6 +84,7 @@ namespace geopm
             bool receive_down(int level, std::vector<double> &policy) override;
             bool receive_up(int level, std::vector<std::vector<double> > &sample) override;
             size_t overhead_send(void) const override;
+            size_t overhead_save(void) const override;
         private:
             int num_level_controlled(const std::vector<int> &coords);
             std::vector<std::shared_ptr<TreeCommLevel> > init_level(
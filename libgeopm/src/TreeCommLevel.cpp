@@ -7,13 +7,34 @@
 
 #include <string.h>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
+#include <atomic>
 
 #include "Comm.hpp"
+#include "geopm/Environment.hpp"
 #include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
 
 namespace geopm
 {
+    std::unique_ptr<TreeCommLevel> TreeCommLevel::make_unique(std::shared_ptr<Comm> comm,
+                                                              int num_send_up,
+                                                              int num_send_down)
+    {
+        std::string tree_comm = environment().tree_comm();
+        if (tree_comm.empty() || tree_comm == "lock") {
+            return geopm::make_unique<TreeCommLevelImp>(comm, num_send_up, num_send_down);
+        }
+        else if (tree_comm == "mailbox") {
+            return geopm::make_unique<MailboxTreeCommLevel>(comm, num_send_up, num_send_down);
+        }
+        else {
+            throw Exception("TreeCommLevel::make_unique(): Unknown GEOPM_TREE_COMM: " + tree_comm,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
     TreeCommLevelImp::TreeCommLevelImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down)
         : m_comm(comm)
         , m_size(comm->num_rank())
@@ -23,6 +44,8 @@ namespace geopm
         , m_sample_window(0)
         , m_policy_window(0)
         , m_overhead_send(0)
+        , m_overhead_save(0)
+        , m_num_unchanged(0)
         , m_num_send_up(num_send_up)
         , m_num_send_down(num_send_down)
     {
@@ -62,11 +85,25 @@ namespace geopm
         double is_ready = 1.0;
         if (m_rank) {
             size_t base_off = m_rank * (msg_size + sizeof(double));
+            // A sample with a NAN never compares equal, so it is
+            // always sent with its values
+            bool is_unchanged = sample == m_sample_last &&
+                                m_num_unchanged < M_MAX_NUM_UNCHANGED;
             m_comm->window_lock(m_sample_window, true, 0, 0);
             m_comm->window_put(&is_ready, sizeof(double), 0, base_off, m_sample_window);
-            m_comm->window_put(sample.data(), msg_size, 0, base_off + sizeof(double), m_sample_window);
+            if (is_unchanged) {
+                // The parent's mailbox still holds the values
+                ++m_num_unchanged;
+                m_overhead_save += msg_size;
+            }
+            else {
+                m_comm->window_put(sample.data(), msg_size, 0, base_off + sizeof(double), m_sample_window);
+                m_sample_last = sample;
+                m_num_unchanged = 0;
+                m_overhead_send += msg_size;
+            }
             m_comm->window_unlock(m_sample_window, 0);
-            m_overhead_send += sizeof(double) + msg_size;
+            m_overhead_send += sizeof(double);
         }
         else {
             m_sample_mailbox[0] = 1.0;
@@ -179,6 +216,11 @@ namespace geopm
         return m_overhead_send;
     }
 
+    size_t TreeCommLevelImp::overhead_save(void) const
+    {
+        return m_overhead_save;
+    }
+
     void TreeCommLevelImp::create_window()
     {
         // Create policy window
@@ -203,4 +245,249 @@ namespace geopm
             m_sample_window = m_comm->window_create(0, NULL);
         }
     }
+
+    MailboxTreeCommLevel::MailboxTreeCommLevel(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down)
+        : m_comm(comm)
+        , m_size(comm->num_rank())
+        , m_rank(comm->rank())
+        , m_sample_mailbox(nullptr)
+        , m_policy_mailbox(nullptr)
+        , m_sample_window(0)
+        , m_policy_window(0)
+        , m_overhead_send(0)
+        , m_overhead_save(0)
+        , m_num_unchanged(0)
+        , m_num_send_up(num_send_up)
+        , m_num_send_down(num_send_down)
+        , m_sample_sequence(0.0)
+        , m_policy_buffer(num_send_down)
+    {
+        if (!m_rank) {
+            m_policy_last.resize(m_size, std::vector<double>(num_send_down, NAN));
+            m_policy_sequence.resize(m_size, 0.0);
+            m_sample_sequence_last.resize(m_size, 0.0);
+            m_sample_sequence_buffer.resize(m_size, 0.0);
+            m_sample_buffer.resize(m_size, std::vector<double>(num_send_up));
+        }
+        create_window();
+        m_comm->window_lock_all(m_sample_window);
+        m_comm->window_lock_all(m_policy_window);
+    }
+
+    MailboxTreeCommLevel::~MailboxTreeCommLevel()
+    {
+        m_comm->barrier();
+        m_comm->window_unlock_all(m_policy_window);
+        m_comm->window_unlock_all(m_sample_window);
+        // Destroy sample window
+        m_comm->window_destroy(m_sample_window);
+        if (m_sample_mailbox) {
+            m_comm->free_mem(m_sample_mailbox);
+        }
+        // Destroy policy window
+        m_comm->window_destroy(m_policy_window);
+        if (m_policy_mailbox) {
+            m_comm->free_mem(m_policy_mailbox);
+        }
+    }
+
+    int MailboxTreeCommLevel::level_rank(void) const
+    {
+        return m_rank;
+    }
+
+    void MailboxTreeCommLevel::put_message(size_t window_id, int rank, off_t offset,
+                                           const std::vector<double> &message, double &sequence)
+    {
+        // The accumulate ordering of the window only applies to
+        // operations on overlapping locations, and the message does
+        // not overlap the sequence number.  Each write is flushed
+        // before the next one is issued so that the receiver sees the
+        // odd sequence number before any part of the message changes,
+        // and sees the even sequence number only after the whole
+        // message is written.
+        double sequence_begin = sequence + 1.0;
+        sequence += 2.0;
+        m_comm->window_replace(&sequence_begin, 1, rank, offset, window_id);
+        m_comm->window_flush(window_id, rank);
+        m_comm->window_replace(message.data(), message.size(),
+                               rank, offset + sizeof(double), window_id);
+        m_comm->window_flush(window_id, rank);
+        m_comm->window_replace(&sequence, 1, rank, offset, window_id);
+        m_comm->window_flush(window_id, rank);
+        m_overhead_send += sizeof(double) * (message.size() + 2);
+    }
+
+    void MailboxTreeCommLevel::write_message(double *mailbox, const std::vector<double> &message)
+    {
+        volatile double *sequence = mailbox;
+        *sequence = *sequence + 1.0;
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(mailbox + 1, message.data(), sizeof(double) * message.size());
+        std::atomic_thread_fence(std::memory_order_release);
+        *sequence = *sequence + 1.0;
+    }
+
+    double MailboxTreeCommLevel::read_message(const double *mailbox, double sequence_last,
+                                              std::vector<double> &message)
+    {
+        const volatile double *sequence = mailbox;
+        double result = *sequence;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (result == sequence_last || ((uint64_t)result & 1) != 0) {
+            return 0.0;
+        }
+        memcpy(message.data(), mailbox + 1, sizeof(double) * message.size());
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (*sequence != result) {
+            result = 0.0;
+        }
+        return result;
+    }
+
+    void MailboxTreeCommLevel::send_up(const std::vector<double> &sample)
+    {
+        if (sample.size() != m_num_send_up) {
+            throw Exception("MailboxTreeCommLevel::send_up(): sample vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_rank) {
+            off_t offset = m_rank * (m_num_send_up + 1) * sizeof(double);
+            if (sample == m_sample_last && m_num_unchanged < M_MAX_NUM_UNCHANGED) {
+                // The values in the parent's mailbox do not change, so
+                // the new sequence number is written in a single step
+                m_sample_sequence += 2.0;
+                m_comm->window_replace(&m_sample_sequence, 1, 0, offset, m_sample_window);
+                m_comm->window_flush(m_sample_window, 0);
+                ++m_num_unchanged;
+                m_overhead_send += sizeof(double);
+                m_overhead_save += sizeof(double) * (m_num_send_up + 1);
+            }
+            else {
+                put_message(m_sample_window, 0, offset, sample, m_sample_sequence);
+                m_sample_last = sample;
+                m_num_unchanged = 0;
+            }
+        }
+        else {
+            write_message(m_sample_mailbox, sample);
+        }
+    }
+
+    void MailboxTreeCommLevel::send_down(const std::vector<std::vector<double> > &policy)
+    {
+#ifdef GEOPM_DEBUG
+        if (m_rank != 0) {
+            throw Exception("MailboxTreeCommLevel::send_down() called from rank not at root of level",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        size_t num_down = m_num_send_down;
+        if (m_size != (int)policy.size() ||
+            std::any_of(policy.begin(), policy.end(),
+                        [num_down](const std::vector<double> &it)
+                        {return it.size() != num_down;})) {
+            throw Exception("MailboxTreeCommLevel::send_down(): policy vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        write_message(m_policy_mailbox, policy[0]);
+        for (int child_rank = 1; child_rank != m_size; ++child_rank) {
+            if (policy[child_rank] != m_policy_last[child_rank]) {
+                put_message(m_policy_window, child_rank, 0, policy[child_rank],
+                            m_policy_sequence[child_rank]);
+                m_policy_last[child_rank] = policy[child_rank];
+            }
+        }
+    }
+
+    bool MailboxTreeCommLevel::receive_up(std::vector<std::vector<double> > &sample)
+    {
+#ifdef GEOPM_DEBUG
+        if (m_rank != 0) {
+            throw Exception("MailboxTreeCommLevel::receive_up(): Only zero rank of the level can call receive_up()",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        size_t num_up = m_num_send_up;
+        if (m_size != (int)sample.size() ||
+            std::any_of(sample.begin(), sample.end(),
+                        [num_up](const std::vector<double> &it)
+                        {return it.size() != num_up;})) {
+            throw Exception("MailboxTreeCommLevel::receive_up(): sample vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_comm->window_sync(m_sample_window);
+        bool is_complete = true;
+        for (int child_rank = 0; is_complete && child_rank != m_size; ++child_rank) {
+            m_sample_sequence_buffer[child_rank] =
+                read_message(m_sample_mailbox + child_rank * (m_num_send_up + 1),
+                             m_sample_sequence_last[child_rank],
+                             m_sample_buffer[child_rank]);
+            is_complete = m_sample_sequence_buffer[child_rank] != 0.0;
+        }
+        is_complete = is_complete &&
+                      std::none_of(m_sample_buffer.begin(), m_sample_buffer.end(),
+                                   [](const std::vector<double> &vec)
+                                   {
+                                       return std::any_of(vec.begin(), vec.end(),
+                                                          [](double val){return std::isnan(val);});
+                                   });
+        if (is_complete) {
+            // Only consume the messages once every child has sent one
+            m_sample_sequence_last = m_sample_sequence_buffer;
+            for (int child_rank = 0; child_rank != m_size; ++child_rank) {
+                std::copy(m_sample_buffer[child_rank].begin(),
+                          m_sample_buffer[child_rank].end(),
+                          sample[child_rank].begin());
+            }
+        }
+        return is_complete;
+    }
+
+    bool MailboxTreeCommLevel::receive_down(std::vector<double> &policy)
+    {
+        m_comm->window_sync(m_policy_window);
+        // The latest policy is returned on every call once one has
+        // been received, so no message is ever considered old.
+        bool is_complete = read_message(m_policy_mailbox, 0.0, m_policy_buffer) != 0.0 &&
+                           std::none_of(m_policy_buffer.begin(), m_policy_buffer.end(),
+                                        [](double val){return std::isnan(val);});
+        if (is_complete) {
+            policy = m_policy_buffer;
+        }
+        return is_complete;
+    }
+
+    size_t MailboxTreeCommLevel::overhead_send(void) const
+    {
+        return m_overhead_send;
+    }
+
+    size_t MailboxTreeCommLevel::overhead_save(void) const
+    {
+        return m_overhead_save;
+    }
+
+    void MailboxTreeCommLevel::create_window(void)
+    {
+        // Each mailbox is the sequence number followed by the message
+        size_t mem_size = sizeof(double) * (m_num_send_down + 1);
+        m_comm->alloc_mem(mem_size, (void **)(&m_policy_mailbox));
+        memset(m_policy_mailbox, 0, mem_size);
+        if (m_rank) {
+            m_policy_window = m_comm->window_create(mem_size, (void *)(m_policy_mailbox));
+        }
+        else {
+            m_policy_window = m_comm->window_create(0, NULL);
+        }
+        mem_size = sizeof(double) * m_size * (m_num_send_up + 1);
+        m_comm->alloc_mem(mem_size, (void **)(&m_sample_mailbox));
+        memset(m_sample_mailbox, 0, mem_size);
+        if (!m_rank) {
+            m_sample_window = m_comm->window_create(mem_size, (void *)(m_sample_mailbox));
+        }
+        else {
+            m_sample_window = m_comm->window_create(0, NULL);
+        }
+    }
 }
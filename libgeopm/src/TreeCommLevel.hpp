@@ -6,11 +6,15 @@
 #ifndef TREECOMMLEVEL_HPP_INCLUDE
 #define TREECOMMLEVEL_HPP_INCLUDE
 
+#include <sys/types.h>
+
 #include <vector>
 #include <memory>
 
 namespace geopm
 {
+    class Comm;
+
     class TreeCommLevel
     {
         public:
@@ -29,10 +33,26 @@ namespace geopm
             /// @brief Returns the total number of bytes sent at this
             ///        level.
             virtual size_t overhead_send(void) const = 0;
+            /// @brief Returns the number of bytes that were not sent
+            ///        at this level because a sample was the same as
+            ///        the last one sent.
+            virtual size_t overhead_save(void) const = 0;
+            /// @brief Number of unchanged samples in a row that are
+            ///        sent up without their values before the values
+            ///        are sent again.
+            static constexpr int M_MAX_NUM_UNCHANGED = 100;
+            /// @brief Create the TreeCommLevel selected by the
+            ///        GEOPM_TREE_COMM environment variable: "lock"
+            ///        (the default) or "mailbox".
+            /// @param [in] comm Communicator for the ranks of the
+            ///        level, rank zero is the parent.
+            /// @param [in] num_send_up Number of values in each sample.
+            /// @param [in] num_send_down Number of values in each policy.
+            static std::unique_ptr<TreeCommLevel> make_unique(std::shared_ptr<Comm> comm,
+                                                              int num_send_up,
+                                                              int num_send_down);
     };
 
-    class Comm;
-
     class TreeCommLevelImp : public TreeCommLevel
     {
         public:
@@ -46,6 +66,7 @@ namespace geopm
             bool receive_up(std::vector<std::vector<double> > &sample) override;
             bool receive_down(std::vector<double> &policy) override;
             size_t overhead_send(void) const override;
+            size_t overhead_save(void) const override;
         private:
             void create_window();
             std::shared_ptr<Comm> m_comm;
@@ -56,9 +77,91 @@ namespace geopm
             size_t m_sample_window;
             size_t m_policy_window;
             size_t m_overhead_send;
+            size_t m_overhead_save;
+            std::vector<std::vector<double> > m_policy_last;
+            std::vector<double> m_sample_last;
+            int m_num_unchanged;
+            size_t m_num_send_up;
+            size_t m_num_send_down;
+    };
+
+    /// @brief TreeCommLevel that passes each message through a
+    ///        mailbox with a sequence number instead of locking the
+    ///        window for every message.
+    ///
+    /// Both windows are locked on all ranks with window_lock_all()
+    /// for the lifetime of the object.  The sender marks the mailbox
+    /// as busy by writing an odd sequence number, writes the message,
+    /// and then writes the next even sequence number, completing each
+    /// step with window_flush().  The receiver reads its local memory
+    /// and accepts a message if the sequence number is even, is new,
+    /// and has not changed while the message was copied.  Neither
+    /// side ever waits for a lock held by another rank.  A sample that
+    /// is the same as the last one sent is sent as the next even
+    /// sequence number alone, and the parent reads the values that
+    /// are still in its mailbox.
+    class MailboxTreeCommLevel : public TreeCommLevel
+    {
+        public:
+            MailboxTreeCommLevel(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down);
+            MailboxTreeCommLevel(const MailboxTreeCommLevel &other) = delete;
+            MailboxTreeCommLevel &operator=(const MailboxTreeCommLevel &other) = delete;
+            virtual ~MailboxTreeCommLevel();
+            int level_rank(void) const override;
+            void send_up(const std::vector<double> &sample) override;
+            void send_down(const std::vector<std::vector<double> > &policy) override;
+            bool receive_up(std::vector<std::vector<double> > &sample) override;
+            bool receive_down(std::vector<double> &policy) override;
+            size_t overhead_send(void) const override;
+            size_t overhead_save(void) const override;
+        private:
+            void create_window(void);
+            /// @brief Write a message into the mailbox of another
+            ///        rank.
+            /// @param [in, out] sequence Sequence number of the last
+            ///        message sent to the mailbox, advanced by two.
+            void put_message(size_t window_id, int rank, off_t offset,
+                             const std::vector<double> &message, double &sequence);
+            /// @brief Write a message into a mailbox in local memory.
+            static void write_message(double *mailbox, const std::vector<double> &message);
+            /// @brief Copy a new message out of a mailbox in local
+            ///        memory.
+            /// @param [in] sequence_last Sequence number of the last
+            ///        message read from the mailbox.
+            /// @return Sequence number of the message that was
+            ///         copied, or zero if there is no complete new
+            ///         message.
+            static double read_message(const double *mailbox, double sequence_last,
+                                       std::vector<double> &message);
+            std::shared_ptr<Comm> m_comm;
+            int m_size;
+            int m_rank;
+            double *m_sample_mailbox;
+            double *m_policy_mailbox;
+            size_t m_sample_window;
+            size_t m_policy_window;
+            size_t m_overhead_send;
+            size_t m_overhead_save;
             std::vector<std::vector<double> > m_policy_last;
+            /// @brief Last sample sent with its values and the number
+            ///        of unchanged samples sent since
+            std::vector<double> m_sample_last;
+            int m_num_unchanged;
             size_t m_num_send_up;
             size_t m_num_send_down;
+            /// @brief Sequence number of the last sample sent
+            double m_sample_sequence;
+            /// @brief Sequence number of the last sample received from
+            ///        each child
+            std::vector<double> m_sample_sequence_last;
+            /// @brief Sequence number of the last policy sent to each
+            ///        child
+            std::vector<double> m_policy_sequence;
+            /// @brief Samples copied out of the mailboxes before all
+            ///        of them are known to be complete
+            std::vector<std::vector<double> > m_sample_buffer;
+            std::vector<double> m_sample_sequence_buffer;
+            std::vector<double> m_policy_buffer;
     };
 }
 
@@ -6,9 +6,15 @@
 
 #include "geopm/Waiter.hpp"
 
+#include <sys/timerfd.h>
 #include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
 
 #include "geopm/Exception.hpp"
+#include "geopm/Environment.hpp"
 #include "geopm_time.h"
 
 
@@ -16,15 +22,33 @@ namespace geopm
 {
     std::unique_ptr<Waiter> Waiter::make_unique(double period)
     {
-        return Waiter::make_unique(period, "sleep");
+        std::string strategy = environment().wait_strategy();
+        if (strategy.empty()) {
+            strategy = "sleep";
+        }
+        return Waiter::make_unique(period, strategy,
+                                   environment().wait_slack(HybridWaiter::M_DEFAULT_SLACK));
     }
 
     std::unique_ptr<Waiter> Waiter::make_unique(double period,
                                                 std::string strategy)
+    {
+        return Waiter::make_unique(period, strategy, HybridWaiter::M_DEFAULT_SLACK);
+    }
+
+    std::unique_ptr<Waiter> Waiter::make_unique(double period,
+                                                std::string strategy,
+                                                double slack)
     {
         if (strategy == "sleep") {
             return std::make_unique<SleepWaiter>(period);
         }
+        else if (strategy == "timer") {
+            return std::make_unique<TimerWaiter>(period);
+        }
+        else if (strategy == "hybrid") {
+            return std::make_unique<HybridWaiter>(period, slack);
+        }
         else {
             throw Exception("Waiter::make_unique(): Unknown strategy: " + strategy,
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -74,4 +98,124 @@ namespace geopm
     {
         return m_period;
     }
+
+    TimerWaiter::TimerWaiter(double period)
+        : m_period(period)
+        , m_time_target({{0, 0}})
+        , m_is_first_time(true)
+        , m_timer_fd(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC))
+    {
+        if (m_timer_fd == -1) {
+            throw Exception("TimerWaiter::TimerWaiter(): timerfd_create() failed",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    TimerWaiter::~TimerWaiter()
+    {
+        close(m_timer_fd);
+    }
+
+    void TimerWaiter::reset(void)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &(m_time_target.t));
+        geopm_time_add(&m_time_target, m_period, &m_time_target);
+    }
+
+    void TimerWaiter::reset(double period)
+    {
+        m_period = period;
+        reset();
+    }
+
+    void TimerWaiter::wait(void)
+    {
+        if (m_is_first_time) {
+            reset();
+            m_is_first_time = false;
+        }
+        struct itimerspec deadline = {{0, 0}, m_time_target.t};
+        if (timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &deadline, nullptr) == -1) {
+            throw Exception("TimerWaiter::wait(): timerfd_settime() failed",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // The read returns the number of expirations once the
+        // deadline has passed, immediately if it is already past.
+        uint64_t num_expire = 0;
+        ssize_t num_read = 0;
+        do {
+            num_read = read(m_timer_fd, &num_expire, sizeof(num_expire));
+        } while (num_read == -1 && errno == EINTR);
+
+        if (num_read != sizeof(num_expire)) {
+            throw Exception("TimerWaiter::wait(): read() of timerfd failed",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        geopm_time_add(&m_time_target, m_period, &m_time_target);
+    }
+
+    double TimerWaiter::period(void) const
+    {
+        return m_period;
+    }
+
+    HybridWaiter::HybridWaiter(double period)
+        : HybridWaiter(period, M_DEFAULT_SLACK)
+    {
+
+    }
+
+    HybridWaiter::HybridWaiter(double period, double slack)
+        : m_period(period)
+        , m_slack(slack)
+        , m_time_target({{0, 0}})
+        , m_is_first_time(true)
+    {
+        if (!(m_slack >= 0.0)) {
+            throw Exception("HybridWaiter::HybridWaiter(): slack must be non-negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void HybridWaiter::reset(void)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &(m_time_target.t));
+        geopm_time_add(&m_time_target, m_period, &m_time_target);
+    }
+
+    void HybridWaiter::reset(double period)
+    {
+        m_period = period;
+        reset();
+    }
+
+    void HybridWaiter::wait(void)
+    {
+        if (m_is_first_time) {
+            reset();
+            m_is_first_time = false;
+        }
+        geopm_time_s sleep_target;
+        geopm_time_add(&m_time_target, -m_slack, &sleep_target);
+        int err = 0;
+        do {
+            err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                  &(sleep_target.t), nullptr);
+        } while(err == EINTR);
+
+        if (err != 0) {
+            throw Exception("HybridWaiter::wait(): Failed with error: ",
+                            err, __FILE__, __LINE__);
+        }
+        geopm_time_s curr_time;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &(curr_time.t));
+        } while (geopm_time_comp(&curr_time, &m_time_target));
+        geopm_time_add(&m_time_target, m_period, &m_time_target);
+    }
+
+    double HybridWaiter::period(void) const
+    {
+        return m_period;
+    }
 }
@@ -8,6 +8,7 @@
 #include "geopm_test.hpp"
 
 #include "geopm_time.h"
+#include "geopm/Helper.hpp"
 #include "ApplicationRecordLog.hpp"
 #include "record.hpp"
 #include "MockSharedMemory.hpp"
@@ -69,40 +70,87 @@ TEST_F(ApplicationRecordLogTest, empty_dump)
     std::vector<record_s> records;
     std::vector<short_region_s> short_regions;
     EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
-        .Times(1);
+        .Times(0);
     m_record_log->dump(records, short_regions);
     EXPECT_EQ(0ULL, records.size());
     EXPECT_EQ(0ULL, short_regions.size());
 }
 
-TEST_F(ApplicationRecordLogTest, scoped_lock_test)
+TEST_F(ApplicationRecordLogTest, lock_free)
 {
     uint64_t hash = 0x1234abcd;
     geopm_time_s time = {{2, 0}};
+    std::vector<record_s> records;
+    std::vector<short_region_s> short_regions;
 
-    {
-        EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
-            .Times(1);
-        m_record_log->enter(hash, time);
-    }
-    {
-        EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
-            .Times(1);
-        m_record_log->exit(hash, time);
-    }
-    {
-        EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
-            .Times(1);
-        m_record_log->epoch(time);
-    }
-    {
-        std::vector<record_s> records;
-        std::vector<short_region_s> short_regions;
-        EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
-            .Times(1);
-        m_record_log->dump(records, short_regions);
-    }
+    EXPECT_CALL(*m_mock_shared_memory, get_scoped_lock())
+        .Times(0);
+    m_record_log->enter(hash, time);
+    m_record_log->exit(hash, time);
+    m_record_log->epoch(time);
+    m_record_log->dump(records, short_regions);
+}
+
+TEST_F(ApplicationRecordLogTest, producer_consumer)
+{
+    // Separate objects for the Profile and the ApplicationSampler
+    // sides mapping the same shared memory.
+    std::unique_ptr<ApplicationRecordLog> consumer =
+        geopm::make_unique<ApplicationRecordLogImp>(m_mock_shared_memory, M_PROC_ID, m_scheduler);
+    std::vector<record_s> records;
+    std::vector<short_region_s> short_regions;
+    uint64_t hash = 0xABCD;
+
+    m_record_log->enter(hash, {{2, 0}});
+    m_record_log->exit(hash, {{3, 0}});
+    consumer->dump(records, short_regions);
+    ASSERT_EQ(1ULL, records.size());
+    EXPECT_EQ(geopm::EVENT_SHORT_REGION, records[0].event);
+    ASSERT_EQ(1ULL, short_regions.size());
+    EXPECT_EQ(1, short_regions[0].num_complete);
 
+    // Two dumps without any producer activity in between
+    consumer->dump(records, short_regions);
+    EXPECT_EQ(0ULL, records.size());
+    consumer->dump(records, short_regions);
+    EXPECT_EQ(0ULL, records.size());
+
+    // The producer must notice the dumps even though the active
+    // buffer index is unchanged: the exit is not a short region.
+    m_record_log->enter(hash, {{4, 0}});
+    consumer->dump(records, short_regions);
+    ASSERT_EQ(1ULL, records.size());
+    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, records[0].event);
+    consumer->dump(records, short_regions);
+    m_record_log->exit(hash, {{5, 0}});
+    consumer->dump(records, short_regions);
+    ASSERT_EQ(1ULL, records.size());
+    EXPECT_EQ(geopm::EVENT_REGION_EXIT, records[0].event);
+    EXPECT_EQ(0ULL, short_regions.size());
+}
+
+TEST_F(ApplicationRecordLogTest, capacity)
+{
+    EXPECT_EQ(ApplicationRecordLog::buffer_size(),
+              ApplicationRecordLog::buffer_size(ApplicationRecordLog::max_record()));
+    EXPECT_EQ((int)ApplicationRecordLog::max_record(),
+              ApplicationRecordLog::max_record(ApplicationRecordLog::buffer_size()));
+    EXPECT_EQ(4096, ApplicationRecordLog::max_record(ApplicationRecordLog::buffer_size(4096)));
+    EXPECT_EQ(4096, ApplicationRecordLog::max_record(ApplicationRecordLog::buffer_size(4097) - 1));
+
+    std::vector<record_s> records;
+    std::vector<short_region_s> short_regions;
+    int max_size = 4096;
+    auto shmem = std::make_shared<MockSharedMemory>(ApplicationRecordLog::buffer_size(max_size));
+    ApplicationRecordLogImp record_log(shmem, M_PROC_ID, m_scheduler);
+    for (int ii = 0; ii < max_size; ++ii) {
+        record_log.epoch({{ii, 0}});
+    }
+    EXPECT_EQ(0ULL, record_log.num_overflow());
+    record_log.epoch({{max_size, 0}});
+    EXPECT_EQ(1ULL, record_log.num_overflow());
+    record_log.dump(records, short_regions);
+    EXPECT_EQ((size_t)max_size, records.size());
 }
 
 TEST_F(ApplicationRecordLogTest, one_entry)
@@ -272,8 +320,21 @@ TEST_F(ApplicationRecordLogTest, overflow_record_table)
     for (int ii = 0; ii < max_size; ++ii) {
         m_record_log->epoch({ii, 0});
     }
-    GEOPM_EXPECT_THROW_MESSAGE(m_record_log->epoch({max_size, 0}),
-                               GEOPM_ERROR_RUNTIME, "maximum number of records reached");
+    EXPECT_EQ(0ULL, m_record_log->num_overflow());
+    m_record_log->epoch({max_size, 0});
+    m_record_log->epoch({max_size + 1, 0});
+    EXPECT_EQ(2ULL, m_record_log->num_overflow());
+    m_record_log->dump(records, short_regions);
+    ASSERT_EQ((size_t)max_size, records.size());
+    EXPECT_EQ((uint64_t)max_size, records.back().signal);
+
+    // Space is available again after the dump; the overflow count
+    // is cumulative.
+    m_record_log->epoch({max_size + 2, 0});
+    m_record_log->dump(records, short_regions);
+    ASSERT_EQ(1ULL, records.size());
+    EXPECT_EQ((uint64_t)max_size + 3, records[0].signal);
+    EXPECT_EQ(2ULL, m_record_log->num_overflow());
 }
 
 TEST_F(ApplicationRecordLogTest, cannot_overflow_region_table)
@@ -293,6 +354,18 @@ TEST_F(ApplicationRecordLogTest, cannot_overflow_region_table)
         m_record_log->enter(hash+ii, {6+ii, 0});
         m_record_log->exit(hash+ii, {6+ii, 0});
     }
-    GEOPM_EXPECT_THROW_MESSAGE(m_record_log->enter(hash+max_size, {6+max_size, 0}),
-                               GEOPM_ERROR_RUNTIME, "maximum number of records reached");
+    EXPECT_EQ(0ULL, m_record_log->num_overflow());
+    // Dropped entry is followed by a dropped exit
+    m_record_log->enter(hash+max_size, {6+max_size, 0});
+    m_record_log->exit(hash+max_size, {7+max_size, 0});
+    EXPECT_EQ(2ULL, m_record_log->num_overflow());
+    // Short regions already in the table keep accumulating
+    m_record_log->enter(hash+1, {8+max_size, 0});
+    m_record_log->exit(hash+1, {9+max_size, 0});
+    EXPECT_EQ(2ULL, m_record_log->num_overflow());
+    m_record_log->dump(records, short_regions);
+    ASSERT_EQ((size_t)max_size, records.size());
+    ASSERT_EQ((size_t)max_size, short_regions.size());
+    EXPECT_EQ(hash+1, short_regions[1].hash);
+    EXPECT_EQ(2, short_regions[1].num_complete);
 }
@@ -530,6 +530,15 @@ TEST_F(ApplicationSamplerTest, cpu_progress)
     EXPECT_EQ(expected, m_app_sampler->cpu_progress(1));
 }
 
+TEST_F(ApplicationSamplerTest, record_log_overflow)
+{
+    EXPECT_CALL(*m_record_log_0, num_overflow())
+        .WillOnce(Return(3));
+    EXPECT_CALL(*m_record_log_1, num_overflow())
+        .WillOnce(Return(4));
+    EXPECT_EQ(7ULL, m_app_sampler->record_log_overflow());
+}
+
 TEST_F(ApplicationSamplerTest, sampler_cpu)
 {
     // The model for this test is a system with two cores and four
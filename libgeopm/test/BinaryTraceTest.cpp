@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+#include "geopm/Helper.hpp"
+#include "BinaryTrace.hpp"
+#include "CSV.hpp"
+#include "geopm_version.h"
+#include "geopm_field.h"
+
+using geopm::BinaryTraceImp;
+
+class BinaryTraceTest: public :: testing :: Test
+{
+    protected:
+        void SetUp(void);
+        // Parse a binary trace file written on a little-endian host
+        void parse(const std::string &path);
+        uint32_t read_uint32(void);
+        std::string read_string(void);
+        std::string m_host_name;
+        std::string m_start_time;
+        std::string m_data;
+        size_t m_offset;
+        std::string m_metadata;
+        std::vector<std::string> m_column_name;
+        std::vector<std::string> m_column_format;
+        std::vector<uint32_t> m_block_size;
+        // Values of each row
+        std::vector<std::vector<double> > m_row;
+};
+
+void BinaryTraceTest::SetUp(void)
+{
+    m_host_name = "binary-trace-test-host";
+    m_start_time = "Mon Jul  1 11:10:08 PDT 2019";
+    m_offset = 0;
+}
+
+uint32_t BinaryTraceTest::read_uint32(void)
+{
+    uint32_t result = 0;
+    EXPECT_LE(m_offset + sizeof(result), m_data.size());
+    memcpy(&result, m_data.data() + m_offset, sizeof(result));
+    m_offset += sizeof(result);
+    return result;
+}
+
+std::string BinaryTraceTest::read_string(void)
+{
+    uint32_t size = read_uint32();
+    std::string result = m_data.substr(m_offset, size);
+    m_offset += size;
+    return result;
+}
+
+void BinaryTraceTest::parse(const std::string &path)
+{
+    m_data = geopm::read_file(path);
+    m_offset = 8;
+    ASSERT_EQ(std::string(BinaryTraceImp::M_MAGIC), m_data.substr(0, m_offset));
+    EXPECT_EQ(BinaryTraceImp::M_VERSION, read_uint32());
+    uint32_t num_column = read_uint32();
+    m_metadata = read_string();
+    for (uint32_t col_idx = 0; col_idx != num_column; ++col_idx) {
+        m_column_name.push_back(read_string());
+        m_column_format.push_back(read_string());
+    }
+    while (m_offset < m_data.size()) {
+        uint32_t num_row = read_uint32();
+        m_block_size.push_back(num_row);
+        size_t row_begin = m_row.size();
+        m_row.resize(row_begin + num_row, std::vector<double>(num_column));
+        for (uint32_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            for (uint32_t row_idx = 0; row_idx != num_row; ++row_idx) {
+                ASSERT_LE(m_offset + sizeof(double), m_data.size());
+                memcpy(&m_row[row_begin + row_idx][col_idx],
+                       m_data.data() + m_offset, sizeof(double));
+                m_offset += sizeof(double);
+            }
+        }
+    }
+}
+
+TEST_F(BinaryTraceTest, header)
+{
+    std::string output_path = "BinaryTraceTest-header-output";
+    {
+        auto trace = geopm::make_unique<BinaryTraceImp>(output_path, m_host_name, m_start_time, 256);
+        trace->add_column("TIME");
+        trace->activate();
+    }
+    output_path += "-" + m_host_name;
+    parse(output_path);
+    std::vector<std::string> lines = geopm::string_split(m_metadata, "\n");
+    ASSERT_LE(5u, lines.size());
+    EXPECT_EQ("# geopm_version: " + std::string(geopm_version()), lines[0]);
+    EXPECT_EQ("# start_time: " + m_start_time, lines[1]);
+    EXPECT_TRUE(geopm::string_begins_with(lines[2], "# profile_name:"));
+    EXPECT_EQ("# node_name: " + m_host_name, lines[3]);
+    EXPECT_TRUE(geopm::string_begins_with(lines[4], "# agent:"));
+    EXPECT_EQ(std::vector<std::string>({"TIME"}), m_column_name);
+    EXPECT_EQ(std::vector<std::string>({"double"}), m_column_format);
+    EXPECT_EQ(0u, m_row.size());
+    unlink(output_path.c_str());
+}
+
+TEST_F(BinaryTraceTest, columns)
+{
+    std::string output_path = "BinaryTraceTest-columns-output";
+    std::vector<std::vector<double> > rows;
+    // Three rows fit in each block
+    size_t buffer_size = 3 * 9 * sizeof(double);
+    {
+        std::unique_ptr<geopm::CSV> trace = geopm::CSV::make_unique(output_path, "", m_start_time,
+                                                                    buffer_size, "binary", "block", "none");
+        trace->add_column("COLUMN_DOUBLE", "double");
+        trace->add_column("COLUMN_FLOAT", "float");
+        trace->add_column("COLUMN_INTEGER", "integer");
+        trace->add_column("COLUMN_HEX", "hex");
+        trace->add_column("COLUMN_RAW64", "raw64");
+        trace->add_column("COLUMN_DEFAULT");
+        trace->add_column("COLUMN_FUNCTION", geopm::string_format_hex);
+        trace->add_column("COLUMN_LAMBDA", [](double value) {return std::to_string(value);});
+        trace->add_column("COLUMN_EVENT", "event");
+        GEOPM_EXPECT_THROW_MESSAGE(trace->add_column("COLUMN_BAD", "bad"),
+                                   GEOPM_ERROR_INVALID, "format is unknown");
+        GEOPM_EXPECT_THROW_MESSAGE(trace->update({1.0}),
+                                   GEOPM_ERROR_INVALID, "activate() must be called prior to update");
+        trace->activate();
+        GEOPM_EXPECT_THROW_MESSAGE(trace->add_column("COLUMN_LATE"),
+                                   GEOPM_ERROR_INVALID, "cannot be called after activate()");
+        GEOPM_EXPECT_THROW_MESSAGE(trace->update({1.0}),
+                                   GEOPM_ERROR_INVALID, "Input vector incorrectly sized");
+        for (int row_idx = 0; row_idx != 7; ++row_idx) {
+            rows.push_back({0.25 * row_idx, 0.5, 1024.0 + row_idx, 32.0, geopm_field_to_signal(~0ULL),
+                            NAN, 3.0, -1.0 * row_idx, 2.0});
+            trace->update(rows.back());
+        }
+    }
+    parse(output_path);
+    EXPECT_EQ(std::vector<std::string>({"COLUMN_DOUBLE", "COLUMN_FLOAT", "COLUMN_INTEGER",
+                                        "COLUMN_HEX", "COLUMN_RAW64", "COLUMN_DEFAULT",
+                                        "COLUMN_FUNCTION", "COLUMN_LAMBDA", "COLUMN_EVENT"}),
+              m_column_name);
+    EXPECT_EQ(std::vector<std::string>({"double", "float", "integer", "hex", "raw64",
+                                        "double", "hex", "double", "event"}),
+              m_column_format);
+    EXPECT_EQ(std::vector<uint32_t>({3, 3, 1}), m_block_size);
+    ASSERT_EQ(rows.size(), m_row.size());
+    for (size_t row_idx = 0; row_idx != rows.size(); ++row_idx) {
+        for (size_t col_idx = 0; col_idx != rows[row_idx].size(); ++col_idx) {
+            EXPECT_EQ(geopm_signal_to_field(rows[row_idx][col_idx]),
+                      geopm_signal_to_field(m_row[row_idx][col_idx]));
+        }
+    }
+    unlink(output_path.c_str());
+}
+
+TEST_F(BinaryTraceTest, bad_format)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::CSV::make_unique("BinaryTraceTest-bad-format", "",
+                                                       m_start_time, 256, "json", "sync", "none"),
+                               GEOPM_ERROR_INVALID, "unknown trace format");
+}
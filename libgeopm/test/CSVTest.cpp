@@ -173,6 +173,33 @@ TEST_F(CSVTest, buffer)
     unlink(output_path.c_str());
 }
 
+TEST_F(CSVTest, format_function)
+{
+    std::string output_path = "CSVTest-format_function-output";
+    {
+        std::unique_ptr<geopm::CSV> csv =
+            geopm::make_unique<geopm::CSVImp>(output_path, "", m_start_time, m_buffer_size);
+        csv->add_column("CUSTOM_FIRST", [](double signal) {
+            return "<" + std::to_string((int)signal) + ">";
+        });
+        csv->add_column("DOUBLE", geopm::string_format_double);
+        csv->add_column("HEX", geopm::string_format_hex);
+        csv->add_column("CUSTOM_LAST", [](double signal) {
+            return std::string(signal > 0 ? "positive" : "other");
+        });
+        csv->activate();
+        csv->update({1.0, 0.1, 0xdeadbeef, 2.0});
+        csv->update({-3.0, 1.0 / 3.0, 16.0, -2.0});
+    }
+    std::vector<std::string> output_lines =
+        geopm::string_split(geopm::read_file(output_path), "\n");
+    ASSERT_EQ(9u, output_lines.size());
+    EXPECT_EQ("CUSTOM_FIRST|DOUBLE|HEX|CUSTOM_LAST", output_lines[5]);
+    EXPECT_EQ("<1>|0.1|0xdeadbeef|positive", output_lines[6]);
+    EXPECT_EQ("<-3>|0.3333333333333333|0x00000010|other", output_lines[7]);
+    unlink(output_path.c_str());
+}
+
 TEST_F(CSVTest, negative)
 {
     std::string output_path = "CSVTest-negative-output";
@@ -22,6 +22,7 @@ typedef int MPI_Win;
 
 #define MPI_MAX                 (MPI_Op)(0x58000001)
 #define MPI_LAND                (MPI_Op)(0x58000005)
+#define MPI_REPLACE             (MPI_Op)(0x5800000d)
 #define MPI_UNDEFINED           (-32766)
 #define MPI_COMM_WORLD          ((MPI_Comm)0x44000000)
 #define MPI_COMM_NULL           ((MPI_Comm)0x04000000)
@@ -285,6 +286,44 @@ extern "C"
 #define MPI_Win_unlock(p0, p1) mock_win_unlock(p0, p1)
 #define PMPI_Win_unlock(p0, p1) mock_win_unlock(p0, p1)
 
+    static int mock_win_lock_all(int param0, MPI_Win param1)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        memcpy(g_params[1], &param1, g_sizes[1]);
+        return 0;
+    }
+
+#define MPI_Win_lock_all(p0, p1) mock_win_lock_all(p0, p1)
+#define PMPI_Win_lock_all(p0, p1) mock_win_lock_all(p0, p1)
+
+    static int mock_win_unlock_all(MPI_Win param0)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        return 0;
+    }
+
+#define MPI_Win_unlock_all(p0) mock_win_unlock_all(p0)
+#define PMPI_Win_unlock_all(p0) mock_win_unlock_all(p0)
+
+    static int mock_win_flush(int param0, MPI_Win param1)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        memcpy(g_params[1], &param1, g_sizes[1]);
+        return 0;
+    }
+
+#define MPI_Win_flush(p0, p1) mock_win_flush(p0, p1)
+#define PMPI_Win_flush(p0, p1) mock_win_flush(p0, p1)
+
+    static int mock_win_sync(MPI_Win param0)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        return 0;
+    }
+
+#define MPI_Win_sync(p0) mock_win_sync(p0)
+#define PMPI_Win_sync(p0) mock_win_sync(p0)
+
     static int mock_put(const void *param0, int param1, MPI_Datatype param2, int param3, MPI_Aint param4,
             int param5, MPI_Datatype param6, MPI_Win param7)
     {
@@ -303,6 +342,25 @@ extern "C"
 #define MPI_Put(p0, p1, p2, p3, p4, p5, p6, p7) mock_put(p0, p1, p2, p3, p4, p5, p6, p7)
 #define PMPI_Put(p0, p1, p2, p3, p4, p5, p6, p7) mock_put(p0, p1, p2, p3, p4, p5, p6, p7)
 
+    static int mock_accumulate(const void *param0, int param1, MPI_Datatype param2, int param3, MPI_Aint param4,
+            int param5, MPI_Datatype param6, MPI_Op param7, MPI_Win param8)
+    {
+        size_t tmp0 = (size_t) param0;
+        memcpy(g_params[0], &tmp0, g_sizes[0]);
+        memcpy(g_params[1], &param1, g_sizes[1]);
+        memcpy(g_params[2], &param2, g_sizes[2]);
+        memcpy(g_params[3], &param3, g_sizes[3]);
+        memcpy(g_params[4], &param4, g_sizes[4]);
+        memcpy(g_params[5], &param5, g_sizes[5]);
+        memcpy(g_params[6], &param6, g_sizes[6]);
+        memcpy(g_params[7], &param7, g_sizes[7]);
+        memcpy(g_params[8], &param8, g_sizes[8]);
+        return 0;
+    }
+
+#define MPI_Accumulate(p0, p1, p2, p3, p4, p5, p6, p7, p8) mock_accumulate(p0, p1, p2, p3, p4, p5, p6, p7, p8)
+#define PMPI_Accumulate(p0, p1, p2, p3, p4, p5, p6, p7, p8) mock_accumulate(p0, p1, p2, p3, p4, p5, p6, p7, p8)
+
     static int mock_rank(MPI_Comm param0, int *param1)
     {
         memcpy(g_params[0], &param0, g_sizes[0]);
@@ -928,6 +986,47 @@ TEST_F(CommMPIImpTest, mpi_win_ops)
     reset();
     m_params.clear();
 
+    // replace
+    double replace_input[2] = {1.0, 2.0};
+    size_t replace_tmp = (size_t) replace_input;
+    int replace_count = 2;
+    MPI_Datatype replace_dt = MPI_DOUBLE;
+    MPI_Op replace_op = MPI_REPLACE;
+    g_sizes.push_back(sizeof(size_t));
+    g_params.push_back(malloc(g_sizes[0]));
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[1]));
+    g_sizes.push_back(sizeof(replace_dt));
+    g_params.push_back(malloc(g_sizes[2]));
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[3]));
+    g_sizes.push_back(sizeof(MPI_Aint));
+    g_params.push_back(malloc(g_sizes[4]));
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[5]));
+    g_sizes.push_back(sizeof(replace_dt));
+    g_params.push_back(malloc(g_sizes[6]));
+    g_sizes.push_back(sizeof(replace_op));
+    g_params.push_back(malloc(g_sizes[7]));
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[8]));
+
+    tmp_comm.window_replace(replace_input, replace_count, rank, disp, win_handle);
+
+    m_params.push_back(&replace_tmp);
+    m_params.push_back(&replace_count);
+    m_params.push_back(&replace_dt);
+    m_params.push_back(&rank);
+    m_params.push_back(&disp);
+    m_params.push_back(&replace_count);
+    m_params.push_back(&replace_dt);
+    m_params.push_back(&replace_op);
+    m_params.push_back(tmp_comm.get_win_ref(win_handle));
+
+    check_params();
+    reset();
+    m_params.clear();
+
     // unlock
     g_sizes.push_back(sizeof(int));
     g_params.push_back(malloc(g_sizes[0]));
@@ -943,6 +1042,61 @@ TEST_F(CommMPIImpTest, mpi_win_ops)
     reset();
     m_params.clear();
 
+    // lock all
+    int no_assert = 0;
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[0]));
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[1]));
+
+    m_params.push_back(&no_assert);
+    m_params.push_back((void *) tmp2);
+
+    tmp_comm.window_lock_all(win_handle);
+
+    check_params();
+    reset();
+    m_params.clear();
+
+    // flush
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[0]));
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[1]));
+
+    m_params.push_back(&rank);
+    m_params.push_back((void *) tmp2);
+
+    tmp_comm.window_flush(win_handle, rank);
+
+    check_params();
+    reset();
+    m_params.clear();
+
+    // sync
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[0]));
+
+    m_params.push_back((void *) tmp2);
+
+    tmp_comm.window_sync(win_handle);
+
+    check_params();
+    reset();
+    m_params.clear();
+
+    // unlock all
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[0]));
+
+    m_params.push_back((void *) tmp2);
+
+    tmp_comm.window_unlock_all(win_handle);
+
+    check_params();
+    reset();
+    m_params.clear();
+
     // win destroy
     g_sizes.push_back(sizeof(size_t));
     g_params.push_back(malloc(g_sizes[0]));
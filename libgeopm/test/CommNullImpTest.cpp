@@ -145,6 +145,31 @@ TEST_F(CommNullImpTest, window_lock)
     m_comm->free_mem(window);
 }
 
+TEST_F(CommNullImpTest, window_lock_all)
+{
+    static const unsigned int BUFFER_SIZE = 32;
+    void * window;
+
+    // Can't use a window that doesn't exist
+    EXPECT_THROW(m_comm->window_lock_all(1234), geopm::Exception);
+    EXPECT_THROW(m_comm->window_unlock_all(1234), geopm::Exception);
+    EXPECT_THROW(m_comm->window_flush(1234, 0), geopm::Exception);
+    EXPECT_THROW(m_comm->window_sync(1234), geopm::Exception);
+
+    m_comm->alloc_mem(BUFFER_SIZE, &window);
+    auto window_id = m_comm->window_create(BUFFER_SIZE, window);
+
+    // NullComm only works with 1 rank
+    EXPECT_THROW(m_comm->window_flush(window_id, 99 /* rank */), geopm::Exception);
+    m_comm->window_lock_all(window_id);
+    m_comm->window_flush(window_id, 0);
+    m_comm->window_sync(window_id);
+    m_comm->window_unlock_all(window_id);
+
+    m_comm->window_destroy(window_id);
+    m_comm->free_mem(window);
+}
+
 TEST_F(CommNullImpTest, coordinate)
 {
     std::vector<int> coordinate;
@@ -245,6 +270,29 @@ TEST_F(CommNullImpTest, window_put)
     m_comm->free_mem(window);
 }
 
+TEST_F(CommNullImpTest, window_replace)
+{
+    std::vector<double> senders = {1, 2};
+    static const unsigned int BUFFER_SIZE = senders.size() * sizeof senders[0];
+    void * window;
+
+    // Can't replace on a window that doesn't exist
+    EXPECT_THROW(m_comm->window_replace(senders.data(), senders.size(), 0, 0, 1234), geopm::Exception);
+
+    m_comm->alloc_mem(BUFFER_SIZE, &window);
+    auto window_id = m_comm->window_create(BUFFER_SIZE, window);
+
+    // NullComm only works with 1 rank
+    EXPECT_THROW(m_comm->window_replace(senders.data(), senders.size(), 123, 0, window_id), geopm::Exception);
+    // Can't write past the end of the window
+    EXPECT_THROW(m_comm->window_replace(senders.data(), senders.size(), 0, sizeof(double), window_id), geopm::Exception);
+
+    m_comm->window_replace(senders.data(), senders.size(), 0, 0, window_id);
+
+    m_comm->window_destroy(window_id);
+    m_comm->free_mem(window);
+}
+
 TEST_F(CommNullImpTest, tear_down)
 {
     // This is a no-op for NullComm
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+#include "geopm/Helper.hpp"
+#include "ControlLoop.hpp"
+
+using geopm::ControlLoop;
+using geopm::ControlLoopImp;
+
+class ControlLoopTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        std::unique_ptr<ControlLoopImp> make_loop(bool do_adapt);
+        /// @brief Run one iteration where each phase outside of
+        ///        wait takes busy_time / 5 and the wait takes
+        ///        wait_time.
+        bool iteration(ControlLoopImp &loop, double busy_time,
+                       double wait_time, bool is_active);
+        std::map<std::string, std::string> report(const ControlLoopImp &loop);
+        double m_time;
+};
+
+void ControlLoopTest::SetUp(void)
+{
+    m_time = 0.0;
+}
+
+std::unique_ptr<ControlLoopImp> ControlLoopTest::make_loop(bool do_adapt)
+{
+    return geopm::make_unique<ControlLoopImp>(do_adapt, [this](void) {
+        return m_time;
+    });
+}
+
+bool ControlLoopTest::iteration(ControlLoopImp &loop, double busy_time,
+                                double wait_time, bool is_active)
+{
+    loop.begin();
+    for (int phase : {ControlLoop::M_PHASE_COMM, ControlLoop::M_PHASE_AGENT,
+                      ControlLoop::M_PHASE_WRITE}) {
+        m_time += busy_time / 5;
+        loop.mark(phase);
+    }
+    m_time += wait_time;
+    loop.mark(ControlLoop::M_PHASE_WAIT);
+    for (int phase : {ControlLoop::M_PHASE_READ, ControlLoop::M_PHASE_TRACE}) {
+        m_time += busy_time / 5;
+        loop.mark(phase);
+    }
+    return loop.end(is_active);
+}
+
+std::map<std::string, std::string> ControlLoopTest::report(const ControlLoopImp &loop)
+{
+    std::map<std::string, std::string> result;
+    for (const auto &kv : loop.report()) {
+        result.insert(kv);
+    }
+    return result;
+}
+
+TEST_F(ControlLoopTest, phases)
+{
+    auto loop = make_loop(false);
+    loop->init(0.005, 0.0, 0.0);
+    loop->begin();
+    m_time += 3e-6;
+    loop->mark(ControlLoop::M_PHASE_COMM);
+    m_time += 1e-3;
+    loop->mark(ControlLoop::M_PHASE_AGENT);
+    m_time += 2e-6;
+    loop->mark(ControlLoop::M_PHASE_COMM);
+    m_time += 4e-3;
+    loop->mark(ControlLoop::M_PHASE_WAIT);
+    EXPECT_FALSE(loop->end(true));
+
+    auto fields = report(*loop);
+    EXPECT_EQ("1", fields.at("iterations"));
+    EXPECT_EQ("0", fields.at("overrun"));
+    EXPECT_EQ("0.005", fields.at("period (s)"));
+    EXPECT_EQ(0u, fields.count("period changes"));
+    EXPECT_EQ("5e-06", fields.at("comm (s)"));
+    EXPECT_EQ("5e-06", fields.at("comm max (s)"));
+    // The two comm phases are added before the histogram is updated
+    EXPECT_EQ("{8: 1}", fields.at("comm histogram (us)"));
+    EXPECT_EQ("{1024: 1}", fields.at("agent histogram (us)"));
+    EXPECT_EQ("{4096: 1}", fields.at("wait histogram (us)"));
+    EXPECT_EQ("{1: 1}", fields.at("read histogram (us)"));
+    EXPECT_EQ("0", fields.at("read (s)"));
+
+    // Longer than the histogram range
+    loop->begin();
+    m_time += 10.0;
+    loop->mark(ControlLoop::M_PHASE_READ);
+    EXPECT_FALSE(loop->end(true));
+    fields = report(*loop);
+    EXPECT_EQ("{1: 1, .inf: 1}", fields.at("read histogram (us)"));
+    EXPECT_EQ("10", fields.at("read max (s)"));
+    EXPECT_EQ("{1: 1, 8: 1}", fields.at("comm histogram (us)"));
+    EXPECT_EQ("1", fields.at("overrun"));
+}
+
+TEST_F(ControlLoopTest, overrun)
+{
+    auto loop = make_loop(false);
+    loop->init(0.01, 0.01, 0.1);
+    // Time in wait() does not count
+    EXPECT_FALSE(iteration(*loop, 0.005, 0.1, true));
+    EXPECT_EQ(0ULL, loop->num_overrun());
+    EXPECT_FALSE(iteration(*loop, 0.02, 0.0, true));
+    EXPECT_EQ(1ULL, loop->num_overrun());
+    // Not adapted without do_adapt
+    for (int idx = 0; idx != 20; ++idx) {
+        EXPECT_FALSE(iteration(*loop, 0.02, 0.0, false));
+    }
+    EXPECT_EQ(21ULL, loop->num_overrun());
+    EXPECT_EQ(0.01, loop->period());
+}
+
+TEST_F(ControlLoopTest, unknown_period)
+{
+    auto loop = make_loop(true);
+    EXPECT_TRUE(std::isnan(loop->period()));
+    EXPECT_FALSE(iteration(*loop, 1.0, 0.0, false));
+    loop->init(NAN, 0.0, 0.0);
+    for (int idx = 0; idx != 20; ++idx) {
+        EXPECT_FALSE(iteration(*loop, 1.0, 0.0, false));
+    }
+    EXPECT_EQ(0ULL, loop->num_overrun());
+    EXPECT_EQ("nan", report(*loop).at("period (s)"));
+    GEOPM_EXPECT_THROW_MESSAGE(loop->init(0.1, 0.2, 0.1), GEOPM_ERROR_INVALID,
+                               "minimum period is larger than maximum period");
+}
+
+TEST_F(ControlLoopTest, adapt_idle)
+{
+    auto loop = make_loop(true);
+    loop->init(0.1, 0.1, 0.5);
+    EXPECT_FALSE(iteration(*loop, 0.001, 0.1, true));
+    // The period is lengthened after ten idle iterations
+    for (int idx = 0; idx != 9; ++idx) {
+        EXPECT_FALSE(iteration(*loop, 0.001, 0.1, false));
+        EXPECT_EQ(0.1, loop->period());
+    }
+    EXPECT_TRUE(iteration(*loop, 0.001, 0.1, false));
+    EXPECT_EQ(0.2, loop->period());
+    EXPECT_TRUE(iteration(*loop, 0.001, 0.2, false));
+    EXPECT_EQ(0.4, loop->period());
+    EXPECT_TRUE(iteration(*loop, 0.001, 0.4, false));
+    EXPECT_EQ(0.5, loop->period());
+    EXPECT_FALSE(iteration(*loop, 0.001, 0.5, false));
+    EXPECT_EQ(0.5, loop->period());
+    // Activity returns to the shortest period at once
+    EXPECT_TRUE(iteration(*loop, 0.001, 0.5, true));
+    EXPECT_EQ(0.1, loop->period());
+    auto fields = report(*loop);
+    EXPECT_EQ("4", fields.at("period changes"));
+    EXPECT_EQ("0", fields.at("overrun"));
+}
+
+TEST_F(ControlLoopTest, adapt_cost)
+{
+    auto loop = make_loop(true);
+    loop->init(0.1, 0.1, 0.5);
+    // An overrun lengthens the period to twice the busy time
+    EXPECT_TRUE(iteration(*loop, 0.15, 0.0, true));
+    EXPECT_EQ(1ULL, loop->num_overrun());
+    EXPECT_NEAR(0.3, loop->period(), 1e-9);
+    // A cheap iteration returns to the minimum
+    EXPECT_TRUE(iteration(*loop, 0.001, 0.3, true));
+    EXPECT_EQ(0.1, loop->period());
+    // A sustained cost keeps the period long enough that at most half
+    // of it is spent outside of wait()
+    for (int idx = 0; idx != 100; ++idx) {
+        iteration(*loop, 0.08, loop->period() - 0.08, true);
+    }
+    EXPECT_NEAR(0.16, loop->period(), 1e-6);
+    EXPECT_EQ(1ULL, loop->num_overrun());
+    // Never longer than the maximum
+    EXPECT_TRUE(iteration(*loop, 2.0, 0.0, true));
+    EXPECT_EQ(0.5, loop->period());
+}
@@ -29,6 +29,7 @@
 #include "MockApplicationSampler.hpp"
 #include "MockProfileTracer.hpp"
 #include "MockInitControl.hpp"
+#include "MockControlLoop.hpp"
 
 using geopm::Controller;
 using geopm::PlatformIO;
@@ -147,6 +148,8 @@ class ControllerTest : public ::testing::Test
         std::string m_shm_key = "ControllerTest_shm_key";
 
         std::shared_ptr<MockInitControl> m_init_control;
+        std::unique_ptr<MockControlLoop> m_control_loop;
+        MockControlLoop *m_control_loop_ptr;
 };
 
 void ControllerTest::SetUp()
@@ -170,6 +173,8 @@ void ControllerTest::SetUp()
     m_policy_tracer_ptr = m_policy_tracer.get();
     m_profile_tracer = std::make_shared<MockProfileTracer>();
     m_init_control = std::make_shared<MockInitControl>();
+    m_control_loop = std::make_unique<NiceMock<MockControlLoop> >();
+    m_control_loop_ptr = m_control_loop.get();
 }
 
 void ControllerTest::TearDown()
@@ -224,7 +229,8 @@ TEST_F(ControllerTest, construct_with_file_policy_and_init_control)
                           {"A", "B"},
                           m_file_policy_path, true,
                           nullptr, "", false, // endpoint
-                          m_init_control, true);
+                          m_init_control, true,
+                          std::move(m_control_loop));
 }
 
 TEST_F(ControllerTest, run_with_no_policy)
@@ -259,7 +265,8 @@ TEST_F(ControllerTest, run_with_no_policy)
                           {"A", "B"},
                           "", false,  // false
                           nullptr, "", false, // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     std::vector<std::function<std::string(double)> > trace_formats = {
@@ -358,7 +365,8 @@ TEST_F(ControllerTest, get_hostnames)
                           {}, "", false, // file policy
                           std::move(m_endpoint),
                           "", true,  // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     EXPECT_CALL(*multi_node_comm, rank());
     std::set<std::string> result = controller.get_hostnames("node4");
@@ -393,7 +401,8 @@ TEST_F(ControllerTest, single_node)
                           {}, "", false,  // file policy
                           std::move(m_endpoint),
                           "", true,  // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     // setup trace
     std::vector<std::string> trace_names = {"COL1", "COL2"};
@@ -430,6 +439,16 @@ TEST_F(ControllerTest, single_node)
     // should not call aggregate_sample/split_policy
     EXPECT_CALL(*agent, aggregate_sample(_, _)).Times(0);
     EXPECT_CALL(*agent, split_policy(_, _)).Times(0);
+    // each step is timed, and the second step changes the period
+    EXPECT_CALL(*m_control_loop_ptr, begin()).Times(m_num_step);
+    EXPECT_CALL(*m_control_loop_ptr, mark(_)).Times(AtLeast(m_num_step));
+    EXPECT_CALL(*m_control_loop_ptr, mark(geopm::ControlLoop::M_PHASE_WAIT)).Times(m_num_step);
+    EXPECT_CALL(*m_control_loop_ptr, end(false)).Times(m_num_step)
+        .WillOnce(Return(false))
+        .WillOnce(Return(true))
+        .WillRepeatedly(Return(false));
+    EXPECT_CALL(*m_control_loop_ptr, period()).WillOnce(Return(0.4));
+    EXPECT_CALL(*agent, reset_wait_period(0.4));
 
     for (int step = 0; step < m_num_step; ++step) {
         controller.step();
@@ -475,7 +494,8 @@ TEST_F(ControllerTest, two_level_controller_1)
                           {}, "", false, // file policy
                           std::move(m_endpoint),
                           "", true,  // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     std::vector<std::function<std::string(double)> > trace_formats = {
@@ -569,7 +589,8 @@ TEST_F(ControllerTest, two_level_controller_2)
                           {}, "", false, // file policy
                           std::move(m_endpoint),
                           "", true, // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     std::vector<std::function<std::string(double)> > trace_formats = {
@@ -672,7 +693,8 @@ TEST_F(ControllerTest, two_level_controller_0)
                           {}, "", false, // file policy
                           std::move(m_endpoint),
                           "", true, // endpoint
-                          m_init_control, false);
+                          m_init_control, false,
+                          std::move(m_control_loop));
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
     std::vector<std::function<std::string(double)> > trace_formats = {
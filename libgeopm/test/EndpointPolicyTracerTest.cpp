@@ -38,7 +38,7 @@ TEST_F(EndpointPolicyTracerTest, construct_update_destruct)
     EXPECT_CALL(m_platform_io, sample(m_time_signal));
     // Test that the constructor and update methods do not throw
     std::unique_ptr<geopm::EndpointPolicyTracer> tracer =
-        geopm::make_unique<geopm::EndpointPolicyTracerImp>(2, true, m_path, m_platform_io, m_agent_policy);
+        geopm::make_unique<geopm::EndpointPolicyTracerImp>(2, true, m_path, "sync", "none", m_platform_io, m_agent_policy);
     std::vector<double> policy {77.7, 80.6, 44.5};
     tracer->update(policy);
     // Test that a file was created by deleting it without error
@@ -50,7 +50,7 @@ TEST_F(EndpointPolicyTracerTest, format)
 {
     EXPECT_CALL(m_platform_io, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
             .WillOnce(Return(m_time_signal));
-    geopm::EndpointPolicyTracerImp tracer(2, true, m_path, m_platform_io, m_agent_policy);
+    geopm::EndpointPolicyTracerImp tracer(2, true, m_path, "sync", "none", m_platform_io, m_agent_policy);
 
     for (int ii = 0; ii < 5; ++ii) {
         EXPECT_CALL(m_platform_io, sample(m_time_signal))
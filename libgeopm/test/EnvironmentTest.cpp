@@ -655,6 +655,33 @@ TEST_F(EnvironmentTest, init_control_unset)
     EXPECT_EQ("", m_env->init_control());
 }
 
+TEST_F(EnvironmentTest, wait_slack)
+{
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    EXPECT_EQ(100e-6, m_env->wait_slack(100e-6));
+    setenv("GEOPM_WAIT_SLACK", "0.0005", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    EXPECT_EQ(0.0005, m_env->wait_slack(100e-6));
+    setenv("GEOPM_WAIT_SLACK", "0", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    EXPECT_EQ(0.0, m_env->wait_slack(100e-6));
+
+    setenv("GEOPM_WAIT_SLACK", "slack", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    GEOPM_EXPECT_THROW_MESSAGE(m_env->wait_slack(100e-6), GEOPM_ERROR_INVALID,
+                               "could not be converted into a double");
+    setenv("GEOPM_WAIT_SLACK", "1e999", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "");
+    GEOPM_EXPECT_THROW_MESSAGE(m_env->wait_slack(100e-6), GEOPM_ERROR_INVALID,
+                               "out of range");
+    for (const std::string value : {"-1e-6", "nan", "inf"}) {
+        setenv("GEOPM_WAIT_SLACK", value.c_str(), 1);
+        m_env = geopm::make_unique<EnvironmentImp>("", "");
+        GEOPM_EXPECT_THROW_MESSAGE(m_env->wait_slack(100e-6), GEOPM_ERROR_INVALID,
+                                   "must be a finite non-negative number");
+    }
+}
+
 TEST_F(EnvironmentTest, signal_parser)
 {
     std::vector<std::pair<std::string, int> >& expected_signals = m_trace_signals;
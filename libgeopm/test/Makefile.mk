@@ -44,9 +44,11 @@ test_geopm_test_SOURCES = test/AccumulatorTest.cpp \
                           test/ApplicationRecordLogTest.cpp \
                           test/ApplicationSamplerTest.cpp \
                           test/ApplicationStatusTest.cpp \
+                          test/BinaryTraceTest.cpp \
                           test/CommMPIImpTest.cpp \
                           test/CommNullImpTest.cpp \
                           test/ControllerTest.cpp \
+                          test/ControlLoopTest.cpp \
                           test/CSVTest.cpp \
                           test/DebugIOGroupTest.cpp \
                           test/DenseLayerTest.cpp \
@@ -72,6 +74,7 @@ test_geopm_test_SOURCES = test/AccumulatorTest.cpp \
                           test/MockApplicationSampler.hpp \
                           test/MockApplicationStatus.hpp \
                           test/MockComm.hpp \
+                          test/MockControlLoop.hpp \
                           test/MockDenseLayer.hpp \
                           test/MockDomainNetMap.hpp \
                           test/MockEndpoint.hpp \
@@ -133,6 +136,7 @@ test_geopm_test_SOURCES = test/AccumulatorTest.cpp \
                           test/TensorTwoDIntegrationTest.cpp \
                           test/TensorTwoDMatcher.cpp \
                           test/TensorTwoDMatcher.hpp \
+                          test/TraceWriterTest.cpp \
                           test/TracerTest.cpp \
                           test/TreeCommLevelTest.cpp \
                           test/TreeCommTest.cpp \
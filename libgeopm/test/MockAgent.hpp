@@ -35,6 +35,9 @@ class MockAgent : public geopm::Agent
         MOCK_METHOD(void, sample_platform, (std::vector<double> & out_sample),
                     (override));
         MOCK_METHOD(void, wait, (), (override));
+        MOCK_METHOD(double, wait_period, (), (const, override));
+        MOCK_METHOD((std::pair<double, double>), wait_period_range, (), (const, override));
+        MOCK_METHOD(void, reset_wait_period, (double period), (override));
         MOCK_METHOD((std::vector<std::pair<std::string, std::string> >),
                     report_header, (), (const, override));
         MOCK_METHOD((std::vector<std::pair<std::string, std::string> >),
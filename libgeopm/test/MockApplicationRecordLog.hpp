@@ -25,6 +25,7 @@ class MockApplicationRecordLog : public geopm::ApplicationRecordLog
         MOCK_METHOD(void, start_profile, (const geopm_time_s &time, const std::string &profile_name), (override));
         MOCK_METHOD(void, stop_profile, (const geopm_time_s &time, const std::string &profile_name), (override));
         MOCK_METHOD(void, overhead, (const geopm_time_s &time, double overhead_sec), (override));
+        MOCK_METHOD(uint64_t, num_overflow, (), (const, override));
 };
 
 #endif
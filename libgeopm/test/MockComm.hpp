@@ -40,6 +40,11 @@ class MockComm : public geopm::Comm
                     (const, override));
         MOCK_METHOD(void, window_unlock, (size_t window_id, int rank),
                     (const, override));
+        MOCK_METHOD(void, window_lock_all, (size_t window_id), (const, override));
+        MOCK_METHOD(void, window_unlock_all, (size_t window_id), (const, override));
+        MOCK_METHOD(void, window_flush, (size_t window_id, int rank),
+                    (const, override));
+        MOCK_METHOD(void, window_sync, (size_t window_id), (const, override));
         MOCK_METHOD(void, coordinate, (int rank, std::vector<int> &coord),
                     (const, override));
         MOCK_METHOD(std::vector<int>, coordinate, (int rank), (const, override));
@@ -63,6 +68,10 @@ class MockComm : public geopm::Comm
                     (const void *send_buf, size_t send_size, int rank,
                      off_t disp, size_t window_id),
                     (const, override));
+        MOCK_METHOD(void, window_replace,
+                    (const double *send_buf, size_t count, int rank,
+                     off_t disp, size_t window_id),
+                    (const, override));
         MOCK_METHOD(void, tear_down, (), (override));
 };
 
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOCKCONTROLLOOP_HPP_INCLUDE
+#define MOCKCONTROLLOOP_HPP_INCLUDE
+
+#include "gmock/gmock.h"
+
+#include "ControlLoop.hpp"
+
+class MockControlLoop : public geopm::ControlLoop
+{
+    public:
+        MOCK_METHOD(void, init, (double period, double min_period, double max_period),
+                    (override));
+        MOCK_METHOD(void, begin, (), (override));
+        MOCK_METHOD(void, mark, (int phase), (override));
+        MOCK_METHOD(bool, end, (bool is_active), (override));
+        MOCK_METHOD(double, period, (), (const, override));
+        MOCK_METHOD(uint64_t, num_overrun, (), (const, override));
+        MOCK_METHOD((std::vector<std::pair<std::string, std::string> >), report, (),
+                    (const, override));
+};
+
+#endif
@@ -14,6 +14,8 @@ class MockEndpointPolicyTracer : public geopm::EndpointPolicyTracer
 {
     public:
         MOCK_METHOD(void, update, (const std::vector<double> &policy), (override));
+        MOCK_METHOD(uint64_t, num_flush_overrun, (), (const, override));
+        MOCK_METHOD(double, write_time, (), (const, override));
 };
 
 #endif
@@ -15,6 +15,8 @@ class MockProfileTracer : public geopm::ProfileTracer
     public:
         MOCK_METHOD(void, update, (const std::vector<geopm::record_s> &records),
                     (override));
+        MOCK_METHOD(uint64_t, num_flush_overrun, (), (const, override));
+        MOCK_METHOD(double, write_time, (), (const, override));
 };
 
 #endif
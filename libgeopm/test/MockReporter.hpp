@@ -36,6 +36,12 @@ class MockReporter : public geopm::Reporter
                     (override));
         MOCK_METHOD(void, total_time, (double total), (override));
         MOCK_METHOD(void, overhead, (double overhead_sec, double sample_delay), (override));
+        MOCK_METHOD(void, record_log_overflow, (uint64_t num_overflow), (override));
+        MOCK_METHOD(void, trace_flush_overrun, (uint64_t num_overrun), (override));
+        MOCK_METHOD(void, trace_write_time, (double write_time), (override));
+        MOCK_METHOD(void, control_loop,
+                    ((const std::vector<std::pair<std::string, std::string> > &control_loop)),
+                    (override));
 };
 
 #endif
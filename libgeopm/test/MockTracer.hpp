@@ -20,6 +20,8 @@ class MockTracer : public geopm::Tracer
                     (override));
         MOCK_METHOD(void, update, (const std::vector<double> &agent_vals), (override));
         MOCK_METHOD(void, flush, (), (override));
+        MOCK_METHOD(uint64_t, num_flush_overrun, (), (const, override));
+        MOCK_METHOD(double, write_time, (), (const, override));
 };
 
 #endif
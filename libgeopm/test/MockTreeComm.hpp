@@ -75,6 +75,7 @@ class MockTreeComm : public geopm::TreeComm
             return true;
         }
         MOCK_METHOD(size_t, overhead_send, (), (const, override));
+        MOCK_METHOD(size_t, overhead_save, (), (const, override));
         int num_send(void)
         {
             return m_num_send;
@@ -21,6 +21,7 @@ class MockTreeCommLevel : public geopm::TreeCommLevel
                     (std::vector<std::vector<double> > & sample), (override));
         MOCK_METHOD(bool, receive_down, (std::vector<double> & policy), (override));
         MOCK_METHOD(size_t, overhead_send, (), (const, override));
+        MOCK_METHOD(size_t, overhead_save, (), (const, override));
 };
 
 #endif
@@ -64,7 +64,7 @@ TEST_F(ProfileTracerTest, construct_update_destruct)
     {
         // Test that the constructor and update methods do not throw
         std::unique_ptr<ProfileTracer> tracer = geopm::make_unique<ProfileTracerImp>(
-            m_start_time, geopm_time_s {{0, 0}}, 2, true, m_path, "", m_application_sampler);
+            m_start_time, geopm_time_s {{0, 0}}, 2, true, m_path, "", "csv", "sync", "none", m_application_sampler);
         tracer->update(m_data);
     }
     // Test that a file was created by deleting it without error
@@ -81,7 +81,7 @@ TEST_F(ProfileTracerTest, format)
 
     {
         std::unique_ptr<ProfileTracer> tracer = geopm::make_unique<ProfileTracerImp>(
-            m_start_time, geopm_time_s {{0, 0}}, 2, true, m_path, m_host_name, m_application_sampler);
+            m_start_time, geopm_time_s {{0, 0}}, 2, true, m_path, m_host_name, "csv", "sync", "none", m_application_sampler);
         tracer->update(m_data);
     }
 
@@ -113,3 +113,27 @@ TEST_F(ProfileTracerTest, format)
     int err = unlink(m_output_path.c_str());
     EXPECT_EQ(0, err);
 }
+
+TEST_F(ProfileTracerTest, binary)
+{
+    // Short region hashes are resolved when the record is written
+    EXPECT_CALL(m_application_sampler, get_short_region(88))
+        .WillOnce(Return(geopm::short_region_s{
+            0xdeadbeef, 2, 3.14
+        }));
+
+    {
+        std::unique_ptr<ProfileTracer> tracer = geopm::make_unique<ProfileTracerImp>(
+            m_start_time, geopm_time_s {{0, 0}}, 2, true, m_path, m_host_name, "binary", "sync", "none", m_application_sampler);
+        tracer->update(m_data);
+    }
+
+    std::string output = geopm::read_file(m_output_path);
+    EXPECT_EQ("GEOPMTRB", output.substr(0, 8));
+    EXPECT_NE(std::string::npos, output.find("event_signal"));
+    double short_region_hash = 0xdeadbeef;
+    std::string hash_bytes((const char *)&short_region_hash, sizeof(short_region_hash));
+    EXPECT_NE(std::string::npos, output.find(hash_bytes));
+    int err = unlink(m_output_path.c_str());
+    EXPECT_EQ(0, err);
+}
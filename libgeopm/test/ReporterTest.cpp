@@ -78,6 +78,8 @@ class ReporterTest : public testing::Test
             M_POWER_GPU_IDX,
             M_FREQUENCY_GPU_IDX,
             M_FREQUENCY_CPU_UNCORE_IDX,
+            M_READ_BATCH_TIME_IDX,
+            M_WRITE_BATCH_TIME_IDX,
         };
         ReporterTest();
         void TearDown(void);
@@ -326,6 +328,7 @@ void ReporterTest::generate_setup(void)
 
     // Other calls
     EXPECT_CALL(m_tree_comm, overhead_send()).WillOnce(Return(678 * 56));
+    EXPECT_CALL(m_tree_comm, overhead_save()).WillOnce(Return(4096));
     EXPECT_CALL(*m_comm, rank()).WillRepeatedly(Return(0));
     EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
 }
@@ -493,7 +496,11 @@ TEST_F(ReporterTest, generate)
              << "      GEOPM startup (s): 0.321\n"
              << "      GEOPM overhead (s): 0.123\n"
              << "      geopmctl memory HWM (B): @ANY_STRING@\n"
-             << "      geopmctl network BW (B/s): 678\n\n";
+             << "      geopmctl network BW (B/s): 678\n"
+             << "      geopmctl network saved (B): 4096\n"
+             << "      GEOPM record log overflow: 0\n"
+             << "      GEOPM trace flush overrun: 0\n"
+             << "      GEOPM trace write (s): 0\n\n";
 
     std::istringstream exp_stream(expected.str());
 
@@ -520,9 +527,20 @@ TEST_F(ReporterTest, generate_conditional)
     EXPECT_CALL(*m_sample_agg, push_signal("CPU_UNCORE_FREQUENCY_STATUS", GEOPM_DOMAIN_BOARD, 0))
         .WillOnce(Return(M_FREQUENCY_CPU_UNCORE_IDX));
 
-    std::set<std::string> signal_names = {"GPU_ENERGY","GPU_POWER","GPU_CORE_FREQUENCY_STATUS","CPU_UNCORE_FREQUENCY_STATUS"};
+    std::set<std::string> signal_names = {"GPU_ENERGY","GPU_POWER","GPU_CORE_FREQUENCY_STATUS","CPU_UNCORE_FREQUENCY_STATUS",
+                                          "PLATFORMIO::READ_BATCH_TIME@MSR", "PLATFORMIO::WRITE_BATCH_TIME@MSR"};
     EXPECT_CALL(m_platform_io, signal_names()).WillOnce(Return(signal_names));
 
+    // PlatformIO batch timing signals
+    EXPECT_CALL(m_platform_io, push_signal("PLATFORMIO::READ_BATCH_TIME@MSR", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(M_READ_BATCH_TIME_IDX));
+    EXPECT_CALL(m_platform_io, push_signal("PLATFORMIO::WRITE_BATCH_TIME@MSR", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(M_WRITE_BATCH_TIME_IDX));
+    EXPECT_CALL(m_platform_io, sample(M_READ_BATCH_TIME_IDX))
+        .WillOnce(Return(1.5));
+    EXPECT_CALL(m_platform_io, sample(M_WRITE_BATCH_TIME_IDX))
+        .WillOnce(Return(0.25));
+
     //setup default values for 'generate' tests
     generate_setup();
 
@@ -721,11 +739,27 @@ TEST_F(ReporterTest, generate_conditional)
              << "      GEOPM startup (s): 0.321\n"
              << "      GEOPM overhead (s): 0.123\n"
              << "      geopmctl memory HWM (B): @ANY_STRING@\n"
-             << "      geopmctl network BW (B/s): 678\n\n";
+             << "      geopmctl network BW (B/s): 678\n"
+             << "      geopmctl network saved (B): 4096\n"
+             << "      GEOPM record log overflow: 12\n"
+             << "      GEOPM trace flush overrun: 3\n"
+             << "      GEOPM trace write (s): 0.5\n"
+             << "      read-batch-time@MSR (s): 1.5\n"
+             << "      write-batch-time@MSR (s): 0.25\n"
+             << "    Control Loop:\n"
+             << "      iterations: 20\n"
+             << "      overrun: 1\n"
+             << "      read histogram (us): {64: 19, 2048: 1}\n\n";
 
     std::istringstream exp_istream(expected.str());
     m_reporter->update();
     m_reporter->overhead(0.123, 0.321);
+    m_reporter->record_log_overflow(12);
+    m_reporter->trace_flush_overrun(3);
+    m_reporter->trace_write_time(0.5);
+    m_reporter->control_loop({{"iterations", "20"},
+                              {"overrun", "1"},
+                              {"read histogram (us)", "{64: 19, 2048: 1}"}});
     m_reporter->generate("my_agent", agent_header, agent_node_report, m_region_agent_detail,
                          m_application_io,
                          m_comm, m_tree_comm);
@@ -49,7 +49,8 @@ class SampleAggregatorTest : public ::testing::Test
             M_SIGNAL_R_HASH_CPU_1,
             M_SIGNAL_R_HASH_CPU_2,
             M_SIGNAL_R_HASH_CPU_3,
-            M_SIGNAL_EPOCH_COUNT
+            M_SIGNAL_EPOCH_COUNT,
+            M_SIGNAL_POWER_0,
         };
 };
 
@@ -279,9 +280,8 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
     std::vector<uint64_t> pre_epoch_regions {reg_normal, GEOPM_REGION_HASH_UNMARKED};
     int step = 0;
     for (auto region : pre_epoch_regions) {
+        // Sampled once for the update and once as a pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
             .WillOnce(Return(step))
             .WillOnce(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
@@ -307,9 +307,8 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
                                          reg_normal,
                                          GEOPM_REGION_HASH_UNMARKED};
     for (auto region : epoch_regions) {
+        // Sampled once for the update and once as a pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
             .WillOnce(Return(step))
             .WillOnce(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
@@ -333,9 +332,8 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
 
     // Run through the same three region hashes with the epoch set to two
     for (auto region : epoch_regions) {
+        // Sampled once for the update and once as a pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
             .WillOnce(Return(step))
             .WillOnce(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
@@ -365,6 +363,62 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
     EXPECT_DOUBLE_EQ(7.0, m_agg->sample_application(M_SIGNAL_TIME));
 }
 
+TEST_F(SampleAggregatorTest, shared_domain)
+{
+    double regA = 0x4444;
+    double regB = 0x5555;
+    EXPECT_CALL(m_platio, push_signal("ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(m_platio, push_signal("POWER", GEOPM_DOMAIN_PACKAGE, 0))
+        .WillOnce(Return(M_SIGNAL_POWER_0));
+    EXPECT_CALL(m_platio, push_signal("REGION_HASH", GEOPM_DOMAIN_PACKAGE, 0))
+        .Times(2);
+    EXPECT_CALL(m_platio, signal_behavior("ENERGY"))
+        .WillOnce(Return(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    EXPECT_CALL(m_platio, signal_behavior("POWER"))
+        .WillOnce(Return(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    int energy_idx = m_agg->push_signal("ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    int power_idx = m_agg->push_signal("POWER", GEOPM_DOMAIN_PACKAGE, 0);
+    // The energy is missing while the region changes, so its change
+    // is counted in the region that it was last sampled in
+    std::vector<double> time {0, 1, 2, 3};
+    std::vector<double> region_hash {regA, regA, regB, regB};
+    std::vector<double> energy {0, 100, NAN, 300};
+    std::vector<double> power {10, 20, 30, 40};
+    for (size_t idx = 0; idx != time.size(); ++idx) {
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
+            .WillOnce(Return(time[idx]));
+        // The region hash and epoch count are sampled once for both
+        // signals of the domain
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_PKG_0))
+            .WillOnce(Return(region_hash[idx]));
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_EPOCH_COUNT))
+            .WillOnce(Return(0));
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_ENERGY_0))
+            .WillOnce(Return(energy[idx]));
+        if (idx != 0) {
+            EXPECT_CALL(m_platio, sample(M_SIGNAL_POWER_0))
+                .WillOnce(Return(power[idx]));
+        }
+        m_agg->update();
+    }
+    EXPECT_DOUBLE_EQ(300.0, m_agg->sample_application(energy_idx));
+    EXPECT_DOUBLE_EQ(300.0, m_agg->sample_region(energy_idx, regA));
+    EXPECT_DOUBLE_EQ(300.0, m_agg->sample_region_last(energy_idx, regA));
+    EXPECT_DOUBLE_EQ(0.0, m_agg->sample_region(energy_idx, regB));
+    EXPECT_DOUBLE_EQ(200.0, m_agg->sample_period_last(energy_idx));
+    EXPECT_DOUBLE_EQ(30.0, m_agg->sample_application(power_idx));
+    EXPECT_DOUBLE_EQ(25.0, m_agg->sample_region(power_idx, regA));
+    EXPECT_DOUBLE_EQ(25.0, m_agg->sample_region_last(power_idx, regA));
+    EXPECT_DOUBLE_EQ(40.0, m_agg->sample_region(power_idx, regB));
+    EXPECT_DOUBLE_EQ(40.0, m_agg->sample_period_last(power_idx));
+    // A region that was never entered
+    EXPECT_DOUBLE_EQ(0.0, m_agg->sample_region(energy_idx, 0x9999));
+    EXPECT_TRUE(std::isnan(m_agg->sample_region(power_idx, 0x9999)));
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_agg->push_signal_total("POWER", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "called after update()");
+}
+
 TEST_F(SampleAggregatorTest, test_sample_before_update)
 {
     EXPECT_CALL(m_platio, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
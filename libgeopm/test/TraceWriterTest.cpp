@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "TraceWriter.hpp"
+#ifdef GEOPM_HAS_ZSTD
+#include <zstd.h>
+#endif
+#ifdef GEOPM_HAS_LZ4
+#include <lz4.h>
+#endif
+
+using geopm::TraceWriterImp;
+
+class TraceWriterTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        /// @brief Create a writer with sinks that record the
+        ///        buffers.  The sink waits for release() before
+        ///        writing the first buffer.
+        std::unique_ptr<TraceWriterImp> make_writer(const std::string &policy,
+                                                    size_t max_queue);
+        void release(void);
+        std::vector<std::string> written(void);
+        std::mutex m_mutex;
+        std::vector<std::string> m_written;
+        int m_num_flush;
+        std::promise<void> m_release;
+        std::shared_future<void> m_is_released;
+        bool m_do_release;
+};
+
+void TraceWriterTest::SetUp(void)
+{
+    m_num_flush = 0;
+    m_is_released = m_release.get_future().share();
+    m_do_release = true;
+}
+
+std::unique_ptr<TraceWriterImp> TraceWriterTest::make_writer(const std::string &policy,
+                                                             size_t max_queue)
+{
+    return geopm::make_unique<TraceWriterImp>(
+        [this](const std::string &buffer)
+        {
+            m_is_released.wait();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_written.push_back(buffer);
+        },
+        [this](void)
+        {
+            ++m_num_flush;
+        },
+        policy, "none", max_queue);
+}
+
+void TraceWriterTest::release(void)
+{
+    if (m_do_release) {
+        m_do_release = false;
+        m_release.set_value();
+    }
+}
+
+std::vector<std::string> TraceWriterTest::written(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+TEST_F(TraceWriterTest, sync)
+{
+    release();
+    auto writer = make_writer("sync", 1);
+    writer->write("a");
+    EXPECT_EQ(std::vector<std::string>({"a"}), written());
+    writer->write("b");
+    EXPECT_EQ(std::vector<std::string>({"a", "b"}), written());
+    writer->flush();
+    EXPECT_EQ(1, m_num_flush);
+    EXPECT_EQ(0ULL, writer->num_flush_overrun());
+}
+
+TEST_F(TraceWriterTest, block)
+{
+    auto writer = make_writer("block", 1);
+    // The writer thread holds the first buffer until release()
+    writer->write("a");
+    EXPECT_EQ(0ULL, writer->num_flush_overrun());
+    std::thread producer([&writer]() {
+        writer->write("b");
+    });
+    while (writer->num_flush_overrun() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // The producer is waiting for space in the queue
+    EXPECT_EQ(0u, written().size());
+    release();
+    producer.join();
+    writer->flush();
+    EXPECT_EQ(std::vector<std::string>({"a", "b"}), written());
+    EXPECT_EQ(1, m_num_flush);
+    EXPECT_EQ(1ULL, writer->num_flush_overrun());
+}
+
+TEST_F(TraceWriterTest, drop)
+{
+    auto writer = make_writer("drop", 1);
+    writer->write("a");
+    writer->write("b");
+    writer->write("c");
+    EXPECT_EQ(2ULL, writer->num_flush_overrun());
+    release();
+    writer->flush();
+    writer->write("d");
+    writer->flush();
+    EXPECT_EQ(std::vector<std::string>({"a", "d"}), written());
+    EXPECT_EQ(2, m_num_flush);
+    EXPECT_EQ(2ULL, writer->num_flush_overrun());
+}
+
+TEST_F(TraceWriterTest, queue)
+{
+    auto writer = make_writer("block", 3);
+    writer->write("a");
+    writer->write("b");
+    writer->write("c");
+    EXPECT_EQ(0ULL, writer->num_flush_overrun());
+    release();
+    writer->flush();
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), written());
+}
+
+TEST_F(TraceWriterTest, destructor)
+{
+    release();
+    {
+        auto writer = make_writer("block", 2);
+        writer->write("a");
+        writer->write("b");
+    }
+    EXPECT_EQ(std::vector<std::string>({"a", "b"}), written());
+}
+
+TEST_F(TraceWriterTest, affinity)
+{
+    release();
+    cpu_set_t sink_mask;
+    CPU_ZERO(&sink_mask);
+    TraceWriterImp writer(
+        [&sink_mask](const std::string &)
+        {
+            ASSERT_EQ(0, sched_getaffinity(0, sizeof(sink_mask), &sink_mask));
+        },
+        [](void) {},
+        "block", "none", 2);
+    // The caller is pinned after the writer is created, as the
+    // Controller thread is pinned after its tracers are created
+    cpu_set_t caller_mask;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(caller_mask), &caller_mask));
+    int cpu_idx = 0;
+    while (!CPU_ISSET(cpu_idx, &caller_mask)) {
+        ++cpu_idx;
+    }
+    CPU_ZERO(&caller_mask);
+    CPU_SET(cpu_idx, &caller_mask);
+    std::thread caller([&writer, &caller_mask]() {
+        ASSERT_EQ(0, sched_setaffinity(0, sizeof(caller_mask), &caller_mask));
+        writer.write("a");
+        writer.flush();
+    });
+    caller.join();
+    EXPECT_TRUE(CPU_EQUAL(&caller_mask, &sink_mask));
+}
+
+TEST_F(TraceWriterTest, error)
+{
+    release();
+    int num_call = 0;
+    TraceWriterImp writer(
+        [&num_call](const std::string &)
+        {
+            ++num_call;
+            if (num_call == 1) {
+                throw geopm::Exception("Injected write failure",
+                                       GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        },
+        [](void) {},
+        "block", "none", 2);
+    writer.write("a");
+    GEOPM_EXPECT_THROW_MESSAGE(writer.flush(), GEOPM_ERROR_RUNTIME,
+                               "Injected write failure");
+    // The error is reported once
+    writer.write("b");
+    writer.flush();
+    EXPECT_EQ(2, num_call);
+}
+
+TEST_F(TraceWriterTest, bad_policy)
+{
+    release();
+    GEOPM_EXPECT_THROW_MESSAGE(make_writer("lazy", 1), GEOPM_ERROR_INVALID,
+                               "unknown trace writer policy");
+    GEOPM_EXPECT_THROW_MESSAGE(make_writer("block", 0), GEOPM_ERROR_INVALID,
+                               "max_queue must be positive");
+}
+
+TEST_F(TraceWriterTest, file)
+{
+    std::string path = "TraceWriterTest-file-output";
+    for (const std::string policy : {"block", "drop", "sync"}) {
+        {
+            auto writer = geopm::TraceWriter::make_unique(path, policy, "none");
+            writer->write("header\n");
+            writer->write("line\n");
+            writer->flush();
+            EXPECT_EQ("header\nline\n", geopm::read_file(path)) << policy;
+            writer->write("last\n");
+        }
+        EXPECT_EQ("header\nline\nlast\n", geopm::read_file(path)) << policy;
+        unlink(path.c_str());
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::TraceWriter::make_unique("/does/not/exist", "block", "none"),
+                               ENOENT, "Unable to open trace file");
+}
+
+#if defined(GEOPM_HAS_ZSTD) || defined(GEOPM_HAS_LZ4)
+static uint32_t read_uint32(const std::string &data, size_t &offset)
+{
+    uint32_t result = 0;
+    EXPECT_LE(offset + sizeof(result), data.size());
+    memcpy(&result, data.data() + offset, sizeof(result));
+    offset += sizeof(result);
+    return result;
+}
+
+// Split a compressed trace into frames and decode each one
+static std::vector<std::string> decode_frames(const std::string &data, uint32_t expect_codec)
+{
+    std::vector<std::string> result;
+    size_t offset = strlen(geopm::TraceWriter::M_MAGIC);
+    EXPECT_EQ(std::string(geopm::TraceWriter::M_MAGIC), data.substr(0, offset));
+    EXPECT_EQ(geopm::TraceWriter::M_VERSION, read_uint32(data, offset));
+    uint32_t codec = read_uint32(data, offset);
+    EXPECT_EQ(expect_codec, codec);
+    while (offset < data.size()) {
+        uint32_t compressed_size = read_uint32(data, offset);
+        uint32_t size = read_uint32(data, offset);
+        EXPECT_LE(offset + compressed_size, data.size());
+        std::string frame(size, '\0');
+#ifdef GEOPM_HAS_ZSTD
+        if (codec == 1) {
+            EXPECT_EQ(size, ZSTD_decompress(&frame[0], size, data.data() + offset, compressed_size));
+        }
+#endif
+#ifdef GEOPM_HAS_LZ4
+        if (codec == 2) {
+            EXPECT_EQ((int)size, LZ4_decompress_safe(data.data() + offset, &frame[0],
+                                                      compressed_size, size));
+        }
+#endif
+        result.push_back(frame);
+        offset += compressed_size;
+    }
+    return result;
+}
+
+static void check_compression(const std::string &compression, uint32_t codec)
+{
+    for (const std::string policy : {"block", "sync"}) {
+        std::string output;
+        std::vector<std::string> input;
+        {
+            TraceWriterImp writer([&output](const std::string &buffer)
+                                  {
+                                      output += buffer;
+                                  },
+                                  [](void) {},
+                                  policy, compression, 2);
+            EXPECT_EQ(1024u * 1024u, writer.max_buffer_size());
+            for (int frame_idx = 0; frame_idx != 3; ++frame_idx) {
+                std::string buffer;
+                for (int row_idx = 0; row_idx != 1000; ++row_idx) {
+                    buffer += std::to_string(row_idx * frame_idx) + "|0x00000000" + "|1.5\n";
+                }
+                input.push_back(buffer);
+                writer.write(std::string(buffer));
+            }
+            writer.flush();
+            EXPECT_LE(0.0, writer.write_time());
+        }
+        EXPECT_LT(output.size(), input[0].size() + input[1].size() + input[2].size()) << policy;
+        EXPECT_EQ(input, decode_frames(output, codec)) << policy;
+    }
+}
+#endif
+
+TEST_F(TraceWriterTest, compression)
+{
+    release();
+    auto writer = make_writer("sync", 1);
+    EXPECT_EQ(SIZE_MAX, writer->max_buffer_size());
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::TraceWriter::make_unique("TraceWriterTest-compression",
+                                                               "block", "gzip"),
+                               GEOPM_ERROR_INVALID, "unknown trace compression");
+#ifdef GEOPM_HAS_ZSTD
+    check_compression("zstd", 1);
+#else
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::TraceWriter::make_unique("TraceWriterTest-compression",
+                                                               "block", "zstd"),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "built without zstd");
+#endif
+#ifdef GEOPM_HAS_LZ4
+    check_compression("lz4", 2);
+#else
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::TraceWriter::make_unique("TraceWriterTest-compression",
+                                                               "block", "lz4"),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "built without lz4");
+#endif
+}
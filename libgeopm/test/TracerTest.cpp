@@ -111,7 +111,7 @@ void TracerTest::SetUp(void)
             .WillOnce(Return(column.format));
     }
 
-    m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
+    m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true, "csv", "sync", "none",
                                              m_platform_io, m_platform_topo, env_signals);
 }
 
@@ -15,9 +15,11 @@
 
 using geopm::TreeCommLevel;
 using geopm::TreeCommLevelImp;
+using geopm::MailboxTreeCommLevel;
 using testing::Return;
 using testing::Invoke;
 using testing::SetArgPointee;
+using testing::NiceMock;
 using testing::_;
 
 class TreeCommLevelTest : public ::testing::Test
@@ -165,6 +167,49 @@ TEST_F(TreeCommLevelTest, send_up)
                                GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
 }
 
+TEST_F(TreeCommLevelTest, send_up_unchanged)
+{
+    size_t msg_size = 3 * sizeof(double);
+    std::vector<double> sample {5.5, 6.6, 7.7};
+    EXPECT_CALL(*m_comm_1, window_lock(_, _, _, _)).Times(3);
+    EXPECT_CALL(*m_comm_1, window_unlock(_, _)).Times(3);
+    EXPECT_CALL(*m_comm_1, window_put(_, sizeof(double), _, _, _)).Times(3);
+    EXPECT_CALL(*m_comm_1, window_put(_, msg_size, _, _, _)).Times(2);
+    m_level_rank_1->send_up(sample);
+    EXPECT_EQ(0u, m_level_rank_1->overhead_save());
+    // Only the ready flag is sent for the same sample
+    m_level_rank_1->send_up(sample);
+    EXPECT_EQ(sizeof(double) + msg_size + sizeof(double), m_level_rank_1->overhead_send());
+    EXPECT_EQ(msg_size, m_level_rank_1->overhead_save());
+    sample[2] = 8.8;
+    m_level_rank_1->send_up(sample);
+    EXPECT_EQ(3 * sizeof(double) + 2 * msg_size, m_level_rank_1->overhead_send());
+    EXPECT_EQ(msg_size, m_level_rank_1->overhead_save());
+    testing::Mock::VerifyAndClearExpectations(m_comm_1.get());
+
+    // The values are sent again after the maximum number of
+    // unchanged samples
+    int num_send = TreeCommLevel::M_MAX_NUM_UNCHANGED + 1;
+    EXPECT_CALL(*m_comm_1, window_lock(_, _, _, _)).Times(num_send);
+    EXPECT_CALL(*m_comm_1, window_unlock(_, _)).Times(num_send);
+    EXPECT_CALL(*m_comm_1, window_put(_, sizeof(double), _, _, _)).Times(num_send);
+    EXPECT_CALL(*m_comm_1, window_put(_, msg_size, _, _, _)).Times(1);
+    for (int send_idx = 0; send_idx != num_send; ++send_idx) {
+        m_level_rank_1->send_up(sample);
+    }
+    EXPECT_EQ((1 + TreeCommLevel::M_MAX_NUM_UNCHANGED) * msg_size,
+              m_level_rank_1->overhead_save());
+
+    // A sample with a NAN is always sent with its values
+    sample[0] = NAN;
+    EXPECT_CALL(*m_comm_1, window_lock(_, _, _, _)).Times(2);
+    EXPECT_CALL(*m_comm_1, window_unlock(_, _)).Times(2);
+    EXPECT_CALL(*m_comm_1, window_put(_, sizeof(double), _, _, _)).Times(2);
+    EXPECT_CALL(*m_comm_1, window_put(_, msg_size, _, _, _)).Times(2);
+    m_level_rank_1->send_up(sample);
+    m_level_rank_1->send_up(sample);
+}
+
 TEST_F(TreeCommLevelTest, send_down)
 {
     std::vector<std::vector<double> > policy {{2.2, 3.3}, {2.9, 3.9}, {2.1, 3.1}, {2.0, 3.0}};
@@ -324,3 +369,185 @@ TEST_F(TreeCommLevelTest, receive_down_incomplete)
         EXPECT_TRUE(std::isnan(pp));
     }
 }
+
+class MailboxTreeCommLevelTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        int m_num_up = 3;
+        int m_num_down = 2;
+        int m_num_rank = 2;
+        std::shared_ptr<NiceMock<MockComm> > m_comm[2];
+        std::shared_ptr<TreeCommLevel> m_level[2];
+        std::vector<double> m_policy_mem[2];
+        std::vector<double> m_sample_mem[2];
+        size_t m_num_replace[2] = {0, 0};
+};
+
+void MailboxTreeCommLevelTest::SetUp()
+{
+    size_t policy_size = sizeof(double) * (m_num_down + 1);
+    size_t sample_size = sizeof(double) * m_num_rank * (m_num_up + 1);
+    for (int rank = 0; rank != m_num_rank; ++rank) {
+        m_comm[rank] = std::make_shared<NiceMock<MockComm> >();
+        m_policy_mem[rank].resize(m_num_down + 1);
+        m_sample_mem[rank].resize(m_num_rank * (m_num_up + 1));
+        ON_CALL(*m_comm[rank], num_rank()).WillByDefault(Return(m_num_rank));
+        ON_CALL(*m_comm[rank], rank()).WillByDefault(Return(rank));
+        ON_CALL(*m_comm[rank], alloc_mem(policy_size, _))
+            .WillByDefault(SetArgPointee<1>(m_policy_mem[rank].data()));
+        ON_CALL(*m_comm[rank], alloc_mem(sample_size, _))
+            .WillByDefault(SetArgPointee<1>(m_sample_mem[rank].data()));
+        // Window 1 is the sample window, window 2 is the policy window
+        ON_CALL(*m_comm[rank], window_create(sample_size, _)).WillByDefault(Return(1));
+        ON_CALL(*m_comm[rank], window_create(policy_size, _)).WillByDefault(Return(2));
+        // Rank zero exposes no policy memory, the others no sample memory
+        ON_CALL(*m_comm[rank], window_create(0, NULL)).WillByDefault(Return(rank == 0 ? 2 : 1));
+        // Copy each replace into the memory of the target rank
+        ON_CALL(*m_comm[rank], window_replace(_, _, _, _, _))
+            .WillByDefault(Invoke([this, rank](const double *send_buf, size_t count, int target,
+                                               off_t disp, size_t window_id)
+            {
+                std::vector<double> &mem = window_id == 1 ? m_sample_mem[target] : m_policy_mem[target];
+                ASSERT_LE(disp + sizeof(double) * count, sizeof(double) * mem.size());
+                memcpy((char *)mem.data() + disp, send_buf, sizeof(double) * count);
+                ++m_num_replace[rank];
+            }));
+    }
+    for (int rank = 0; rank != m_num_rank; ++rank) {
+        EXPECT_CALL(*m_comm[rank], window_lock_all(_)).Times(2);
+        m_level[rank] = std::make_shared<MailboxTreeCommLevel>(m_comm[rank], m_num_up, m_num_down);
+    }
+}
+
+void MailboxTreeCommLevelTest::TearDown()
+{
+    for (int rank = 0; rank != m_num_rank; ++rank) {
+        EXPECT_CALL(*m_comm[rank], barrier());
+        EXPECT_CALL(*m_comm[rank], window_unlock_all(_)).Times(2);
+        EXPECT_CALL(*m_comm[rank], window_destroy(_)).Times(2);
+        EXPECT_CALL(*m_comm[rank], free_mem(_)).Times(2);
+        m_level[rank].reset();
+    }
+}
+
+TEST_F(MailboxTreeCommLevelTest, level_rank)
+{
+    EXPECT_EQ(0, m_level[0]->level_rank());
+    EXPECT_EQ(1, m_level[1]->level_rank());
+}
+
+TEST_F(MailboxTreeCommLevelTest, send_receive_up)
+{
+    std::vector<std::vector<double> > sample {{5.5, 6.6, 7.7}, {1.1, 2.2, 3.3}};
+    std::vector<std::vector<double> > sample_out(m_num_rank, std::vector<double>(m_num_up, 0.0));
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+
+    // Each write of a message is completed before the next one
+    EXPECT_CALL(*m_comm[1], window_put(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*m_comm[1], window_flush(1, 0)).Times(3);
+    m_level[1]->send_up(sample[1]);
+    testing::Mock::VerifyAndClearExpectations(m_comm[1].get());
+    EXPECT_EQ(3u, m_num_replace[1]);
+    EXPECT_EQ(5 * sizeof(double), m_level[1]->overhead_send());
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+
+    m_level[0]->send_up(sample[0]);
+    EXPECT_EQ(0u, m_num_replace[0]);
+    EXPECT_EQ(0u, m_level[0]->overhead_send());
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+
+    // The messages are consumed, a new one is needed from every child
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    sample[1] = {1.5, 2.5, 3.5};
+    m_level[1]->send_up(sample[1]);
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    m_level[0]->send_up(sample[0]);
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+
+    // An unchanged sample is sent as a new sequence number alone
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    size_t num_replace = m_num_replace[1];
+    EXPECT_CALL(*m_comm[1], window_flush(1, 0)).Times(1);
+    m_level[1]->send_up(sample[1]);
+    testing::Mock::VerifyAndClearExpectations(m_comm[1].get());
+    EXPECT_EQ(num_replace + 1, m_num_replace[1]);
+    EXPECT_EQ(11 * sizeof(double), m_level[1]->overhead_send());
+    EXPECT_EQ(4 * sizeof(double), m_level[1]->overhead_save());
+    m_level[0]->send_up(sample[0]);
+    sample_out.assign(m_num_rank, std::vector<double>(m_num_up, 0.0));
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+
+    // errors
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[1]->send_up({8.8, 9.9}),
+                               GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
+    sample_out.resize(1);
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[0]->receive_up(sample_out),
+                               GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
+}
+
+TEST_F(MailboxTreeCommLevelTest, receive_up_busy)
+{
+    std::vector<std::vector<double> > sample {{5.5, 6.6, 7.7}, {1.1, 2.2, 3.3}};
+    std::vector<std::vector<double> > sample_out(m_num_rank, std::vector<double>(m_num_up, 0.0));
+    m_level[0]->send_up(sample[0]);
+    m_level[1]->send_up(sample[1]);
+    // A child has started to write the next message
+    double *sequence = m_sample_mem[0].data() + m_num_up + 1;
+    *sequence += 1.0;
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(std::vector<double>(m_num_up, 0.0), sample_out[1]);
+    *sequence -= 1.0;
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+
+    // A NAN in any sample leaves the messages for a later call
+    m_level[0]->send_up({NAN, 1.0, 2.0});
+    m_level[1]->send_up(sample[1]);
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    m_level[0]->send_up(sample[0]);
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+}
+
+TEST_F(MailboxTreeCommLevelTest, send_receive_down)
+{
+    std::vector<std::vector<double> > policy {{2.2, 3.3}, {2.9, 3.9}};
+    std::vector<double> policy_out;
+    EXPECT_FALSE(m_level[0]->receive_down(policy_out));
+    EXPECT_FALSE(m_level[1]->receive_down(policy_out));
+    EXPECT_TRUE(policy_out.empty());
+
+    EXPECT_CALL(*m_comm[0], window_put(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*m_comm[0], window_flush(2, 1)).Times(3);
+    m_level[0]->send_down(policy);
+    testing::Mock::VerifyAndClearExpectations(m_comm[0].get());
+    EXPECT_EQ(3u, m_num_replace[0]);
+    EXPECT_EQ(4 * sizeof(double), m_level[0]->overhead_send());
+    EXPECT_TRUE(m_level[0]->receive_down(policy_out));
+    EXPECT_EQ(policy[0], policy_out);
+    EXPECT_TRUE(m_level[1]->receive_down(policy_out));
+    EXPECT_EQ(policy[1], policy_out);
+    // The latest policy is returned again
+    EXPECT_TRUE(m_level[1]->receive_down(policy_out));
+    EXPECT_EQ(policy[1], policy_out);
+
+    // An unchanged policy is not sent again
+    m_level[0]->send_down(policy);
+    EXPECT_EQ(3u, m_num_replace[0]);
+    policy[1] = {NAN, 1.0};
+    m_level[0]->send_down(policy);
+    EXPECT_EQ(6u, m_num_replace[0]);
+    EXPECT_FALSE(m_level[1]->receive_down(policy_out));
+    EXPECT_EQ((std::vector<double>{2.9, 3.9}), policy_out);
+
+    // errors
+    policy = {{7.7, 6.6}};
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[0]->send_down(policy),
+                               GEOPM_ERROR_INVALID, "policy vector is not sized correctly");
+}
+
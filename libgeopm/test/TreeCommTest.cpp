@@ -179,3 +179,16 @@ TEST_F(TreeCommTest, overhead_send)
 
     EXPECT_EQ(expected_overhead, m_tree_comm->overhead_send());
 }
+
+TEST_F(TreeCommTest, overhead_save)
+{
+    root_setup();
+
+    std::vector<size_t> saved{12, 0, 34, 5};
+    for (size_t level = 0; level < m_level_ptr.size(); ++level) {
+        EXPECT_CALL(*(m_level_ptr[level]), overhead_save())
+            .WillOnce(Return(saved[level]));
+    }
+
+    EXPECT_EQ(51u, m_tree_comm->overhead_save());
+}
@@ -4,6 +4,8 @@
  */
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "geopm_test.hpp"
@@ -11,12 +13,14 @@
 #include "geopm/Waiter.hpp"
 
 using geopm::Waiter;
+using geopm::HybridWaiter;
 
 class WaiterTest : public ::testing::Test
 {
     protected:
         double m_period = 0.1;
         double m_epsilon = 0.01;
+        std::vector<std::string> m_strategies = {"sleep", "timer", "hybrid"};
 };
 
 
@@ -32,15 +36,32 @@ TEST_F(WaiterTest, make_unique)
     ASSERT_EQ(1.0, waiter->period());
     waiter = Waiter::make_unique(2.0, "sleep");
     ASSERT_EQ(2.0, waiter->period());
+    waiter = Waiter::make_unique(3.0, "timer");
+    ASSERT_EQ(3.0, waiter->period());
+    waiter = Waiter::make_unique(4.0, "hybrid");
+    ASSERT_EQ(4.0, waiter->period());
+    waiter = Waiter::make_unique(5.0, "hybrid", 1e-3);
+    ASSERT_EQ(5.0, waiter->period());
 }
 
-TEST_F(WaiterTest, reset)
+TEST_F(WaiterTest, invalid_slack)
 {
-    std::shared_ptr<Waiter> waiter = Waiter::make_unique(m_period);
+    GEOPM_EXPECT_THROW_MESSAGE(HybridWaiter(1.0, -1e-6),
+                               GEOPM_ERROR_INVALID, "slack must be non-negative");
+    GEOPM_EXPECT_THROW_MESSAGE(Waiter::make_unique(1.0, "hybrid", -1e-6),
+                               GEOPM_ERROR_INVALID, "slack must be non-negative");
+    // The slack is only used by the hybrid strategy
+    std::shared_ptr<Waiter> waiter = Waiter::make_unique(1.0, "sleep", -1e-6);
+    EXPECT_EQ(1.0, waiter->period());
+}
+
+TEST_F(WaiterTest, hybrid_slack)
+{
+    // With a slack longer than the period the wait polls the clock
+    // from the start, and still ends at the deadline
+    std::shared_ptr<Waiter> waiter = Waiter::make_unique(m_period, "hybrid", 2 * m_period);
     geopm_time_s time_0;
     geopm_time_s time_1;
-    timespec delay = {0,100000000};
-    nanosleep(&delay, nullptr);
     waiter->reset();
     geopm_time(&time_0);
     waiter->wait();
@@ -48,17 +69,50 @@ TEST_F(WaiterTest, reset)
     EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
 }
 
-TEST_F(WaiterTest, wait)
+TEST_F(WaiterTest, reset)
 {
-    geopm_time_s time_0;
-    geopm_time_s time_1;
-    std::shared_ptr<Waiter> waiter = Waiter::make_unique(m_period);
-    timespec delay = {0,100000000};
-    nanosleep(&delay, nullptr);
-    for (int count = 0; count < 10; ++count) {
+    for (const auto &strategy : m_strategies) {
+        std::shared_ptr<Waiter> waiter = Waiter::make_unique(m_period, strategy);
+        geopm_time_s time_0;
+        geopm_time_s time_1;
+        timespec delay = {0,100000000};
+        nanosleep(&delay, nullptr);
+        waiter->reset();
+        geopm_time(&time_0);
+        waiter->wait();
+        geopm_time(&time_1);
+        EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon) << strategy;
+    }
+}
+
+TEST_F(WaiterTest, reset_period)
+{
+    for (const auto &strategy : m_strategies) {
+        std::shared_ptr<Waiter> waiter = Waiter::make_unique(2 * m_period, strategy);
+        geopm_time_s time_0;
+        geopm_time_s time_1;
+        waiter->reset(m_period);
+        EXPECT_EQ(m_period, waiter->period());
         geopm_time(&time_0);
         waiter->wait();
         geopm_time(&time_1);
-        EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
+        EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon) << strategy;
+    }
+}
+
+TEST_F(WaiterTest, wait)
+{
+    for (const auto &strategy : m_strategies) {
+        geopm_time_s time_0;
+        geopm_time_s time_1;
+        std::shared_ptr<Waiter> waiter = Waiter::make_unique(m_period, strategy);
+        timespec delay = {0,100000000};
+        nanosleep(&delay, nullptr);
+        for (int count = 0; count < 10; ++count) {
+            geopm_time(&time_0);
+            waiter->wait();
+            geopm_time(&time_1);
+            EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon) << strategy;
+        }
     }
 }
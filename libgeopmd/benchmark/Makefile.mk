@@ -0,0 +1,19 @@
+#  Copyright (c) 2015 - 2024 Intel Corporation
+#  SPDX-License-Identifier: BSD-3-Clause
+#
+
+# Microbenchmarks are built with "make checkprogs" and are run by hand,
+# they are not part of "make check".
+check_PROGRAMS += benchmark/iouring_bench \
+                  benchmark/msr_field_bench \
+                  benchmark/platform_topo_bench \
+                  # end
+
+benchmark_iouring_bench_SOURCES = benchmark/iouring_bench.cpp
+benchmark_iouring_bench_LDADD = libgeopmd.la
+
+benchmark_msr_field_bench_SOURCES = benchmark/msr_field_bench.cpp
+benchmark_msr_field_bench_LDADD = libgeopmd.la
+
+benchmark_platform_topo_bench_SOURCES = benchmark/platform_topo_bench.cpp
+benchmark_platform_topo_bench_LDADD = libgeopmd.la
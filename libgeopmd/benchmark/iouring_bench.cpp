@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Compare the cost of a batch of small reads issued through the
+/// IOUring interface: operations prepared for each submission with
+/// prep_read() versus a batch prepared once with add_batch(), for
+/// both the io_uring and the fallback implementations.  When the
+/// MSR drivers are accessible the cost of MSRIO::read_batch() with
+/// the msr-safe batch ioctl and with the msr driver is also reported.
+///
+/// Usage: iouring_bench [NUM_OP [NUM_ITER]]
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "geopm/Exception.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "IOUring.hpp"
+#include "IOUringFallback.hpp"
+#include "MSRIO.hpp"
+
+using geopm::IOUring;
+
+static void report(const std::string &name, int num_op, int num_iter,
+                   std::function<void(void)> iteration)
+{
+    // Warm up and prepare batches
+    iteration();
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int iter = 0; iter != num_iter; ++iter) {
+        iteration();
+    }
+    double elapsed = geopm_time_since(&begin);
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+              << 1e6 * elapsed / num_iter << " us/batch"
+              << std::setw(12) << 1e9 * elapsed / num_iter / num_op << " ns/op\n";
+}
+
+static void bench_prep(const std::string &name, IOUring &io, int fd,
+                       std::vector<uint64_t> &buf, int num_iter)
+{
+    report(name, buf.size(), num_iter, [&io, fd, &buf]() {
+        std::vector<std::shared_ptr<int> > ret;
+        ret.reserve(buf.size());
+        for (size_t idx = 0; idx != buf.size(); ++idx) {
+            ret.emplace_back(new int(0));
+            io.prep_read(ret.back(), fd, &buf[idx], sizeof(buf[idx]),
+                         idx * sizeof(buf[idx]));
+        }
+        io.submit();
+    });
+}
+
+static void bench_batch(const std::string &name, IOUring &io, int fd,
+                        std::vector<uint64_t> &buf, int num_iter)
+{
+    std::vector<IOUring::m_operation_s> operations;
+    for (size_t idx = 0; idx != buf.size(); ++idx) {
+        operations.push_back({true, fd, &buf[idx], sizeof(buf[idx]),
+                              (off_t)(idx * sizeof(buf[idx]))});
+    }
+    int batch_idx = io.add_batch(operations);
+    std::vector<int> ret(buf.size());
+    report(name, buf.size(), num_iter, [&io, batch_idx, &ret]() {
+        io.submit_batch(batch_idx, ret.data());
+    });
+}
+
+static void bench_msr(const std::string &name, int driver_type,
+                      int num_op, int num_iter)
+{
+    try {
+        auto msrio = geopm::MSRIO::make_unique(driver_type);
+        int num_cpu = geopm::platform_topo().num_domain(GEOPM_DOMAIN_CPU);
+        // Time stamp counter
+        const uint64_t offset = 0x10;
+        for (int op_idx = 0; op_idx != num_op; ++op_idx) {
+            msrio->add_read(op_idx % num_cpu, offset);
+        }
+        report(name, num_op, num_iter, [&msrio]() {
+            msrio->read_batch();
+        });
+    }
+    catch (const geopm::Exception &ex) {
+        std::cout << std::left << std::setw(24) << name << " skipped: "
+                  << ex.what() << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int num_op = argc > 1 ? std::stoi(argv[1]) : 4096;
+    int num_iter = argc > 2 ? std::stoi(argv[2]) : 1000;
+    if (num_op <= 0 || num_iter <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [NUM_OP [NUM_ITER]]\n";
+        return -1;
+    }
+
+    // Reads are served from the page cache of a temporary file
+    char path[] = "/tmp/geopm-iouring-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1 || ftruncate(fd, num_op * sizeof(uint64_t)) != 0) {
+        std::cerr << "Error: unable to create " << path << "\n";
+        return -1;
+    }
+    unlink(path);
+    std::vector<uint64_t> buf(num_op);
+
+    std::cout << num_op << " reads per batch, " << num_iter << " batches\n";
+    auto fallback = geopm::IOUringFallback::make_unique(num_op);
+    bench_prep("fallback prep_read", *fallback, fd, buf, num_iter);
+    bench_batch("fallback add_batch", *fallback, fd, buf, num_iter);
+    // Uses io_uring when it is built in and supported
+    auto uring = IOUring::make_unique(num_op);
+    bench_prep("uring prep_read", *uring, fd, buf, num_iter);
+    bench_batch("uring add_batch", *uring, fd, buf, num_iter);
+    close(fd);
+
+    bench_msr("msr-safe ioctl", geopm::MSRIO::M_DRIVER_MSRSAFE, num_op, num_iter);
+    bench_msr("msr driver", geopm::MSRIO::M_DRIVER_MSR, num_op, num_iter);
+    return 0;
+}
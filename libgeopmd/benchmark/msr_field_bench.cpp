@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Compare the cost of decoding a synthetic batch of MSR bitfields
+/// with one MSRFieldSignal::sample() call per field versus a single
+/// MSRFieldDecoder::decode() call over the whole batch, as done by
+/// MSRIOGroup::read_batch().  Each CPU contributes the fields that
+/// are commonly pushed per CPU: APERF, MPERF, the fixed counters, the
+/// current frequency and the thermal readout.
+///
+/// Usage: msr_field_bench [NUM_CPU [NUM_ITER]]
+
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "geopm_field.h"
+#include "geopm_time.h"
+#include "geopm/Helper.hpp"
+#include "MSR.hpp"
+#include "MSRFieldDecoder.hpp"
+#include "MSRFieldSignal.hpp"
+#include "Signal.hpp"
+
+using geopm::MSR;
+
+// Stands in for RawMSRSignal with values stored in memory
+class ArraySignal : public geopm::Signal
+{
+    public:
+        ArraySignal(const uint64_t *value)
+            : m_value(value)
+        {
+
+        }
+        virtual ~ArraySignal() = default;
+        void setup_batch(void) override
+        {
+
+        }
+        double sample(void) override
+        {
+            return geopm_field_to_signal(*m_value);
+        }
+        double read(void) const override
+        {
+            return geopm_field_to_signal(*m_value);
+        }
+    private:
+        const uint64_t *m_value;
+};
+
+static void report(const std::string &name, int num_field, int num_iter,
+                   std::function<void(void)> iteration)
+{
+    iteration();
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int iter = 0; iter != num_iter; ++iter) {
+        iteration();
+    }
+    double elapsed = geopm_time_since(&begin);
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+              << 1e6 * elapsed / num_iter << " us/batch"
+              << std::setw(12) << 1e9 * elapsed / num_iter / num_field << " ns/field\n";
+}
+
+int main(int argc, char **argv)
+{
+    int num_cpu = argc > 1 ? std::stoi(argv[1]) : 256;
+    int num_iter = argc > 2 ? std::stoi(argv[2]) : 10000;
+    if (num_cpu <= 0 || num_iter <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [NUM_CPU [NUM_ITER]]\n";
+        return -1;
+    }
+    struct field_s {
+        int begin_bit;
+        int end_bit;
+        int function;
+        double scalar;
+    };
+    // One raw MSR per field except the frequency and thermal fields
+    // which are in separate MSRs as well.
+    std::vector<field_s> per_cpu_field = {
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 1.0},       // APERF
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 1.0},       // MPERF
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 1.0},       // FIXED_CTR0
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 1.0},       // FIXED_CTR1
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 1.0},       // FIXED_CTR2
+        {8, 15, MSR::M_FUNCTION_SCALE, 1e8},          // PERF_STATUS:FREQ
+        {16, 22, MSR::M_FUNCTION_SCALE, 1.0},         // THERM_STATUS:DIGITAL_READOUT
+    };
+    int num_field = num_cpu * per_cpu_field.size();
+    std::vector<uint64_t> raw(num_field);
+    std::mt19937_64 generator(0);
+
+    std::vector<std::shared_ptr<geopm::Signal> > raw_signal;
+    std::vector<std::unique_ptr<geopm::Signal> > field_signal;
+    geopm::MSRFieldDecoder decoder;
+    for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+        for (const auto &field : per_cpu_field) {
+            int raw_idx = raw_signal.size();
+            raw_signal.push_back(std::make_shared<ArraySignal>(&raw[raw_idx]));
+            field_signal.push_back(geopm::make_unique<geopm::MSRFieldSignal>(
+                raw_signal.back(), field.begin_bit, field.end_bit,
+                field.function, field.scalar));
+            field_signal.back()->setup_batch();
+            decoder.add_field(raw_idx, field.begin_bit, field.end_bit,
+                              field.function, field.scalar);
+        }
+    }
+    std::vector<double> result(num_field);
+    std::vector<uint64_t> raw_value(num_field);
+    auto update_raw = [&raw, &generator]() {
+        for (auto &value : raw) {
+            value += generator() & 0xFFFFFFF;
+        }
+    };
+
+    std::cout << num_cpu << " CPUs, " << num_field << " fields per batch, "
+              << num_iter << " batches\n";
+    report("MSRFieldSignal", num_field, num_iter, [&]() {
+        update_raw();
+        for (int idx = 0; idx != num_field; ++idx) {
+            result[idx] = field_signal[idx]->sample();
+        }
+    });
+    report("MSRFieldDecoder", num_field, num_iter, [&]() {
+        update_raw();
+        for (int idx = 0; idx != num_field; ++idx) {
+            raw_value[idx] = geopm_signal_to_field(raw_signal[idx]->sample());
+        }
+        decoder.decode(raw_value.data());
+        for (int idx = 0; idx != num_field; ++idx) {
+            result[idx] = decoder.value(idx);
+        }
+    });
+    report("decode only", num_field, num_iter, [&]() {
+        decoder.decode(raw.data());
+    });
+    report("update only", num_field, num_iter, update_raw);
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/// Measure the cost of creating a PlatformTopoImp and of the
+/// domain_idx() and domain_nested() queries made while IOGroups and
+/// agents are initialized.  A synthetic topology cache is written for
+/// a node with NUM_PACKAGE packages of NUM_CORE cores with
+/// NUM_THREAD hyper-threads each, one NUMA node per package and
+/// NUM_GPU GPUs with two chips each.  Every domain_idx() query is
+/// made for every CPU and every domain_nested() query is made for
+/// every outer domain of every nested pair of domain types.
+///
+/// The topology cache is ignored by users with CAP_SYS_ADMIN, so run
+/// as an unprivileged user.
+///
+/// Usage: platform_topo_bench [NUM_PACKAGE [NUM_CORE [NUM_THREAD [NUM_GPU [NUM_ITER]]]]]
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "geopm/Helper.hpp"
+#include "PlatformTopoImp.hpp"
+
+using geopm::PlatformTopoImp;
+
+static std::string cpu_list_string(const std::set<int> &cpu_set)
+{
+    std::ostringstream result;
+    std::string delim;
+    for (int cpu_idx : cpu_set) {
+        result << delim << cpu_idx;
+        delim = ",";
+    }
+    return result.str();
+}
+
+static std::string cpu_mask_string(const std::set<int> &cpu_set)
+{
+    std::vector<int> nibble(cpu_set.empty() ? 1 : *cpu_set.rbegin() / 4 + 1, 0);
+    for (int cpu_idx : cpu_set) {
+        nibble[cpu_idx / 4] |= 1 << (cpu_idx % 4);
+    }
+    std::ostringstream result;
+    result << "0x" << std::hex;
+    for (auto nib_it = nibble.rbegin(); nib_it != nibble.rend(); ++nib_it) {
+        result << *nib_it;
+    }
+    return result.str();
+}
+
+// Linux numbers all of the first hyper-threads of every core before
+// the second hyper-threads
+static std::string synthetic_topo(int num_package, int num_core, int num_thread, int num_gpu)
+{
+    int num_core_total = num_package * num_core;
+    int num_cpu = num_core_total * num_thread;
+    std::set<int> all_cpu;
+    for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+        all_cpu.insert(cpu_idx);
+    }
+    std::ostringstream result;
+    result << "CPU(s): " << num_cpu << "\n"
+           << "On-line CPU(s) mask: " << cpu_mask_string(all_cpu) << "\n"
+           << "Thread(s) per core: " << num_thread << "\n"
+           << "Core(s) per socket: " << num_core << "\n"
+           << "Socket(s): " << num_package << "\n"
+           << "NUMA node(s): " << num_package << "\n";
+    for (int package_idx = 0; package_idx != num_package; ++package_idx) {
+        std::set<int> node_cpu;
+        for (int cpu_idx : all_cpu) {
+            if ((cpu_idx % num_core_total) / num_core == package_idx) {
+                node_cpu.insert(cpu_idx);
+            }
+        }
+        result << "NUMA node" << package_idx << " CPU(s): " << cpu_mask_string(node_cpu) << "\n";
+    }
+    std::vector<std::set<int> > gpu_cpu(num_gpu);
+    std::vector<std::set<int> > chip_cpu(2 * num_gpu);
+    for (int cpu_idx : all_cpu) {
+        int gpu_idx = (cpu_idx % num_core_total) * num_gpu / num_core_total;
+        gpu_cpu[gpu_idx].insert(cpu_idx);
+        chip_cpu[2 * gpu_idx + cpu_idx % 2].insert(cpu_idx);
+    }
+    for (int gpu_idx = 0; gpu_idx != num_gpu; ++gpu_idx) {
+        result << "GPU node" << gpu_idx << " CPU(s): " << cpu_list_string(gpu_cpu[gpu_idx]) << "\n";
+    }
+    for (int chip_idx = 0; chip_idx != 2 * num_gpu; ++chip_idx) {
+        result << "GPU chip" << chip_idx << " CPU(s): " << cpu_list_string(chip_cpu[chip_idx]) << "\n";
+    }
+    return result.str();
+}
+
+static void report(const std::string &name, int num_op, int num_iter,
+                   std::function<void(void)> iteration)
+{
+    iteration();
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int iter = 0; iter != num_iter; ++iter) {
+        iteration();
+    }
+    double elapsed = geopm_time_since(&begin);
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+              << 1e6 * elapsed / num_iter << " us/iter"
+              << std::setw(12) << 1e9 * elapsed / num_iter / num_op << " ns/op\n";
+}
+
+int main(int argc, char **argv)
+{
+    int num_package = argc > 1 ? std::stoi(argv[1]) : 2;
+    int num_core = argc > 2 ? std::stoi(argv[2]) : 56;
+    int num_thread = argc > 3 ? std::stoi(argv[3]) : 4;
+    int num_gpu = argc > 4 ? std::stoi(argv[4]) : 8;
+    int num_iter = argc > 5 ? std::stoi(argv[5]) : 100;
+    if (num_package <= 0 || num_core <= 0 || num_thread <= 0 ||
+        num_gpu < 0 || num_gpu > num_package * num_core || num_iter <= 0) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [NUM_PACKAGE [NUM_CORE [NUM_THREAD [NUM_GPU [NUM_ITER]]]]]\n";
+        return -1;
+    }
+    if (geopm::has_cap_sys_admin()) {
+        std::cerr << "Error: " << argv[0] << " must be run without CAP_SYS_ADMIN\n";
+        return -1;
+    }
+    std::string cache_path = "/tmp/platform_topo_bench_cache-" + std::to_string(getpid());
+    std::ofstream(cache_path) << synthetic_topo(num_package, num_core, num_thread, num_gpu);
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR);
+
+    PlatformTopoImp topo(cache_path, nullptr);
+    int num_cpu = topo.num_domain(GEOPM_DOMAIN_CPU);
+    const std::vector<int> domain_types = {
+        GEOPM_DOMAIN_BOARD,
+        GEOPM_DOMAIN_PACKAGE,
+        GEOPM_DOMAIN_CORE,
+        GEOPM_DOMAIN_CPU,
+        GEOPM_DOMAIN_MEMORY,
+        GEOPM_DOMAIN_GPU,
+        GEOPM_DOMAIN_GPU_CHIP,
+    };
+    int num_nested = 0;
+    for (int inner_domain : domain_types) {
+        for (int outer_domain : domain_types) {
+            if (topo.is_nested_domain(inner_domain, outer_domain)) {
+                num_nested += topo.num_domain(outer_domain);
+            }
+        }
+    }
+    std::cout << num_cpu << " CPUs, " << topo.num_domain(GEOPM_DOMAIN_GPU) << " GPUs, "
+              << num_iter << " iterations\n";
+
+    report("construct", 1, num_iter, [&cache_path]() {
+        PlatformTopoImp iter_topo(cache_path, nullptr);
+    });
+    report("domain_idx", num_cpu * domain_types.size(), num_iter, [&]() {
+        for (int domain_type : domain_types) {
+            for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                topo.domain_idx(domain_type, cpu_idx);
+            }
+        }
+    });
+    report("domain_nested", num_nested, num_iter, [&]() {
+        for (int inner_domain : domain_types) {
+            for (int outer_domain : domain_types) {
+                if (topo.is_nested_domain(inner_domain, outer_domain)) {
+                    int num_outer = topo.num_domain(outer_domain);
+                    for (int outer_idx = 0; outer_idx != num_outer; ++outer_idx) {
+                        topo.domain_nested(inner_domain, outer_domain, outer_idx);
+                    }
+                }
+            }
+        }
+    });
+    unlink(cache_path.c_str());
+    return 0;
+}
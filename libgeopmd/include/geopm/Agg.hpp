@@ -6,6 +6,7 @@
 #ifndef AGG_HPP_INCLUDE
 #define AGG_HPP_INCLUDE
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <vector>
@@ -35,6 +36,9 @@ namespace geopm
                 M_EXPECT_SAME,
                 M_NUM_TYPE
             };
+            /// @brief Aggregation function that operates on a
+            ///        contiguous array of operands.
+            using ArrayFunction = double (*)(const double *operand, size_t num_operand);
             /// @brief Returns the sum of the input operands.
             static double sum(const std::vector<double> &operand);
             /// @brief Returns the average of the input operands.
@@ -105,6 +109,18 @@ namespace geopm
             ///        one of the Agg:m_type_e enum values.  If the
             ///        agg_type is out of range, it throws an error.
             static std::string type_to_name(int agg_type);
+            /// @brief Returns a function that aggregates a contiguous
+            ///        array of operands without allocating memory and
+            ///        is equivalent to the given std::function, or
+            ///        nullptr if there is no such function.
+            ///
+            /// Array functions are provided for sum, average, min,
+            /// max and logical_or.  They ignore NAN operands in the
+            /// same way as the std::vector functions and are written
+            /// to be vectorized by the compiler, so the result of sum
+            /// and average may differ from the std::vector functions
+            /// by floating point rounding.
+            static ArrayFunction function_to_array_function(std::function<double(const std::vector<double> &)> func);
     };
 }
 
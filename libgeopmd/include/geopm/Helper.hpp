@@ -121,7 +121,9 @@ namespace geopm
     ///        decimal integer.
     /// @param [in] signal An integer that is best represented as a
     ///        decimal number.
-    /// @return A well formatted string representation of the signal.
+    /// @return A well formatted string representation of the signal,
+    ///         formatted as by string_format_float() if the signal
+    ///         is NAN or infinite.
     std::string GEOPM_PUBLIC
         string_format_integer(double signal);
 
@@ -142,6 +144,50 @@ namespace geopm
     std::string GEOPM_PUBLIC
         string_format_raw64(double signal);
 
+    /// @brief Number of characters that must be available in the
+    ///        buffer passed to a string_format_buffer_f function.
+    static constexpr size_t string_format_buffer_size = 32;
+
+    /// @brief Function that writes the same characters as one of the
+    ///        string_format_*() functions into a caller provided
+    ///        buffer without allocating memory.  The output is not
+    ///        null terminated.
+    /// @param [in] signal Value to format.
+    /// @param [out] buffer Start of the output, must have at least
+    ///        string_format_buffer_size characters available.
+    /// @return Pointer one past the last character written.
+    typedef char *(*string_format_buffer_f)(double signal, char *buffer);
+
+    /// @brief Buffer version of string_format_double().
+    char GEOPM_PUBLIC *
+        string_format_double_buffer(double signal, char *buffer);
+
+    /// @brief Buffer version of string_format_float().
+    char GEOPM_PUBLIC *
+        string_format_float_buffer(double signal, char *buffer);
+
+    /// @brief Buffer version of string_format_integer().
+    char GEOPM_PUBLIC *
+        string_format_integer_buffer(double signal, char *buffer);
+
+    /// @brief Buffer version of string_format_hex().
+    char GEOPM_PUBLIC *
+        string_format_hex_buffer(double signal, char *buffer);
+
+    /// @brief Buffer version of string_format_raw64().
+    char GEOPM_PUBLIC *
+        string_format_raw64_buffer(double signal, char *buffer);
+
+    /// @brief Find the buffer function that gives the same output
+    ///        as a format function.
+    /// @param [in] format_function One of the string_format_*()
+    ///        functions, or any other function.
+    /// @return The equivalent string_format_*_buffer() function, or
+    ///         nullptr if format_function is not one of the
+    ///         string_format_*() functions.
+    string_format_buffer_f GEOPM_PUBLIC
+        string_format_function_to_buffer(const std::function<std::string(double)> &format_function);
+
     /// @brief Cache line size used to properly align structs to avoid
     ///        false sharing between threads.
     /// @todo  Replace with C++17 standard library equivalent.
@@ -115,6 +115,18 @@ namespace geopm
             ///        call to push_signal().
             /// @return Value of signal in SI units.
             virtual double sample(int sample_idx) = 0;
+            /// @brief Retrieve the values of several signals from
+            ///        data read by last call to read_batch().  The
+            ///        default implementation calls sample() for each
+            ///        index; IOGroups may override this with a bulk
+            ///        implementation.
+            /// @param [in] sample_idx The indices returned by
+            ///        previous calls to push_signal().
+            /// @param [out] result Array of at least
+            ///        sample_idx.size() values that is filled with
+            ///        the value of each signal in SI units.
+            virtual void sample_all(const std::vector<int> &sample_idx,
+                                    double *result);
             /// @brief Adjust a setting for a particular control that
             ///        was previously pushed with push_control(). This
             ///        adjustment will be written to the platform on
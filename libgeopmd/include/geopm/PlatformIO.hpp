@@ -122,6 +122,24 @@ namespace geopm
             ///
             /// @return Signal value measured from the platform in SI units.
             virtual double sample(int signal_idx) = 0;
+            /// @brief Sample several signals that have been pushed on
+            ///        to the signal stack into a caller provided
+            ///        buffer.  Must be called after a call to
+            ///        read_batch(void).  Equivalent to calling
+            ///        sample() for each index, but consecutive
+            ///        signals provided by the same IOGroup are
+            ///        retrieved with a single call to
+            ///        IOGroup::sample_all().
+            ///
+            /// @param [in] signal_idx indices returned by previous
+            ///        calls to the push_signal() method.
+            ///
+            /// @param [out] result Array of at least
+            ///        signal_idx.size() values that is filled with the
+            ///        signal values measured from the platform in SI
+            ///        units.
+            virtual void sample_all(const std::vector<int> &signal_idx,
+                                    double *result) = 0;
             /// @brief Adjust a single control that has been pushed on
             ///        to the control stack.  This control will not
             ///        take effect until the next call to
@@ -9,6 +9,8 @@
 #include "geopm_hash.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 #include <algorithm>
 #include <numeric>
@@ -18,6 +20,147 @@
 
 namespace geopm
 {
+    // The array functions are written with the GCC/Clang vector
+    // extensions so that they use SIMD registers at the baseline
+    // instruction set without reassociating floating point operations
+    // behind the compiler's back, which it will not do under
+    // -fno-fast-math.  Comparisons of vectors produce masks with all
+    // bits set in the lanes where the comparison is true.
+    typedef double m_vec_t __attribute__((vector_size(16)));
+    typedef int64_t m_mask_t __attribute__((vector_size(16)));
+    static constexpr size_t M_NUM_LANE = sizeof(m_vec_t) / sizeof(double);
+
+    static inline m_vec_t array_load(const double *operand)
+    {
+        m_vec_t result;
+        std::memcpy(&result, operand, sizeof(result));
+        return result;
+    }
+
+    static inline m_vec_t array_select(m_mask_t mask, m_vec_t if_true, m_vec_t if_false)
+    {
+        return (m_vec_t)(((m_mask_t)if_true & mask) | ((m_mask_t)if_false & ~mask));
+    }
+
+    // Load the tail of the array padded with pad_value
+    static inline m_vec_t array_load_tail(const double *operand, size_t num_operand, double pad_value)
+    {
+        double tail[M_NUM_LANE];
+        std::fill(tail, tail + M_NUM_LANE, pad_value);
+        std::copy(operand, operand + num_operand, tail);
+        return array_load(tail);
+    }
+
+    static inline m_vec_t array_broadcast(double value)
+    {
+        return array_load_tail(nullptr, 0, value);
+    }
+
+    static double array_sum_count(const double *operand, size_t num_operand, int64_t &count)
+    {
+        m_vec_t total = {};
+        m_mask_t valid = {};
+        size_t idx = 0;
+        for (; idx + M_NUM_LANE <= num_operand; idx += M_NUM_LANE) {
+            m_vec_t value = array_load(operand + idx);
+            m_mask_t is_valid = value == value;
+            total += (m_vec_t)((m_mask_t)value & is_valid);
+            valid -= is_valid;
+        }
+        if (idx < num_operand) {
+            m_vec_t value = array_load_tail(operand + idx, num_operand - idx, NAN);
+            m_mask_t is_valid = value == value;
+            total += (m_vec_t)((m_mask_t)value & is_valid);
+            valid -= is_valid;
+        }
+        count = 0;
+        double result = 0.0;
+        for (size_t lane = 0; lane < M_NUM_LANE; ++lane) {
+            count += valid[lane];
+            result += total[lane];
+        }
+        return result;
+    }
+
+    static double array_sum(const double *operand, size_t num_operand)
+    {
+        int64_t count = 0;
+        double result = array_sum_count(operand, num_operand, count);
+        return count != 0 ? result : NAN;
+    }
+
+    static double array_average(const double *operand, size_t num_operand)
+    {
+        int64_t count = 0;
+        double result = array_sum_count(operand, num_operand, count);
+        return count != 0 ? result / count : NAN;
+    }
+
+    template <bool is_min>
+    static inline m_mask_t array_is_more(m_vec_t value, m_vec_t extreme)
+    {
+        return is_min ? value < extreme : value > extreme;
+    }
+
+    template <bool is_min>
+    static double array_extreme(const double *operand, size_t num_operand)
+    {
+        const double init = is_min ? INFINITY : -INFINITY;
+        m_vec_t extreme = array_broadcast(init);
+        m_mask_t valid = {};
+        size_t idx = 0;
+        // Comparisons with NAN are false, so NAN operands never
+        // replace the current extreme.
+        for (; idx + M_NUM_LANE <= num_operand; idx += M_NUM_LANE) {
+            m_vec_t value = array_load(operand + idx);
+            extreme = array_select(array_is_more<is_min>(value, extreme), value, extreme);
+            valid |= value == value;
+        }
+        if (idx < num_operand) {
+            m_vec_t value = array_load_tail(operand + idx, num_operand - idx, NAN);
+            extreme = array_select(array_is_more<is_min>(value, extreme), value, extreme);
+            valid |= value == value;
+        }
+        double result = NAN;
+        bool is_valid = false;
+        for (size_t lane = 0; lane < M_NUM_LANE; ++lane) {
+            if (valid[lane]) {
+                result = is_valid ? (is_min ? std::min(result, extreme[lane]) :
+                                              std::max(result, extreme[lane])) :
+                                    extreme[lane];
+                is_valid = true;
+            }
+        }
+        return result;
+    }
+
+    static double array_logical_or(const double *operand, size_t num_operand)
+    {
+        const m_vec_t zero = {};
+        m_mask_t valid = {};
+        m_mask_t non_zero = {};
+        size_t idx = 0;
+        for (; idx + M_NUM_LANE <= num_operand; idx += M_NUM_LANE) {
+            m_vec_t value = array_load(operand + idx);
+            m_mask_t is_valid = value == value;
+            valid |= is_valid;
+            non_zero |= is_valid & (value != zero);
+        }
+        if (idx < num_operand) {
+            m_vec_t value = array_load_tail(operand + idx, num_operand - idx, NAN);
+            m_mask_t is_valid = value == value;
+            valid |= is_valid;
+            non_zero |= is_valid & (value != zero);
+        }
+        bool any_valid = false;
+        bool any_non_zero = false;
+        for (size_t lane = 0; lane < M_NUM_LANE; ++lane) {
+            any_valid |= valid[lane] != 0;
+            any_non_zero |= non_zero[lane] != 0;
+        }
+        return any_valid ? (double)any_non_zero : NAN;
+    }
+
     std::vector<double> nan_filter(const std::vector<double> &operand)
     {
         std::vector<double> result;
@@ -322,4 +465,26 @@ namespace geopm
         }
         return result->second;
     }
+
+    Agg::ArrayFunction Agg::function_to_array_function(std::function<double(const std::vector<double> &)> func)
+    {
+        static const std::map<decltype(&sum), ArrayFunction> function_map = {
+            {sum, array_sum},
+            {average, array_average},
+            {min, array_extreme<true>},
+            {max, array_extreme<false>},
+            {logical_or, array_logical_or},
+        };
+        ArrayFunction result = nullptr;
+        // Functions that are not one of the static Agg methods, for
+        // example lambdas provided by an IOGroup, have no array form.
+        auto f_ptr = func.target<decltype(&sum)>();
+        if (f_ptr != nullptr) {
+            auto it = function_map.find(*f_ptr);
+            if (it != function_map.end()) {
+                result = it->second;
+            }
+        }
+        return result;
+    }
 }
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "BatchCache.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <set>
+
+#include "geopm_hash.h"
+#include "geopm_time.h"
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/IOGroup.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm/SharedMemory.hpp"
+
+namespace geopm
+{
+    std::unique_ptr<BatchCache> BatchCache::make_unique(double max_staleness)
+    {
+        return geopm::make_unique<BatchCacheImp>(max_staleness);
+    }
+
+    bool BatchCache::is_cacheable(const std::string &signal_name,
+                                  int signal_behavior)
+    {
+        // Variable signals that are read from the hardware with no
+        // state held by the reader.  Derived signals such as power
+        // must not be added: they depend on the previous samples of
+        // the process that computed them.
+        static const std::set<std::string> variable_allowed = {
+            "CPU_FREQUENCY_STATUS",
+            "CPU_UNCORE_FREQUENCY_STATUS",
+            "CPU_CORE_TEMPERATURE",
+            "CPU_PACKAGE_TEMPERATURE",
+            "CPU_FREQUENCY_MIN_CONTROL",
+            "CPU_FREQUENCY_MAX_CONTROL",
+            "CPU_FREQUENCY_DESIRED_CONTROL",
+            "CPU_UNCORE_FREQUENCY_MIN_CONTROL",
+            "CPU_UNCORE_FREQUENCY_MAX_CONTROL",
+            "CPU_POWER_LIMIT_CONTROL",
+            "CPU_POWER_TIME_WINDOW_CONTROL",
+            "BOARD_POWER_LIMIT_CONTROL",
+            "BOARD_POWER_TIME_WINDOW_CONTROL",
+            "GPU_CORE_FREQUENCY_STATUS",
+            "GPU_CORE_FREQUENCY_MIN_CONTROL",
+            "GPU_CORE_FREQUENCY_MAX_CONTROL",
+            "GPU_UNCORE_FREQUENCY_STATUS",
+        };
+        bool result = false;
+        if (signal_name == "TIME" || string_begins_with(signal_name, "TIME::")) {
+            // Elapsed time is measured from the start of each process
+            result = false;
+        }
+        else if (signal_behavior == IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT ||
+                 signal_behavior == IOGroup::M_SIGNAL_BEHAVIOR_LABEL) {
+            result = true;
+        }
+        else if (signal_behavior == IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE) {
+            result = variable_allowed.find(signal_name) != variable_allowed.end();
+        }
+        return result;
+    }
+
+    std::string BatchCache::shmem_key(void)
+    {
+        return "/run/geopm/batch-cache";
+    }
+
+    size_t BatchCache::shmem_size(void)
+    {
+        return sizeof(BatchCacheImp::m_layout_s);
+    }
+
+    BatchCache::m_stats_s BatchCache::read_stats(void)
+    {
+        std::shared_ptr<SharedMemory> shmem = SharedMemory::make_unique_user(shmem_key(), 0);
+        if (shmem->size() < shmem_size()) {
+            throw Exception("BatchCache::read_stats(): Shared memory region " + shmem->key() +
+                            " is too small for the batch cache",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        auto layout = (const BatchCacheImp::m_layout_s *)shmem->pointer();
+        BatchCacheImp::check_version(*shmem);
+        return {layout->num_request.load(std::memory_order_relaxed),
+                layout->num_read.load(std::memory_order_relaxed)};
+    }
+
+    void BatchCache::remove(void)
+    {
+        SharedMemory::make_unique_user(shmem_key(), 0)->unlink();
+    }
+
+    BatchCacheImp::BatchCacheImp(double max_staleness)
+        : BatchCacheImp(max_staleness, open_shmem())
+    {
+
+    }
+
+    BatchCacheImp::BatchCacheImp(double max_staleness,
+                                 std::shared_ptr<SharedMemory> shmem)
+        : m_max_staleness(max_staleness)
+        , m_shmem(shmem)
+        , m_layout(nullptr)
+    {
+        if (!(m_max_staleness > 0.0)) {
+            throw Exception("BatchCacheImp: Maximum staleness must be a positive number of seconds: " +
+                            std::to_string(m_max_staleness),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_shmem->size() < shmem_size()) {
+            throw Exception("BatchCacheImp: Shared memory region " + m_shmem->key() +
+                            " is too small for the batch cache",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_layout = (m_layout_s *)m_shmem->pointer();
+        // A zero filled region is valid for any version: the first
+        // user claims it for this one.
+        uint64_t version = 0;
+        m_layout->version.compare_exchange_strong(version, M_LAYOUT_VERSION,
+                                                  std::memory_order_acq_rel);
+        check_version(*m_shmem);
+    }
+
+    void BatchCacheImp::check_version(const SharedMemory &shmem)
+    {
+        auto layout = (const m_layout_s *)shmem.pointer();
+        uint64_t version = layout->version.load(std::memory_order_acquire);
+        if (version != M_LAYOUT_VERSION) {
+            throw Exception("BatchCacheImp: Shared memory region " + shmem.key() +
+                            " has layout version " + std::to_string(version) +
+                            ", expected " + std::to_string(M_LAYOUT_VERSION) +
+                            ": remove it with \"geopmbatch --cache-remove\"",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    std::shared_ptr<SharedMemory> BatchCacheImp::open_shmem(void)
+    {
+        // The region is zero filled on creation which marks every
+        // entry as empty.  The first server on the node creates it
+        // and every later server attaches to it.
+        std::shared_ptr<SharedMemory> result;
+        try {
+            result = SharedMemory::make_unique_owner_secure(shmem_key(), shmem_size());
+        }
+        catch (const Exception &ex) {
+            if (ex.err_value() != EEXIST) {
+                throw;
+            }
+            result = SharedMemory::make_unique_user(shmem_key(), 1);
+        }
+        return result;
+    }
+
+    std::vector<int> BatchCacheImp::push_requests(const std::vector<geopm_request_s> &requests)
+    {
+        std::vector<int> result;
+        for (const auto &req : requests) {
+            int entry_idx = find_entry(req);
+            if (entry_idx == -1) {
+                result.clear();
+                break;
+            }
+            result.push_back(entry_idx);
+        }
+        return result;
+    }
+
+    int BatchCacheImp::find_entry(const geopm_request_s &request)
+    {
+        int result = -1;
+        std::string name(request.name, strnlen(request.name, NAME_MAX));
+        std::string hash_key = name + "@" + std::to_string(request.domain_type) +
+                               ":" + std::to_string(request.domain_idx);
+        int start_idx = geopm_crc32_str(hash_key.c_str()) % M_NUM_ENTRY;
+        for (int probe = 0; result == -1 && probe < M_NUM_ENTRY; ++probe) {
+            int entry_idx = (start_idx + probe) % M_NUM_ENTRY;
+            m_entry_s &entry = m_layout->entry[entry_idx];
+            uint32_t state = entry.state.load(std::memory_order_acquire);
+            if (state == M_ENTRY_EMPTY) {
+                if (entry.state.compare_exchange_strong(state, M_ENTRY_CLAIMED,
+                                                        std::memory_order_acq_rel)) {
+                    entry.domain_type = request.domain_type;
+                    entry.domain_idx = request.domain_idx;
+                    strncpy(entry.name, name.c_str(), NAME_MAX - 1);
+                    entry.name[NAME_MAX - 1] = '\0';
+                    entry.time.store(0.0, std::memory_order_relaxed);
+                    entry.state.store(M_ENTRY_READY, std::memory_order_release);
+                    state = M_ENTRY_READY;
+                }
+            }
+            // Another server is filling in the entry key
+            for (int spin = 0; state == M_ENTRY_CLAIMED && spin < M_CLAIM_SPIN_COUNT; ++spin) {
+                state = entry.state.load(std::memory_order_acquire);
+            }
+            if (state == M_ENTRY_CLAIMED) {
+                break;
+            }
+            if (entry.domain_type == request.domain_type &&
+                entry.domain_idx == request.domain_idx &&
+                name == entry.name) {
+                result = entry_idx;
+            }
+        }
+        return result;
+    }
+
+    bool BatchCacheImp::sample(const std::vector<int> &entry_idx, double *result)
+    {
+        double time_min = time_now() - m_max_staleness;
+        size_t num_entry = entry_idx.size();
+        for (size_t idx = 0; idx < num_entry; ++idx) {
+            m_entry_s &entry = m_layout->entry[entry_idx[idx]];
+            double time_begin = entry.time.load(std::memory_order_acquire);
+            double value = entry.value.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            double time_end = entry.time.load(std::memory_order_relaxed);
+            // A zero time marks an update in progress
+            if (time_begin == 0.0 || time_begin != time_end || time_begin < time_min) {
+                return false;
+            }
+            result[idx] = value;
+        }
+        m_layout->num_request.fetch_add(num_entry, std::memory_order_relaxed);
+        return true;
+    }
+
+    void BatchCacheImp::update(const std::vector<int> &entry_idx, const double *value)
+    {
+        double time = time_now();
+        size_t num_entry = entry_idx.size();
+        for (size_t idx = 0; idx < num_entry; ++idx) {
+            m_entry_s &entry = m_layout->entry[entry_idx[idx]];
+            entry.time.store(0.0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            entry.value.store(value[idx], std::memory_order_relaxed);
+            entry.time.store(time, std::memory_order_release);
+        }
+        m_layout->num_read.fetch_add(num_entry, std::memory_order_relaxed);
+        m_layout->num_request.fetch_add(num_entry, std::memory_order_relaxed);
+    }
+
+    BatchCache::m_stats_s BatchCacheImp::stats(void) const
+    {
+        return {m_layout->num_request.load(std::memory_order_relaxed),
+                m_layout->num_read.load(std::memory_order_relaxed)};
+    }
+
+    double BatchCacheImp::time_now(void)
+    {
+        geopm_time_s now;
+        geopm_time(&now);
+        return now.t.tv_sec + 1.0e-9 * now.t.tv_nsec;
+    }
+}
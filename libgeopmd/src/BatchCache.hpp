@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BATCHCACHE_HPP_INCLUDE
+#define BATCHCACHE_HPP_INCLUDE
+
+#include <atomic>
+#include <cstdint>
+#include <limits.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct geopm_request_s;
+
+namespace geopm
+{
+    class SharedMemory;
+
+    /// @brief Node wide cache of signal values shared by all batch
+    ///        servers.
+    ///
+    /// Batch servers that are started for different clients often
+    /// read the same signals.  Each server publishes the values that
+    /// it reads into a shared memory table keyed by signal name,
+    /// domain type and domain index.  A server may skip reading the
+    /// platform when every signal that it needs was published by any
+    /// server within the configured maximum staleness.
+    ///
+    /// Only signals that have the same value in every process may be
+    /// shared; see is_cacheable().
+    class BatchCache
+    {
+        public:
+            struct m_stats_s {
+                /// @brief Number of signal values provided to batch
+                ///        clients by all servers.
+                uint64_t num_request;
+                /// @brief Number of signal values read from the
+                ///        platform by all servers.
+                uint64_t num_read;
+            };
+
+            BatchCache() = default;
+            virtual ~BatchCache() = default;
+            /// @brief Attach to the node wide cache, creating it if
+            ///        it does not exist.
+            ///
+            /// @param max_staleness [in] Maximum age in seconds of a
+            ///                      cached value that may be provided
+            ///                      in place of reading the platform.
+            static std::unique_ptr<BatchCache> make_unique(double max_staleness);
+            /// @brief Check if a signal may be shared between batch
+            ///        servers.
+            ///
+            /// The value of a signal may depend on the process that
+            /// read it: TIME counts from the start of the process,
+            /// counters are extended across overflow by each reader
+            /// and derived signals keep the history of the samples
+            /// read by the process.  Signals with constant or label
+            /// behavior are cacheable, as are a fixed list of
+            /// variable signals that are read directly from the
+            /// hardware without any state held by the reader.
+            ///
+            /// @param signal_name [in] Name of the signal.
+            ///
+            /// @param signal_behavior [in] One of the
+            ///        IOGroup::m_signal_behavior_e values reported
+            ///        for the signal.
+            ///
+            /// @return True if a value read by one server may be
+            ///         provided to the clients of another.
+            static bool is_cacheable(const std::string &signal_name,
+                                     int signal_behavior);
+            /// @brief Find or create the cache entries for a set of
+            ///        signal requests.
+            ///
+            /// @param requests [in] Signal requests made by a batch
+            ///                 client.
+            ///
+            /// @return Cache entry index for each request, or an empty
+            ///         vector if the cache is full.
+            virtual std::vector<int> push_requests(const std::vector<geopm_request_s> &requests) = 0;
+            /// @brief Copy cached values if all of them are fresh.
+            ///
+            /// @param entry_idx [in] Entry indices returned by
+            ///                  push_requests().
+            ///
+            /// @param result [out] Array of entry_idx.size() values
+            ///               that is written only if all entries are
+            ///               younger than the maximum staleness.
+            ///
+            /// @return True if the result was written.
+            virtual bool sample(const std::vector<int> &entry_idx, double *result) = 0;
+            /// @brief Publish values read from the platform.
+            ///
+            /// @param entry_idx [in] Entry indices returned by
+            ///                  push_requests().
+            ///
+            /// @param value [in] Array of entry_idx.size() values.
+            virtual void update(const std::vector<int> &entry_idx, const double *value) = 0;
+            /// @return Counters accumulated by all users of the
+            ///         cache.
+            virtual m_stats_s stats(void) const = 0;
+            /// @brief Attach to an existing node wide cache and read
+            ///        its counters.
+            ///
+            /// @return Counters accumulated by all users of the
+            ///         cache.
+            static m_stats_s read_stats(void);
+            /// @brief Remove the node wide cache.
+            ///
+            /// Servers that are attached keep using the removed
+            /// region, servers started afterward create a new one.
+            /// Used to recover from a cache left behind by a previous
+            /// version of the service.
+            static void remove(void);
+            /// @return The shm key of the node wide cache.
+            static std::string shmem_key(void);
+            /// @return Size in bytes of the cache shared memory region.
+            static size_t shmem_size(void);
+    };
+
+    class BatchCacheImp : public BatchCache
+    {
+        public:
+            BatchCacheImp(double max_staleness);
+            BatchCacheImp(double max_staleness,
+                          std::shared_ptr<SharedMemory> shmem);
+            BatchCacheImp(const BatchCacheImp &other) = delete;
+            BatchCacheImp &operator=(const BatchCacheImp &other) = delete;
+            virtual ~BatchCacheImp() = default;
+            std::vector<int> push_requests(const std::vector<geopm_request_s> &requests) override;
+            bool sample(const std::vector<int> &entry_idx, double *result) override;
+            void update(const std::vector<int> &entry_idx, const double *value) override;
+            m_stats_s stats(void) const override;
+        private:
+            /// @brief Incremented with any change to m_layout_s.
+            static constexpr uint64_t M_LAYOUT_VERSION = 1;
+            static constexpr int M_NUM_ENTRY = 8192;
+            static constexpr uint32_t M_ENTRY_EMPTY = 0;
+            static constexpr uint32_t M_ENTRY_CLAIMED = 1;
+            static constexpr uint32_t M_ENTRY_READY = 2;
+            static constexpr int M_CLAIM_SPIN_COUNT = 1000000;
+            struct m_entry_s {
+                std::atomic<uint32_t> state;
+                int32_t domain_type;
+                int32_t domain_idx;
+                char name[NAME_MAX];
+                /// @brief Time the value was read in seconds, zero
+                ///        while the value is being updated.
+                std::atomic<double> time;
+                std::atomic<double> value;
+            };
+            struct m_layout_s {
+                /// @brief Zero until the first user of the region
+                ///        stamps it with M_LAYOUT_VERSION.
+                std::atomic<uint64_t> version;
+                std::atomic<uint64_t> num_request;
+                std::atomic<uint64_t> num_read;
+                char padding[64 - 3 * sizeof(uint64_t)];
+                m_entry_s entry[M_NUM_ENTRY];
+            };
+            friend class BatchCache;
+            static std::shared_ptr<SharedMemory> open_shmem(void);
+            int find_entry(const geopm_request_s &request);
+            static double time_now(void);
+            static void check_version(const SharedMemory &shmem);
+
+            const double m_max_staleness;
+            std::shared_ptr<SharedMemory> m_shmem;
+            m_layout_s *m_layout;
+    };
+}
+
+#endif
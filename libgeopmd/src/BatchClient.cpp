@@ -27,8 +27,29 @@ namespace geopm
                                                   num_signal, num_control);
     }
 
+    std::unique_ptr<BatchClient> BatchClient::make_unique(const std::string &server_key,
+                                                          double timeout,
+                                                          int num_signal,
+                                                          int num_control,
+                                                          int transport,
+                                                          double sample_period)
+    {
+        return geopm::make_unique<BatchClientImp>(server_key, timeout,
+                                                  num_signal, num_control,
+                                                  transport, sample_period);
+    }
+
     BatchClientImp::BatchClientImp(const std::string &server_key, double timeout,
                                    int num_signal, int num_control)
+        : BatchClientImp(server_key, timeout, num_signal, num_control,
+                         BatchStatus::M_TRANSPORT_FIFO, 0.0)
+    {
+
+    }
+
+    BatchClientImp::BatchClientImp(const std::string &server_key, double timeout,
+                                   int num_signal, int num_control, int transport,
+                                   double sample_period)
         : BatchClientImp(num_signal, num_control,
                          BatchStatus::make_unique_client(server_key),
                          num_signal == 0 ? nullptr :
@@ -38,7 +59,18 @@ namespace geopm
                          num_control == 0 ? nullptr :
                             SharedMemory::make_unique_user(
                                 BatchServer::get_control_shmem_key(
-                                    server_key), timeout))
+                                    server_key), timeout),
+                         transport == BatchStatus::M_TRANSPORT_FIFO ? nullptr :
+                            BatchStatus::make_unique_shmem_client(
+                                SharedMemory::make_unique_user(
+                                    BatchServer::get_status_shmem_key(
+                                        server_key), timeout),
+                                transport),
+                         num_signal == 0 || sample_period == 0.0 ? nullptr :
+                            SharedMemory::make_unique_user(
+                                BatchServer::get_snapshot_shmem_key(
+                                    server_key), timeout),
+                         sample_period)
     {
 
     }
@@ -48,13 +80,63 @@ namespace geopm
                                    std::shared_ptr<BatchStatus> batch_status,
                                    std::shared_ptr<SharedMemory> signal_shmem,
                                    std::shared_ptr<SharedMemory> control_shmem)
+        : BatchClientImp(num_signal, num_control, std::move(batch_status),
+                         std::move(signal_shmem), std::move(control_shmem),
+                         nullptr, nullptr, 0.0)
+    {
+
+    }
+
+    BatchClientImp::BatchClientImp(int num_signal, int num_control,
+                                   std::shared_ptr<BatchStatus> batch_status,
+                                   std::shared_ptr<SharedMemory> signal_shmem,
+                                   std::shared_ptr<SharedMemory> control_shmem,
+                                   std::shared_ptr<BatchStatus> shmem_status,
+                                   std::shared_ptr<SharedMemory> snapshot_shmem,
+                                   double sample_period)
         : m_num_signal(num_signal)
         , m_num_control(num_control)
         , m_batch_status(std::move(batch_status))
+        , m_shmem_status(std::move(shmem_status))
         , m_signal_shmem(std::move(signal_shmem))
         , m_control_shmem(std::move(control_shmem))
+        , m_snapshot_shmem(std::move(snapshot_shmem))
+        , m_is_sampling(false)
     {
+        if (m_snapshot_shmem != nullptr) {
+            if (!(sample_period > 0.0)) {
+                throw Exception("BatchClientImp: sample_period must be positive: " +
+                                std::to_string(sample_period),
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            // The server reads the period when sampling is started
+            auto header = (BatchServer::m_snapshot_header_s *)m_snapshot_shmem->pointer();
+            header->period = sample_period;
+        }
+    }
 
+    void BatchClientImp::select_transport(void)
+    {
+        if (m_shmem_status != nullptr) {
+            m_batch_status->send_message(BatchStatus::M_MESSAGE_SHMEM);
+            m_batch_status->receive_message(BatchStatus::M_MESSAGE_CONTINUE);
+            m_batch_status = std::move(m_shmem_status);
+            m_shmem_status = nullptr;
+        }
+    }
+
+    void BatchClientImp::start_sampling(void)
+    {
+        try {
+            select_transport();
+            m_batch_status->send_message(BatchStatus::M_MESSAGE_SAMPLE);
+            m_batch_status->receive_message(BatchStatus::M_MESSAGE_CONTINUE);
+        }
+        catch (const Exception &ex) {
+            throw Exception("BatchClient::" + std::string(__func__) + " The server is unresponsive",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_is_sampling = true;
     }
 
     std::vector<double> BatchClientImp::read_batch(void)
@@ -62,7 +144,21 @@ namespace geopm
         if (m_num_signal == 0) {
             return {};
         }
+        if (m_snapshot_shmem != nullptr) {
+            if (!m_is_sampling) {
+                start_sampling();
+            }
+            auto header = (BatchServer::m_snapshot_header_s *)m_snapshot_shmem->pointer();
+            if (header->error.load() != 0) {
+                throw Exception("BatchClient::" + std::string(__func__) + " The server stopped periodic sampling",
+                                header->error.load(), __FILE__, __LINE__);
+            }
+            std::vector<double> result(m_num_signal);
+            BatchServer::read_snapshot(header, m_num_signal, result.data());
+            return result;
+        }
         try {
+            select_transport();
             m_batch_status->send_message(BatchStatus::M_MESSAGE_READ);
             m_batch_status->receive_message(BatchStatus::M_MESSAGE_CONTINUE);
         }
@@ -87,6 +183,7 @@ namespace geopm
         double *buffer = (double *)m_control_shmem->pointer();
         std::copy(settings.begin(), settings.end(), buffer);
         try {
+            select_transport();
             m_batch_status->send_message(BatchStatus::M_MESSAGE_WRITE);
             m_batch_status->receive_message(BatchStatus::M_MESSAGE_CONTINUE);
         }
@@ -50,6 +50,34 @@ namespace geopm
                                                             double timeout,
                                                             int num_signal,
                                                             int num_control);
+            /// @brief Factory method to create a pointer to a BatchClient object
+            ///        that uses the specified message transport and
+            ///        sampling mode.
+            ///
+            /// @param transport [in] One of the BatchStatus::m_transport_e
+            ///                  values.  With M_TRANSPORT_FUTEX or
+            ///                  M_TRANSPORT_BUSY_POLL the client asks the
+            ///                  server to switch the session to the
+            ///                  shared memory transport before the first
+            ///                  read or write request.
+            ///
+            /// @param sample_period [in] If zero, each call to
+            ///                      read_batch() asks the server to read
+            ///                      the signals.  Otherwise the first call
+            ///                      to read_batch() asks the server to
+            ///                      sample the signals on its own with
+            ///                      this period in seconds, and every call
+            ///                      returns the latest sample from shared
+            ///                      memory without contacting the server.
+            ///
+            /// @return New unique pointer to an object that supports the
+            ///         BatchClient interface.
+            static std::unique_ptr<BatchClient> make_unique(const std::string &server_key,
+                                                            double timeout,
+                                                            int num_signal,
+                                                            int num_control,
+                                                            int transport,
+                                                            double sample_period);
 
             /// @brief Ask batch server to read all signal values and return
             ///        result.
@@ -81,20 +109,46 @@ namespace geopm
         public:
             BatchClientImp(const std::string &server_key, double timeout,
                            int num_signal, int num_control);
+            BatchClientImp(const std::string &server_key, double timeout,
+                           int num_signal, int num_control, int transport,
+                           double sample_period);
             BatchClientImp(int num_signal, int num_control,
                            std::shared_ptr<BatchStatus> batch_status,
                            std::shared_ptr<SharedMemory> signal_shmem,
                            std::shared_ptr<SharedMemory> control_shmem);
+            BatchClientImp(int num_signal, int num_control,
+                           std::shared_ptr<BatchStatus> batch_status,
+                           std::shared_ptr<SharedMemory> signal_shmem,
+                           std::shared_ptr<SharedMemory> control_shmem,
+                           std::shared_ptr<BatchStatus> shmem_status,
+                           std::shared_ptr<SharedMemory> snapshot_shmem,
+                           double sample_period);
             virtual ~BatchClientImp() = default;
             std::vector<double> read_batch(void) override;
             void write_batch(std::vector<double> settings) override;
             void stop_batch(void) override;
         private:
+            /// @brief Switch the session to the shared memory
+            ///        transport if requested and not yet done.
+            void select_transport(void);
+            /// @brief Ask the server to begin periodic sampling if
+            ///        requested and not yet done.
+            void start_sampling(void);
+
             int m_num_signal;
             int m_num_control;
             std::shared_ptr<BatchStatus> m_batch_status;
+            /// @brief Shared memory transport that replaces
+            ///        m_batch_status after the first request, or
+            ///        nullptr if the FIFO transport is used.
+            std::shared_ptr<BatchStatus> m_shmem_status;
             std::shared_ptr<SharedMemory> m_signal_shmem;
             std::shared_ptr<SharedMemory> m_control_shmem;
+            /// @brief Region written by the server in periodic
+            ///        sampling mode, or nullptr if signals are read
+            ///        on demand.
+            std::shared_ptr<SharedMemory> m_snapshot_shmem;
+            bool m_is_sampling;
     };
 }
 
@@ -5,10 +5,15 @@
 
 #include "BatchServer.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <cerrno>
 #include <sstream>
 #include <limits.h>
+#include <pthread.h>
+#include <signal.h>
 #include <unistd.h>
 #include <wait.h>
 #include <iostream>
@@ -23,6 +28,7 @@
 #include "geopm/SharedMemory.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/PlatformIO.hpp"
+#include "BatchCache.hpp"
 #include "BatchStatus.hpp"
 #include "POSIXSignal.hpp"
 #include "geopm_debug.hpp"
@@ -41,6 +47,21 @@ static void action_sigterm(int signo, siginfo_t *siginfo, void *context)
 
 namespace geopm
 {
+    static void print_cache_stats(std::ostream &out)
+    {
+        BatchCache::m_stats_s stats = BatchCache::read_stats();
+        out << "requests: " << stats.num_request << "\n"
+            << "reads: " << stats.num_read << "\n"
+            << "dedup-ratio: ";
+        if (stats.num_read != 0) {
+            out << (double)stats.num_request / stats.num_read;
+        }
+        else {
+            out << "NAN";
+        }
+        out << std::endl;
+    }
+
     std::unique_ptr<BatchServer>
     BatchServer::make_unique(int client_pid,
                              const std::vector<geopm_request_s> &signal_config,
@@ -62,12 +83,48 @@ namespace geopm
         return M_SHMEM_PREFIX + server_key + "-control";
     }
 
+    std::string BatchServer::get_status_shmem_key(
+        const std::string &server_key)
+    {
+        return M_SHMEM_PREFIX + server_key + "-status";
+    }
+
+    std::string BatchServer::get_snapshot_shmem_key(
+        const std::string &server_key)
+    {
+        return M_SHMEM_PREFIX + server_key + "-snapshot";
+    }
+
+    size_t BatchServer::snapshot_shmem_size(int num_signal)
+    {
+        return sizeof(m_snapshot_header_s) + 2 * num_signal * sizeof(double);
+    }
+
+    void BatchServer::read_snapshot(const void *snapshot, int num_signal,
+                                    double *result)
+    {
+        const m_snapshot_header_s *header = (const m_snapshot_header_s *)snapshot;
+        const double *buffer = (const double *)(header + 1);
+        uint64_t seq_begin = 0;
+        uint64_t seq_end = 0;
+        do {
+            seq_begin = header->seq.load(std::memory_order_acquire);
+            const double *latest = buffer + ((seq_begin / 2) % 2) * num_signal;
+            std::copy(latest, latest + num_signal, result);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq_end = header->seq.load(std::memory_order_relaxed);
+            // The buffer that was copied is only overwritten by the
+            // second write that begins after seq_begin was loaded.
+        } while (seq_end - seq_begin >= 2);
+    }
+
     BatchServerImp::BatchServerImp(
         int client_pid,
         const std::vector<geopm_request_s> &signal_config,
         const std::vector<geopm_request_s> &control_config)
-        : BatchServerImp(client_pid, signal_config, control_config, "", "",
-                         platform_io(), nullptr, nullptr, nullptr, nullptr, 0)
+        : BatchServerImp(client_pid, signal_config, control_config, "", "", "", "",
+                         platform_io(), nullptr, nullptr, nullptr, nullptr,
+                         nullptr, nullptr, make_cache(), 0)
     {
 
     }
@@ -78,11 +135,16 @@ namespace geopm
         const std::vector<geopm_request_s> &control_config,
         const std::string &signal_shmem_key,
         const std::string &control_shmem_key,
+        const std::string &status_shmem_key,
+        const std::string &snapshot_shmem_key,
         PlatformIO &pio,
         std::shared_ptr<BatchStatus> batch_status,
         std::shared_ptr<POSIXSignal> posix_signal,
         std::shared_ptr<SharedMemory> signal_shmem,
         std::shared_ptr<SharedMemory> control_shmem,
+        std::shared_ptr<SharedMemory> status_shmem,
+        std::shared_ptr<SharedMemory> snapshot_shmem,
+        std::shared_ptr<BatchCache> cache,
         int server_pid)
         : m_client_pid(client_pid)
         , m_server_key(std::to_string(m_client_pid))
@@ -95,24 +157,62 @@ namespace geopm
                                control_shmem_key :
                                BatchServer::get_control_shmem_key(
                                   m_server_key))
+        , m_status_shmem_key(!status_shmem_key.empty() ?
+                              status_shmem_key :
+                              BatchServer::get_status_shmem_key(
+                                  m_server_key))
+        , m_snapshot_shmem_key(!snapshot_shmem_key.empty() ?
+                                snapshot_shmem_key :
+                                BatchServer::get_snapshot_shmem_key(
+                                    m_server_key))
         , m_pio(pio)
         , m_signal_shmem(std::move(signal_shmem))
         , m_control_shmem(std::move(control_shmem))
+        , m_status_shmem(std::move(status_shmem))
+        , m_snapshot_shmem(std::move(snapshot_shmem))
         , m_batch_status(batch_status != nullptr ?
                          std::move(batch_status) :
                          BatchStatus::make_unique_server(m_client_pid, m_server_key))
         , m_posix_signal(posix_signal != nullptr ?
                          std::move(posix_signal) :
                          POSIXSignal::make_unique())
+        , m_cache(std::move(cache))
         , m_server_pid(server_pid)
         , m_is_active(true)
         , m_is_client_attached(false)
         , m_is_client_waiting(false)
+        , m_is_sampling(false)
+        , m_sample_period(NAN)
     {
 
     }
 
+    std::shared_ptr<BatchCache> BatchServerImp::make_cache(void)
+    {
+        std::shared_ptr<BatchCache> result;
+        const char *staleness_env = getenv("GEOPM_BATCH_CACHE_STALENESS");
+        if (staleness_env == nullptr || std::string(staleness_env).empty()) {
+            return result;
+        }
+        try {
+            result = BatchCache::make_unique(std::stod(staleness_env));
+        }
+        catch (const std::exception &ex) {
+            // The cache is an optimization: serve the client without it
+            std::cerr << "Warning: <geopm>: " << __FILE__ << ":" << __LINE__
+                      << " Batch server cache is disabled, GEOPM_BATCH_CACHE_STALENESS=\""
+                      << staleness_env << "\": " << ex.what() << "\n";
+        }
+        return result;
+    }
+
     BatchServerImp::~BatchServerImp()
+    {
+        stop_sampling();
+        unlink_shmem();
+    }
+
+    void BatchServerImp::unlink_shmem(void)
     {
         if (m_signal_shmem != nullptr) {
             m_signal_shmem->unlink();
@@ -121,6 +221,14 @@ namespace geopm
         if (m_control_shmem != nullptr) {
             m_control_shmem->unlink();
         }
+
+        if (m_status_shmem != nullptr) {
+            m_status_shmem->unlink();
+        }
+
+        if (m_snapshot_shmem != nullptr) {
+            m_snapshot_shmem->unlink();
+        }
     }
 
     int BatchServerImp::server_pid(void) const
@@ -148,13 +256,7 @@ namespace geopm
             }
         }
         if (!m_is_client_attached) {
-            if (m_signal_shmem != nullptr) {
-                m_signal_shmem->unlink();
-            }
-
-            if (m_control_shmem != nullptr) {
-                m_control_shmem->unlink();
-            }
+            unlink_shmem();
             m_is_client_attached = true;
         }
         return in_message;
@@ -222,6 +324,16 @@ namespace geopm
                 case BatchStatus::M_MESSAGE_TERMINATE:
                     out_message = BatchStatus::M_MESSAGE_TERMINATE;
                     break;
+                case BatchStatus::M_MESSAGE_SHMEM:
+                    // Acknowledge over the FIFO, then use the status
+                    // shared memory for the rest of the session.
+                    m_is_client_waiting = true;
+                    use_shmem_transport();
+                    continue;
+                case BatchStatus::M_MESSAGE_SAMPLE:
+                    m_is_client_waiting = true;
+                    start_sampling();
+                    break;
                 default:
                     throw Exception("BatchServerImp::run_batch(): Received unknown response from client: " +
                                     std::to_string(in_message), GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
@@ -232,6 +344,135 @@ namespace geopm
                 write_message(out_message);
             }
         }
+        stop_sampling();
+    }
+
+    void BatchServerImp::use_shmem_transport(void)
+    {
+        if (m_status_shmem == nullptr) {
+            throw Exception("BatchServerImp::use_shmem_transport(): Status shared memory was not created",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        std::shared_ptr<BatchStatus> shmem_status =
+            BatchStatus::make_unique_shmem_server(
+                m_status_shmem, m_client_pid,
+                [](void) { return g_sigterm_count != 0; });
+        write_message(BatchStatus::M_MESSAGE_CONTINUE);
+        m_batch_status = shmem_status;
+    }
+
+    void BatchServerImp::start_sampling(void)
+    {
+        if (m_snapshot_shmem == nullptr || m_is_sampling) {
+            return;
+        }
+        auto header = (m_snapshot_header_s *)m_snapshot_shmem->pointer();
+        m_sample_period = header->period;
+        if (!(m_sample_period > 0.0) || std::isinf(m_sample_period)) {
+            throw Exception("BatchServerImp::start_sampling(): Invalid sample period requested: " +
+                            std::to_string(m_sample_period),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // The period is written by the client: do not let it make
+        // the server read the hardware continuously.
+        m_sample_period = std::max(m_sample_period, M_MIN_SAMPLE_PERIOD);
+        {
+            // The snapshot is valid before the client is acknowledged
+            std::lock_guard<std::mutex> pio_lock(m_pio_mutex);
+            write_snapshot();
+        }
+        m_is_sampling = true;
+        // SIGTERM must interrupt the read() of the main thread, so the
+        // sampling thread inherits a mask that blocks it.
+        sigset_t term_set;
+        sigset_t orig_set;
+        sigemptyset(&term_set);
+        sigaddset(&term_set, SIGTERM);
+        int err = pthread_sigmask(SIG_BLOCK, &term_set, &orig_set);
+        if (err != 0) {
+            throw Exception("BatchServerImp::start_sampling(): pthread_sigmask() failed",
+                            err, __FILE__, __LINE__);
+        }
+        try {
+            m_sample_thread = std::thread(&BatchServerImp::sample_loop, this);
+        }
+        catch (...) {
+            pthread_sigmask(SIG_SETMASK, &orig_set, nullptr);
+            throw;
+        }
+        pthread_sigmask(SIG_SETMASK, &orig_set, nullptr);
+    }
+
+    void BatchServerImp::stop_sampling(void)
+    {
+        {
+            std::lock_guard<std::mutex> sample_lock(m_sample_mutex);
+            m_is_sampling = false;
+        }
+        m_sample_cv.notify_all();
+        if (m_sample_thread.joinable()) {
+            m_sample_thread.join();
+        }
+    }
+
+    void BatchServerImp::sample_loop(void)
+    {
+        auto header = (m_snapshot_header_s *)m_snapshot_shmem->pointer();
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_sample_period));
+        auto deadline = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> sample_lock(m_sample_mutex);
+        while (m_is_sampling) {
+            deadline += period;
+            auto now = std::chrono::steady_clock::now();
+            if (deadline < now) {
+                // Skip the periods that were missed rather than
+                // sampling back to back.
+                deadline = now + period;
+            }
+            if (m_sample_cv.wait_until(sample_lock, deadline,
+                                       [this] { return !m_is_sampling; })) {
+                break;
+            }
+            try {
+                std::lock_guard<std::mutex> pio_lock(m_pio_mutex);
+                write_snapshot();
+            }
+            catch (const Exception &ex) {
+                std::cerr << "Warning: <geopm>: " << __FILE__ << ":" << __LINE__
+                          << " Batch server stopped periodic sampling: " << ex.what() << "\n";
+                header->error.store(ex.err_value() != 0 ? ex.err_value() : GEOPM_ERROR_RUNTIME);
+                break;
+            }
+        }
+    }
+
+    void BatchServerImp::write_snapshot(void)
+    {
+        auto header = (m_snapshot_header_s *)m_snapshot_shmem->pointer();
+        double *buffer = (double *)(header + 1);
+        int num_signal = m_signal_handle.size();
+        uint64_t seq = header->seq.load(std::memory_order_relaxed);
+        // Odd sequence number marks the write in progress, the
+        // buffer being written is the one that is not published.
+        header->seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        sample_signals(buffer + ((seq / 2 + 1) % 2) * num_signal);
+        header->seq.store(seq + 2, std::memory_order_release);
+    }
+
+    void BatchServerImp::sample_signals(double *result)
+    {
+        // PlatformIO reads every pushed signal in one batch, so the
+        // platform is read unless all of the cached values are fresh.
+        if (m_cache != nullptr && m_cache->sample(m_cache_idx, result)) {
+            return;
+        }
+        m_pio.read_batch();
+        m_pio.sample_all(m_signal_handle, result);
+        if (m_cache != nullptr) {
+            m_cache->update(m_cache_idx, result);
+        }
     }
 
     bool BatchServerImp::is_active(void)
@@ -249,6 +490,22 @@ namespace geopm
             m_control_handle.push_back(
                 m_pio.push_control(req.name, req.domain_type, req.domain_idx));
         }
+        for (const auto &req : m_signal_config) {
+            if (m_cache != nullptr &&
+                !BatchCache::is_cacheable(req.name, m_pio.signal_behavior(req.name))) {
+                // Skipping read_batch() would be visible in this
+                // signal, and a shared value would differ from the
+                // value this server reads.
+                m_cache.reset();
+            }
+        }
+        if (m_cache != nullptr) {
+            m_cache_idx = m_cache->push_requests(m_signal_config);
+            if (m_cache_idx.size() != m_signal_config.size()) {
+                // The cache is full
+                m_cache.reset();
+            }
+        }
     }
 
     void BatchServerImp::read_and_update(void)
@@ -257,13 +514,8 @@ namespace geopm
             return;
         }
 
-        m_pio.read_batch();
-        double *shmem_buffer = (double *)m_signal_shmem->pointer();
-        int buffer_idx = 0;
-        for (const auto &handle : m_signal_handle) {
-            shmem_buffer[buffer_idx] = m_pio.sample(handle);
-            ++buffer_idx;
-        }
+        std::lock_guard<std::mutex> pio_lock(m_pio_mutex);
+        sample_signals((double *)m_signal_shmem->pointer());
     }
 
     void BatchServerImp::update_and_write(void)
@@ -272,6 +524,7 @@ namespace geopm
             return;
         }
 
+        std::lock_guard<std::mutex> pio_lock(m_pio_mutex);
         double *shmem_buffer = (double *)m_control_shmem->pointer();
         int buffer_idx = 0;
         for (const auto &handle : m_control_handle) {
@@ -293,6 +546,9 @@ namespace geopm
                 m_signal_shmem_key, signal_size);
             // Requires a chown if server is different user than client
             m_signal_shmem->chown(uid, gid);
+            m_snapshot_shmem = SharedMemory::make_unique_owner_secure(
+                m_snapshot_shmem_key, snapshot_shmem_size(m_signal_config.size()));
+            m_snapshot_shmem->chown(uid, gid);
         }
         if (control_size != 0) {
             m_control_shmem = SharedMemory::make_unique_owner_secure(
@@ -300,6 +556,12 @@ namespace geopm
             // Requires a chown if server is different user than client
             m_control_shmem->chown(uid, gid);
         }
+        // The status region is only used if the client requests the
+        // shared memory transport, but it must exist before the
+        // client attaches.
+        m_status_shmem = SharedMemory::make_unique_owner_secure(
+            m_status_shmem_key, BatchStatus::shmem_size());
+        m_status_shmem->chown(uid, gid);
     }
 
     void BatchServerImp::register_handler(void)
@@ -316,6 +578,28 @@ namespace geopm
     int BatchServer::main(int argc, char **argv)
     {
         int client_pid = -1;
+        if (argc == 2 && std::string(argv[1]) == "--cache-stats") {
+            try {
+                print_cache_stats(std::cout);
+            }
+            catch (const std::runtime_error &ex) {
+                std::cerr << "Error: <geopmbatch>: Unable to read batch cache: "
+                          << ex.what() << std::endl;
+                return -1;
+            }
+            return 0;
+        }
+        if (argc == 2 && std::string(argv[1]) == "--cache-remove") {
+            try {
+                BatchCache::remove();
+            }
+            catch (const std::runtime_error &ex) {
+                std::cerr << "Error: <geopmbatch>: Unable to remove batch cache: "
+                          << ex.what() << std::endl;
+                return -1;
+            }
+            return 0;
+        }
         if (argc != 2)
         {
             std::cerr << "Usage: " + std::string(argv[0]) + " CLIENT_PID" << std::endl;
@@ -323,6 +607,8 @@ namespace geopm
         }
         else if (std::string(argv[1]) == "--help") {
             std::cerr << "Usage: " + std::string(argv[0]) + " CLIENT_PID" << std::endl;
+            std::cerr << "       " + std::string(argv[0]) + " --cache-stats" << std::endl;
+            std::cerr << "       " + std::string(argv[0]) + " --cache-remove" << std::endl;
             return 0;
         }
         try {
@@ -6,7 +6,12 @@
 #ifndef BATCHSERVER_HPP_INCLUDE
 #define BATCHSERVER_HPP_INCLUDE
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <functional>
@@ -21,6 +26,7 @@ namespace geopm
     class SharedMemory;
     class BatchStatus;
     class POSIXSignal;
+    class BatchCache;
 
     class BatchServer
     {
@@ -76,6 +82,53 @@ namespace geopm
             ///         region.
             static std::string get_control_shmem_key(
                 const std::string &server_key);
+            /// @return The shm key to use for the status shared memory
+            ///         region that supports the shared memory
+            ///         message transport.
+            static std::string get_status_shmem_key(
+                const std::string &server_key);
+            /// @return The shm key to use for the snapshot shared
+            ///         memory region that is written in periodic
+            ///         sampling mode.
+            static std::string get_snapshot_shmem_key(
+                const std::string &server_key);
+            /// @brief Shortest sampling period in seconds used in
+            ///        periodic sampling mode: a shorter period
+            ///        requested by the client is increased to this.
+            static constexpr double M_MIN_SAMPLE_PERIOD = 0.001;
+            /// @brief Header of the snapshot shared memory region.
+            ///
+            /// The header is followed by two buffers of num_signal
+            /// doubles.  The server writes a new sample into the
+            /// buffer that readers are not using and then publishes
+            /// it by incrementing the sequence number: the sequence
+            /// number is odd while a write is in progress, and
+            /// (seq / 2) % 2 selects the buffer holding the latest
+            /// complete sample.
+            struct m_snapshot_header_s {
+                std::atomic<uint64_t> seq;
+                /// @brief Sampling period in seconds requested by
+                ///        the client.
+                double period;
+                /// @brief Set to a non-zero value if the server
+                ///        stopped sampling due to an error.
+                std::atomic<int32_t> error;
+                char padding[64 - 2 * sizeof(uint64_t) - sizeof(int32_t)];
+            };
+            /// @return Size in bytes of the snapshot shared memory
+            ///         region for the given number of signals.
+            static size_t snapshot_shmem_size(int num_signal);
+            /// @brief Copy the latest complete sample out of a
+            ///        snapshot shared memory region.
+            ///
+            /// @param snapshot [in] Pointer to the snapshot region.
+            ///
+            /// @param num_signal [in] Number of signals in each
+            ///                   buffer.
+            ///
+            /// @param result [out] Array of num_signal values.
+            static void read_snapshot(const void *snapshot, int num_signal,
+                                      double *result);
             /// @return The Unix process ID of the server process
             ///        created.
             static int main(int argc, char **argv);
@@ -106,11 +159,16 @@ namespace geopm
                            const std::vector<geopm_request_s> &control_config,
                            const std::string &signal_shmem_key,
                            const std::string &control_shmem_key,
+                           const std::string &status_shmem_key,
+                           const std::string &snapshot_shmem_key,
                            PlatformIO &pio,
                            std::shared_ptr<BatchStatus> batch_status,
                            std::shared_ptr<POSIXSignal> posix_signal,
                            std::shared_ptr<SharedMemory> signal_shmem,
                            std::shared_ptr<SharedMemory> control_shmem,
+                           std::shared_ptr<SharedMemory> status_shmem,
+                           std::shared_ptr<SharedMemory> snapshot_shmem,
+                           std::shared_ptr<BatchCache> cache,
                            int server_pid);
             BatchServerImp(const BatchServerImp &other) = delete;
             BatchServerImp &operator=(const BatchServerImp &other) = delete;
@@ -126,6 +184,14 @@ namespace geopm
             void read_and_update(void);
             void update_and_write(void);
             void check_invalid_signal(void);
+            void unlink_shmem(void);
+            void use_shmem_transport(void);
+            void start_sampling(void);
+            void stop_sampling(void);
+            void sample_loop(void);
+            void write_snapshot(void);
+            void sample_signals(double *result);
+            static std::shared_ptr<BatchCache> make_cache(void);
             void check_return(int ret, const std::string &func_name) const;
             char read_message(void);
             void write_message(char message);
@@ -137,11 +203,18 @@ namespace geopm
             const std::vector<geopm_request_s> m_control_config;
             const std::string m_signal_shmem_key;
             const std::string m_control_shmem_key;
+            const std::string m_status_shmem_key;
+            const std::string m_snapshot_shmem_key;
             PlatformIO &m_pio;
             std::shared_ptr<SharedMemory> m_signal_shmem;
             std::shared_ptr<SharedMemory> m_control_shmem;
+            std::shared_ptr<SharedMemory> m_status_shmem;
+            std::shared_ptr<SharedMemory> m_snapshot_shmem;
             std::shared_ptr<BatchStatus> m_batch_status;
             std::shared_ptr<POSIXSignal> m_posix_signal;
+            /// @brief Node wide cache shared with other batch servers,
+            ///        null if caching is disabled.
+            std::shared_ptr<BatchCache> m_cache;
             int m_server_pid;
             bool m_is_active;
             bool m_is_client_attached;
@@ -152,6 +225,17 @@ namespace geopm
             /// @brief Stores the PlatformIO batch handles for all pushed
             ///        controls
             std::vector<int> m_control_handle;
+            /// @brief Stores the cache entry indices for all pushed
+            ///        signals
+            std::vector<int> m_cache_idx;
+            /// @brief Serializes access to m_pio between the event
+            ///        loop and the sampling thread.
+            std::mutex m_pio_mutex;
+            std::mutex m_sample_mutex;
+            std::condition_variable m_sample_cv;
+            bool m_is_sampling;
+            double m_sample_period;
+            std::thread m_sample_thread;
     };
 }
 
@@ -9,10 +9,16 @@
 
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
+#include "geopm/SharedMemory.hpp"
+#include "geopm_time.h"
 
 #include <cerrno>
+#include <cmath>
+#include <csignal>
 #include <sstream>
 #include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -38,6 +44,51 @@ namespace geopm
         return geopm::make_unique<BatchStatusClient>(server_key);
     }
 
+    std::unique_ptr<BatchStatus>
+    BatchStatus::make_unique_shmem_server(std::shared_ptr<SharedMemory> shmem,
+                                          int client_pid,
+                                          std::function<bool(void)> is_interrupted)
+    {
+        return geopm::make_unique<BatchStatusShmem>(shmem, client_pid,
+                                                    is_interrupted);
+    }
+
+    std::unique_ptr<BatchStatus>
+    BatchStatus::make_unique_shmem_client(std::shared_ptr<SharedMemory> shmem,
+                                          int transport)
+    {
+        if (transport != M_TRANSPORT_FUTEX &&
+            transport != M_TRANSPORT_BUSY_POLL) {
+            throw Exception("BatchStatus::make_unique_shmem_client(): Invalid transport: " +
+                            std::to_string(transport),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return geopm::make_unique<BatchStatusShmem>(shmem,
+                                                    transport == M_TRANSPORT_BUSY_POLL);
+    }
+
+    size_t BatchStatus::shmem_size(void)
+    {
+        return BatchStatusShmem::shmem_size();
+    }
+
+    int BatchStatus::transport_type(const std::string &name)
+    {
+        int result = M_TRANSPORT_FIFO;
+        if (name == "futex") {
+            result = M_TRANSPORT_FUTEX;
+        }
+        else if (name == "busy-poll") {
+            result = M_TRANSPORT_BUSY_POLL;
+        }
+        else if (name != "fifo") {
+            throw Exception("BatchStatus::transport_type(): Unknown transport: \"" +
+                            name + "\", expected \"fifo\", \"futex\" or \"busy-poll\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
     /***********************************
      * Members of class BatchStatusImp *
      ***********************************/
@@ -190,4 +241,177 @@ namespace geopm
             check_return(m_write_fd, "open(2)");
         }
     }
+
+    /*************************************
+     * Members of class BatchStatusShmem *
+     *************************************/
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+                  "Sequence numbers must be usable as futex words");
+
+    BatchStatusShmem::BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                                       int client_pid,
+                                       std::function<bool(void)> is_interrupted)
+        : BatchStatusShmem(std::move(shmem), true, client_pid, false,
+                           std::move(is_interrupted))
+    {
+
+    }
+
+    BatchStatusShmem::BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                                       bool is_busy_poll)
+        : BatchStatusShmem(std::move(shmem), false, -1, is_busy_poll,
+                           [](void) { return false; })
+    {
+
+    }
+
+    BatchStatusShmem::BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                                       bool is_server,
+                                       int client_pid,
+                                       bool is_busy_poll,
+                                       std::function<bool(void)> is_interrupted)
+        : m_shmem(std::move(shmem))
+        , m_status(status_pointer(m_shmem))
+        , m_is_server(is_server)
+        , m_client_pid(client_pid)
+        , m_is_busy_poll(is_server ? m_status->is_busy_poll.load() != 0 : is_busy_poll)
+        , m_is_interrupted(std::move(is_interrupted))
+        , m_send(is_server ? m_status->to_client : m_status->to_server)
+        , m_recv(is_server ? m_status->to_server : m_status->to_client)
+        , m_recv_seq(m_recv.seq.load())
+    {
+        if (m_is_server) {
+            m_status->server_pid.store(getpid());
+        }
+        else {
+            m_status->is_busy_poll.store(m_is_busy_poll);
+        }
+    }
+
+    size_t BatchStatusShmem::shmem_size(void)
+    {
+        return sizeof(m_status_s);
+    }
+
+    BatchStatusShmem::m_status_s *
+    BatchStatusShmem::status_pointer(const std::shared_ptr<SharedMemory> &shmem)
+    {
+        if (shmem == nullptr || shmem->size() < shmem_size()) {
+            throw Exception("BatchStatusShmem: Status shared memory region is missing or too small",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return (m_status_s *)shmem->pointer();
+    }
+
+    void BatchStatusShmem::send_message(char msg)
+    {
+        uint32_t seq = m_send.seq.load(std::memory_order_relaxed);
+        if (seq - m_send.ack.load(std::memory_order_acquire) >= M_RING_SIZE) {
+            throw Exception("BatchStatusShmem::send_message(): Message ring is full",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        m_send.ring[seq % M_RING_SIZE].store(msg, std::memory_order_relaxed);
+        // Sequentially consistent store and load pair with the
+        // receiver's is_waiting store and seq load in wait() so that
+        // at least one side observes the other.
+        m_send.seq.store(seq + 1);
+        if (m_send.is_waiting.load()) {
+            check_return(syscall(SYS_futex, &m_send.seq, FUTEX_WAKE, 1,
+                                 nullptr, nullptr, 0),
+                         "futex(2)");
+        }
+    }
+
+    char BatchStatusShmem::receive_message(void)
+    {
+        if (m_recv.seq.load(std::memory_order_acquire) == m_recv_seq) {
+            wait(m_recv, m_recv_seq);
+        }
+        char result = m_recv.ring[m_recv_seq % M_RING_SIZE].load(std::memory_order_relaxed);
+        ++m_recv_seq;
+        m_recv.ack.store(m_recv_seq, std::memory_order_release);
+        return result;
+    }
+
+    void BatchStatusShmem::receive_message(char expect)
+    {
+        char actual = receive_message();
+        if (actual != expect) {
+            std::ostringstream error_message;
+            error_message << "BatchStatusShmem::receive_message(): "
+                          << "Expected message: \"" << expect
+                          << "\" but received \"" <<   actual << "\"";
+            throw Exception(error_message.str(), GEOPM_ERROR_RUNTIME,
+                            __FILE__, __LINE__);
+        }
+    }
+
+    void BatchStatusShmem::wait(m_channel_s &channel, uint32_t seq)
+    {
+        if (m_is_busy_poll) {
+            geopm_time_s spin_begin = geopm::time_curr();
+            int spin_count = 0;
+            while (channel.seq.load(std::memory_order_acquire) == seq) {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+                // Only check the clock periodically
+                if (++spin_count == M_SPIN_CHECK_COUNT) {
+                    spin_count = 0;
+                    if (geopm_time_since(&spin_begin) > M_BUSY_POLL_TIMEOUT ||
+                        m_is_interrupted()) {
+                        break;
+                    }
+                }
+            }
+        }
+        struct timespec timeout = {0, (long)(M_FUTEX_TIMEOUT * 1e9)};
+        while (channel.seq.load(std::memory_order_acquire) == seq) {
+            if (m_is_interrupted()) {
+                throw Exception("BatchStatusShmem::receive_message(): Interrupted while waiting for message",
+                                EINTR, __FILE__, __LINE__);
+            }
+            channel.is_waiting.store(1);
+            int ret = 0;
+            int err = 0;
+            if (channel.seq.load() == seq) {
+                ret = syscall(SYS_futex, &channel.seq, FUTEX_WAIT, seq,
+                              &timeout, nullptr, 0);
+                err = errno;
+            }
+            channel.is_waiting.store(0);
+            if (ret == -1 && err == EINTR) {
+                throw Exception("BatchStatusShmem::receive_message(): Interrupted while waiting for message",
+                                EINTR, __FILE__, __LINE__);
+            }
+            else if (ret == -1 && err == ETIMEDOUT) {
+                check_peer();
+            }
+            else if (ret == -1 && err != EAGAIN) {
+                errno = err;
+                check_return(ret, "futex(2)");
+            }
+        }
+    }
+
+    void BatchStatusShmem::check_peer(void) const
+    {
+        int peer_pid = m_is_server ? m_client_pid : m_status->server_pid.load();
+        if (peer_pid > 0 && kill(peer_pid, 0) == -1 && errno == ESRCH) {
+            throw Exception("BatchStatusShmem::receive_message(): Process " +
+                            std::to_string(peer_pid) + " exited while waiting for message",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void BatchStatusShmem::check_return(int ret, const std::string &func_name) const
+    {
+        if (ret == -1) {
+            throw Exception("BatchStatusShmem: System call failed: " + func_name,
+                            errno ? errno : GEOPM_ERROR_RUNTIME,
+                            __FILE__, __LINE__);
+        }
+    }
 }
@@ -6,6 +6,9 @@
 #ifndef BATCHSTATUS_HPP_INCLUDE
 #define BATCHSTATUS_HPP_INCLUDE
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -14,6 +17,8 @@
 
 namespace geopm
 {
+    class SharedMemory;
+
     class BatchStatus
     {
         public:
@@ -22,6 +27,29 @@ namespace geopm
             static constexpr char M_MESSAGE_CONTINUE = 'c';
             static constexpr char M_MESSAGE_QUIT = 'q';
             static constexpr char M_MESSAGE_TERMINATE = 't';
+            /// @brief Sent by the client over the FIFO to request
+            ///        that all further messages in the session are
+            ///        exchanged through the status shared memory.
+            static constexpr char M_MESSAGE_SHMEM = 's';
+            /// @brief Sent by the client to request that the server
+            ///        samples all signals periodically into the
+            ///        snapshot shared memory.
+            static constexpr char M_MESSAGE_SAMPLE = 'p';
+
+            /// @brief Transport used to exchange messages between a
+            ///        batch client and server.
+            enum m_transport_e {
+                /// @brief One byte messages written to a pair of
+                ///        FIFOs (default).
+                M_TRANSPORT_FIFO,
+                /// @brief Sequence numbered messages in shared
+                ///        memory, a waiting process blocks on a futex.
+                M_TRANSPORT_FUTEX,
+                /// @brief Same as M_TRANSPORT_FUTEX, but a waiting
+                ///        process spins on the shared memory before
+                ///        blocking.
+                M_TRANSPORT_BUSY_POLL,
+            };
 
             BatchStatus() = default;
             virtual ~BatchStatus() = default;
@@ -30,6 +58,45 @@ namespace geopm
                 const std::string &server_key);
             static std::unique_ptr<BatchStatus> make_unique_client(
                 const std::string &server_key);
+            /// @brief Create the server side of the shared memory
+            ///        transport.
+            ///
+            /// @param shmem [in] Status shared memory region of at
+            ///              least shmem_size() bytes created by the
+            ///              server.
+            ///
+            /// @param client_pid [in] Process ID of the client, used
+            ///                   to detect if the client has exited.
+            ///
+            /// @param is_interrupted [in] Polled while waiting for a
+            ///                       message, a true return value
+            ///                       aborts the wait with an EINTR
+            ///                       exception.
+            static std::unique_ptr<BatchStatus> make_unique_shmem_server(
+                std::shared_ptr<SharedMemory> shmem,
+                int client_pid,
+                std::function<bool(void)> is_interrupted);
+            /// @brief Create the client side of the shared memory
+            ///        transport.
+            ///
+            /// @param shmem [in] Status shared memory region attached
+            ///              by the client.
+            ///
+            /// @param transport [in] One of M_TRANSPORT_FUTEX or
+            ///                  M_TRANSPORT_BUSY_POLL.
+            static std::unique_ptr<BatchStatus> make_unique_shmem_client(
+                std::shared_ptr<SharedMemory> shmem,
+                int transport);
+            /// @brief Size in bytes of the status shared memory
+            ///        region used by the shared memory transport.
+            static size_t shmem_size(void);
+            /// @brief Convert a transport name into an
+            ///        m_transport_e value.
+            ///
+            /// @param name [in] One of "fifo", "futex" or "busy-poll".
+            ///
+            /// @throw Exception if the name is not recognized.
+            static int transport_type(const std::string &name);
 
             /// @brief Send an integer to the other process
             ///
@@ -108,6 +175,78 @@ namespace geopm
             std::string m_read_fifo_path;
             std::string m_write_fifo_path;
     };
+
+    /// @brief Message transport through a status shared memory
+    ///        region.
+    ///
+    /// Each direction has a sequence number that is incremented by
+    /// the sender after storing the message into a small ring indexed
+    /// by the sequence number.  The receiver waits for the sequence
+    /// number to change by spinning (busy-poll mode) and then
+    /// blocking with futex(2).  The sender only issues the futex wake
+    /// system call when the receiver has advertised that it is
+    /// blocked.
+    class BatchStatusShmem : public BatchStatus
+    {
+        public:
+            /// @brief Server side constructor.
+            BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                             int client_pid,
+                             std::function<bool(void)> is_interrupted);
+            /// @brief Client side constructor.
+            BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                             bool is_busy_poll);
+            BatchStatusShmem(const BatchStatusShmem &other) = delete;
+            BatchStatusShmem &operator=(const BatchStatusShmem &other) = delete;
+            virtual ~BatchStatusShmem() = default;
+            void send_message(char msg) override;
+            char receive_message(void) override;
+            void receive_message(char expect) override;
+            static size_t shmem_size(void);
+        private:
+            static constexpr uint32_t M_RING_SIZE = 8;
+            struct m_channel_s {
+                std::atomic<uint32_t> seq;
+                std::atomic<uint32_t> is_waiting;
+                std::atomic<uint32_t> ack;
+                std::atomic<char> ring[M_RING_SIZE];
+                char padding[64 - 3 * sizeof(uint32_t) - M_RING_SIZE];
+            };
+            struct m_status_s {
+                std::atomic<int32_t> server_pid;
+                std::atomic<uint32_t> is_busy_poll;
+                char padding[64 - 2 * sizeof(uint32_t)];
+                m_channel_s to_server;
+                m_channel_s to_client;
+            };
+            BatchStatusShmem(std::shared_ptr<SharedMemory> shmem,
+                             bool is_server,
+                             int client_pid,
+                             bool is_busy_poll,
+                             std::function<bool(void)> is_interrupted);
+            static m_status_s *status_pointer(const std::shared_ptr<SharedMemory> &shmem);
+            void wait(m_channel_s &channel, uint32_t seq);
+            void check_peer(void) const;
+            void check_return(int ret, const std::string &func_name) const;
+
+            std::shared_ptr<SharedMemory> m_shmem;
+            m_status_s *m_status;
+            const bool m_is_server;
+            const int m_client_pid;
+            const bool m_is_busy_poll;
+            std::function<bool(void)> m_is_interrupted;
+            m_channel_s &m_send;
+            m_channel_s &m_recv;
+            uint32_t m_recv_seq;
+
+            /// @brief Maximum time spent spinning before blocking
+            ///        in busy-poll mode.
+            static constexpr double M_BUSY_POLL_TIMEOUT = 0.01;
+            /// @brief Period for checking that the other process is
+            ///        still alive while blocked.
+            static constexpr double M_FUTEX_TIMEOUT = 0.1;
+            static constexpr int M_SPIN_CHECK_COUNT = 256;
+    };
 }
 
 #endif
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "BatchTimeIOGroup.hpp"
+
+#include <cmath>
+
+#include "geopm/PlatformTopo.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Agg.hpp"
+
+#define GEOPM_BATCH_TIME_IO_GROUP_PLUGIN_NAME "PLATFORMIO"
+
+namespace geopm
+{
+    BatchTimeIOGroup::BatchTimeIOGroup()
+        : m_is_batch_read(false)
+    {
+
+    }
+
+    int BatchTimeIOGroup::add_iogroup(const std::string &iogroup_name)
+    {
+        if (m_is_batch_read) {
+            throw Exception("BatchTimeIOGroup::add_iogroup(): cannot add an IOGroup after call to read_batch()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = m_total_time.size() / 2;
+        // An IOGroup registered more than once replaces the signals
+        // of the earlier one, as with PlatformIO signal lookup.
+        m_signal_total_idx[plugin_name() + "::READ_BATCH_TIME@" + iogroup_name] = 2 * result;
+        m_signal_total_idx[plugin_name() + "::WRITE_BATCH_TIME@" + iogroup_name] = 2 * result + 1;
+        m_total_time.push_back(0.0);
+        m_total_time.push_back(0.0);
+        return result;
+    }
+
+    void BatchTimeIOGroup::add_read_time(int iogroup_idx, double delta)
+    {
+        m_total_time[2 * iogroup_idx] += delta;
+    }
+
+    void BatchTimeIOGroup::add_write_time(int iogroup_idx, double delta)
+    {
+        m_total_time[2 * iogroup_idx + 1] += delta;
+    }
+
+    int BatchTimeIOGroup::total_idx(const std::string &signal_name) const
+    {
+        int result = -1;
+        auto it = m_signal_total_idx.find(signal_name);
+        if (it != m_signal_total_idx.end()) {
+            result = it->second;
+        }
+        return result;
+    }
+
+    void BatchTimeIOGroup::check_signal(const std::string &signal_name,
+                                        const std::string &func_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("BatchTimeIOGroup::" + func_name + "(): " + signal_name +
+                            " not valid for BatchTimeIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    std::set<std::string> BatchTimeIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_total_idx) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> BatchTimeIOGroup::control_names(void) const
+    {
+        return {};
+    }
+
+    bool BatchTimeIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return total_idx(signal_name) != -1;
+    }
+
+    bool BatchTimeIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return false;
+    }
+
+    int BatchTimeIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        if (is_valid_signal(signal_name)) {
+            result = GEOPM_DOMAIN_BOARD;
+        }
+        return result;
+    }
+
+    int BatchTimeIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return GEOPM_DOMAIN_INVALID;
+    }
+
+    int BatchTimeIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal(signal_name, "push_signal");
+        if (domain_type != GEOPM_DOMAIN_BOARD || domain_idx != 0) {
+            throw Exception("BatchTimeIOGroup::push_signal(): signal_name " + signal_name +
+                            " not defined for domain " + std::to_string(domain_type),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_is_batch_read) {
+            throw Exception("BatchTimeIOGroup::push_signal(): cannot push signal after call to read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int idx = total_idx(signal_name);
+        int result = 0;
+        for (; result != (int)m_pushed_total_idx.size(); ++result) {
+            if (m_pushed_total_idx[result] == idx) {
+                return result;
+            }
+        }
+        m_pushed_total_idx.push_back(idx);
+        m_sample.push_back(NAN);
+        return result;
+    }
+
+    int BatchTimeIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        throw Exception("BatchTimeIOGroup::push_control(): there are no controls supported by the BatchTimeIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void BatchTimeIOGroup::read_batch(void)
+    {
+        // The totals include every IOGroup read_batch() completed
+        // before this one.  PlatformIO reads this IOGroup first, so
+        // all samples are from the end of the previous batch.
+        for (size_t ii = 0; ii != m_pushed_total_idx.size(); ++ii) {
+            m_sample[ii] = m_total_time[m_pushed_total_idx[ii]];
+        }
+        m_is_batch_read = true;
+    }
+
+    void BatchTimeIOGroup::write_batch(void)
+    {
+
+    }
+
+    double BatchTimeIOGroup::sample(int batch_idx)
+    {
+        if (!m_is_batch_read) {
+            throw Exception("BatchTimeIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (batch_idx < 0 || batch_idx >= (int)m_sample.size()) {
+            throw Exception("BatchTimeIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_sample[batch_idx];
+    }
+
+    void BatchTimeIOGroup::sample_all(const std::vector<int> &batch_idx, double *result)
+    {
+        for (const auto &idx : batch_idx) {
+            *result = sample(idx);
+            ++result;
+        }
+    }
+
+    void BatchTimeIOGroup::adjust(int batch_idx, double setting)
+    {
+        throw Exception("BatchTimeIOGroup::adjust(): there are no controls supported by the BatchTimeIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double BatchTimeIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal(signal_name, "read_signal");
+        if (domain_type != GEOPM_DOMAIN_BOARD || domain_idx != 0) {
+            throw Exception("BatchTimeIOGroup::read_signal(): signal_name " + signal_name +
+                            " not defined for domain " + std::to_string(domain_type),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_total_time[total_idx(signal_name)];
+    }
+
+    void BatchTimeIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        throw Exception("BatchTimeIOGroup::write_control(): there are no controls supported by the BatchTimeIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void BatchTimeIOGroup::save_control(void)
+    {
+
+    }
+
+    void BatchTimeIOGroup::restore_control(void)
+    {
+
+    }
+
+    std::string BatchTimeIOGroup::name(void) const
+    {
+        return plugin_name();
+    }
+
+    std::string BatchTimeIOGroup::plugin_name(void)
+    {
+        return GEOPM_BATCH_TIME_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::function<double(const std::vector<double> &)> BatchTimeIOGroup::agg_function(const std::string &signal_name) const
+    {
+        check_signal(signal_name, "agg_function");
+        return Agg::select_first;
+    }
+
+    std::function<std::string(double)> BatchTimeIOGroup::format_function(const std::string &signal_name) const
+    {
+        check_signal(signal_name, "format_function");
+        return string_format_double;
+    }
+
+    std::string BatchTimeIOGroup::signal_description(const std::string &signal_name) const
+    {
+        check_signal(signal_name, "signal_description");
+        std::string operation = total_idx(signal_name) % 2 ? "write_batch()" : "read_batch()";
+        std::string iogroup_name = signal_name.substr(signal_name.find('@') + 1);
+        std::string result;
+        result = "    description: Total time spent in the " + operation + " method of the " +
+                 iogroup_name + " IOGroup.\n";
+        result += "    units: " + IOGroup::units_to_string(M_UNITS_SECONDS) + '\n';
+        result += "    aggregation: " + Agg::function_to_name(Agg::select_first) + '\n';
+        result += "    domain: " + PlatformTopo::domain_type_to_name(GEOPM_DOMAIN_BOARD) + '\n';
+        result += "    iogroup: BatchTimeIOGroup";
+        return result;
+    }
+
+    std::string BatchTimeIOGroup::control_description(const std::string &control_name) const
+    {
+        throw Exception("BatchTimeIOGroup::control_description(): there are no controls supported by the BatchTimeIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    int BatchTimeIOGroup::signal_behavior(const std::string &signal_name) const
+    {
+        check_signal(signal_name, "signal_behavior");
+        return IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE;
+    }
+
+    void BatchTimeIOGroup::save_control(const std::string &save_path)
+    {
+
+    }
+
+    void BatchTimeIOGroup::restore_control(const std::string &save_path)
+    {
+
+    }
+}
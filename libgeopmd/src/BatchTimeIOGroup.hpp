@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BATCHTIMEIOGROUP_HPP_INCLUDE
+#define BATCHTIMEIOGROUP_HPP_INCLUDE
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "geopm/IOGroup.hpp"
+
+namespace geopm
+{
+    /// @brief IOGroup created by PlatformIO when batch timing is
+    ///        enabled.  Provides the total time spent in the
+    ///        read_batch() and write_batch() methods of each IOGroup
+    ///        registered with PlatformIO.
+    ///
+    /// The signals are named PLATFORMIO::READ_BATCH_TIME@<IOGroup>
+    /// and PLATFORMIO::WRITE_BATCH_TIME@<IOGroup> where <IOGroup> is
+    /// the value returned by IOGroup::name().  This IOGroup is not
+    /// registered with the IOGroup factory.
+    class BatchTimeIOGroup : public IOGroup
+    {
+        public:
+            BatchTimeIOGroup();
+            virtual ~BatchTimeIOGroup() = default;
+            /// @brief Add the signals for an IOGroup.
+            /// @param [in] iogroup_name Name returned by the
+            ///        IOGroup::name() method.
+            /// @return Index to pass to add_read_time() and
+            ///         add_write_time().
+            int add_iogroup(const std::string &iogroup_name);
+            /// @brief Accumulate time spent in IOGroup::read_batch().
+            /// @param [in] iogroup_idx Index returned by add_iogroup().
+            /// @param [in] delta Elapsed time in seconds.
+            void add_read_time(int iogroup_idx, double delta);
+            /// @brief Accumulate time spent in IOGroup::write_batch().
+            /// @param [in] iogroup_idx Index returned by add_iogroup().
+            /// @param [in] delta Elapsed time in seconds.
+            void add_write_time(int iogroup_idx, double delta);
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx)  override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void sample_all(const std::vector<int> &batch_idx, double *result) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)> format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            int signal_behavior(const std::string &signal_name) const override;
+            void save_control(const std::string &save_path) override;
+            void restore_control(const std::string &save_path) override;
+            std::string name(void) const override;
+            static std::string plugin_name(void);
+        private:
+            /// @brief Index into m_total_time for a signal name, or
+            ///        -1 if the name is not valid.
+            int total_idx(const std::string &signal_name) const;
+            void check_signal(const std::string &signal_name,
+                              const std::string &func_name) const;
+            bool m_is_batch_read;
+            /// @brief Read time followed by write time for each
+            ///        IOGroup added.
+            std::vector<double> m_total_time;
+            /// @brief Totals copied from m_total_time for each pushed
+            ///        signal by read_batch().
+            std::vector<double> m_sample;
+            std::vector<int> m_pushed_total_idx;
+            std::map<std::string, int> m_signal_total_idx;
+    };
+}
+
+#endif
@@ -5,6 +5,9 @@
 
 #include "CNLIOGroup.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -30,6 +33,31 @@ namespace geopm
         return std::bind(read_double_from_file, path, units);
     }
 
+    // Parse the contents of a pm_counters file read into a null
+    // terminated buffer.  The checks are the same as those of
+    // read_double_from_file(), but no string is constructed.
+    static double parse_counter(const char *buf, const std::string &units,
+                                const std::string &path)
+    {
+        static const char *separators = " \t\n";
+        char *value_end = nullptr;
+        double result = std::strtod(buf, &value_end);
+        const char *units_begin = value_end + std::strspn(value_end, separators);
+        const char *units_end = units_begin + std::strcspn(units_begin, separators);
+        size_t units_length = units_end - units_begin;
+        bool is_valid = value_end != buf &&
+                        units_end[std::strspn(units_end, separators)] == '\0' &&
+                        units_length == units.size() &&
+                        (units_length == 0 ||
+                         (units_begin != value_end &&
+                          units.compare(0, units_length, units_begin, units_length) == 0));
+        if (!is_valid) {
+            throw Exception("CNLIOGroup::read_batch(): Unexpected format in " + path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
     CNLIOGroup::CNLIOGroup()
         : CNLIOGroup("/sys/cray/pm_counters")
     {
@@ -41,8 +69,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/power", "W"),
-                                   false,
-                                   NAN,
+                                   "power",
+                                   "W",
                                    M_UNITS_WATTS,
                                    IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE}},
                               {"CNL::BOARD_ENERGY", {
@@ -50,8 +78,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/energy", "J"),
-                                   false,
-                                   NAN,
+                                   "energy",
+                                   "J",
                                    M_UNITS_JOULES,
                                    IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE}},
                               {"CNL::MEMORY_POWER", {
@@ -59,8 +87,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/memory_power", "W"),
-                                   false,
-                                   NAN,
+                                   "memory_power",
+                                   "W",
                                    M_UNITS_WATTS,
                                    IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE}},
                               {"CNL::MEMORY_ENERGY", {
@@ -68,8 +96,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/memory_energy", "J"),
-                                   false,
-                                   NAN,
+                                   "memory_energy",
+                                   "J",
                                    M_UNITS_JOULES,
                                    IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE}},
                               {"CNL::BOARD_POWER_CPU", {
@@ -77,8 +105,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/cpu_power", "W"),
-                                   false,
-                                   NAN,
+                                   "cpu_power",
+                                   "W",
                                    M_UNITS_WATTS,
                                    IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE}},
                               {"CNL::BOARD_ENERGY_CPU", {
@@ -86,8 +114,8 @@ namespace geopm
                                    Agg::sum,
                                    string_format_integer,
                                    get_formatted_file_reader(cpu_info_path + "/cpu_energy", "J"),
-                                   false,
-                                   NAN,
+                                   "cpu_energy",
+                                   "J",
                                    M_UNITS_JOULES,
                                    IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE}},
                               {"CNL::SAMPLE_RATE", {
@@ -95,8 +123,8 @@ namespace geopm
                                    Agg::expect_same,
                                    string_format_integer,
                                    std::bind(&CNLIOGroup::m_sample_rate, this),
-                                   false,
-                                   NAN,
+                                   "",
+                                   "",
                                    M_UNITS_HERTZ,
                                    IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT}},
                               {"CNL::SAMPLE_ELAPSED_TIME", {
@@ -104,11 +132,12 @@ namespace geopm
                                    Agg::max,
                                    string_format_double,
                                    std::bind(&CNLIOGroup::read_time, this, cpu_info_path + "/" + FRESHNESS_FILE_NAME),
-                                   false,
-                                   NAN,
+                                   FRESHNESS_FILE_NAME,
+                                   "",
                                    M_UNITS_SECONDS,
                                    IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE}},
                              })
+        , m_pm_counters_path(cpu_info_path)
         , m_time_zero(geopm::time_zero())
     {
         m_sample_rate = read_double_from_file(
@@ -179,8 +208,41 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
-        m_signal_available[signal_name].m_do_read = true;
-        return std::distance(m_signal_available.begin(), m_signal_available.find(signal_name));
+        auto pushed_it = std::find_if(m_pushed_signal.begin(), m_pushed_signal.end(),
+                                      [&signal_name](const m_pushed_signal_s &pushed)
+                                      {
+                                          return pushed.m_name == signal_name;
+                                      });
+        if (pushed_it != m_pushed_signal.end()) {
+            return std::distance(m_pushed_signal.begin(), pushed_it);
+        }
+        const auto &info = m_signal_available.at(signal_name);
+        m_pushed_signal_s pushed {signal_name, -1, 0.0, 1.0, NAN};
+        if (!info.m_file_name.empty()) {
+            // Aliases of the same signal share an open file
+            auto file_it = std::find_if(m_file.begin(), m_file.end(),
+                                        [&info](const m_file_s &file)
+                                        {
+                                            return file.m_name == info.m_file_name;
+                                        });
+            pushed.m_file_idx = std::distance(m_file.begin(), file_it);
+            if (file_it == m_file.end()) {
+                std::string path = m_pm_counters_path + "/" + info.m_file_name;
+                UniqueFd fd = open(path.c_str(), O_RDONLY);
+                if (fd.get() == -1) {
+                    throw Exception("CNLIOGroup::push_signal(): failed to open " + path,
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                m_file.push_back({info.m_file_name, path, info.m_file_units,
+                                  std::move(fd), NAN});
+            }
+            if (info.m_file_name == FRESHNESS_FILE_NAME) {
+                pushed.m_offset = m_initial_freshness;
+                pushed.m_scale = 1.0 / m_sample_rate;
+            }
+        }
+        m_pushed_signal.push_back(pushed);
+        return m_pushed_signal.size() - 1;
     }
 
     int CNLIOGroup::push_control(const std::string &control_name,
@@ -192,9 +254,24 @@ namespace geopm
 
     void CNLIOGroup::read_batch(void)
     {
-        for (auto &signal : m_signal_available) {
-            if (signal.second.m_do_read) {
-                signal.second.m_value = signal.second.m_read_function();
+        // Read each open file once, even if several pushed signals
+        // refer to it
+        for (auto &file : m_file) {
+            ssize_t num_read = pread(file.m_fd.get(), m_buffer.data(), m_buffer.size() - 1, 0);
+            if (num_read < 0) {
+                throw Exception("CNLIOGroup::read_batch(): failed to read " + file.m_path,
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            m_buffer[num_read] = '\0';
+            file.m_value = parse_counter(m_buffer.data(), file.m_units, file.m_path);
+        }
+        for (auto &pushed : m_pushed_signal) {
+            if (pushed.m_file_idx == -1) {
+                pushed.m_value = m_sample_rate;
+            }
+            else {
+                pushed.m_value = (m_file[pushed.m_file_idx].m_value - pushed.m_offset) *
+                                 pushed.m_scale;
             }
         }
     }
@@ -203,25 +280,12 @@ namespace geopm
 
     double CNLIOGroup::sample(int batch_idx)
     {
-        double result = NAN;
-        auto res_it = m_signal_available.begin();
-        if (batch_idx >= 0 && batch_idx < static_cast<int>(m_signal_available.size())) {
-            std::advance(res_it, batch_idx);
-            if(res_it->second.m_do_read) {
-                result = res_it->second.m_value;
-            }
-            else if (!res_it->second.m_do_read) {
-                throw Exception("CNLIOGroup::sample(): batch_idx " +
-                                std::to_string(batch_idx) + " has not been pushed",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-        }
-        else {
+        if (batch_idx < 0 || batch_idx >= static_cast<int>(m_pushed_signal.size())) {
             throw Exception("CNLIOGroup::sample(): batch_idx " + std::to_string(batch_idx) +
-                            "not valid for CNLIOGroup",
+                            " has not been pushed",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        return result;
+        return m_pushed_signal[batch_idx].m_value;
     }
 
     void CNLIOGroup::adjust(int batch_idx, double setting)
@@ -5,12 +5,16 @@
 #ifndef CNLIOGROUP_HPP_INCLUDE
 #define CNLIOGROUP_HPP_INCLUDE
 
+#include <array>
 #include <functional>
 #include <map>
+#include <vector>
 
 #include "geopm/IOGroup.hpp"
 #include "geopm_time.h"
 
+#include "UniqueFd.hpp"
+
 namespace geopm
 {
     /// @brief IOGroup that wraps interfaces to Compute Node Linux.
@@ -145,18 +149,46 @@ namespace geopm
                 std::function<double(const std::vector<double> &)> m_agg_function;
                 std::function<std::string(double)> m_format_function;
                 std::function<double()> m_read_function;
-                bool m_do_read;
-                double m_value;
+                // Name of the pm_counters file and the units it is
+                // expected to contain, or empty if the signal is not
+                // read from a file by read_batch()
+                std::string m_file_name;
+                std::string m_file_units;
                 int m_units;
                 int m_behavior;
             };
             std::map<std::string, m_signal_info_s> m_signal_available;
 
+            // A pm_counters file that is kept open for read_batch()
+            struct m_file_s {
+                std::string m_name;
+                std::string m_path;
+                std::string m_units;
+                UniqueFd m_fd;
+                // Value parsed by the last read_batch()
+                double m_value;
+            };
+
+            // A pushed signal, the value is (file value - m_offset) *
+            // m_scale, or the sample rate if m_file_idx is -1
+            struct m_pushed_signal_s {
+                std::string m_name;
+                int m_file_idx;
+                double m_offset;
+                double m_scale;
+                double m_value;
+            };
+
             double read_time(const std::string &freshness_path) const;
 
+            std::string m_pm_counters_path;
             geopm_time_s m_time_zero;
             double m_initial_freshness;
             double m_sample_rate;
+            std::vector<m_file_s> m_file;
+            // Indexed by the value returned from push_signal()
+            std::vector<m_pushed_signal_s> m_pushed_signal;
+            std::array<char, 128> m_buffer;
     };
 }
 
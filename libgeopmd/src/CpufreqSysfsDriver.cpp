@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <climits>
 #include <cmath>
 #include <cstring>
 #include <sstream>
@@ -187,6 +188,22 @@ namespace geopm
         };
     }
 
+    double CpufreqSysfsDriver::signal_integer_scale(const std::string &signal_name) const
+    {
+        auto prop_it = M_PROPERTIES.find(signal_name);
+        if (prop_it == M_PROPERTIES.end()) {
+            throw Exception("CpufreqSysfsDriver::signal_integer_scale(): Unknown signal name: " + signal_name,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return prop_it->second.scaling_factor;
+    }
+
+    int64_t CpufreqSysfsDriver::signal_integer_max(const std::string &signal_name) const
+    {
+        // Parsed with std::stoi()
+        return INT_MAX;
+    }
+
     std::function<std::string(double)> CpufreqSysfsDriver::control_gen(const std::string &control_name) const
     {
         auto prop_it = M_PROPERTIES.find(control_name);
@@ -30,6 +30,8 @@ namespace geopm
             std::string attribute_path(const std::string &name,
                                        int domain_idx) override;
             std::function<double(const std::string&)> signal_parse(const std::string &signal_name) const override;
+            double signal_integer_scale(const std::string &signal_name) const override;
+            int64_t signal_integer_max(const std::string &signal_name) const override;
             std::function<std::string(double)> control_gen(const std::string &control_name) const override;
             std::string driver(void) const override;
             std::map<std::string, SysfsDriver::properties_s> properties(void) const override;
@@ -183,6 +183,16 @@ namespace geopm
         };
     }
 
+    double DrmSysfsDriver::signal_integer_scale(const std::string &signal_name) const
+    {
+        auto prop_it = M_PROPERTIES.find(signal_name);
+        if (prop_it == M_PROPERTIES.end()) {
+            throw Exception("DrmSysfsDriver::signal_integer_scale(): Unknown signal name: " + signal_name,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return prop_it->second.scaling_factor;
+    }
+
     std::function<std::string(double)> DrmSysfsDriver::control_gen(const std::string &control_name) const
     {
         auto prop_it = M_PROPERTIES.find(control_name);
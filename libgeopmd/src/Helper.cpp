@@ -20,6 +20,7 @@
 #include <sys/syscall.h>
 #endif
 
+#include <charconv>
 #include <cmath>
 #include <climits>
 #include <cinttypes>
@@ -171,49 +172,127 @@ namespace geopm
         return string_begins_with(str, key);
     }
 
-    std::string string_format_double(double signal)
+    // Write the value as printf() would with "%.<precision>g"
+    static char *string_format_general(double signal, int precision, char *buffer)
     {
-        char result[NAME_MAX];
-        snprintf(result, NAME_MAX, "%.16g", signal);
-        return result;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        // Same digits as printf(), including "nan", "-nan", "inf"
+        // and "-inf", without parsing a format string.
+        return std::to_chars(buffer, buffer + string_format_buffer_size, signal,
+                             std::chars_format::general, precision).ptr;
+#else
+        int length = snprintf(buffer, string_format_buffer_size, "%.*g", precision, signal);
+        return buffer + length;
+#endif
     }
 
-    std::string string_format_float(double signal)
+    // Write value as lower case hexadecimal digits, with leading zeros
+    // added to make at least min_digits digits.
+    static char *string_format_hex_digits(uint64_t value, int min_digits, char *buffer)
     {
-        char result[NAME_MAX];
-        snprintf(result, NAME_MAX, "%g", signal);
+        static const char digits[] = "0123456789abcdef";
+        int num_digits = 1;
+        for (uint64_t shift = value >> 4; shift != 0; shift >>= 4) {
+            ++num_digits;
+        }
+        if (num_digits < min_digits) {
+            num_digits = min_digits;
+        }
+        char *result = buffer + num_digits;
+        for (char *it = result; it != buffer; value >>= 4) {
+            --it;
+            *it = digits[value & 0xF];
+        }
         return result;
     }
 
-    std::string string_format_integer(double signal)
+    char *string_format_double_buffer(double signal, char *buffer)
     {
-        char result[NAME_MAX];
-        if (std::isnan(signal)) {
-            snprintf(result, NAME_MAX, "%g", signal);
-        }
-        else {
-            snprintf(result, NAME_MAX, "%lld", (long long)signal);
+        return string_format_general(signal, 16, buffer);
+    }
+
+    char *string_format_float_buffer(double signal, char *buffer)
+    {
+        return string_format_general(signal, 6, buffer);
+    }
+
+    char *string_format_integer_buffer(double signal, char *buffer)
+    {
+        // Conversion of NAN or infinity to an integer is undefined
+        if (!std::isfinite(signal)) {
+            return string_format_general(signal, 6, buffer);
         }
-        return result;
+        return std::to_chars(buffer, buffer + string_format_buffer_size,
+                             (long long)signal).ptr;
     }
 
-    std::string string_format_hex(double signal)
+    char *string_format_hex_buffer(double signal, char *buffer)
     {
         if (std::isnan(signal)) {
-            return "NAN";
+            memcpy(buffer, "NAN", 3);
+            return buffer + 3;
         }
-        char result[NAME_MAX];
-        snprintf(result, NAME_MAX, "0x%08" PRIx64, (uint64_t)signal);
-        return result;
+        buffer[0] = '0';
+        buffer[1] = 'x';
+        return string_format_hex_digits((uint64_t)signal, 8, buffer + 2);
+    }
+
+    char *string_format_raw64_buffer(double signal, char *buffer)
+    {
+        buffer[0] = '0';
+        buffer[1] = 'x';
+        return string_format_hex_digits(geopm_signal_to_field(signal), 16, buffer + 2);
+    }
+
+    std::string string_format_double(double signal)
+    {
+        char result[string_format_buffer_size];
+        return std::string(result, string_format_double_buffer(signal, result));
+    }
+
+    std::string string_format_float(double signal)
+    {
+        char result[string_format_buffer_size];
+        return std::string(result, string_format_float_buffer(signal, result));
+    }
+
+    std::string string_format_integer(double signal)
+    {
+        char result[string_format_buffer_size];
+        return std::string(result, string_format_integer_buffer(signal, result));
+    }
+
+    std::string string_format_hex(double signal)
+    {
+        char result[string_format_buffer_size];
+        return std::string(result, string_format_hex_buffer(signal, result));
     }
 
     std::string string_format_raw64(double signal)
     {
-        char result[NAME_MAX];
-        snprintf(result, NAME_MAX, "0x%016" PRIx64, geopm_signal_to_field(signal));
-        return result;
+        char result[string_format_buffer_size];
+        return std::string(result, string_format_raw64_buffer(signal, result));
     }
 
+    string_format_buffer_f string_format_function_to_buffer(const std::function<std::string(double)> &format_function)
+    {
+        static const std::map<decltype(&string_format_double), string_format_buffer_f> function_map = {
+            {string_format_double, string_format_double_buffer},
+            {string_format_float, string_format_float_buffer},
+            {string_format_integer, string_format_integer_buffer},
+            {string_format_hex, string_format_hex_buffer},
+            {string_format_raw64, string_format_raw64_buffer},
+        };
+        string_format_buffer_f result = nullptr;
+        auto f_ptr = format_function.target<decltype(&string_format_double)>();
+        if (f_ptr != nullptr) {
+            auto it = function_map.find(*f_ptr);
+            if (it != function_map.end()) {
+                result = it->second;
+            }
+        }
+        return result;
+    }
 
     std::function<std::string(double)> string_format_type_to_function(int format_type)
     {
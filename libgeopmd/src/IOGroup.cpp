@@ -193,6 +193,15 @@ namespace geopm
     }
 
 
+    void IOGroup::sample_all(const std::vector<int> &sample_idx,
+                             double *result)
+    {
+        for (const auto &idx : sample_idx) {
+            *result = sample(idx);
+            ++result;
+        }
+    }
+
     std::function<std::string(double)> IOGroup::format_function(const std::string &signal_name) const
     {
 #ifdef GEOPM_DEBUG
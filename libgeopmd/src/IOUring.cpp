@@ -35,12 +35,21 @@ namespace geopm
     std::unique_ptr<IOUring> IOUring::make_unique(unsigned entries)
     {
 #ifdef GEOPM_HAS_IO_URING
-        if (IOUringImp::is_supported() &&
-            std::getenv("GEOPM_DISABLE_IO_URING") == nullptr) {
+        if (is_uring_supported()) {
             return IOUringImp::make_unique(entries);
         }
         emit_missing_support_warning();
 #endif
         return IOUringFallback::make_unique(entries);
     }
+
+    bool IOUring::is_uring_supported(void)
+    {
+#ifdef GEOPM_HAS_IO_URING
+        return IOUringImp::is_supported() &&
+               std::getenv("GEOPM_DISABLE_IO_URING") == nullptr;
+#else
+        return false;
+#endif
+    }
 }
@@ -11,12 +11,30 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace geopm
 {
     class IOUring
     {
         public:
+            /// @brief One operation in a batch that is prepared once
+            ///        with add_batch() and issued many times with
+            ///        submit_batch().
+            struct m_operation_s {
+                /// @brief True for a pread, false for a pwrite.
+                bool is_read;
+                /// @brief Which already-opened file to access.
+                int fd;
+                /// @brief Buffer that is read into or written from.
+                ///        Must remain valid while the batch exists.
+                void *buf;
+                /// @brief Number of bytes to transfer.
+                unsigned nbytes;
+                /// @brief Offset within fd for the transfer.
+                off_t offset;
+            };
+
             /// @brief Create and initialize an IO uring.
             IOUring() = default;
 
@@ -57,12 +75,47 @@ namespace geopm
             virtual void prep_write(std::shared_ptr<int> ret, int fd,
                                     const void *buf, unsigned nbytes, off_t offset) = 0;
 
+            /// @brief Define a batch of operations that is issued by
+            ///        every call to submit_batch().  The files and
+            ///        buffers of the operations may be registered with
+            ///        the kernel so that the batch is not prepared
+            ///        again for each submission.
+            /// @param operations  The operations in the batch.
+            /// @return Index of the batch for use with
+            ///         submit_batch() and update_batch().
+            virtual int add_batch(const std::vector<m_operation_s> &operations) = 0;
+
+            /// @brief Replace the operations of a batch, e.g. after
+            ///        the buffers that it refers to were reallocated.
+            /// @param batch_idx  Index returned by add_batch().
+            /// @param operations  The new operations in the batch.
+            virtual void update_batch(int batch_idx,
+                                      const std::vector<m_operation_s> &operations) = 0;
+
+            /// @brief Issue all operations of a batch and wait for
+            ///        them to complete.  Throws if there are errors
+            ///        interacting with the completion queue.
+            ///        Failures of individual operations are reported
+            ///        in @p ret and do not cause this function to
+            ///        throw.
+            /// @param batch_idx  Index returned by add_batch().
+            /// @param ret  Array with one element per operation in
+            ///             the batch where the return values are
+            ///             stored: a non-negative number of bytes
+            ///             transferred, or -errno on failure.
+            virtual void submit_batch(int batch_idx, int *ret) = 0;
+
             /// @brief Create an object that supports an io_uring-like interface. The
             ///        created object uses io_uring if supported, otherwise uses
             ///        individual read/write operations.
             /// @param entries  Maximum number of queue operations to contain
             ///        within a single batch submission.
             static std::unique_ptr<IOUring> make_unique(unsigned entries);
+
+            /// @brief Return whether make_unique() creates an object that
+            ///        uses io_uring rather than individual read/write
+            ///        operations.
+            static bool is_uring_supported(void);
     };
 }
 
@@ -4,8 +4,10 @@
  */
 #include "IOUringFallback.hpp"
 
+#include <cerrno>
 #include <unistd.h>
 
+#include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 
 #include <utility>
@@ -55,6 +57,39 @@ namespace geopm
         m_operations.emplace_back(ret, std::bind(pwrite, fd, buf, nbytes, offset));
     }
 
+    int IOUringFallback::add_batch(const std::vector<m_operation_s> &operations)
+    {
+        m_batch.push_back(operations);
+        return m_batch.size() - 1;
+    }
+
+    void IOUringFallback::update_batch(int batch_idx,
+                                       const std::vector<m_operation_s> &operations)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_batch.size()) {
+            throw Exception("IOUringFallback::update_batch(): batch_idx out of range: " +
+                            std::to_string(batch_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_batch[batch_idx] = operations;
+    }
+
+    void IOUringFallback::submit_batch(int batch_idx, int *ret)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_batch.size()) {
+            throw Exception("IOUringFallback::submit_batch(): batch_idx out of range: " +
+                            std::to_string(batch_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (const auto &op : m_batch[batch_idx]) {
+            ssize_t result = op.is_read ?
+                             pread(op.fd, op.buf, op.nbytes, op.offset) :
+                             pwrite(op.fd, op.buf, op.nbytes, op.offset);
+            *ret = result < 0 ? -errno : result;
+            ++ret;
+        }
+    }
+
     std::unique_ptr<IOUring> IOUringFallback::make_unique(unsigned entries)
     {
         return geopm::make_unique<IOUringFallback>(entries);
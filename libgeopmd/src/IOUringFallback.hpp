@@ -30,6 +30,13 @@ namespace geopm
             void prep_write(std::shared_ptr<int> ret, int fd,
                             const void *buf, unsigned nbytes, off_t offset) override;
 
+            int add_batch(const std::vector<m_operation_s> &operations) override;
+
+            void update_batch(int batch_idx,
+                              const std::vector<m_operation_s> &operations) override;
+
+            void submit_batch(int batch_idx, int *ret) override;
+
             /// @brief Create a fallback implementation of IOUring that uses non-batched
             ///        IO operations, in case we cannot use IO uring or liburing.
             /// @param entries The expected maximum number of batched operations.
@@ -39,6 +46,7 @@ namespace geopm
             // that perform the operation and forward its return value.
             using FutureOperation = std::pair<std::shared_ptr<int>, std::function<int()> >;
             std::vector<FutureOperation> m_operations;
+            std::vector<std::vector<m_operation_s> > m_batch;
     };
 }
 #endif // IOURINGFALLBACK_HPP_INCLUDE
@@ -9,6 +9,8 @@
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <liburing.h>
 
@@ -17,6 +19,8 @@ namespace geopm
     IOUringImp::IOUringImp(unsigned entries)
         : m_ring()
         , m_result_destinations()
+        , m_is_file_registered(false)
+        , m_is_buffer_registered(false)
     {
         int ret = io_uring_queue_init(entries, &m_ring, 0);
         if (ret < 0) {
@@ -101,6 +105,158 @@ namespace geopm
         set_sqe_return_destination(sqe, std::move(ret));
     }
 
+    int IOUringImp::add_batch(const std::vector<m_operation_s> &operations)
+    {
+        m_batch_operations.push_back(operations);
+        m_batch_sqe.emplace_back();
+        register_batches();
+        return m_batch_operations.size() - 1;
+    }
+
+    void IOUringImp::update_batch(int batch_idx,
+                                  const std::vector<m_operation_s> &operations)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_batch_operations.size()) {
+            throw Exception("IOUringImp::update_batch(): batch_idx out of range: " +
+                            std::to_string(batch_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_batch_operations[batch_idx] = operations;
+        register_batches();
+    }
+
+    void IOUringImp::register_batches(void)
+    {
+        // Registration is an optimization: if the kernel refuses it
+        // (e.g. due to RLIMIT_MEMLOCK) the batches use plain file
+        // descriptors and buffers.
+        std::vector<int> fds;
+        for (const auto &operations : m_batch_operations) {
+            for (const auto &op : operations) {
+                fds.push_back(op.fd);
+            }
+        }
+        std::sort(fds.begin(), fds.end());
+        fds.erase(std::unique(fds.begin(), fds.end()), fds.end());
+        if (m_is_file_registered) {
+            io_uring_unregister_files(&m_ring);
+            m_is_file_registered = false;
+        }
+        m_registered_fd = fds;
+        if (!m_registered_fd.empty()) {
+            m_is_file_registered = io_uring_register_files(
+                &m_ring, m_registered_fd.data(), m_registered_fd.size()) == 0;
+        }
+
+        // Register one buffer per batch that spans the memory of all
+        // of its operations when the span is compact.
+        if (m_is_buffer_registered) {
+            io_uring_unregister_buffers(&m_ring);
+            m_is_buffer_registered = false;
+        }
+        m_registered_buffer.clear();
+        m_batch_buffer_idx.assign(m_batch_operations.size(), -1);
+        for (size_t batch_idx = 0; batch_idx != m_batch_operations.size(); ++batch_idx) {
+            const auto &operations = m_batch_operations[batch_idx];
+            if (operations.empty()) {
+                continue;
+            }
+            uintptr_t begin = UINTPTR_MAX;
+            uintptr_t end = 0;
+            for (const auto &op : operations) {
+                begin = std::min(begin, (uintptr_t)op.buf);
+                end = std::max(end, (uintptr_t)op.buf + op.nbytes);
+            }
+            if (end - begin <= M_MAX_FIXED_BUFFER_SIZE) {
+                m_batch_buffer_idx[batch_idx] = m_registered_buffer.size();
+                m_registered_buffer.push_back({(void *)begin, end - begin});
+            }
+        }
+        if (!m_registered_buffer.empty()) {
+            m_is_buffer_registered = io_uring_register_buffers(
+                &m_ring, m_registered_buffer.data(), m_registered_buffer.size()) == 0;
+        }
+        if (!m_is_buffer_registered) {
+            m_batch_buffer_idx.assign(m_batch_operations.size(), -1);
+        }
+
+        for (size_t batch_idx = 0; batch_idx != m_batch_operations.size(); ++batch_idx) {
+            prepare_batch(batch_idx);
+        }
+    }
+
+    void IOUringImp::prepare_batch(int batch_idx)
+    {
+        const auto &operations = m_batch_operations[batch_idx];
+        auto &batch_sqe = m_batch_sqe[batch_idx];
+        int buffer_idx = m_batch_buffer_idx[batch_idx];
+        batch_sqe.assign(operations.size(), {});
+        for (size_t op_idx = 0; op_idx != operations.size(); ++op_idx) {
+            const auto &op = operations[op_idx];
+            auto sqe = &batch_sqe[op_idx];
+            int fd = op.fd;
+            if (m_is_file_registered) {
+                // Registered files are referred to by their index
+                fd = std::lower_bound(m_registered_fd.begin(), m_registered_fd.end(), op.fd) -
+                     m_registered_fd.begin();
+            }
+            if (op.is_read && buffer_idx != -1) {
+                io_uring_prep_read_fixed(sqe, fd, op.buf, op.nbytes, op.offset, buffer_idx);
+            }
+            else if (op.is_read) {
+                io_uring_prep_read(sqe, fd, op.buf, op.nbytes, op.offset);
+            }
+            else if (buffer_idx != -1) {
+                io_uring_prep_write_fixed(sqe, fd, op.buf, op.nbytes, op.offset, buffer_idx);
+            }
+            else {
+                io_uring_prep_write(sqe, fd, op.buf, op.nbytes, op.offset);
+            }
+            if (m_is_file_registered) {
+                sqe->flags |= IOSQE_FIXED_FILE;
+            }
+            // The completion is matched to its return value by index
+            sqe->user_data = op_idx;
+        }
+    }
+
+    void IOUringImp::submit_batch(int batch_idx, int *ret)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_batch_sqe.size()) {
+            throw Exception("IOUringImp::submit_batch(): batch_idx out of range: " +
+                            std::to_string(batch_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const auto &batch_sqe = m_batch_sqe[batch_idx];
+        size_t num_op = batch_sqe.size();
+        size_t op_idx = 0;
+        while (op_idx != num_op) {
+            // Copy as many prepared entries as fit into the queue
+            unsigned num_queued = 0;
+            struct io_uring_sqe *sqe = nullptr;
+            while (op_idx != num_op && (sqe = io_uring_get_sqe(&m_ring)) != nullptr) {
+                *sqe = batch_sqe[op_idx];
+                ++op_idx;
+                ++num_queued;
+            }
+            int err = io_uring_submit_and_wait(&m_ring, num_queued);
+            if (err < 0) {
+                throw Exception("Failed to submit a batch to IO uring",
+                                -err, __FILE__, __LINE__);
+            }
+            for (unsigned num_seen = 0; num_seen != num_queued; ++num_seen) {
+                struct io_uring_cqe *cqe;
+                err = io_uring_wait_cqe(&m_ring, &cqe);
+                if (err < 0) {
+                    throw Exception("Failed to get a completion event from IO uring",
+                                    -err, __FILE__, __LINE__);
+                }
+                ret[cqe->user_data] = cqe->res;
+                io_uring_cqe_seen(&m_ring, cqe);
+            }
+        }
+    }
+
     bool IOUringImp::is_supported()
     {
 #ifdef GEOPM_IO_URING_HAS_FREE
@@ -14,6 +14,8 @@
 
 #include "IOUring.hpp"
 
+#include <sys/uio.h>
+
 #include <vector>
 
 namespace geopm
@@ -36,6 +38,13 @@ namespace geopm
             void prep_write(std::shared_ptr<int> ret, int fd,
                             const void *buf, unsigned nbytes, off_t offset) override;
 
+            int add_batch(const std::vector<m_operation_s> &operations) override;
+
+            void update_batch(int batch_idx,
+                              const std::vector<m_operation_s> &operations) override;
+
+            void submit_batch(int batch_idx, int *ret) override;
+
             /// @brief Return whether this implementation of IOUring is supported.
             static bool is_supported();
 
@@ -50,8 +59,28 @@ namespace geopm
                 std::shared_ptr<int> destination);
 
         private:
+            /// @brief Largest span of memory that is registered as a
+            ///        fixed buffer for one batch.
+            static constexpr size_t M_MAX_FIXED_BUFFER_SIZE = 1024 * 1024;
+            void register_batches(void);
+            void prepare_batch(int batch_idx);
+
             struct io_uring m_ring;
             std::vector<std::shared_ptr<int> > m_result_destinations;
+            /// @brief Operations of each batch as provided by the user.
+            std::vector<std::vector<m_operation_s> > m_batch_operations;
+            /// @brief Prepared submission queue entries for each batch
+            ///        that are copied into the ring on submission.
+            std::vector<std::vector<struct io_uring_sqe> > m_batch_sqe;
+            /// @brief Index of the registered buffer that covers all
+            ///        operations of each batch, or -1.
+            std::vector<int> m_batch_buffer_idx;
+            /// @brief Registered file descriptors, the index into this
+            ///        vector is used in place of the fd.
+            std::vector<int> m_registered_fd;
+            std::vector<struct iovec> m_registered_buffer;
+            bool m_is_file_registered;
+            bool m_is_buffer_registered;
     };
 }
 #endif // IOURINGIMP_HPP_INCLUDE
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "MSRBackendSignal.hpp"
+
+#include <cmath>
+
+#include "geopm_debug.hpp"
+#include "MSRIO.hpp"
+
+namespace geopm
+{
+    MSRBackendSignal::MSRBackendSignal(std::shared_ptr<MSRIO> msrio, int backend)
+        : m_msrio(std::move(msrio))
+        , m_backend(backend)
+    {
+        GEOPM_DEBUG_ASSERT(m_msrio != nullptr, "no valid MSRIO object.");
+    }
+
+    void MSRBackendSignal::setup_batch(void)
+    {
+
+    }
+
+    double MSRBackendSignal::sample(void)
+    {
+        return read();
+    }
+
+    double MSRBackendSignal::read(void) const
+    {
+        double result = NAN;
+        if (m_backend == -1) {
+            int backend = m_msrio->batch_backend();
+            if (backend != -1) {
+                result = backend;
+            }
+        }
+        else {
+            result = m_msrio->batch_latency(m_backend);
+        }
+        return result;
+    }
+}
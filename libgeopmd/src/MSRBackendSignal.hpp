@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MSRBACKENDSIGNAL_HPP_INCLUDE
+#define MSRBACKENDSIGNAL_HPP_INCLUDE
+
+#include <memory>
+
+#include "Signal.hpp"
+
+
+namespace geopm
+{
+    class MSRIO;
+
+    /// @brief Signal reporting the MSR batch read backend selected
+    ///        by MSRIO calibration, or the read latency measured for
+    ///        one of the backends.
+    class MSRBackendSignal : public Signal
+    {
+        public:
+            /// @param [in] msrio MSRIO object used by the IOGroup.
+            /// @param [in] backend One of the MSRIO::m_backend_e
+            ///        values to report the measured latency of that
+            ///        backend, or -1 to report the selected backend.
+            MSRBackendSignal(std::shared_ptr<MSRIO> msrio, int backend);
+            MSRBackendSignal(const MSRBackendSignal &other) = delete;
+            MSRBackendSignal &operator=(const MSRBackendSignal &other) = delete;
+            virtual ~MSRBackendSignal() = default;
+            void setup_batch(void) override;
+            double sample(void) override;
+            double read(void) const override;
+        private:
+            std::shared_ptr<MSRIO> m_msrio;
+            int m_backend;
+    };
+}
+
+#endif
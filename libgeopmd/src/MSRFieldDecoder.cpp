@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+
+#include "MSRFieldDecoder.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include <algorithm>
+
+#include "geopm/Exception.hpp"
+#include "geopm_debug.hpp"
+#include "MSR.hpp"  // for enums
+
+namespace geopm
+{
+    // The decoding is written with the GCC/Clang vector extensions so
+    // that each group is converted with SIMD instructions available
+    // at the baseline instruction set.  Subfields are converted to
+    // double by placing them in the mantissa of 2^52, which is exact
+    // for values of up to 52 bits, and powers of two are constructed
+    // directly in the exponent.  The results are bitwise identical
+    // to MSRFieldSignal::sample().
+    typedef double m_vec_t __attribute__((vector_size(16)));
+    typedef uint64_t m_uvec_t __attribute__((vector_size(16)));
+    static constexpr int M_NUM_LANE = sizeof(m_vec_t) / sizeof(double);
+    static constexpr int M_MAX_VECTOR_BIT = 52;
+    static constexpr uint64_t M_TWO_52_BITS = 0x4330000000000000ULL;
+    static constexpr double M_TWO_52 = 4503599627370496.0;
+    static constexpr uint64_t M_EXPONENT_BIAS = 1023;
+    static constexpr int M_MANTISSA_BIT = 52;
+
+    static inline m_uvec_t decoder_load(const uint64_t *ptr)
+    {
+        m_uvec_t result;
+        std::memcpy(&result, ptr, sizeof(result));
+        return result;
+    }
+
+    static inline void decoder_store(const m_uvec_t &vec, uint64_t *ptr)
+    {
+        std::memcpy(ptr, &vec, sizeof(vec));
+    }
+
+    static inline void decoder_store(const m_vec_t &vec, double *ptr)
+    {
+        std::memcpy(ptr, &vec, sizeof(vec));
+    }
+
+    static inline m_vec_t decoder_to_double(m_uvec_t value)
+    {
+        return (m_vec_t)(value | M_TWO_52_BITS) - M_TWO_52;
+    }
+
+    // Same conversion as MSRFieldSignal::convert_raw_value()
+    static double decoder_scalar(int function, uint64_t subfield, int num_bit,
+                                 double scalar, uint64_t &last_subfield,
+                                 uint64_t &num_overflow)
+    {
+        double result = NAN;
+        uint64_t float_y, float_z;
+        switch (function) {
+            case MSR::M_FUNCTION_LOG_HALF:
+                result = 1.0 / (1ULL << subfield);
+                break;
+            case MSR::M_FUNCTION_7_BIT_FLOAT:
+                float_y = subfield & 0x1F;
+                float_z = subfield >> 5;
+                result = (1ULL << float_y) * (1.0 + float_z / 4.0);
+                break;
+            case MSR::M_FUNCTION_OVERFLOW:
+                if (last_subfield > subfield) {
+                    ++num_overflow;
+                }
+                result = subfield + ((((1ULL << num_bit) - 1) + 1.0) * num_overflow);
+                break;
+            case MSR::M_FUNCTION_SCALE:
+            case MSR::M_FUNCTION_LOGIC:
+                result = subfield;
+                break;
+            default:
+                GEOPM_DEBUG_ASSERT(false, "invalid function type for MSRFieldDecoder");
+                break;
+        }
+        last_subfield = subfield;
+        return result * scalar;
+    }
+
+    template <int function>
+    static void decoder_vector(const uint64_t *field, int num_field,
+                               int shift, int num_bit, double scalar,
+                               double *value, uint64_t *last_subfield,
+                               uint64_t *num_overflow)
+    {
+        const uint64_t mask = ((1ULL << num_bit) - 1) << shift;
+        const double field_range = ((1ULL << num_bit) - 1) + 1.0;
+        int idx = 0;
+        for (; idx + M_NUM_LANE <= num_field; idx += M_NUM_LANE) {
+            m_uvec_t subfield = (decoder_load(field + idx) & mask) >> shift;
+            m_vec_t result;
+            if (function == MSR::M_FUNCTION_LOG_HALF) {
+                // 2 ^ -X
+                result = (m_vec_t)((M_EXPONENT_BIAS - subfield) << M_MANTISSA_BIT);
+            }
+            else if (function == MSR::M_FUNCTION_7_BIT_FLOAT) {
+                // 2 ^ Y * (1.0 + Z / 4.0) with Z in the two most
+                // significant bits of the mantissa
+                m_uvec_t float_y = subfield & 0x1F;
+                m_uvec_t float_z = subfield >> 5;
+                result = (m_vec_t)(((M_EXPONENT_BIAS + float_y) << M_MANTISSA_BIT) |
+                                   (float_z << (M_MANTISSA_BIT - 2)));
+            }
+            else if (function == MSR::M_FUNCTION_OVERFLOW) {
+                m_uvec_t last = decoder_load(last_subfield + idx);
+                // Comparison yields -1 in lanes that wrapped
+                m_uvec_t overflow = decoder_load(num_overflow + idx) -
+                                    (m_uvec_t)(last > subfield);
+                result = decoder_to_double(subfield) +
+                         field_range * decoder_to_double(overflow);
+                decoder_store(subfield, last_subfield + idx);
+                decoder_store(overflow, num_overflow + idx);
+            }
+            else {
+                result = decoder_to_double(subfield);
+            }
+            decoder_store(result * scalar, value + idx);
+        }
+        for (; idx < num_field; ++idx) {
+            uint64_t subfield = (field[idx] & mask) >> shift;
+            value[idx] = decoder_scalar(function, subfield, num_bit, scalar,
+                                        last_subfield[idx], num_overflow[idx]);
+        }
+    }
+
+    MSRFieldDecoder::MSRFieldDecoder()
+        : m_is_frozen(false)
+    {
+
+    }
+
+    int MSRFieldDecoder::add_field(int raw_idx, int begin_bit, int end_bit,
+                                   int function, double scalar)
+    {
+        if (m_is_frozen) {
+            throw Exception("MSRFieldDecoder::add_field(): cannot add a field after decode() has been called",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        GEOPM_DEBUG_ASSERT(begin_bit <= end_bit && end_bit - begin_bit + 1 < 64,
+                           "invalid bit range for MSRFieldDecoder");
+        GEOPM_DEBUG_ASSERT(function >= 0 && function < MSR::M_NUM_FUNCTION,
+                           "invalid encoding function");
+        int num_bit = end_bit - begin_bit + 1;
+        auto group_it = std::find_if(m_group.begin(), m_group.end(),
+            [begin_bit, num_bit, function, scalar](const m_group_s &group) {
+                return group.shift == begin_bit &&
+                       group.num_bit == num_bit &&
+                       group.function == function &&
+                       group.scalar == scalar;
+            });
+        if (group_it == m_group.end()) {
+            m_group.push_back({begin_bit, num_bit, function, scalar, 0, {}, {}});
+            group_it = m_group.end() - 1;
+        }
+        int result = m_field_pos.size();
+        group_it->raw_idx.push_back(raw_idx);
+        group_it->field_idx.push_back(result);
+        m_field_pos.push_back(-1);
+        return result;
+    }
+
+    int MSRFieldDecoder::num_field(void) const
+    {
+        return m_field_pos.size();
+    }
+
+    void MSRFieldDecoder::freeze(void)
+    {
+        int offset = 0;
+        for (auto &group : m_group) {
+            group.offset = offset;
+            for (auto field_idx : group.field_idx) {
+                m_field_pos[field_idx] = offset;
+                ++offset;
+            }
+        }
+        m_field.resize(offset, 0);
+        m_value.resize(offset, NAN);
+        m_last_subfield.resize(offset, 0);
+        m_num_overflow.resize(offset, 0);
+        m_is_frozen = true;
+    }
+
+    void MSRFieldDecoder::decode(const uint64_t *raw)
+    {
+        if (!m_is_frozen) {
+            freeze();
+        }
+        for (const auto &group : m_group) {
+            uint64_t *field = m_field.data() + group.offset;
+            for (auto raw_idx : group.raw_idx) {
+                *field = raw[raw_idx];
+                ++field;
+            }
+            decode_group(group);
+        }
+    }
+
+    void MSRFieldDecoder::decode_group(const m_group_s &group)
+    {
+        const uint64_t *field = m_field.data() + group.offset;
+        int num_field = group.raw_idx.size();
+        double *value = m_value.data() + group.offset;
+        uint64_t *last_subfield = m_last_subfield.data() + group.offset;
+        uint64_t *num_overflow = m_num_overflow.data() + group.offset;
+        // Limits on the field width where the vector conversion is
+        // exact; wider fields use the scalar conversion.
+        int max_bit = M_MAX_VECTOR_BIT;
+        auto kernel = decoder_vector<MSR::M_FUNCTION_SCALE>;
+        switch (group.function) {
+            case MSR::M_FUNCTION_LOG_HALF:
+                max_bit = 6;
+                kernel = decoder_vector<MSR::M_FUNCTION_LOG_HALF>;
+                break;
+            case MSR::M_FUNCTION_7_BIT_FLOAT:
+                max_bit = 7;
+                kernel = decoder_vector<MSR::M_FUNCTION_7_BIT_FLOAT>;
+                break;
+            case MSR::M_FUNCTION_OVERFLOW:
+                kernel = decoder_vector<MSR::M_FUNCTION_OVERFLOW>;
+                break;
+            default:
+                break;
+        }
+        if (group.num_bit <= max_bit) {
+            kernel(field, num_field, group.shift, group.num_bit, group.scalar,
+                   value, last_subfield, num_overflow);
+        }
+        else {
+            const uint64_t mask = ((1ULL << group.num_bit) - 1) << group.shift;
+            for (int idx = 0; idx < num_field; ++idx) {
+                uint64_t subfield = (field[idx] & mask) >> group.shift;
+                value[idx] = decoder_scalar(group.function, subfield, group.num_bit,
+                                            group.scalar, last_subfield[idx],
+                                            num_overflow[idx]);
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MSRFIELDDECODER_HPP_INCLUDE
+#define MSRFIELDDECODER_HPP_INCLUDE
+
+#include <cstdint>
+
+#include <vector>
+
+namespace geopm
+{
+    /// Decodes a batch of MSR bitfields into double signal values in
+    /// SI units.  The conversion of each field is the same as
+    /// MSRFieldSignal::sample(), but fields that share the same bits,
+    /// function and scalar are grouped together and each group is
+    /// decoded in a single pass over contiguous arrays.  The enum
+    /// for the function comes from the MSR class.
+    class MSRFieldDecoder
+    {
+        public:
+            MSRFieldDecoder();
+            ~MSRFieldDecoder() = default;
+            /// @brief Add a field to be decoded by future calls to
+            ///        decode().  Fields cannot be added after the
+            ///        first call to decode().
+            /// @param [in] raw_idx Index of the raw MSR value in the
+            ///        array passed to decode().
+            /// @param [in] begin_bit First bit of the field.
+            /// @param [in] end_bit Last bit of the field.
+            /// @param [in] function One of the MSR::m_function_e
+            ///        values.
+            /// @param [in] scalar Factor applied to the decoded
+            ///        value.
+            /// @return Index of the field to pass to value().
+            int add_field(int raw_idx, int begin_bit, int end_bit,
+                          int function, double scalar);
+            /// @return Number of fields added.
+            int num_field(void) const;
+            /// @brief Decode all fields.  Counter overflow is tracked
+            ///        between calls.
+            /// @param [in] raw Array of raw MSR values indexed by
+            ///        the raw_idx given to add_field().
+            void decode(const uint64_t *raw);
+            /// @return The value of a field from the last call to
+            ///         decode().
+            /// @param [in] field_idx Index returned by add_field().
+            double value(int field_idx) const
+            {
+                return m_value[m_field_pos[field_idx]];
+            }
+        private:
+            struct m_group_s {
+                int shift;
+                int num_bit;
+                int function;
+                double scalar;
+                /// Offset of the group in the contiguous arrays
+                int offset;
+                /// Indices into the raw array for each member
+                std::vector<int> raw_idx;
+                /// Field indices of each member
+                std::vector<int> field_idx;
+            };
+            void freeze(void);
+            void decode_group(const m_group_s &group);
+
+            std::vector<m_group_s> m_group;
+            bool m_is_frozen;
+            /// Position of each field in the contiguous arrays
+            std::vector<int> m_field_pos;
+            /// Raw values gathered for each group
+            std::vector<uint64_t> m_field;
+            std::vector<double> m_value;
+            /// Overflow state for M_FUNCTION_OVERFLOW fields
+            std::vector<uint64_t> m_last_subfield;
+            std::vector<uint64_t> m_num_overflow;
+    };
+}
+
+#endif
@@ -110,4 +110,9 @@ namespace geopm
         int num_overflow = 0;
         return convert_raw_value(m_raw_msr->read(), last_field, num_overflow);
     }
+
+    MSRFieldSignal::m_field_s MSRFieldSignal::field(void) const
+    {
+        return {m_raw_msr, m_shift, m_shift + m_num_bit - 1, m_function, m_scalar};
+    }
 }
@@ -35,6 +35,18 @@ namespace geopm
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Description of the bitfield decoded by the
+            ///        signal.
+            struct m_field_s {
+                std::shared_ptr<Signal> raw_msr;
+                int begin_bit;
+                int end_bit;
+                int function;
+                double scalar;
+            };
+            /// @return The raw MSR signal and decoding parameters
+            ///         used by sample().
+            m_field_s field(void) const;
         private:
             double convert_raw_value(double val,
                                      uint64_t &last_field,
@@ -11,16 +11,20 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <map>
 
 #include "geopm_error.h"
 #include "geopm_sched.h"
+#include "geopm_time.h"
 #include "geopm_debug.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "IOUring.hpp"
+#include "IOUringFallback.hpp"
 #include "MSRPath.hpp"
 
 #define GEOPM_IOC_MSR_BATCH _IOWR('c', 0xA2, struct geopm::MSRIOImp::m_msr_batch_array_s)
@@ -33,7 +37,8 @@ namespace geopm
     }
 
     MSRIOImp::MSRIOImp(std::shared_ptr<MSRPath> path)
-        : MSRIOImp(platform_topo().num_domain(GEOPM_DOMAIN_CPU), std::move(path), nullptr, nullptr)
+        : MSRIOImp(platform_topo().num_domain(GEOPM_DOMAIN_CPU), std::move(path), nullptr, nullptr,
+                   IOUring::is_uring_supported() ? IOUringFallback::make_unique(0) : nullptr)
     {
 
     }
@@ -41,6 +46,16 @@ namespace geopm
     MSRIOImp::MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
                        std::shared_ptr<IOUring> batch_reader,
                        std::shared_ptr<IOUring> batch_writer)
+        : MSRIOImp(num_cpu, std::move(path), std::move(batch_reader),
+                   std::move(batch_writer), nullptr)
+    {
+
+    }
+
+    MSRIOImp::MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
+                       std::shared_ptr<IOUring> batch_reader,
+                       std::shared_ptr<IOUring> batch_writer,
+                       std::shared_ptr<IOUring> pread_reader)
         : m_num_cpu(num_cpu)
         , m_file_desc(m_num_cpu + 1, -1) // Last file descriptor is for the batch file
         , m_is_batch_enabled(path->msr_batch_path() != "")
@@ -48,9 +63,12 @@ namespace geopm
         , m_path(std::move(path))
         , m_batch_reader(std::move(batch_reader))
         , m_batch_writer(std::move(batch_writer))
+        , m_pread_reader(std::move(pread_reader))
+        , m_backend(-1)
     {
         create_batch_context();
         open_all();
+        reset_calibration();
     }
 
     MSRIOImp::~MSRIOImp()
@@ -327,7 +345,7 @@ namespace geopm
         }
     }
 
-    void MSRIOImp::msr_read_files(int batch_ctx)
+    void MSRIOImp::msr_read_files(int batch_ctx, int backend)
     {
         auto &read_batch = m_batch_context.at(batch_ctx).m_read_batch;
         if (read_batch.numops == 0) {
@@ -338,37 +356,50 @@ namespace geopm
                            "Batch operations not updated prior to calling "
                            "MSRIOImp::msr_read_files()");
 
+        if (backend == M_BACKEND_PREAD && m_pread_reader) {
+            msr_batch_io(*m_pread_reader, m_batch_context.at(batch_ctx).m_uring_pread,
+                         read_batch);
+            return;
+        }
         if (!m_batch_reader) {
             m_batch_reader = IOUring::make_unique(read_batch.numops);
         }
-        msr_batch_io(*m_batch_reader, read_batch);
+        msr_batch_io(*m_batch_reader, m_batch_context.at(batch_ctx).m_uring_read,
+                     read_batch);
     }
 
     void MSRIOImp::msr_batch_io(IOUring &batcher,
+                                struct m_uring_batch_s &uring_batch,
                                 struct m_msr_batch_array_s &batch)
     {
-        std::vector<std::shared_ptr<int> > return_values;
-        return_values.reserve(batch.numops);
-
-        for (uint32_t batch_idx = 0; batch_idx != batch.numops; ++batch_idx) {
-            return_values.emplace_back(new int(0));
-            auto& batch_op = batch.ops[batch_idx];
-            if (batch_op.isrdmsr) {
-                batcher.prep_read(return_values.back(), msr_desc(batch_op.cpu),
-                                  &batch_op.msrdata, sizeof(batch_op.msrdata),
-                                  batch_op.msr);
+        // Prepare the IOUring batch once and only again if the
+        // operations were added to or reallocated.
+        if (uring_batch.ops != batch.ops || uring_batch.numops != batch.numops) {
+            std::vector<IOUring::m_operation_s> operations;
+            operations.reserve(batch.numops);
+            for (uint32_t batch_idx = 0; batch_idx != batch.numops; ++batch_idx) {
+                auto& batch_op = batch.ops[batch_idx];
+                operations.push_back({batch_op.isrdmsr != 0, msr_desc(batch_op.cpu),
+                                      &batch_op.msrdata, sizeof(batch_op.msrdata),
+                                      batch_op.msr});
+            }
+            if (uring_batch.batch_idx == -1) {
+                uring_batch.batch_idx = batcher.add_batch(operations);
             }
             else {
-                batcher.prep_write(return_values.back(), msr_desc(batch_op.cpu),
-                                   &batch_op.msrdata, sizeof(batch_op.msrdata),
-                                   batch_op.msr);
+                batcher.update_batch(uring_batch.batch_idx, operations);
             }
+            uring_batch.ops = batch.ops;
+            uring_batch.numops = batch.numops;
+        }
+        if (m_batch_return.size() < batch.numops) {
+            m_batch_return.resize(batch.numops);
         }
 
-        batcher.submit();
+        batcher.submit_batch(uring_batch.batch_idx, m_batch_return.data());
 
         for (uint32_t batch_idx = 0; batch_idx != batch.numops; ++batch_idx) {
-            ssize_t successful_bytes = *return_values[batch_idx];
+            ssize_t successful_bytes = m_batch_return[batch_idx];
             auto& batch_op = batch.ops[batch_idx];
             if (successful_bytes != sizeof(batch_op.msrdata)) {
                 std::ostringstream err_str;
@@ -402,7 +433,8 @@ namespace geopm
         }
 
         // Read existing MSR values
-        msr_batch_io(*m_batch_writer, write_batch);
+        msr_batch_io(*m_batch_writer, m_batch_context.at(batch_ctx).m_uring_rmw_read,
+                     write_batch);
 
         // Modify with write mask
         int op_idx = 0;
@@ -417,7 +449,8 @@ namespace geopm
         }
 
         // Write back the modified MSRs
-        msr_batch_io(*m_batch_writer, write_batch);
+        msr_batch_io(*m_batch_writer, m_batch_context.at(batch_ctx).m_uring_rmw_write,
+                     write_batch);
         for (auto &op_it : write_batch_op) {
             op_it.isrdmsr = 1;
         }
@@ -434,17 +467,133 @@ namespace geopm
         ctx.m_read_batch.numops = ctx.m_read_batch_op.size();
         ctx.m_read_batch.ops = ctx.m_read_batch_op.data();
 
-        // Use the batch-oriented MSR-safe ioctl if possible. Otherwise, operate
-        // over individual read operations per MSR.
-        if (m_is_batch_enabled) {
-            msr_ioctl_read(ctx);
+        // Use the backend selected by calibration.  Until one is
+        // selected, each read is used to time one of the candidates.
+        if (m_backend != -1) {
+            read_backend(batch_ctx, m_backend);
+        }
+        else if (ctx.m_read_batch.numops != 0) {
+            calibrate_read(batch_ctx);
+        }
+        ctx.m_is_batch_read = true;
+    }
+
+    void MSRIOImp::read_backend(int batch_ctx, int backend)
+    {
+        if (backend == M_BACKEND_IOCTL) {
+            msr_ioctl_read(m_batch_context.at(batch_ctx));
         }
         else {
-            msr_read_files(batch_ctx);
+            msr_read_files(batch_ctx, backend);
+        }
+    }
+
+    void MSRIOImp::reset_calibration(void)
+    {
+        // The msr-safe batch ioctl is a candidate if its device was
+        // opened.  When a separate pread_reader is provided, the
+        // batch_reader is assumed to use io_uring and both are timed.
+        m_calibrate_backend.clear();
+        if (m_is_batch_enabled) {
+            m_calibrate_backend.push_back(M_BACKEND_IOCTL);
+        }
+        if (m_pread_reader) {
+            m_calibrate_backend.push_back(M_BACKEND_URING);
+        }
+        m_calibrate_backend.push_back(M_BACKEND_PREAD);
+        m_calibrate_num_sample.assign(M_NUM_BACKEND, 0);
+        m_batch_latency.assign(M_NUM_BACKEND, NAN);
+        m_backend = -1;
+        if (m_calibrate_backend.size() == 1) {
+            m_backend = m_calibrate_backend[0];
+        }
+    }
+
+    void MSRIOImp::calibrate_read(int batch_ctx)
+    {
+        // Time the candidate with the fewest samples.  A candidate
+        // that throws is removed and the next one is tried; if every
+        // candidate fails the error is passed to the caller.
+        std::vector<int> failed_backend;
+        bool is_done = false;
+        while (!is_done) {
+            auto backend_it = std::min_element(
+                m_calibrate_backend.begin(), m_calibrate_backend.end(),
+                [this](int lhs, int rhs) {
+                    return m_calibrate_num_sample[lhs] < m_calibrate_num_sample[rhs];
+                });
+            int backend = *backend_it;
+            geopm_time_s begin;
+            geopm_time(&begin);
+            try {
+                read_backend(batch_ctx, backend);
+                is_done = true;
+            }
+            catch (const Exception &ex) {
+                failed_backend.push_back(backend);
+                m_calibrate_backend.erase(backend_it);
+                if (m_calibrate_backend.empty()) {
+                    m_calibrate_backend = failed_backend;
+                    std::sort(m_calibrate_backend.begin(), m_calibrate_backend.end());
+                    throw;
+                }
+                continue;
+            }
+            double latency = geopm_time_since(&begin) /
+                             m_batch_context.at(batch_ctx).m_read_batch.numops;
+            if (std::isnan(m_batch_latency[backend]) ||
+                latency < m_batch_latency[backend]) {
+                m_batch_latency[backend] = latency;
+            }
+            ++m_calibrate_num_sample[backend];
+        }
+        bool is_calibrated = std::all_of(
+            m_calibrate_backend.begin(), m_calibrate_backend.end(),
+            [this](int backend) {
+                return m_calibrate_num_sample[backend] >= M_NUM_CALIBRATE_SAMPLE;
+            });
+        if (is_calibrated) {
+            m_backend = *std::min_element(
+                m_calibrate_backend.begin(), m_calibrate_backend.end(),
+                [this](int lhs, int rhs) {
+                    return m_batch_latency[lhs] < m_batch_latency[rhs];
+                });
+        }
+    }
+
+    void MSRIOImp::calibrate(int batch_ctx)
+    {
+        m_batch_context_s &ctx = m_batch_context.at(batch_ctx);
+        ctx.m_read_batch.numops = ctx.m_read_batch_op.size();
+        ctx.m_read_batch.ops = ctx.m_read_batch_op.data();
+        if (ctx.m_read_batch.numops == 0) {
+            throw Exception("MSRIOImp::calibrate(): No reads have been added to batch context " +
+                            std::to_string(batch_ctx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        reset_calibration();
+        m_backend = -1;
+        while (m_backend == -1) {
+            calibrate_read(batch_ctx);
         }
         ctx.m_is_batch_read = true;
     }
 
+    int MSRIOImp::batch_backend(void) const
+    {
+        return m_backend;
+    }
+
+    double MSRIOImp::batch_latency(int backend) const
+    {
+        if (backend < 0 || backend >= M_NUM_BACKEND) {
+            throw Exception("MSRIOImp::batch_latency(): Backend out of range: " +
+                            std::to_string(backend),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_batch_latency[backend];
+    }
+
     void MSRIOImp::write_batch(void)
     {
         write_batch(0);
@@ -21,6 +21,17 @@ namespace geopm
                 M_NUM_DRIVER,
             };
 
+            /// @brief Mechanisms used to issue a batch of MSR reads.
+            enum m_backend_e {
+                /// @brief Single ioctl() to the msr-safe batch device.
+                M_BACKEND_IOCTL,
+                /// @brief Reads of the per-CPU files through io_uring.
+                M_BACKEND_URING,
+                /// @brief Individual pread() of the per-CPU files.
+                M_BACKEND_PREAD,
+                M_NUM_BACKEND,
+            };
+
             MSRIO() = default;
             virtual ~MSRIO() = default;
             /// @brief Read from a single MSR on a CPU.
@@ -131,6 +142,22 @@ namespace geopm
             /// @brief Write all adjusted values.
             /// @param [in] batch_ctx index for batch context to use for the write.
             virtual void write_batch(int batch_ctx) = 0;
+            /// @brief Time each available backend on the reads of a
+            ///        batch context and use the fastest one for all
+            ///        later calls to read_batch().  If this is not
+            ///        called, the backends are timed during the first
+            ///        calls to read_batch() instead.
+            /// @param [in] batch_ctx index of the batch context with
+            ///        the reads to time.
+            virtual void calibrate(int batch_ctx) = 0;
+            /// @return The m_backend_e used by read_batch(), or -1
+            ///         if calibration has not finished.
+            virtual int batch_backend(void) const = 0;
+            /// @param [in] backend One of the m_backend_e values.
+            /// @return The shortest batch read time per MSR in
+            ///         seconds measured for the backend, or NAN if
+            ///         it was not measured.
+            virtual double batch_latency(int backend) const = 0;
             /// @brief Returns a unique_ptr to a concrete object
             ///        constructed using the underlying implementation
             static std::unique_ptr<MSRIO> make_unique(int driver_type);
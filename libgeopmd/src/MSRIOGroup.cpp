@@ -18,6 +18,7 @@
 #include "geopm/json11.hpp"
 
 #include "geopm_sched.h"
+#include "geopm_field.h"
 #include "geopm/Exception.hpp"
 #include "geopm/Agg.hpp"
 #include "geopm/PlatformIO.hpp"
@@ -25,6 +26,7 @@
 #include "MSR.hpp"
 #include "Signal.hpp"
 #include "RawMSRSignal.hpp"
+#include "MSRBackendSignal.hpp"
 #include "MSRFieldSignal.hpp"
 #include "DifferenceSignal.hpp"
 #include "TimeSignal.hpp"
@@ -281,6 +283,7 @@ namespace geopm
         register_power_signals();
         register_pcnt_scalability_signals();
         register_rdt_signals();
+        register_backend_signals();
 
         register_control_alias("CPU_POWER_LIMIT_CONTROL", "MSR::PKG_POWER_LIMIT:PL1_POWER_LIMIT");
         register_control_alias("CPU_POWER_TIME_WINDOW_CONTROL", "MSR::PKG_POWER_LIMIT:PL1_TIME_WINDOW");
@@ -430,6 +433,36 @@ namespace geopm
         }
     }
 
+    void MSRIOGroup::register_backend_signals(void)
+    {
+        m_signal_available["MSR::BATCH_BACKEND"] = {
+            {std::make_shared<MSRBackendSignal>(m_msrio, -1)},
+            GEOPM_DOMAIN_BOARD,
+            IOGroup::M_UNITS_NONE,
+            Agg::select_first,
+            "Backend used for batch MSR reads: 0 for the msr-safe batch ioctl, "
+            "1 for io_uring, 2 for pread(2); NAN while calibrating",
+            // Changes once when calibration completes
+            IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE,
+            string_format_integer};
+        const std::vector<std::pair<std::string, int> > latency_signals {
+            {"MSR::BATCH_LATENCY_IOCTL", MSRIO::M_BACKEND_IOCTL},
+            {"MSR::BATCH_LATENCY_URING", MSRIO::M_BACKEND_URING},
+            {"MSR::BATCH_LATENCY_PREAD", MSRIO::M_BACKEND_PREAD},
+        };
+        for (const auto &sig : latency_signals) {
+            m_signal_available[sig.first] = {
+                {std::make_shared<MSRBackendSignal>(m_msrio, sig.second)},
+                GEOPM_DOMAIN_BOARD,
+                IOGroup::M_UNITS_SECONDS,
+                Agg::select_first,
+                "Fastest batch MSR read time per MSR measured during calibration "
+                "of the backend; NAN if the backend was not measured",
+                IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE,
+                string_format_double};
+        }
+    }
+
     void MSRIOGroup::register_power_signals(void)
     {
         // register time signal; domain board
@@ -783,6 +816,28 @@ namespace geopm
             result = m_signal_pushed.size();
             m_signal_pushed.push_back(signal);
             signal->setup_batch();
+            m_signal_field_idx.push_back(push_field(signal));
+        }
+        return result;
+    }
+
+    int MSRIOGroup::push_field(const std::shared_ptr<Signal> &signal)
+    {
+        int result = -1;
+        auto field_signal = std::dynamic_pointer_cast<MSRFieldSignal>(signal);
+        if (field_signal != nullptr) {
+            auto field = field_signal->field();
+            // Fields of the same MSR share one raw value
+            auto raw_it = std::find(m_field_raw.begin(), m_field_raw.end(),
+                                    field.raw_msr);
+            int raw_idx = raw_it - m_field_raw.begin();
+            if (raw_it == m_field_raw.end()) {
+                m_field_raw.push_back(field.raw_msr);
+                m_field_raw_value.push_back(0);
+            }
+            result = m_field_decoder.add_field(raw_idx, field.begin_bit,
+                                               field.end_bit, field.function,
+                                               field.scalar);
         }
         return result;
     }
@@ -843,6 +898,13 @@ namespace geopm
         if (m_signal_pushed.size() != 0) {
             m_msrio->read_batch();
         }
+        if (m_field_decoder.num_field() != 0) {
+            for (size_t raw_idx = 0; raw_idx != m_field_raw.size(); ++raw_idx) {
+                m_field_raw_value[raw_idx] =
+                    geopm_signal_to_field(m_field_raw[raw_idx]->sample());
+            }
+            m_field_decoder.decode(m_field_raw_value.data());
+        }
         // update timesignal value
         *m_time_batch = geopm_time_since(m_time_zero.get());
 
@@ -873,7 +935,29 @@ namespace geopm
             throw Exception("MSRIOGroup::sample() called before signal was read.",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        return m_signal_pushed[signal_idx]->sample();
+        int field_idx = m_signal_field_idx[signal_idx];
+        return field_idx != -1 ? m_field_decoder.value(field_idx) :
+                                 m_signal_pushed[signal_idx]->sample();
+    }
+
+    void MSRIOGroup::sample_all(const std::vector<int> &sample_idx,
+                                double *result)
+    {
+        if (!m_is_read) {
+            throw Exception("MSRIOGroup::sample_all() called before signal was read.",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        int num_signal = m_signal_pushed.size();
+        for (const auto &signal_idx : sample_idx) {
+            if (signal_idx < 0 || signal_idx >= num_signal) {
+                throw Exception("MSRIOGroup::sample_all(): signal_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            int field_idx = m_signal_field_idx[signal_idx];
+            *result = field_idx != -1 ? m_field_decoder.value(field_idx) :
+                                        m_signal_pushed[signal_idx]->sample();
+            ++result;
+        }
     }
 
     void MSRIOGroup::adjust(int control_idx, double setting)
@@ -19,6 +19,7 @@
 #include "geopm_time.h"
 
 #include "geopm/IOGroup.hpp"
+#include "MSRFieldDecoder.hpp"
 
 extern "C"
 {
@@ -71,6 +72,8 @@ namespace geopm
             void read_batch(void) override;
             void write_batch(void) override;
             double sample(int sample_idx) override;
+            void sample_all(const std::vector<int> &sample_idx,
+                            double *result) override;
             void adjust(int control_idx,
                         double setting) override;
             double read_signal(const std::string &signal_name,
@@ -162,6 +165,9 @@ namespace geopm
             /// @brief Add support for Intel Resource Director signals if
             ///        underlying signals are available.
             void register_rdt_signals(void);
+            /// @brief Add diagnostic signals that report the MSR batch
+            ///        read backend selected by calibration.
+            void register_backend_signals(void);
             /// @brief Add support for frequency signal aliases if underlying
             ///        signals are available.
             void register_frequency_signals(void);
@@ -173,6 +179,11 @@ namespace geopm
             void check_control(const std::string &control_name);
 
             void check_control_pwrite(void);
+            /// @brief Add a pushed signal to the batch decoder if it
+            ///        is an MSR bitfield.
+            /// @return Index into the decoder, or -1 if the signal
+            ///         is not decoded in batch.
+            int push_field(const std::shared_ptr<Signal> &signal);
 
             /// @brief Check control lock and error if locked
             void check_control_lock(const std::string &lock_name, const std::string &error);
@@ -256,6 +267,16 @@ namespace geopm
 
             // Mapping of signal index to pushed signals.
             std::vector<std::shared_ptr<Signal> > m_signal_pushed;
+            // Pushed signals that are MSR bitfields are decoded
+            // together by read_batch().  Index into m_field_decoder
+            // for each pushed signal, or -1 if the signal is sampled
+            // directly.
+            std::vector<int> m_signal_field_idx;
+            MSRFieldDecoder m_field_decoder;
+            // Raw MSR signals that contain the decoded bitfields and
+            // their values from the last read_batch()
+            std::vector<std::shared_ptr<Signal> > m_field_raw;
+            std::vector<uint64_t> m_field_raw_value;
             // Mapping of control index to pushed controls
             std::vector<std::shared_ptr<Control> > m_control_pushed;
 
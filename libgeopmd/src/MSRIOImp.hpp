@@ -24,6 +24,14 @@ namespace geopm
             MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
                      std::shared_ptr<IOUring> batch_reader,
                      std::shared_ptr<IOUring> batch_writer);
+            /// @param [in] pread_reader If not null, an IOUring that
+            ///        issues individual pread() operations and is
+            ///        timed against the batch_reader, which is then
+            ///        considered to use io_uring.
+            MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
+                     std::shared_ptr<IOUring> batch_reader,
+                     std::shared_ptr<IOUring> batch_writer,
+                     std::shared_ptr<IOUring> pread_reader);
             MSRIOImp(const MSRIOImp &other) = delete;
             MSRIOImp &operator=(const MSRIOImp &other) = delete;
             virtual ~MSRIOImp();
@@ -47,7 +55,13 @@ namespace geopm
             void adjust(int batch_idx, uint64_t value, uint64_t write_mask) override;
             void adjust(int batch_idx, uint64_t value, uint64_t write_mask, int batch_ctx) override;
             uint64_t system_write_mask(uint64_t offset) override;
+            void calibrate(int batch_ctx) override;
+            int batch_backend(void) const override;
+            double batch_latency(int backend) const override;
         private:
+            /// @brief Number of times each backend is timed before the
+            ///        fastest one is selected.
+            static constexpr int M_NUM_CALIBRATE_SAMPLE = 3;
             struct m_msr_batch_op_s {
                 uint16_t cpu;      /// @brief In: CPU to execute {rd/wr}msr ins.
                 uint16_t isrdmsr;  /// @brief In: 0=wrmsr, non-zero=rdmsr
@@ -62,11 +76,25 @@ namespace geopm
                 struct m_msr_batch_op_s *ops;  /// @brief In: Array[numops] of operations
             };
 
+            /// @brief Tracks the IOUring batch that was prepared for
+            ///        an array of operations.
+            struct m_uring_batch_s {
+                /// @brief Index returned by IOUring::add_batch(), or -1.
+                int batch_idx;
+                /// @brief Operations that the IOUring batch refers to.
+                const struct m_msr_batch_op_s *ops;
+                uint32_t numops;
+            };
+
             struct m_batch_context_s {
                 m_batch_context_s(int num_cpu)
                     : m_is_batch_read(false)
                     , m_read_batch({0, nullptr})
                     , m_write_batch({0, nullptr})
+                    , m_uring_read({-1, nullptr, 0})
+                    , m_uring_rmw_read({-1, nullptr, 0})
+                    , m_uring_rmw_write({-1, nullptr, 0})
+                    , m_uring_pread({-1, nullptr, 0})
                     , m_read_batch_op(0)
                     , m_write_batch_op(0)
                     , m_read_batch_idx_map(num_cpu)
@@ -76,6 +104,10 @@ namespace geopm
                 bool m_is_batch_read;
                 struct m_msr_batch_array_s m_read_batch;
                 struct m_msr_batch_array_s m_write_batch;
+                struct m_uring_batch_s m_uring_read;
+                struct m_uring_batch_s m_uring_rmw_read;
+                struct m_uring_batch_s m_uring_rmw_write;
+                struct m_uring_batch_s m_uring_pread;
                 std::vector<struct m_msr_batch_op_s> m_read_batch_op;
                 std::vector<struct m_msr_batch_op_s> m_write_batch_op;
                 std::vector<std::map<uint64_t, int> > m_read_batch_idx_map;
@@ -95,8 +127,12 @@ namespace geopm
             void msr_ioctl(struct m_msr_batch_array_s &batch);
             void msr_ioctl_read(struct m_batch_context_s &ctx);
             void msr_ioctl_write(struct m_batch_context_s &ctx);
-            void msr_batch_io(IOUring &batcher, struct m_msr_batch_array_s &batch);
-            void msr_read_files(int batch_ctx);
+            void msr_batch_io(IOUring &batcher, struct m_uring_batch_s &uring_batch,
+                              struct m_msr_batch_array_s &batch);
+            void msr_read_files(int batch_ctx, int backend);
+            void read_backend(int batch_ctx, int backend);
+            void calibrate_read(int batch_ctx);
+            void reset_calibration(void);
             void msr_rmw_files(int batch_ctx);
 
             const int m_num_cpu;
@@ -108,6 +144,15 @@ namespace geopm
             std::shared_ptr<MSRPath> m_path;
             std::shared_ptr<IOUring> m_batch_reader;
             std::shared_ptr<IOUring> m_batch_writer;
+            /// @brief Return values of the last IOUring batch.
+            std::vector<int> m_batch_return;
+            std::shared_ptr<IOUring> m_pread_reader;
+            /// @brief Backend used by read_batch(), -1 while calibrating.
+            int m_backend;
+            /// @brief Backends that have not failed during calibration.
+            std::vector<int> m_calibrate_backend;
+            std::vector<int> m_calibrate_num_sample;
+            std::vector<double> m_batch_latency;
     };
 }
 
@@ -10,6 +10,7 @@
 #include <sys/types.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <tuple>
 #include <memory>
@@ -21,7 +22,9 @@
 #include "geopm/PlatformTopo.hpp"
 
 #include "geopm_pio.h"
+#include "geopm_time.h"
 #include "BatchServer.hpp"
+#include "BatchTimeIOGroup.hpp"
 #include "CombinedControl.hpp"
 #include "CombinedSignal.hpp"
 #include "ServiceIOGroup.hpp"
@@ -50,7 +53,14 @@ namespace geopm
     }
 
     PlatformIOImp::PlatformIOImp()
-        : PlatformIOImp({}, platform_topo())
+        : PlatformIOImp({}, platform_topo(), is_batch_timing_env())
+    {
+
+    }
+
+    PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                                 const PlatformTopo &topo)
+        : PlatformIOImp(std::move(iogroup_list), topo, false)
     {
 
     }
@@ -230,14 +240,26 @@ namespace geopm
 
 
     PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
-                                 const PlatformTopo &topo)
+                                 const PlatformTopo &topo,
+                                 bool is_batch_timed)
         : m_is_signal_active(false)
         , m_is_control_active(false)
+        , m_is_read_plan_frozen(false)
         , m_platform_topo(topo)
         , m_iogroup_list(std::move(iogroup_list))
         , m_do_restore(false)
     {
-        if (m_iogroup_list.empty()) {
+        bool is_plugin_load = m_iogroup_list.empty();
+        if (is_batch_timed) {
+            // The timing IOGroup is first in the list so that it is
+            // the first IOGroup read by read_batch().
+            m_batch_time_iogroup = std::make_shared<BatchTimeIOGroup>();
+            for (const auto &it : m_iogroup_list) {
+                m_batch_time_idx[it.get()] = m_batch_time_iogroup->add_iogroup(it->name());
+            }
+            m_iogroup_list.push_front(m_batch_time_iogroup);
+        }
+        if (is_plugin_load) {
             for (const auto &it : IOGroup::iogroup_names()) {
                 try {
                     register_iogroup(IOGroup::make_unique(it));
@@ -263,9 +285,17 @@ namespace geopm
                             "IOGroup cannot be registered after a call to save_control()",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (m_batch_time_iogroup) {
+            m_batch_time_idx[iogroup.get()] = m_batch_time_iogroup->add_iogroup(iogroup->name());
+        }
         m_iogroup_list.push_back(iogroup);
     }
 
+    bool PlatformIOImp::is_batch_timing_env(void)
+    {
+        return std::getenv("GEOPM_PIO_BATCH_TIMING") != nullptr;
+    }
+
     std::vector<std::shared_ptr<IOGroup> > PlatformIOImp::find_signal_iogroup(const std::string &signal_name) const
     {
         std::vector<std::shared_ptr<IOGroup> > result;
@@ -662,28 +692,73 @@ namespace geopm
             throw Exception("PlatformIOImp::sample(): read_batch() not called prior to call to sample()",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        auto &group_idx_pair = m_active_signal[signal_idx];
-        if (group_idx_pair.first) {
-            result = group_idx_pair.first->sample(group_idx_pair.second);
+        const m_read_target_s &target = m_read_plan_target[signal_idx];
+        if (target.iogroup != nullptr) {
+            result = target.iogroup->sample(target.iogroup_idx);
         }
         else {
-            result = sample_combined(group_idx_pair.second);
+            result = sample_combined(target.iogroup_idx);
         }
         return result;
     }
 
-    double PlatformIOImp::sample_combined(int signal_idx)
+    void PlatformIOImp::sample_all(const std::vector<int> &signal_idx,
+                                   double *result)
     {
-        double result = NAN;
-        auto &op_obj_pair = m_combined_signal.at(signal_idx);
-        std::vector<int> &operand_idx = op_obj_pair.first;
-        auto &signal = op_obj_pair.second;
-        std::vector<double> operands(operand_idx.size());
-        for (size_t ii = 0; ii < operands.size(); ++ii) {
-            operands[ii] = sample(operand_idx[ii]);
+        if (!m_is_signal_active) {
+            throw Exception("PlatformIOImp::sample_all(): read_batch() not called prior to call to sample_all()",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        result = signal->sample(operands);
-        return result;
+        int num_signal = num_signal_pushed();
+        for (const auto &idx : signal_idx) {
+            if (idx < 0 || idx >= num_signal) {
+                throw Exception("PlatformIOImp::sample_all(): signal_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        size_t num_idx = signal_idx.size();
+        size_t begin = 0;
+        while (begin < num_idx) {
+            const m_read_target_s &target = m_read_plan_target[signal_idx[begin]];
+            if (target.iogroup == nullptr) {
+                result[begin] = sample_combined(target.iogroup_idx);
+                ++begin;
+                continue;
+            }
+            // Gather the run of consecutive signals provided by the
+            // same IOGroup and sample them with one call.
+            m_sample_all_idx.clear();
+            size_t end = begin;
+            while (end < num_idx &&
+                   m_read_plan_target[signal_idx[end]].iogroup == target.iogroup) {
+                m_sample_all_idx.push_back(m_read_plan_target[signal_idx[end]].iogroup_idx);
+                ++end;
+            }
+            target.iogroup->sample_all(m_sample_all_idx, result + begin);
+            begin = end;
+        }
+    }
+
+    double PlatformIOImp::sample_combined(int combined_idx)
+    {
+        const m_read_combined_s &combined = m_read_plan_combined[combined_idx];
+        double *value = m_read_plan_value.data();
+        for (int step_idx = combined.step_begin; step_idx != combined.step_end; ++step_idx) {
+            const m_combined_step_s &step = m_read_plan_step[step_idx];
+            if (step.iogroup != nullptr) {
+                step.iogroup->sample_all(step.iogroup_idx, value + step.value_offset);
+            }
+            else if (step.array_function != nullptr) {
+                value[step.result_offset] = step.array_function(value + step.value_offset,
+                                                                step.num_value);
+            }
+            else {
+                m_combined_operand.assign(value + step.value_offset,
+                                          value + step.value_offset + step.num_value);
+                value[step.result_offset] = step.signal->sample(m_combined_operand);
+            }
+        }
+        return value[combined.result_offset];
     }
 
     void PlatformIOImp::adjust(int control_idx,
@@ -718,18 +793,162 @@ namespace geopm
         }
     }
 
+    void PlatformIOImp::freeze_read_plan(void)
+    {
+        // Only IOGroups that have signals or controls pushed take
+        // part in the batch read, in the order they were registered.
+        std::set<IOGroup *> pushed_iogroup;
+        for (const auto &group_idx_pair : m_active_signal) {
+            pushed_iogroup.insert(group_idx_pair.first.get());
+        }
+        for (const auto &group_idx_pair : m_active_control) {
+            pushed_iogroup.insert(group_idx_pair.first.get());
+        }
+        m_read_plan_iogroup.clear();
+        m_read_plan_time_idx.clear();
+        for (const auto &it : m_iogroup_list) {
+            if (pushed_iogroup.find(it.get()) != pushed_iogroup.end()) {
+                m_read_plan_iogroup.push_back(it.get());
+                if (m_batch_time_iogroup) {
+                    auto idx_it = m_batch_time_idx.find(it.get());
+                    m_read_plan_time_idx.push_back(idx_it != m_batch_time_idx.end() ?
+                                                   idx_it->second : -1);
+                }
+            }
+        }
+        m_read_plan_target.clear();
+        m_read_plan_combined.clear();
+        m_read_plan_step.clear();
+        m_read_plan_value.clear();
+        m_read_plan_target.reserve(m_active_signal.size());
+        for (const auto &group_idx_pair : m_active_signal) {
+            if (group_idx_pair.first != nullptr) {
+                m_read_plan_target.push_back({group_idx_pair.first.get(),
+                                              group_idx_pair.second});
+            }
+            else {
+                m_read_plan_target.push_back({nullptr,
+                                              (int)m_read_plan_combined.size()});
+                int step_begin = m_read_plan_step.size();
+                int result_offset = m_read_plan_value.size();
+                m_read_plan_value.push_back(NAN);
+                compile_combined(group_idx_pair.second, result_offset);
+                m_read_plan_combined.push_back({step_begin,
+                                                (int)m_read_plan_step.size(),
+                                                result_offset});
+            }
+        }
+        size_t max_operand = 0;
+        for (const auto &step : m_read_plan_step) {
+            if (step.iogroup == nullptr && step.array_function == nullptr) {
+                max_operand = std::max(max_operand, (size_t)step.num_value);
+            }
+        }
+        m_combined_operand.reserve(max_operand);
+        m_is_read_plan_frozen = true;
+    }
+
+    void PlatformIOImp::compile_combined(int signal_idx, int result_offset)
+    {
+        // Combined signals are always pushed after their operands, so
+        // the operands are valid entries of m_read_plan_target.
+        auto &op_obj_pair = m_combined_signal.at(signal_idx);
+        const std::vector<int> &operand_idx = op_obj_pair.first;
+        int num_operand = operand_idx.size();
+        int value_offset = m_read_plan_value.size();
+        m_read_plan_value.resize(value_offset + num_operand, NAN);
+        // Operands that are combined signals store their results
+        // directly into the operand storage.
+        for (int op_idx = 0; op_idx != num_operand; ++op_idx) {
+            const m_read_target_s &target = m_read_plan_target.at(operand_idx[op_idx]);
+            if (target.iogroup == nullptr) {
+                compile_combined(operand_idx[op_idx], value_offset + op_idx);
+            }
+        }
+        // Each run of consecutive operands provided by one IOGroup is
+        // gathered with a single call to IOGroup::sample_all().
+        int op_idx = 0;
+        while (op_idx != num_operand) {
+            IOGroup *iogroup = m_read_plan_target[operand_idx[op_idx]].iogroup;
+            if (iogroup == nullptr) {
+                ++op_idx;
+                continue;
+            }
+            m_combined_step_s gather {iogroup, {}, nullptr, nullptr,
+                                      value_offset + op_idx, 0, -1};
+            while (op_idx != num_operand &&
+                   m_read_plan_target[operand_idx[op_idx]].iogroup == iogroup) {
+                gather.iogroup_idx.push_back(m_read_plan_target[operand_idx[op_idx]].iogroup_idx);
+                ++op_idx;
+            }
+            gather.num_value = gather.iogroup_idx.size();
+            m_read_plan_step.push_back(std::move(gather));
+        }
+        CombinedSignal *signal = op_obj_pair.second.get();
+        m_read_plan_step.push_back({nullptr, {},
+                                    Agg::function_to_array_function(signal->m_agg_function),
+                                    signal, value_offset, num_operand, result_offset});
+    }
+
     void PlatformIOImp::read_batch(void)
     {
-        for (auto &it : m_iogroup_list) {
-            it->read_batch();
+        if (!m_is_read_plan_frozen) {
+            freeze_read_plan();
+        }
+        if (m_batch_time_iogroup) {
+            read_batch_timed();
+        }
+        else {
+            for (auto &it : m_read_plan_iogroup) {
+                it->read_batch();
+            }
         }
         m_is_signal_active = true;
     }
 
     void PlatformIOImp::write_batch(void)
     {
+        if (m_batch_time_iogroup) {
+            write_batch_timed();
+        }
+        else {
+            for (auto &it : m_iogroup_list) {
+                it->write_batch();
+            }
+        }
+    }
+
+    void PlatformIOImp::read_batch_timed(void)
+    {
+        size_t num_iogroup = m_read_plan_iogroup.size();
+        geopm_time_s begin;
+        geopm_time_s end;
+        geopm_time(&begin);
+        for (size_t ii = 0; ii != num_iogroup; ++ii) {
+            m_read_plan_iogroup[ii]->read_batch();
+            geopm_time(&end);
+            if (m_read_plan_time_idx[ii] != -1) {
+                m_batch_time_iogroup->add_read_time(m_read_plan_time_idx[ii],
+                                                    geopm_time_diff(&begin, &end));
+            }
+            begin = end;
+        }
+    }
+
+    void PlatformIOImp::write_batch_timed(void)
+    {
+        geopm_time_s begin;
+        geopm_time_s end;
+        geopm_time(&begin);
         for (auto &it : m_iogroup_list) {
             it->write_batch();
+            geopm_time(&end);
+            auto idx_it = m_batch_time_idx.find(it.get());
+            if (idx_it != m_batch_time_idx.end()) {
+                m_batch_time_iogroup->add_write_time(idx_it->second,
+                                                     geopm_time_diff(&begin, &end));
+            }
+            begin = end;
         }
     }
 
@@ -10,6 +10,7 @@
 #include <map>
 #include <set>
 
+#include "geopm/Agg.hpp"
 #include "geopm/PlatformIO.hpp"
 #include "geopm_pio.h"
 
@@ -20,6 +21,7 @@ namespace geopm
     class CombinedControl;
     class PlatformTopo;
     class BatchServer;
+    class BatchTimeIOGroup;
 
     class PlatformIOImp : public PlatformIO
     {
@@ -27,6 +29,14 @@ namespace geopm
             PlatformIOImp();
             PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                           const PlatformTopo &topo);
+            /// @param [in] is_batch_timed If true, time the
+            ///        read_batch() and write_batch() methods of each
+            ///        IOGroup and provide the totals as
+            ///        PLATFORMIO::READ_BATCH_TIME@<IOGroup> and
+            ///        PLATFORMIO::WRITE_BATCH_TIME@<IOGroup> signals.
+            PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                          const PlatformTopo &topo,
+                          bool is_batch_timed);
             PlatformIOImp(const PlatformIOImp &other) = delete;
             PlatformIOImp &operator=(const PlatformIOImp &other) = delete;
             virtual ~PlatformIOImp() = default;
@@ -42,6 +52,8 @@ namespace geopm
                              int domain_type,
                              int domain_idx) override;
             double sample(int signal_idx) override;
+            void sample_all(const std::vector<int> &signal_idx,
+                            double *result) override;
             void adjust(int control_idx, double setting) override;
             void read_batch(void) override;
             void write_batch(void) override;
@@ -120,8 +132,20 @@ namespace geopm
                                               int domain_type,
                                               int domain_idx,
                                               double setting);
-            /// @brief Sample a combined signal using the saved function and operands.
-            double sample_combined(int signal_idx);
+            /// @brief Sample a combined signal by running its steps
+            ///        of the read plan.
+            double sample_combined(int combined_idx);
+            /// @brief Append the steps that evaluate a combined signal
+            ///        to the read plan.
+            /// @param [in] signal_idx Index of the combined signal.
+            /// @param [in] result_offset Element of m_read_plan_value
+            ///        where the result is stored.
+            void compile_combined(int signal_idx, int result_offset);
+            /// @brief Compile the flat read plan used by read_batch()
+            ///        and sample().  Called once on the first
+            ///        read_batch(), after which no new signals may be
+            ///        pushed.
+            void freeze_read_plan(void);
             void adjust_combined(int control_idx, double setting);
             /// @brief Look up the IOGroup that provides the given signal.
             std::vector<std::shared_ptr<IOGroup> > find_signal_iogroup(const std::string &signal_name) const;
@@ -132,8 +156,50 @@ namespace geopm
             ///        setting will be divided by the number of subdomains
             ///        before being applied.
             bool is_control_adjust_same(const std::string &control_name) const;
+            /// @brief Called by read_batch() and write_batch() when
+            ///        batch timing is enabled.
+            void read_batch_timed(void);
+            void write_batch_timed(void);
+            /// @brief Returns true if the GEOPM_PIO_BATCH_TIMING
+            ///        environment variable is set.
+            static bool is_batch_timing_env(void);
+            /// @brief Dense sample target for a pushed signal.  If
+            ///        iogroup is null then iogroup_idx refers to an
+            ///        element of m_read_plan_combined.
+            struct m_read_target_s {
+                IOGroup *iogroup;
+                int iogroup_idx;
+            };
+            /// @brief Step of the read plan program that evaluates
+            ///        combined signals.
+            ///
+            /// If iogroup is not null the step gathers the operands
+            /// provided by one IOGroup with IOGroup::sample_all()
+            /// into m_read_plan_value starting at value_offset.
+            /// Otherwise it reduces num_value elements of
+            /// m_read_plan_value starting at value_offset and stores
+            /// the result at result_offset, using array_function if
+            /// it is available and signal otherwise.
+            struct m_combined_step_s {
+                IOGroup *iogroup;
+                std::vector<int> iogroup_idx;
+                Agg::ArrayFunction array_function;
+                CombinedSignal *signal;
+                int value_offset;
+                int num_value;
+                int result_offset;
+            };
+            /// @brief Combined signal in the read plan: a range of
+            ///        m_read_plan_step and the element of
+            ///        m_read_plan_value that holds the result.
+            struct m_read_combined_s {
+                int step_begin;
+                int step_end;
+                int result_offset;
+            };
             bool m_is_signal_active;
             bool m_is_control_active;
+            bool m_is_read_plan_frozen;
             const PlatformTopo &m_platform_topo;
             std::list<std::shared_ptr<IOGroup> > m_iogroup_list;
             std::vector<std::pair<std::shared_ptr<IOGroup>, int> > m_active_signal;
@@ -144,6 +210,26 @@ namespace geopm
                                     std::unique_ptr<CombinedSignal> > > m_combined_signal;
             std::map<int, std::pair<std::vector<int>,
                                     std::unique_ptr<CombinedControl> > > m_combined_control;
+            std::vector<IOGroup *> m_read_plan_iogroup;
+            std::vector<m_read_target_s> m_read_plan_target;
+            std::vector<m_read_combined_s> m_read_plan_combined;
+            std::vector<m_combined_step_s> m_read_plan_step;
+            /// @brief Operands and results of all combined signals.
+            std::vector<double> m_read_plan_value;
+            /// @brief Scratch storage for the operands of combined
+            ///        signals that have no Agg::ArrayFunction.
+            std::vector<double> m_combined_operand;
+            /// @brief Null unless batch timing is enabled.
+            std::shared_ptr<BatchTimeIOGroup> m_batch_time_iogroup;
+            /// @brief Index passed to the BatchTimeIOGroup for each
+            ///        registered IOGroup.
+            std::map<const IOGroup *, int> m_batch_time_idx;
+            /// @brief BatchTimeIOGroup index for each element of
+            ///        m_read_plan_iogroup.
+            std::vector<int> m_read_plan_time_idx;
+            /// @brief Scratch storage for IOGroup indices passed to
+            ///        IOGroup::sample_all() by sample_all().
+            std::vector<int> m_sample_all_idx;
             bool m_do_restore;
             std::map<int, std::shared_ptr<BatchServer> > m_batch_server;
             std::set<std::string> m_pushed_signal_names;
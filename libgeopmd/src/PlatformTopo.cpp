@@ -17,8 +17,10 @@
 #include <limits.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <string>
 #include <stdexcept>
@@ -77,6 +79,7 @@ namespace geopm
 {
     const std::string PlatformTopoImp::M_CACHE_FILE_NAME = "/tmp/geopm-topo-cache-" + std::to_string(getuid());
     const std::string PlatformTopoImp::M_SERVICE_CACHE_FILE_NAME = "/run/geopm/geopm-topo-cache";
+    const std::string PlatformTopoImp::M_SYSFS_PATH = "/sys/devices/system";
 
     const PlatformTopo &platform_topo(void)
     {
@@ -112,7 +115,16 @@ namespace geopm
 
     PlatformTopoImp::PlatformTopoImp(const std::string &test_cache_file_name,
                                      std::shared_ptr<ServiceProxy> service_proxy)
+        : PlatformTopoImp(test_cache_file_name, service_proxy, M_SYSFS_PATH)
+    {
+
+    }
+
+    PlatformTopoImp::PlatformTopoImp(const std::string &test_cache_file_name,
+                                     std::shared_ptr<ServiceProxy> service_proxy,
+                                     const std::string &sysfs_path)
         : M_TEST_CACHE_FILE_NAME(test_cache_file_name)
+        , m_sysfs_path(sysfs_path)
         , m_service_proxy(std::move(service_proxy))
     {
         std::map<std::string, std::string> lscpu_map;
@@ -121,6 +133,149 @@ namespace geopm
         m_numa_map = parse_lscpu_numa(lscpu_map);
         m_gpu_info[GEOPM_DOMAIN_GPU] = parse_lscpu_gpu(lscpu_map, GEOPM_DOMAIN_GPU);
         m_gpu_info[GEOPM_DOMAIN_GPU_CHIP] = parse_lscpu_gpu(lscpu_map, GEOPM_DOMAIN_GPU_CHIP);
+        init_nesting();
+    }
+
+    void PlatformTopoImp::init_nesting(void)
+    {
+        // Domain types that support both domain_cpus() and
+        // domain_idx(), queries for the other types are not tabulated
+        // and throw as they did before.
+        static const std::vector<int> cpu_domain_types = {
+            GEOPM_DOMAIN_BOARD,
+            GEOPM_DOMAIN_PACKAGE,
+            GEOPM_DOMAIN_CORE,
+            GEOPM_DOMAIN_CPU,
+            GEOPM_DOMAIN_MEMORY,
+            GEOPM_DOMAIN_GPU,
+            GEOPM_DOMAIN_GPU_CHIP,
+        };
+        for (int inner_domain = 0; inner_domain != GEOPM_NUM_DOMAIN; ++inner_domain) {
+            for (int outer_domain = 0; outer_domain != GEOPM_NUM_DOMAIN; ++outer_domain) {
+                m_is_nested[inner_domain][outer_domain] =
+                    is_nested_domain_type(inner_domain, outer_domain);
+            }
+        }
+        int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
+        for (int domain_type : cpu_domain_types) {
+            auto &cpu_domain_idx = m_cpu_domain_idx[domain_type];
+            if (domain_type == GEOPM_DOMAIN_MEMORY ||
+                domain_type == GEOPM_DOMAIN_GPU ||
+                domain_type == GEOPM_DOMAIN_GPU_CHIP) {
+                // Invert the CPU sets, visit the domains in reverse
+                // order so that the lowest index domain that contains
+                // the CPU is recorded.
+                const auto &domain_map = (domain_type == GEOPM_DOMAIN_MEMORY) ?
+                                         m_numa_map :
+                                         m_gpu_info.at(domain_type);
+                cpu_domain_idx.assign(num_cpu, -1);
+                for (int idx = (int)domain_map.size() - 1; idx >= 0; --idx) {
+                    for (int cpu_idx : domain_map[idx]) {
+                        if (cpu_idx >= 0 && cpu_idx < num_cpu) {
+                            cpu_domain_idx[cpu_idx] = idx;
+                        }
+                    }
+                }
+            }
+            else {
+                cpu_domain_idx.resize(num_cpu);
+                for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                    cpu_domain_idx[cpu_idx] = domain_idx_compute(domain_type, cpu_idx);
+                }
+            }
+        }
+        for (int outer_domain : cpu_domain_types) {
+            // CPUs of each outer domain as returned by domain_cpus(),
+            // the CPUs of outer_idx are outer_cpu[outer_offset[outer_idx]]
+            // up to outer_cpu[outer_offset[outer_idx + 1]].
+            int num_outer = num_domain(outer_domain);
+            std::vector<int> outer_offset(num_outer + 1, 0);
+            std::vector<int> outer_cpu;
+            bool is_valid = true;
+            if (outer_domain == GEOPM_DOMAIN_MEMORY ||
+                outer_domain == GEOPM_DOMAIN_GPU ||
+                outer_domain == GEOPM_DOMAIN_GPU_CHIP) {
+                // These domains may share CPUs
+                const auto &domain_map = (outer_domain == GEOPM_DOMAIN_MEMORY) ?
+                                         m_numa_map :
+                                         m_gpu_info.at(outer_domain);
+                for (int outer_idx = 0; outer_idx != num_outer; ++outer_idx) {
+                    const auto &cpu_set = domain_map[outer_idx];
+                    if (!cpu_set.empty() &&
+                        (*cpu_set.begin() < 0 || *cpu_set.rbegin() >= num_cpu)) {
+                        // domain_nested() reports the error
+                        is_valid = false;
+                    }
+                    outer_cpu.insert(outer_cpu.end(), cpu_set.begin(), cpu_set.end());
+                    outer_offset[outer_idx + 1] = outer_cpu.size();
+                }
+            }
+            else if (outer_domain == GEOPM_DOMAIN_BOARD) {
+                // The board is made of the CPUs of all NUMA nodes
+                std::vector<bool> is_board_cpu(num_cpu, false);
+                for (const auto &numa_cpus : m_numa_map) {
+                    for (int cpu_idx : numa_cpus) {
+                        if (cpu_idx < 0 || cpu_idx >= num_cpu) {
+                            is_valid = false;
+                        }
+                        else {
+                            is_board_cpu[cpu_idx] = true;
+                        }
+                    }
+                }
+                for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                    if (is_board_cpu[cpu_idx]) {
+                        outer_cpu.push_back(cpu_idx);
+                    }
+                }
+                outer_offset[1] = outer_cpu.size();
+            }
+            else {
+                // Each CPU is in exactly one domain, sort the CPUs by
+                // domain with a counting sort
+                const auto &cpu_outer_idx = m_cpu_domain_idx[outer_domain];
+                for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                    ++outer_offset[cpu_outer_idx[cpu_idx] + 1];
+                }
+                for (int outer_idx = 0; outer_idx != num_outer; ++outer_idx) {
+                    outer_offset[outer_idx + 1] += outer_offset[outer_idx];
+                }
+                outer_cpu.resize(num_cpu);
+                std::vector<int> outer_next(outer_offset.begin(), outer_offset.end() - 1);
+                for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                    outer_cpu[outer_next[cpu_outer_idx[cpu_idx]]++] = cpu_idx;
+                }
+            }
+            for (int inner_domain : cpu_domain_types) {
+                if (!is_valid || !m_is_nested[inner_domain][outer_domain]) {
+                    continue;
+                }
+                const auto &cpu_inner_idx = m_cpu_domain_idx[inner_domain];
+                auto &table = m_nested[inner_domain][outer_domain];
+                table.offset.reserve(num_outer + 1);
+                table.offset.push_back(0);
+                // Last outer_idx that each inner domain was added to,
+                // offset by one because a CPU that is not part of any
+                // inner domain has index -1.
+                std::vector<int> inner_last(
+                    *std::max_element(cpu_inner_idx.begin(), cpu_inner_idx.end()) + 2, -1);
+                for (int outer_idx = 0; outer_idx != num_outer; ++outer_idx) {
+                    for (int cpu_pos = outer_offset[outer_idx];
+                         cpu_pos != outer_offset[outer_idx + 1]; ++cpu_pos) {
+                        int inner_idx = cpu_inner_idx[outer_cpu[cpu_pos]];
+                        if (inner_last[inner_idx + 1] != outer_idx) {
+                            inner_last[inner_idx + 1] = outer_idx;
+                            table.inner_idx.push_back(inner_idx);
+                        }
+                    }
+                    auto begin = table.inner_idx.begin() + table.offset.back();
+                    if (!std::is_sorted(begin, table.inner_idx.end())) {
+                        std::sort(begin, table.inner_idx.end());
+                    }
+                    table.offset.push_back(table.inner_idx.size());
+                }
+            }
+        }
     }
 
     int PlatformTopoImp::num_domain(int domain_type) const
@@ -249,6 +404,21 @@ namespace geopm
             throw Exception("PlatformTopoImp::domain_idx(): cpu_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        const auto &cpu_domain_idx = m_cpu_domain_idx[domain_type];
+        if (!cpu_domain_idx.empty()) {
+            result = cpu_domain_idx[cpu_idx];
+        }
+        else {
+            // Not supported for this domain type, throws
+            result = domain_idx_compute(domain_type, cpu_idx);
+        }
+        return result;
+    }
+
+    int PlatformTopoImp::domain_idx_compute(int domain_type,
+                                            int cpu_idx) const
+    {
+        int result = -1;
 
         int core_idx = 0;
         int numa_idx = 0;
@@ -307,6 +477,19 @@ namespace geopm
     }
 
     bool PlatformTopoImp::is_nested_domain(int inner_domain, int outer_domain) const
+    {
+        bool result = false;
+        if (inner_domain >= 0 && inner_domain < GEOPM_NUM_DOMAIN &&
+            outer_domain >= 0 && outer_domain < GEOPM_NUM_DOMAIN) {
+            result = m_is_nested[inner_domain][outer_domain];
+        }
+        else {
+            result = is_nested_domain_type(inner_domain, outer_domain);
+        }
+        return result;
+    }
+
+    bool PlatformTopoImp::is_nested_domain_type(int inner_domain, int outer_domain)
     {
         bool result = false;
         static const std::set<int> package_domain = {
@@ -363,12 +546,26 @@ namespace geopm
                             " is not contained within domain type " + std::to_string(outer_domain),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::set<int> inner_domain_idx;
-        std::set<int> cpus = domain_cpus(outer_domain, outer_idx);
-        for (auto cc : cpus) {
-            inner_domain_idx.insert(domain_idx(inner_domain, cc));
+        std::set<int> result;
+        const m_nested_s *table = nullptr;
+        if (inner_domain >= 0 && inner_domain < GEOPM_NUM_DOMAIN &&
+            outer_domain >= 0 && outer_domain < GEOPM_NUM_DOMAIN) {
+            table = &m_nested[inner_domain][outer_domain];
+        }
+        if (table != nullptr &&
+            outer_idx >= 0 && outer_idx + 1 < (int)table->offset.size()) {
+            result.insert(table->inner_idx.begin() + table->offset[outer_idx],
+                          table->inner_idx.begin() + table->offset[outer_idx + 1]);
         }
-        return inner_domain_idx;
+        else {
+            // Not tabulated, or outer_idx is out of range: compute
+            // from the CPUs so that the same errors are reported.
+            std::set<int> cpus = domain_cpus(outer_domain, outer_idx);
+            for (auto cc : cpus) {
+                result.insert(domain_idx(inner_domain, cc));
+            }
+        }
+        return result;
     }
 
     std::vector<std::string> PlatformTopo::domain_names(void)
@@ -439,6 +636,12 @@ namespace geopm
     }
 
     void PlatformTopoImp::create_cache(const std::string &cache_file_name, const GPUTopo &gtopo)
+    {
+        create_cache(cache_file_name, gtopo, M_SYSFS_PATH);
+    }
+
+    void PlatformTopoImp::create_cache(const std::string &cache_file_name, const GPUTopo &gtopo,
+                                       const std::string &sysfs_path)
     {
         // If cache file is not present, or is too old, create it
         bool is_file_ok = false;
@@ -466,20 +669,40 @@ namespace geopm
             }
             close(tmp_fd);
 
-            std::ostringstream cmd;
-            cmd << "unset LD_PRELOAD; LC_ALL=C lscpu -x >> " << tmp_path << ";";
-
-            FILE *pid;
-            int err = geopm_topo_popen(cmd.str().c_str(), &pid);
-            if (err) {
-                unlink(tmp_path);
-                throw Exception("PlatformTopo::create_cache(): Could not popen lscpu command: ",
-                                err, __FILE__, __LINE__);
+            std::string topo_str;
+            try {
+                topo_str = sysfs_topo(sysfs_path);
             }
-            if (pclose(pid)) {
-                unlink(tmp_path);
-                throw Exception("PlatformTopo::create_cache(): Could not pclose lscpu command: ",
-                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            catch (const Exception &ex) {
+                // The sysfs files are not complete, fall back to lscpu
+            }
+            int err = 0;
+            if (!topo_str.empty()) {
+                std::ofstream topo_stream(tmp_path, std::ios_base::app);
+                topo_stream << topo_str;
+                topo_stream.close();
+                if (!topo_stream) {
+                    unlink(tmp_path);
+                    throw Exception("PlatformTopo::create_cache(): Could not write temp file: ",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+            }
+            else {
+                std::ostringstream cmd;
+                cmd << "unset LD_PRELOAD; LC_ALL=C lscpu -x >> " << tmp_path << ";";
+
+                FILE *pid;
+                err = geopm_topo_popen(cmd.str().c_str(), &pid);
+                if (err) {
+                    unlink(tmp_path);
+                    throw Exception("PlatformTopo::create_cache(): Could not popen lscpu command: ",
+                                    err, __FILE__, __LINE__);
+                }
+                if (pclose(pid)) {
+                    unlink(tmp_path);
+                    throw Exception("PlatformTopo::create_cache(): Could not pclose lscpu command: ",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
             }
             if (gtopo.num_gpu() != 0) {
                 std::ofstream cache_stream;
@@ -512,6 +735,120 @@ namespace geopm
         }
     }
 
+    // Parse a Linux CPU list such as "0-3,8,10-11" into a set of
+    // CPU indices.
+    static std::set<int> parse_cpu_list(const std::string &cpu_list)
+    {
+        std::set<int> result;
+        try {
+            for (const auto &range : string_split(cpu_list, ",")) {
+                if (range.find_first_not_of(" \t\n") == std::string::npos) {
+                    continue;
+                }
+                auto dash_pos = range.find('-');
+                int first = std::stoi(range.substr(0, dash_pos));
+                int last = dash_pos == std::string::npos ?
+                           first : std::stoi(range.substr(dash_pos + 1));
+                if (first < 0 || last < first) {
+                    throw std::invalid_argument(range);
+                }
+                for (int cpu_idx = first; cpu_idx <= last; ++cpu_idx) {
+                    result.insert(cpu_idx);
+                }
+            }
+        }
+        catch (const std::logic_error &ex) {
+            throw Exception("PlatformTopoImp: unable to parse CPU list: \"" + cpu_list + "\"",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    static int read_int_file(const std::string &path)
+    {
+        std::string contents = read_file(path);
+        try {
+            return std::stoi(contents);
+        }
+        catch (const std::logic_error &ex) {
+            throw Exception("PlatformTopoImp: unable to parse integer from " + path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    // Format a set of CPUs as a hexadecimal mask in the same way as
+    // "lscpu -x" does.
+    static std::string cpu_mask_string(const std::set<int> &cpu_set)
+    {
+        std::vector<int> nibble(cpu_set.empty() ? 1 : *cpu_set.rbegin() / 4 + 1, 0);
+        for (int cpu_idx : cpu_set) {
+            nibble[cpu_idx / 4] |= 1 << (cpu_idx % 4);
+        }
+        std::ostringstream result;
+        result << "0x" << std::hex;
+        for (auto nib_it = nibble.rbegin(); nib_it != nibble.rend(); ++nib_it) {
+            result << *nib_it;
+        }
+        return result.str();
+    }
+
+    std::string PlatformTopoImp::sysfs_topo(const std::string &sysfs_path)
+    {
+        std::set<int> present_cpu = parse_cpu_list(read_file(sysfs_path + "/cpu/present"));
+        std::set<int> online_cpu = parse_cpu_list(read_file(sysfs_path + "/cpu/online"));
+        if (online_cpu.empty()) {
+            throw Exception("PlatformTopoImp::sysfs_topo(): no online CPUs found in " + sysfs_path,
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Count the packages, cores and hyper-threads of the online
+        // CPUs the same way that lscpu does.
+        std::set<int> package_id;
+        std::set<std::pair<int, int> > core_id;
+        int thread_per_core = 0;
+        for (int cpu_idx : online_cpu) {
+            std::string topo_path = sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+            int cpu_package_id = read_int_file(topo_path + "physical_package_id");
+            package_id.insert(cpu_package_id);
+            core_id.emplace(cpu_package_id, read_int_file(topo_path + "core_id"));
+            int num_sibling = parse_cpu_list(read_file(topo_path + "thread_siblings_list")).size();
+            thread_per_core = std::max(thread_per_core, num_sibling);
+        }
+        // Nodes are listed from zero without gaps, a node without
+        // CPUs has an empty mask.
+        std::vector<std::set<int> > numa_cpu;
+        std::set<int> online_node;
+        try {
+            online_node = parse_cpu_list(read_file(sysfs_path + "/node/online"));
+        }
+        catch (const Exception &ex) {
+            // Kernel built without NUMA support
+        }
+        if (!online_node.empty()) {
+            numa_cpu.resize(*online_node.rbegin() + 1);
+        }
+        for (int node_idx : online_node) {
+            numa_cpu[node_idx] = parse_cpu_list(
+                read_file(sysfs_path + "/node/node" + std::to_string(node_idx) + "/cpulist"));
+        }
+
+        const int key_width = 23;
+        std::ostringstream result;
+        result << std::left
+               << std::setw(key_width) << "CPU(s):" << present_cpu.size() << "\n"
+               << std::setw(key_width) << "On-line CPU(s) mask:" << cpu_mask_string(online_cpu) << "\n"
+               << std::setw(key_width) << "Thread(s) per core:" << thread_per_core << "\n"
+               << std::setw(key_width) << "Core(s) per socket:" << core_id.size() / package_id.size() << "\n"
+               << std::setw(key_width) << "Socket(s):" << package_id.size() << "\n";
+        if (!numa_cpu.empty()) {
+            result << std::setw(key_width) << "NUMA node(s):" << numa_cpu.size() << "\n";
+        }
+        for (size_t node_idx = 0; node_idx != numa_cpu.size(); ++node_idx) {
+            result << std::setw(key_width) << "NUMA node" + std::to_string(node_idx) + " CPU(s):"
+                   << cpu_mask_string(numa_cpu[node_idx]) << "\n";
+        }
+        return result.str();
+    }
+
     void PlatformTopoImp::parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
                                       int &num_package,
                                       int &core_per_package,
@@ -698,7 +1035,7 @@ namespace geopm
         // Early return for mocked file in test case
         if (M_TEST_CACHE_FILE_NAME.size()) {
             auto mock_topo = std::make_unique<GPUTopoNull>();
-            create_cache(M_TEST_CACHE_FILE_NAME, *mock_topo);
+            create_cache(M_TEST_CACHE_FILE_NAME, *mock_topo, m_sysfs_path);
             return geopm::read_file(M_TEST_CACHE_FILE_NAME);
         }
         // In all other cases create a cache in /tmp
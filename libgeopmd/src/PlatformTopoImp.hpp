@@ -8,6 +8,7 @@
 #define PLATFORMTOPOIMP_HPP_INCLUDE
 
 #include "geopm/PlatformTopo.hpp"
+#include <array>
 #include <vector>
 #include <map>
 #include <memory>
@@ -23,6 +24,9 @@ namespace geopm
             PlatformTopoImp();
             PlatformTopoImp(const std::string &test_cache_file_name,
                             std::shared_ptr<ServiceProxy> service_proxy);
+            PlatformTopoImp(const std::string &test_cache_file_name,
+                            std::shared_ptr<ServiceProxy> service_proxy,
+                            const std::string &sysfs_path);
             virtual ~PlatformTopoImp() = default;
             int num_domain(int domain_type) const override;
             int domain_idx(int domain_type,
@@ -32,13 +36,36 @@ namespace geopm
             static void create_cache();
             static void create_cache(const std::string &cache_file_name);
             static void create_cache(const std::string &cache_file_name, const GPUTopo &gtopo);
+            static void create_cache(const std::string &cache_file_name, const GPUTopo &gtopo,
+                                     const std::string &sysfs_path);
+            /// @brief Describe the CPU topology in the format of
+            ///        "lscpu -x" output using the cpu and node
+            ///        directories under sysfs_path.
+            ///
+            /// Only the fields that are used by PlatformTopoImp are
+            /// provided.  Throws if the files are missing or cannot
+            /// be parsed.
+            ///
+            /// @param [in] sysfs_path Typically "/sys/devices/system".
+            ///
+            /// @return Text to be stored in the topology cache.
+            static std::string sysfs_topo(const std::string &sysfs_path);
         private:
             static const std::string M_CACHE_FILE_NAME;
             static const std::string M_SERVICE_CACHE_FILE_NAME;
+            static const std::string M_SYSFS_PATH;
             /// @brief Get the set of Linux logical CPUs associated
             ///        with the indexed domain.
             std::set<int> domain_cpus(int domain_type,
                                       int domain_idx) const;
+            /// @brief Compute domain_idx() from the topology without
+            ///        the lookup tables.
+            int domain_idx_compute(int domain_type,
+                                   int cpu_idx) const;
+            static bool is_nested_domain_type(int inner_domain, int outer_domain);
+            /// @brief Fill the lookup tables used by domain_idx(),
+            ///        is_nested_domain() and domain_nested().
+            void init_nesting(void);
 
             void lscpu(std::map<std::string, std::string> &lscpu_map);
             void parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
@@ -52,12 +79,28 @@ namespace geopm
             static std::string gpu_short_name(int domain_type);
             static std::unique_ptr<ServiceProxy> try_service_proxy(void);
             const std::string M_TEST_CACHE_FILE_NAME;
+            const std::string m_sysfs_path;
             int m_num_package;
             int m_core_per_package;
             int m_thread_per_core;
             std::vector<std::set<int> > m_numa_map;
             std::map<int, std::vector<std::set<int> > > m_gpu_info;
             std::shared_ptr<ServiceProxy> m_service_proxy;
+            // Inner domain indices nested within each outer domain
+            // in compressed sparse row form: the indices for
+            // outer_idx are inner_idx[offset[outer_idx]] up to
+            // inner_idx[offset[outer_idx + 1]].
+            struct m_nested_s {
+                std::vector<int> offset;
+                std::vector<int> inner_idx;
+            };
+            // Indexed by inner and then outer domain type, offset is
+            // empty if the pair is not tabulated
+            std::array<std::array<m_nested_s, GEOPM_NUM_DOMAIN>, GEOPM_NUM_DOMAIN> m_nested;
+            std::array<std::array<bool, GEOPM_NUM_DOMAIN>, GEOPM_NUM_DOMAIN> m_is_nested;
+            // Indexed by domain type and then CPU, empty for domain
+            // types that domain_idx() does not support
+            std::array<std::vector<int>, GEOPM_NUM_DOMAIN> m_cpu_domain_idx;
     };
 }
 #endif
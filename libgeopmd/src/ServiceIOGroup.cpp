@@ -8,11 +8,13 @@
 
 #include <cmath>
 #include <climits>
+#include <cstdlib>
 #include <cstring>
 #include <unistd.h>
 #include "geopm/Agg.hpp"
 #include "geopm/ServiceProxy.hpp"
 #include "BatchClient.hpp"
+#include "BatchStatus.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/PlatformIO.hpp"
@@ -382,10 +384,29 @@ namespace geopm
                                                   server_key);
             if (m_batch_client == nullptr) {
                 // Not a unit test
+                int transport = BatchStatus::M_TRANSPORT_FIFO;
+                const char *transport_name = std::getenv("GEOPM_BATCH_TRANSPORT");
+                if (transport_name != nullptr) {
+                    transport = BatchStatus::transport_type(transport_name);
+                }
+                double sample_period = 0.0;
+                const char *period_str = std::getenv("GEOPM_BATCH_PERIOD");
+                if (period_str != nullptr) {
+                    try {
+                        sample_period = std::stod(period_str);
+                    }
+                    catch (const std::exception &ex) {
+                        throw Exception("ServiceIOGroup::init_batch_server(): Invalid value for GEOPM_BATCH_PERIOD: " +
+                                        std::string(period_str),
+                                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                    }
+                }
                 m_batch_client = BatchClient::make_unique(server_key,
                                                           1.0,
                                                           m_signal_requests.size(),
-                                                          m_control_requests.size());
+                                                          m_control_requests.size(),
+                                                          transport,
+                                                          sample_period);
             }
             m_is_batch_active = true;
             m_batch_settings.resize(m_control_requests.size(), NAN);
@@ -6,6 +6,9 @@
 
 #include "SysfsDriver.hpp"
 
+#include <cmath>
+#include <climits>
+
 #include "geopm/json11.hpp"
 
 #include "geopm/Agg.hpp"
@@ -18,6 +21,16 @@ using json11::Json;
 
 namespace geopm
 {
+    double SysfsDriver::signal_integer_scale(const std::string &signal_name) const
+    {
+        return NAN;
+    }
+
+    int64_t SysfsDriver::signal_integer_max(const std::string &signal_name) const
+    {
+        return LONG_MAX;
+    }
+
     static void check_json_type(const json11::Json &object,
                                 const std::string &object_name,
                                 enum json11::Json::Type expected_type)
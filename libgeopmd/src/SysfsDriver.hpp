@@ -6,6 +6,7 @@
 #ifndef SYSFSDRIVER_HPP_INCLUDE
 #define SYSFSDRIVER_HPP_INCLUDE
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -72,6 +73,36 @@ namespace geopm
             ///
             /// @return The parsed signal value in SI units.
             virtual std::function<double(const std::string&)> signal_parse(const std::string &signal_name) const = 0;
+            /// @brief Get the scale of a signal whose sysfs content is
+            ///        a single integer.
+            ///
+            /// The SysfsIOGroup parses the batch reads of these
+            /// signals directly from the read buffer and multiplies
+            /// by the scale, rather than calling the function
+            /// returned by signal_parse().  The result must be the
+            /// same as that function would return.
+            ///
+            /// @param [in] signal_name The name of the signal.
+            ///
+            /// @return Factor converting the integer into SI units,
+            ///         or NAN if the content must be parsed with
+            ///         signal_parse().
+            virtual double signal_integer_scale(const std::string &signal_name) const;
+            /// @brief Get the largest magnitude of the integer
+            ///        accepted by the function returned by
+            ///        signal_parse().
+            ///
+            /// Integers outside of the range from -max - 1 to max are
+            /// parsed as NAN, as the function returned by
+            /// signal_parse() does.  Only used if
+            /// signal_integer_scale() is not NAN.
+            ///
+            /// @param [in] signal_name The name of the signal.
+            ///
+            /// @return The largest value of the integer type used
+            ///         by the parser, by default the largest long as
+            ///         parsed by std::stol().
+            virtual int64_t signal_integer_max(const std::string &signal_name) const;
             /// @brief Get a function to convert a control into a sysfs string
             ///
             /// Converts from the SI unit control into the text
@@ -80,6 +80,39 @@ namespace geopm
         }
     }
 
+    // Parse the integer at the start of a buffer read from sysfs
+    // without constructing a string.  Like the std::stoi() and
+    // std::stol() based parsers of the drivers, leading white space
+    // and trailing characters are ignored and NAN is returned if
+    // there is no integer or it is outside of the range from
+    // -max_value - 1 to max_value of the parser's integer type.
+    static double parse_integer(const char *buf, double scale, int64_t max_value)
+    {
+        while (*buf == ' ' || (*buf >= '\t' && *buf <= '\r')) {
+            ++buf;
+        }
+        bool is_negative = *buf == '-';
+        if (is_negative || *buf == '+') {
+            ++buf;
+        }
+        // Any 19 digit number fits in 64 bits
+        static constexpr int MAX_DIGIT = 19;
+        const char *end = buf;
+        uint64_t value = 0;
+        for (unsigned digit = *end - '0';
+             digit < 10 && end - buf < MAX_DIGIT;
+             digit = *(++end) - '0') {
+            value = value * 10 + digit;
+        }
+        uint64_t limit = static_cast<uint64_t>(max_value) + (is_negative ? 1 : 0);
+        double result = NAN;
+        if (end != buf && static_cast<unsigned>(*end - '0') >= 10 && value <= limit) {
+            result = (is_negative ? -static_cast<double>(value) :
+                                    static_cast<double>(value)) * scale;
+        }
+        return result;
+    }
+
     // Return true if this process has read access to the given path
     static bool do_have_read_access(const std::string &path)
     {
@@ -116,6 +149,7 @@ namespace geopm
         , m_control_saver(std::move(control_saver))
         , m_batch_reader(std::move(batch_reader))
         , m_batch_writer(std::move(batch_writer))
+        , m_read_batch_idx(-1)
     {
         for (const auto &it : m_properties) {
             m_signals.try_emplace(it.first, std::cref(it.second));
@@ -275,7 +309,10 @@ namespace geopm
                     std::make_shared<int>(0),
                     {},
                     m_driver->signal_parse(cname),
-                    m_driver->control_gen(cname)
+                    m_driver->control_gen(cname),
+                    m_driver->signal_integer_scale(cname),
+                    m_driver->signal_integer_max(cname),
+                    ""
                 });
             signal_idx = m_pushed_info_signal.size() - 1;
         }
@@ -319,7 +356,10 @@ namespace geopm
                     std::make_shared<int>(0),
                     {},
                     m_driver->signal_parse(control_name),
-                    m_driver->control_gen(control_name)
+                    m_driver->control_gen(control_name),
+                    NAN,
+                    0,
+                    ""
                 });
             control_idx = m_pushed_info_control.size() - 1;
         }
@@ -335,24 +375,40 @@ namespace geopm
             if (!m_batch_reader) {
                 m_batch_reader = IOUring::make_unique(m_pushed_info_signal.size());
             }
-            for (auto &info : m_pushed_info_signal) {
-                m_batch_reader->prep_read(
-                    info.last_io_return, info.fd.get(), info.buf.data(), info.buf.size(), 0);
+            if (m_read_batch_idx == -1) {
+                // Signals cannot be pushed after the first read, so the
+                // batch is prepared only once.
+                std::vector<IOUring::m_operation_s> operations;
+                for (auto &info : m_pushed_info_signal) {
+                    operations.push_back({true, info.fd.get(), info.buf.data(),
+                                          static_cast<unsigned>(info.buf.size()), 0});
+                }
+                m_read_batch_idx = m_batch_reader->add_batch(operations);
+                m_read_batch_return.resize(m_pushed_info_signal.size());
             }
-            m_batch_reader->submit();
+            m_batch_reader->submit_batch(m_read_batch_idx, m_read_batch_return.data());
+            int info_idx = 0;
             for (auto &info : m_pushed_info_signal) {
-                if (*info.last_io_return < 0) {
+                int io_return = m_read_batch_return[info_idx];
+                ++info_idx;
+                if (io_return < 0) {
                     throw geopm::Exception("SysfsIOGroup failed to read signal",
-                                           errno, __FILE__, __LINE__);
+                                           -io_return, __FILE__, __LINE__);
                 }
-                size_t bytes_read = static_cast<size_t>(*info.last_io_return);
+                size_t bytes_read = static_cast<size_t>(io_return);
                 if (bytes_read >= info.buf.size()) {
                     throw geopm::Exception("SysfsIOGroup truncated read signal",
                                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
                 }
                 info.buf[bytes_read] = '\0';
 
-                info.value = info.parse(std::string(info.buf.data()));
+                if (!std::isnan(info.integer_scale)) {
+                    info.value = parse_integer(info.buf.data(), info.integer_scale,
+                                               info.integer_max);
+                }
+                else {
+                    info.value = info.parse(std::string(info.buf.data()));
+                }
             }
         }
     }
@@ -365,6 +421,7 @@ namespace geopm
                 m_batch_writer = IOUring::make_unique(m_pushed_info_signal.size());
             }
 
+            bool is_prepared = false;
             for (auto &info : m_pushed_info_control) {
                 if (info.do_write && !std::isnan(info.value)) {
                     std::string setting = info.gen(info.value);
@@ -372,13 +429,21 @@ namespace geopm
                         throw geopm::Exception("SysfsIOGroup control value is too long",
                                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
                     }
+                    if (setting == info.setting_last) {
+                        // The setting written last time is unchanged
+                        info.do_write = false;
+                        continue;
+                    }
                     std::strncpy(info.buf.data(), setting.c_str(), info.buf.size());
                     m_batch_writer->prep_write(
                         info.last_io_return, info.fd.get(), info.buf.data(),
                         static_cast<unsigned>(setting.length() + 1), 0);
+                    is_prepared = true;
                 }
             }
-            m_batch_writer->submit();
+            if (is_prepared) {
+                m_batch_writer->submit();
+            }
             for (auto &info : m_pushed_info_control) {
                 if (info.do_write && !std::isnan(info.value)) {
                     if (*info.last_io_return < 0) {
@@ -386,6 +451,8 @@ namespace geopm
                                                info.name + "\"",
                                                errno, __FILE__, __LINE__);
                     }
+                    info.setting_last = info.buf.data();
+                    info.do_write = false;
                 }
             }
         }
@@ -432,6 +499,13 @@ namespace geopm
         std::string cname = check_request(__func__, "", control_name, domain_type, domain_idx);
         UniqueFd fd = open_resource_attribute(m_driver->attribute_path(cname, domain_idx), true);
         write_resource_attribute_fd(fd.get(), m_driver->control_gen(cname)(setting));
+        // The write may have changed the attribute of a pushed
+        // control, so write all of them again in the next
+        // write_batch()
+        for (auto &info : m_pushed_info_control) {
+            info.setting_last.clear();
+            info.do_write = true;
+        }
     }
 
     void SysfsIOGroup::save_control(void)
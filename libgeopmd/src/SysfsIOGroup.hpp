@@ -84,11 +84,20 @@ namespace geopm
                 int domain_type;
                 int domain_idx;
                 double value;
+                // True if the value has been adjusted since it was
+                // last written
                 bool do_write;
                 std::shared_ptr<int> last_io_return;
                 std::array<char, SysfsDriver::M_IO_BUFFER_SIZE> buf;
                 std::function<double(const std::string&)> parse;
                 std::function<std::string(double)> gen;
+                // Scale of a signal parsed in place as an integer, or
+                // NAN to use parse()
+                double integer_scale;
+                // Largest magnitude of a signal parsed in place
+                int64_t integer_max;
+                // Content of the last write of a control
+                std::string setting_last;
             };
 
             // Pushed signals
@@ -97,6 +106,10 @@ namespace geopm
             std::shared_ptr<SaveControl> m_control_saver;
             std::shared_ptr<IOUring> m_batch_reader;
             std::shared_ptr<IOUring> m_batch_writer;
+            /// @brief IOUring batch of all pushed signal reads, -1
+            ///        until the first read_batch().
+            int m_read_batch_idx;
+            std::vector<int> m_read_batch_return;
             std::set<std::string> m_unsaved_controls;
     };
 
@@ -5,6 +5,8 @@
 
 #include "TimeIOGroup.hpp"
 
+#include <algorithm>
+
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/Exception.hpp"
@@ -116,6 +118,24 @@ namespace geopm
         return m_time_curr;
     }
 
+    void TimeIOGroup::sample_all(const std::vector<int> &batch_idx, double *result)
+    {
+        if (!m_is_signal_pushed) {
+            throw Exception("TimeIOGroup::sample_all(): signal has not been pushed",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_batch_read) {
+            throw Exception("TimeIOGroup::sample_all(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (std::any_of(batch_idx.begin(), batch_idx.end(),
+                        [](int idx) { return idx != 0; })) {
+            throw Exception("TimeIOGroup::sample_all(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::fill(result, result + batch_idx.size(), m_time_curr);
+    }
+
     void TimeIOGroup::adjust(int batch_idx, double setting)
     {
         throw Exception("TimeIOGroup::adjust(): there are no controls supported by the TimeIOGroup",
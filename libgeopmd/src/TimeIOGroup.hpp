@@ -31,6 +31,7 @@ namespace geopm
             void read_batch(void) override;
             void write_batch(void) override;
             double sample(int batch_idx) override;
+            void sample_all(const std::vector<int> &batch_idx, double *result) override;
             void adjust(int batch_idx, double setting) override;
             double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
             void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
@@ -95,3 +95,43 @@ TEST(AggTest, function_strings)
     GEOPM_EXPECT_THROW_MESSAGE(Agg::name_to_function("invalid"), GEOPM_ERROR_INVALID,
                                "unknown aggregation function");
 }
+
+TEST(AggTest, array_function)
+{
+    std::vector<std::function<double(const std::vector<double> &)> > funcs {
+        Agg::sum, Agg::average, Agg::min, Agg::max, Agg::logical_or
+    };
+    std::vector<double> data {16, 2, 0, NAN, -9, 128, NAN, 32, 4, 64, 0.5};
+    for (const auto &func : funcs) {
+        Agg::ArrayFunction array_func = Agg::function_to_array_function(func);
+        ASSERT_NE(nullptr, array_func) << Agg::function_to_name(func);
+        // Cover every tail length of the unrolled loops
+        for (size_t begin = 0; begin <= data.size(); ++begin) {
+            for (size_t end = begin; end <= data.size(); ++end) {
+                std::vector<double> operand(data.begin() + begin, data.begin() + end);
+                double expect = func(operand);
+                double actual = array_func(operand.data(), operand.size());
+                if (std::isnan(expect)) {
+                    EXPECT_TRUE(std::isnan(actual)) << Agg::function_to_name(func)
+                                                    << " [" << begin << ", " << end << ")";
+                }
+                else {
+                    EXPECT_DOUBLE_EQ(expect, actual) << Agg::function_to_name(func)
+                                                     << " [" << begin << ", " << end << ")";
+                }
+            }
+        }
+    }
+    std::vector<double> all_nan {NAN, NAN, NAN, NAN, NAN};
+    for (const auto &func : funcs) {
+        Agg::ArrayFunction array_func = Agg::function_to_array_function(func);
+        EXPECT_TRUE(std::isnan(array_func(all_nan.data(), all_nan.size())));
+    }
+    std::vector<double> zeros {0.0, NAN, 0.0, 0.0, 0.0};
+    EXPECT_EQ(0.0, Agg::function_to_array_function(Agg::logical_or)(zeros.data(), zeros.size()));
+
+    EXPECT_EQ(nullptr, Agg::function_to_array_function(Agg::median));
+    EXPECT_EQ(nullptr, Agg::function_to_array_function(Agg::select_first));
+    EXPECT_EQ(nullptr, Agg::function_to_array_function(
+        [](const std::vector<double> &operand) { return 0.0; }));
+}
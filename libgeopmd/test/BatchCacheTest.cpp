@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "geopm/IOGroup.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "BatchCache.hpp"
+#include "MockSharedMemory.hpp"
+#include "geopm_test.hpp"
+
+using geopm::BatchCache;
+using geopm::BatchCacheImp;
+using geopm::IOGroup;
+
+class BatchCacheTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        std::shared_ptr<MockSharedMemory> m_shmem;
+        std::vector<geopm_request_s> m_requests;
+};
+
+void BatchCacheTest::SetUp(void)
+{
+    m_shmem = std::make_shared<MockSharedMemory>(BatchCache::shmem_size());
+    m_requests = {geopm_request_s {0, 0, "CPU_FREQUENCY_MAX_AVAIL"},
+                  geopm_request_s {1, 0, "CPU_FREQUENCY_STATUS"},
+                  geopm_request_s {1, 1, "CPU_FREQUENCY_STATUS"}};
+}
+
+TEST_F(BatchCacheTest, sample_and_update)
+{
+    BatchCacheImp cache(1.0, m_shmem);
+    std::vector<int> entry_idx = cache.push_requests(m_requests);
+    ASSERT_EQ(3u, entry_idx.size());
+    EXPECT_NE(entry_idx[1], entry_idx[2]);
+    // Pushing the same requests again finds the same entries
+    EXPECT_EQ(entry_idx, cache.push_requests(m_requests));
+
+    std::vector<double> result(3, NAN);
+    EXPECT_FALSE(cache.sample(entry_idx, result.data()));
+    EXPECT_TRUE(std::isnan(result[0]));
+    EXPECT_EQ(0u, cache.stats().num_request);
+    EXPECT_EQ(0u, cache.stats().num_read);
+
+    std::vector<double> value {1.0, 2.0e9, 3.0e9};
+    cache.update(entry_idx, value.data());
+    EXPECT_TRUE(cache.sample(entry_idx, result.data()));
+    EXPECT_EQ(value, result);
+    EXPECT_EQ(6u, cache.stats().num_request);
+    EXPECT_EQ(3u, cache.stats().num_read);
+}
+
+TEST_F(BatchCacheTest, shared_region)
+{
+    BatchCacheImp cache_a(1.0, m_shmem);
+    BatchCacheImp cache_b(1.0, m_shmem);
+    std::vector<int> entry_idx_a = cache_a.push_requests(m_requests);
+    std::vector<geopm_request_s> requests_b {m_requests[2],
+                                             geopm_request_s {0, 0, "CPU_PACKAGE_TEMPERATURE"}};
+    std::vector<int> entry_idx_b = cache_b.push_requests(requests_b);
+    ASSERT_EQ(2u, entry_idx_b.size());
+    EXPECT_EQ(entry_idx_a[2], entry_idx_b[0]);
+
+    std::vector<double> value {1.0, 2.0e9, 3.0e9};
+    cache_a.update(entry_idx_a, value.data());
+    std::vector<double> result(1, NAN);
+    EXPECT_TRUE(cache_b.sample({entry_idx_b[0]}, result.data()));
+    EXPECT_EQ(3.0e9, result[0]);
+    // The other entry has not been read by any server
+    result.resize(2);
+    EXPECT_FALSE(cache_b.sample(entry_idx_b, result.data()));
+    EXPECT_EQ(4u, cache_a.stats().num_request);
+    EXPECT_EQ(3u, cache_b.stats().num_read);
+}
+
+TEST_F(BatchCacheTest, staleness)
+{
+    BatchCacheImp cache(0.01, m_shmem);
+    std::vector<int> entry_idx = cache.push_requests(m_requests);
+    std::vector<double> value {1.0, 2.0e9, 3.0e9};
+    std::vector<double> result(3, NAN);
+    cache.update(entry_idx, value.data());
+    EXPECT_TRUE(cache.sample(entry_idx, result.data()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(cache.sample(entry_idx, result.data()));
+}
+
+TEST_F(BatchCacheTest, full)
+{
+    BatchCacheImp cache(1.0, m_shmem);
+    std::vector<geopm_request_s> requests;
+    for (int domain_idx = 0; domain_idx < 8192; ++domain_idx) {
+        requests.push_back(geopm_request_s {1, domain_idx, "CPU_FREQUENCY_STATUS"});
+    }
+    EXPECT_EQ(requests.size(), cache.push_requests(requests).size());
+    requests.push_back(geopm_request_s {1, 8192, "CPU_FREQUENCY_STATUS"});
+    EXPECT_EQ(0u, cache.push_requests(requests).size());
+}
+
+TEST_F(BatchCacheTest, invalid)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(BatchCacheImp(0.0, m_shmem), GEOPM_ERROR_INVALID,
+                               "Maximum staleness must be a positive number");
+    GEOPM_EXPECT_THROW_MESSAGE(BatchCacheImp(NAN, m_shmem), GEOPM_ERROR_INVALID,
+                               "Maximum staleness must be a positive number");
+    auto small_shmem = std::make_shared<MockSharedMemory>(64);
+    EXPECT_CALL(*small_shmem, key()).WillOnce(testing::Return("small-key"));
+    GEOPM_EXPECT_THROW_MESSAGE(BatchCacheImp(1.0, small_shmem), GEOPM_ERROR_RUNTIME,
+                               "too small for the batch cache");
+}
+
+TEST_F(BatchCacheTest, is_cacheable)
+{
+    EXPECT_TRUE(BatchCache::is_cacheable("CPU_FREQUENCY_MAX_AVAIL",
+                                         IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT));
+    EXPECT_TRUE(BatchCache::is_cacheable("HOSTNAME", IOGroup::M_SIGNAL_BEHAVIOR_LABEL));
+    EXPECT_TRUE(BatchCache::is_cacheable("CPU_FREQUENCY_STATUS",
+                                         IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    // Measured from the start of each process
+    EXPECT_FALSE(BatchCache::is_cacheable("TIME", IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    EXPECT_FALSE(BatchCache::is_cacheable("TIME::ELAPSED", IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    EXPECT_FALSE(BatchCache::is_cacheable("TIME", IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT));
+    // Extended across overflow by each process
+    EXPECT_FALSE(BatchCache::is_cacheable("CPU_ENERGY", IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    // Derived from previous samples
+    EXPECT_FALSE(BatchCache::is_cacheable("CPU_POWER", IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    EXPECT_FALSE(BatchCache::is_cacheable("CPU_FREQUENCY_STATUS",
+                                          IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+}
+
+TEST_F(BatchCacheTest, layout_version)
+{
+    BatchCacheImp cache(1.0, m_shmem);
+    // Attaching to a region claimed by the same version succeeds
+    BatchCacheImp other_cache(1.0, m_shmem);
+    // A region written by a different version is rejected
+    auto old_shmem = std::make_shared<MockSharedMemory>(BatchCache::shmem_size());
+    *(uint64_t *)old_shmem->pointer() = 1000;
+    EXPECT_CALL(*old_shmem, key()).WillOnce(testing::Return("old-key"));
+    GEOPM_EXPECT_THROW_MESSAGE(BatchCacheImp(1.0, old_shmem), GEOPM_ERROR_RUNTIME,
+                               "has layout version 1000, expected 1");
+}
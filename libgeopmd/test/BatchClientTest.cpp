@@ -5,8 +5,10 @@
 
 
 #include <cerrno>
+#include <cmath>
 
 #include "BatchClient.hpp"
+#include "BatchServer.hpp"
 #include "BatchStatus.hpp"
 #include "MockBatchStatus.hpp"
 #include "MockSharedMemory.hpp"
@@ -145,3 +147,84 @@ TEST_F(BatchClientTest, stop_batch)
 
     m_batch_client->stop_batch();
 }
+
+TEST_F(BatchClientTest, select_shmem_transport)
+{
+    auto shmem_status = std::make_shared<MockBatchStatus>();
+    auto batch_client = std::make_shared<BatchClientImp>(2, 1,
+                                                         m_batch_status,
+                                                         m_signal_shmem,
+                                                         m_control_shmem,
+                                                         shmem_status,
+                                                         nullptr, 0.0);
+    {
+        InSequence sequence;
+        EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_SHMEM))
+            .Times(1);
+        EXPECT_CALL(*m_batch_status, receive_message(BatchStatus::M_MESSAGE_CONTINUE))
+            .Times(1);
+        EXPECT_CALL(*shmem_status, send_message(BatchStatus::M_MESSAGE_READ))
+            .Times(1);
+        EXPECT_CALL(*shmem_status, receive_message(BatchStatus::M_MESSAGE_CONTINUE))
+            .Times(1);
+        EXPECT_CALL(*shmem_status, send_message(BatchStatus::M_MESSAGE_WRITE))
+            .Times(1);
+        EXPECT_CALL(*shmem_status, receive_message(BatchStatus::M_MESSAGE_CONTINUE))
+            .Times(1);
+    }
+    batch_client->read_batch();
+    batch_client->write_batch({1.0});
+}
+
+TEST_F(BatchClientTest, read_batch_periodic)
+{
+    auto snapshot_shmem = std::make_shared<MockSharedMemory>(
+        geopm::BatchServer::snapshot_shmem_size(2));
+    auto batch_client = std::make_shared<BatchClientImp>(2, 1,
+                                                         m_batch_status,
+                                                         m_signal_shmem,
+                                                         m_control_shmem,
+                                                         nullptr,
+                                                         snapshot_shmem,
+                                                         0.005);
+    auto header = (geopm::BatchServer::m_snapshot_header_s *)snapshot_shmem->pointer();
+    double *buffer = (double *)(header + 1);
+    EXPECT_EQ(0.005, header->period);
+    // Second buffer is published and the server is in the middle
+    // of writing the first buffer
+    header->seq = 3;
+    buffer[0] = NAN;
+    buffer[1] = NAN;
+    buffer[2] = 1.0;
+    buffer[3] = 2.0;
+    {
+        InSequence sequence;
+        EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_SAMPLE))
+            .Times(1);
+        EXPECT_CALL(*m_batch_status, receive_message(BatchStatus::M_MESSAGE_CONTINUE))
+            .Times(1);
+    }
+    std::vector<double> expect = {1.0, 2.0};
+    EXPECT_EQ(expect, batch_client->read_batch());
+    // First buffer is published, no further messages are sent
+    header->seq = 4;
+    buffer[0] = 3.0;
+    buffer[1] = 4.0;
+    expect = {3.0, 4.0};
+    EXPECT_EQ(expect, batch_client->read_batch());
+
+    header->error = GEOPM_ERROR_RUNTIME;
+    GEOPM_EXPECT_THROW_MESSAGE(batch_client->read_batch(), GEOPM_ERROR_RUNTIME,
+                               "The server stopped periodic sampling");
+}
+
+TEST_F(BatchClientTest, read_batch_periodic_invalid)
+{
+    auto snapshot_shmem = std::make_shared<MockSharedMemory>(
+        geopm::BatchServer::snapshot_shmem_size(2));
+    GEOPM_EXPECT_THROW_MESSAGE(
+        std::make_shared<BatchClientImp>(2, 1, m_batch_status, m_signal_shmem,
+                                         m_control_shmem, nullptr,
+                                         snapshot_shmem, -1.0),
+        GEOPM_ERROR_INVALID, "sample_period must be positive");
+}
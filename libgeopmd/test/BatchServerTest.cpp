@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <chrono>
+#include <memory>
+#include <pthread.h>
+#include <signal.h>
+#include <thread>
+#include <vector>
+
+#include "geopm/Helper.hpp"
+#include "geopm/IOGroup.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "BatchCache.hpp"
+#include "BatchServer.hpp"
+#include "BatchStatus.hpp"
+#include "MockBatchStatus.hpp"
+#include "MockPlatformIO.hpp"
+#include "MockPOSIXSignal.hpp"
+#include "MockSharedMemory.hpp"
+#include "geopm_test.hpp"
+
+using testing::_;
+using testing::AtLeast;
+using testing::Invoke;
+using testing::Return;
+using geopm::BatchCache;
+using geopm::BatchCacheImp;
+using geopm::BatchServer;
+using geopm::BatchServerImp;
+using geopm::BatchStatus;
+using geopm::IOGroup;
+
+class BatchServerTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        std::unique_ptr<BatchServerImp> make_server(std::shared_ptr<BatchCache> cache = nullptr);
+        std::vector<geopm_request_s> m_signal_config;
+        std::vector<geopm_request_s> m_control_config;
+        MockPlatformIO m_pio;
+        std::shared_ptr<MockBatchStatus> m_batch_status;
+        std::shared_ptr<MockPOSIXSignal> m_posix_signal;
+        std::shared_ptr<MockSharedMemory> m_signal_shmem;
+        std::shared_ptr<MockSharedMemory> m_snapshot_shmem;
+};
+
+void BatchServerTest::SetUp(void)
+{
+    m_signal_config = {geopm_request_s {0, 0, "CPU_PACKAGE_TEMPERATURE"},
+                       geopm_request_s {1, 0, "CPU_FREQUENCY_STATUS"}};
+    m_batch_status = std::make_shared<MockBatchStatus>();
+    m_posix_signal = std::make_shared<MockPOSIXSignal>();
+    m_signal_shmem = std::make_shared<MockSharedMemory>(
+        m_signal_config.size() * sizeof(double));
+    m_snapshot_shmem = std::make_shared<MockSharedMemory>(
+        BatchServer::snapshot_shmem_size(m_signal_config.size()));
+    EXPECT_CALL(m_pio, push_signal("CPU_PACKAGE_TEMPERATURE", 0, 0)).WillOnce(Return(0));
+    EXPECT_CALL(m_pio, push_signal("CPU_FREQUENCY_STATUS", 1, 0)).WillOnce(Return(1));
+}
+
+std::unique_ptr<BatchServerImp> BatchServerTest::make_server(std::shared_ptr<BatchCache> cache)
+{
+    return geopm::make_unique<BatchServerImp>(
+        1234, m_signal_config, m_control_config, "signal-key", "control-key",
+        "status-key", "snapshot-key", m_pio, m_batch_status, m_posix_signal,
+        m_signal_shmem, nullptr, nullptr, m_snapshot_shmem, cache, 4321);
+}
+
+TEST_F(BatchServerTest, read_on_demand)
+{
+    auto server = make_server();
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_READ))
+        .WillOnce(Return(BatchStatus::M_MESSAGE_QUIT));
+    EXPECT_CALL(m_pio, read_batch()).Times(1);
+    EXPECT_CALL(m_pio, sample_all(std::vector<int>{0, 1}, _))
+        .WillOnce(Invoke([](const std::vector<int> &signal_idx, double *result)
+                         {
+                             result[0] = 1.0;
+                             result[1] = 2.0e9;
+                         }));
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(1);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    double *signal = (double *)m_signal_shmem->pointer();
+    EXPECT_EQ(1.0, signal[0]);
+    EXPECT_EQ(2.0e9, signal[1]);
+}
+
+TEST_F(BatchServerTest, read_from_cache)
+{
+    auto cache_shmem = std::make_shared<MockSharedMemory>(BatchCache::shmem_size());
+    auto cache = std::make_shared<BatchCacheImp>(60.0, cache_shmem);
+    EXPECT_CALL(m_pio, signal_behavior(_))
+        .WillRepeatedly(Return(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    // Values published by another server are fresh
+    BatchCacheImp other_cache(60.0, cache_shmem);
+    std::vector<double> value {5.0, 3.0e9};
+    other_cache.update(other_cache.push_requests(m_signal_config), value.data());
+
+    auto server = make_server(cache);
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_READ))
+        .WillOnce(Return(BatchStatus::M_MESSAGE_QUIT));
+    EXPECT_CALL(m_pio, read_batch()).Times(0);
+    EXPECT_CALL(m_pio, sample_all(_, _)).Times(0);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(1);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    double *signal = (double *)m_signal_shmem->pointer();
+    EXPECT_EQ(5.0, signal[0]);
+    EXPECT_EQ(3.0e9, signal[1]);
+    EXPECT_EQ(4u, cache->stats().num_request);
+    EXPECT_EQ(2u, cache->stats().num_read);
+}
+
+TEST_F(BatchServerTest, read_updates_cache)
+{
+    auto cache_shmem = std::make_shared<MockSharedMemory>(BatchCache::shmem_size());
+    auto cache = std::make_shared<BatchCacheImp>(60.0, cache_shmem);
+    EXPECT_CALL(m_pio, signal_behavior(_))
+        .WillRepeatedly(Return(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    auto server = make_server(cache);
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_READ))
+        .WillOnce(Return(BatchStatus::M_MESSAGE_READ))
+        .WillOnce(Return(BatchStatus::M_MESSAGE_QUIT));
+    // Second read is served from the cache
+    EXPECT_CALL(m_pio, read_batch()).Times(1);
+    EXPECT_CALL(m_pio, sample_all(std::vector<int>{0, 1}, _))
+        .WillOnce(Invoke([](const std::vector<int> &signal_idx, double *result)
+                         {
+                             result[0] = 1.0;
+                             result[1] = 2.0e9;
+                         }));
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(2);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    double *signal = (double *)m_signal_shmem->pointer();
+    EXPECT_EQ(1.0, signal[0]);
+    EXPECT_EQ(2.0e9, signal[1]);
+    EXPECT_EQ(4u, cache->stats().num_request);
+    EXPECT_EQ(2u, cache->stats().num_read);
+}
+
+TEST_F(BatchServerTest, read_uncacheable)
+{
+    auto cache_shmem = std::make_shared<MockSharedMemory>(BatchCache::shmem_size());
+    auto cache = std::make_shared<BatchCacheImp>(60.0, cache_shmem);
+    BatchCacheImp other_cache(60.0, cache_shmem);
+    std::vector<double> value {5.0, 3.0e9};
+    other_cache.update(other_cache.push_requests(m_signal_config), value.data());
+    // A counter makes the server read the platform even though the
+    // cached values are fresh.
+    EXPECT_CALL(m_pio, signal_behavior("CPU_PACKAGE_TEMPERATURE"))
+        .WillRepeatedly(Return(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    EXPECT_CALL(m_pio, signal_behavior("CPU_FREQUENCY_STATUS"))
+        .WillRepeatedly(Return(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+
+    auto server = make_server(cache);
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_READ))
+        .WillOnce(Return(BatchStatus::M_MESSAGE_QUIT));
+    EXPECT_CALL(m_pio, read_batch()).Times(1);
+    EXPECT_CALL(m_pio, sample_all(std::vector<int>{0, 1}, _))
+        .WillOnce(Invoke([](const std::vector<int> &signal_idx, double *result)
+                         {
+                             result[0] = 1.0;
+                             result[1] = 2.0e9;
+                         }));
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(1);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    double *signal = (double *)m_signal_shmem->pointer();
+    EXPECT_EQ(1.0, signal[0]);
+    EXPECT_EQ(2.0e9, signal[1]);
+    // The value read is not published
+    EXPECT_EQ(2u, cache->stats().num_read);
+}
+
+TEST_F(BatchServerTest, periodic_sampling)
+{
+    auto header = (BatchServer::m_snapshot_header_s *)m_snapshot_shmem->pointer();
+    header->period = 0.001;
+    auto server = make_server();
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_SAMPLE))
+        .WillOnce(Invoke([]()
+                         {
+                             // Let the server sample for a while
+                             std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                             return BatchStatus::M_MESSAGE_QUIT;
+                         }));
+    int num_sample = 0;
+    int num_sigterm_blocked = 0;
+    EXPECT_CALL(m_pio, read_batch()).Times(AtLeast(3));
+    EXPECT_CALL(m_pio, sample_all(std::vector<int>{0, 1}, _))
+        .Times(AtLeast(3))
+        .WillRepeatedly(Invoke([&num_sample, &num_sigterm_blocked](
+                                   const std::vector<int> &signal_idx,
+                                   double *result)
+                               {
+                                   sigset_t mask;
+                                   pthread_sigmask(SIG_BLOCK, nullptr, &mask);
+                                   if (sigismember(&mask, SIGTERM)) {
+                                       ++num_sigterm_blocked;
+                                   }
+                                   ++num_sample;
+                                   result[0] = num_sample;
+                                   result[1] = 10.0 * num_sample;
+                               }));
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(1);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    // Sampling thread is joined when the event loop exits
+    EXPECT_EQ(2 * (uint64_t)num_sample, header->seq.load());
+    EXPECT_EQ(0, header->error.load());
+    std::vector<double> result(2);
+    BatchServer::read_snapshot(header, 2, result.data());
+    EXPECT_EQ(num_sample, result[0]);
+    EXPECT_EQ(10.0 * num_sample, result[1]);
+    // Only the first sample is taken by the main thread, which must
+    // receive SIGTERM.
+    EXPECT_EQ(num_sample - 1, num_sigterm_blocked);
+}
+
+TEST_F(BatchServerTest, periodic_sampling_min_period)
+{
+    auto header = (BatchServer::m_snapshot_header_s *)m_snapshot_shmem->pointer();
+    header->period = 1.0e-9;
+    auto server = make_server();
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_SAMPLE))
+        .WillOnce(Invoke([]()
+                         {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                             return BatchStatus::M_MESSAGE_QUIT;
+                         }));
+    // The period is increased to M_MIN_SAMPLE_PERIOD
+    int max_sample = 1 + 50e-3 / BatchServer::M_MIN_SAMPLE_PERIOD + 10;
+    EXPECT_CALL(m_pio, read_batch()).Times(testing::AtMost(max_sample));
+    EXPECT_CALL(m_pio, sample_all(std::vector<int>{0, 1}, _))
+        .Times(testing::AtMost(max_sample));
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_CONTINUE)).Times(1);
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    server->run_batch();
+    EXPECT_EQ(0, header->error.load());
+}
+
+TEST_F(BatchServerTest, periodic_sampling_invalid_period)
+{
+    auto header = (BatchServer::m_snapshot_header_s *)m_snapshot_shmem->pointer();
+    header->period = 0.0;
+    auto server = make_server();
+    EXPECT_CALL(*m_batch_status, receive_message())
+        .WillOnce(Return(BatchStatus::M_MESSAGE_SAMPLE));
+    // Client is told to quit when the server fails
+    EXPECT_CALL(*m_batch_status, send_message(BatchStatus::M_MESSAGE_QUIT)).Times(1);
+    GEOPM_EXPECT_THROW_MESSAGE(server->run_batch(), GEOPM_ERROR_INVALID,
+                               "Invalid sample period requested");
+}
@@ -7,6 +7,7 @@
 #include "BatchStatus.hpp"
 
 #include "geopm/Helper.hpp"
+#include "geopm/SharedMemory.hpp"
 
 #include "gtest/gtest.h"
 #include "geopm_test.hpp"
@@ -18,6 +19,7 @@
 
 using geopm::BatchStatus;
 using geopm::BatchStatusImp;
+using geopm::SharedMemory;
 
 class BatchStatusTest : public ::testing::Test
 {
@@ -29,10 +31,12 @@ class BatchStatusTest : public ::testing::Test
         std::unique_ptr<BatchStatus> make_test_client();
         std::unique_ptr<BatchStatus> make_test_client(
             const std::string &server_key);
+        void shmem_round_trip(int transport);
         std::string m_server_prefix;
         std::string m_server_key;
         std::string m_status_path_in;
         std::string m_status_path_out;
+        std::shared_ptr<SharedMemory> m_status_shmem;
 };
 
 void BatchStatusTest::SetUp(void)
@@ -51,6 +55,9 @@ void BatchStatusTest::TearDown(void)
 {
     (void)!unlink(m_status_path_in.c_str());
     (void)!unlink(m_status_path_out.c_str());
+    if (m_status_shmem != nullptr) {
+        m_status_shmem->unlink();
+    }
 }
 
 int BatchStatusTest::fork_other(std::function<void(int)> child_process_func)
@@ -98,6 +105,42 @@ std::unique_ptr<BatchStatus> BatchStatusTest::make_test_client(
                                                         m_server_prefix);
 }
 
+void BatchStatusTest::shmem_round_trip(int transport)
+{
+    m_status_shmem = SharedMemory::make_unique_owner(
+        "/geopm-test-batch-status-shmem-" + std::to_string(getpid()),
+        BatchStatus::shmem_size());
+    int client_pid = getpid();
+    auto client_status = BatchStatus::make_unique_shmem_client(m_status_shmem,
+                                                               transport);
+    std::function<void(int)> child_process_func = [this, client_pid](int write_pipe_fd)
+    {
+        auto server_status = BatchStatus::make_unique_shmem_server(
+            m_status_shmem, client_pid, [](void) { return false; });
+        /* Extra code for synchronizing the server process. */
+        char unique_char = '!';
+        (void)!write(write_pipe_fd, &unique_char, sizeof(unique_char));
+
+        for (int idx = 0; idx < 100; ++idx) {
+            server_status->receive_message(BatchStatus::M_MESSAGE_READ);
+            server_status->send_message(BatchStatus::M_MESSAGE_CONTINUE);
+        }
+        char message = server_status->receive_message();
+        server_status->send_message(message);
+    };
+    int server_pid = fork_other(child_process_func);
+
+    for (int idx = 0; idx < 100; ++idx) {
+        client_status->send_message(BatchStatus::M_MESSAGE_READ);
+        client_status->receive_message(BatchStatus::M_MESSAGE_CONTINUE);
+    }
+    client_status->send_message(BatchStatus::M_MESSAGE_QUIT);
+    EXPECT_EQ(BatchStatus::M_MESSAGE_QUIT, client_status->receive_message());
+    int status = -1;
+    waitpid(server_pid, &status, 0);  // reap child process
+    EXPECT_EQ(0, status);
+}
+
 
 /************************************
  * Test Fixtures of BatchStatusTest *
@@ -242,3 +285,61 @@ TEST_F(BatchStatusTest, bad_client_key)
     );
     waitpid(server_pid, nullptr, 0);  // reap child process
 }
+
+TEST_F(BatchStatusTest, shmem_futex)
+{
+    shmem_round_trip(BatchStatus::M_TRANSPORT_FUTEX);
+}
+
+TEST_F(BatchStatusTest, shmem_busy_poll)
+{
+    shmem_round_trip(BatchStatus::M_TRANSPORT_BUSY_POLL);
+}
+
+TEST_F(BatchStatusTest, shmem_server_exit)
+{
+    m_status_shmem = SharedMemory::make_unique_owner(
+        "/geopm-test-batch-status-shmem-" + std::to_string(getpid()),
+        BatchStatus::shmem_size());
+    int client_pid = getpid();
+    auto client_status = BatchStatus::make_unique_shmem_client(
+        m_status_shmem, BatchStatus::M_TRANSPORT_FUTEX);
+    std::function<void(int)> child_process_func = [this, client_pid](int write_pipe_fd)
+    {
+        auto server_status = BatchStatus::make_unique_shmem_server(
+            m_status_shmem, client_pid, [](void) { return false; });
+        char unique_char = '!';
+        (void)!write(write_pipe_fd, &unique_char, sizeof(unique_char));
+    };
+    int server_pid = fork_other(child_process_func);
+    waitpid(server_pid, nullptr, 0);  // reap child process
+    GEOPM_EXPECT_THROW_MESSAGE(client_status->receive_message(),
+                               GEOPM_ERROR_RUNTIME,
+                               "exited while waiting for message");
+}
+
+TEST_F(BatchStatusTest, shmem_interrupted)
+{
+    m_status_shmem = SharedMemory::make_unique_owner(
+        "/geopm-test-batch-status-shmem-" + std::to_string(getpid()),
+        BatchStatus::shmem_size());
+    auto server_status = BatchStatus::make_unique_shmem_server(
+        m_status_shmem, getpid(), [](void) { return true; });
+    GEOPM_EXPECT_THROW_MESSAGE(server_status->receive_message(),
+                               EINTR, "Interrupted while waiting for message");
+}
+
+TEST_F(BatchStatusTest, shmem_invalid)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(
+        BatchStatus::make_unique_shmem_client(nullptr, BatchStatus::M_TRANSPORT_FUTEX),
+        GEOPM_ERROR_INVALID, "missing or too small");
+    GEOPM_EXPECT_THROW_MESSAGE(
+        BatchStatus::make_unique_shmem_client(nullptr, BatchStatus::M_TRANSPORT_FIFO),
+        GEOPM_ERROR_INVALID, "Invalid transport");
+    EXPECT_EQ(BatchStatus::M_TRANSPORT_FIFO, BatchStatus::transport_type("fifo"));
+    EXPECT_EQ(BatchStatus::M_TRANSPORT_FUTEX, BatchStatus::transport_type("futex"));
+    EXPECT_EQ(BatchStatus::M_TRANSPORT_BUSY_POLL, BatchStatus::transport_type("busy-poll"));
+    GEOPM_EXPECT_THROW_MESSAGE(BatchStatus::transport_type("pipe"),
+                               GEOPM_ERROR_INVALID, "Unknown transport");
+}
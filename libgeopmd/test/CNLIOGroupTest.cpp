@@ -119,6 +119,48 @@ TEST_F(CNLIOGroupTest, push_signal)
     EXPECT_THROW(cnl.push_signal("CNL::BOARD_POWER", GEOPM_DOMAIN_PACKAGE, 0), Exception);
 }
 
+TEST_F(CNLIOGroupTest, push_signal_shared)
+{
+    CNLIOGroup cnl(m_test_dir);
+
+    // Pushing a signal again or through its alias reads the same file
+    int power_idx = cnl.push_signal("CNL::BOARD_POWER", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_EQ(power_idx, cnl.push_signal("CNL::BOARD_POWER", GEOPM_DOMAIN_BOARD, 0));
+    int alias_idx = cnl.push_signal("BOARD_POWER", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_NE(power_idx, alias_idx);
+    int energy_idx = cnl.push_signal("CNL::BOARD_ENERGY", GEOPM_DOMAIN_BOARD, 0);
+    int rate_idx = cnl.push_signal("CNL::SAMPLE_RATE", GEOPM_DOMAIN_BOARD, 0);
+    int time_idx = cnl.push_signal("CNL::SAMPLE_ELAPSED_TIME", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_TRUE(std::isnan(cnl.sample(power_idx)));
+    GEOPM_EXPECT_THROW_MESSAGE(cnl.sample(time_idx + 1), GEOPM_ERROR_INVALID,
+                               "has not been pushed");
+
+    std::string sparse_string("90 W\n");
+    sparse_string.resize(4096);
+    std::ofstream(m_power_path) << sparse_string;
+    std::ofstream(m_freshness_path) << "25\n";
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(90, cnl.sample(power_idx));
+    EXPECT_DOUBLE_EQ(90, cnl.sample(alias_idx));
+    EXPECT_DOUBLE_EQ(598732067, cnl.sample(energy_idx));
+    EXPECT_DOUBLE_EQ(10, cnl.sample(rate_idx));
+    EXPECT_DOUBLE_EQ(2.5, cnl.sample(time_idx));
+
+    // Format errors are reported by read_batch()
+    std::ofstream(m_power_path) << "90 J\n";
+    GEOPM_EXPECT_THROW_MESSAGE(cnl.read_batch(), GEOPM_ERROR_RUNTIME,
+                               "Unexpected format in " + m_power_path);
+    std::ofstream(m_power_path) << "Ninety Watts\n";
+    GEOPM_EXPECT_THROW_MESSAGE(cnl.read_batch(), GEOPM_ERROR_RUNTIME,
+                               "Unexpected format in " + m_power_path);
+    std::ofstream(m_power_path) << "90W\n";
+    GEOPM_EXPECT_THROW_MESSAGE(cnl.read_batch(), GEOPM_ERROR_RUNTIME,
+                               "Unexpected format in " + m_power_path);
+    std::ofstream(m_power_path) << "91 W\n";
+    cnl.read_batch();
+    EXPECT_DOUBLE_EQ(91, cnl.sample(alias_idx));
+}
+
 TEST_F(CNLIOGroupTest, parse_power)
 {
     const std::vector<std::pair<std::string, std::string> > power_signals = {
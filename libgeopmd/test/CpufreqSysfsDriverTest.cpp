@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <cstring>
 #include <memory>
 
@@ -167,6 +168,17 @@ TEST_F(CpufreqSysfsDriverTest, signal_parse)
     EXPECT_TRUE(std::isnan(m_driver->signal_parse("CPUFREQ::SCALING_SETSPEED")("BADDAD")));
 }
 
+TEST_F(CpufreqSysfsDriverTest, signal_integer_scale)
+{
+    EXPECT_THROW(m_driver->signal_integer_scale("CPUFREQ::A_MADE_UP_ATTRIBUTE_NAME"), geopm::Exception)
+        << "Should fail to get the scale of a signal that does not exist";
+    EXPECT_DOUBLE_EQ(1e3, m_driver->signal_integer_scale("CPUFREQ::SCALING_CUR_FREQ"));
+    EXPECT_DOUBLE_EQ(1e-9, m_driver->signal_integer_scale("CPUFREQ::CPUINFO_TRANSITION_LATENCY"));
+    // Same range as the std::stoi() based parser
+    EXPECT_EQ(INT_MAX, m_driver->signal_integer_max("CPUFREQ::SCALING_CUR_FREQ"));
+    EXPECT_TRUE(std::isnan(m_driver->signal_parse("CPUFREQ::SCALING_CUR_FREQ")("2147483648")));
+}
+
 TEST_F(CpufreqSysfsDriverTest, control_gen)
 {
     EXPECT_THROW(m_driver->control_gen("CPUFREQ::A_MADE_UP_ATTRIBUTE_NAME"), geopm::Exception)
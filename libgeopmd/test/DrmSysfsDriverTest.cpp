@@ -5,6 +5,8 @@
 
 #include "DrmSysfsDriver.hpp"
 
+#include <climits>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -123,6 +125,15 @@ TEST_F(DrmSysfsDriverTest, signal_parse)
     EXPECT_DOUBLE_EQ(2.345e9, m_driver->signal_parse("TEST_DRIVER_PREFIX::RPS_ACT_FREQ")("2345" /* in MHz */));
 }
 
+TEST_F(DrmSysfsDriverTest, signal_integer_scale)
+{
+    EXPECT_THROW(m_driver->signal_integer_scale("TEST_DRIVER_PREFIX::A_MADE_UP_ATTRIBUTE_NAME"), geopm::Exception)
+        << "Should fail to get the scale of a signal that does not exist";
+    EXPECT_DOUBLE_EQ(1e6, m_driver->signal_integer_scale("TEST_DRIVER_PREFIX::RPS_CUR_FREQ"));
+    // Same range as the std::stol() based parser
+    EXPECT_EQ(LONG_MAX, m_driver->signal_integer_max("TEST_DRIVER_PREFIX::RPS_CUR_FREQ"));
+}
+
 TEST_F(DrmSysfsDriverTest, control_gen)
 {
     EXPECT_THROW(m_driver->control_gen("TEST_DRIVER_PREFIX::A_MADE_UP_ATTRIBUTE_NAME"), geopm::Exception)
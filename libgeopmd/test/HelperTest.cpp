@@ -6,11 +6,18 @@
 #include "gtest/gtest.h"
 
 #include <fcntl.h>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
 #include <vector>
 #include <unistd.h>
 
 #include "geopm/Helper.hpp"
+#include "geopm_field.h"
 #include "geopm_test.hpp"
 
 TEST(HelperTest, string_split)
@@ -124,3 +131,95 @@ TEST(HelperTest, read_symlink_target)
     EXPECT_THROW(geopm::read_symlink_target(SYMLINK_PATH), geopm::Exception)
         << "Expect an exception when reading an absent symlink";
 }
+
+// The formats that were used with snprintf() before the buffer
+// functions were added
+static std::string snprintf_format(const char *format, double signal)
+{
+    char result[64];
+    if (std::string(format) == "integer") {
+        if (!std::isfinite(signal)) {
+            snprintf(result, sizeof(result), "%g", signal);
+        }
+        else {
+            snprintf(result, sizeof(result), "%lld", (long long)signal);
+        }
+    }
+    else if (std::string(format) == "hex") {
+        if (std::isnan(signal)) {
+            return "NAN";
+        }
+        snprintf(result, sizeof(result), "0x%08" PRIx64, (uint64_t)signal);
+    }
+    else if (std::string(format) == "raw64") {
+        snprintf(result, sizeof(result), "0x%016" PRIx64, geopm_signal_to_field(signal));
+    }
+    else {
+        snprintf(result, sizeof(result), format, signal);
+    }
+    return result;
+}
+
+TEST(HelperTest, string_format)
+{
+    std::vector<double> values = {0.0, -0.0, 1.0, -1.0, 0.1, 1.0 / 3.0, 2.0 / 3.0,
+                                  0.5, 1e-5, 1e-4, 123456.0, 1234567.0, 1e15,
+                                  1e16, 1e17, 9.999999999999999e22, 1e300,
+                                  4.9e-324, 2.2250738585072014e-308,
+                                  -1.7976931348623157e308, 4294967295.0,
+                                  9007199254740993.0, 0xdeadbeef, 0x8a7c1f4f,
+                                  std::numeric_limits<double>::quiet_NaN(),
+                                  -std::numeric_limits<double>::quiet_NaN(),
+                                  std::numeric_limits<double>::infinity(),
+                                  -std::numeric_limits<double>::infinity()};
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    std::uniform_int_distribution<uint64_t> bits;
+    for (int idx = 0; idx != 10000; ++idx) {
+        values.push_back(std::ldexp(mantissa(generator), exponent(generator)));
+        values.push_back(std::round(std::ldexp(std::fabs(mantissa(generator)), 40)));
+        values.push_back(geopm_field_to_signal(bits(generator)));
+    }
+    const std::vector<std::pair<std::string, std::string> > formats = {
+        {"%.16g", "double"},
+        {"%g", "float"},
+        {"integer", "integer"},
+        {"hex", "hex"},
+        {"raw64", "raw64"},
+    };
+    const std::vector<std::function<std::string(double)> > functions = {
+        geopm::string_format_double,
+        geopm::string_format_float,
+        geopm::string_format_integer,
+        geopm::string_format_hex,
+        geopm::string_format_raw64,
+    };
+    char buffer[geopm::string_format_buffer_size];
+    for (size_t format_idx = 0; format_idx != formats.size(); ++format_idx) {
+        const auto &format = formats[format_idx];
+        auto format_buffer = geopm::string_format_function_to_buffer(functions[format_idx]);
+        ASSERT_NE(nullptr, format_buffer);
+        for (double value : values) {
+            // The integer formats are only defined for values that
+            // fit in the integer type
+            if ((format.second == "integer" && std::isfinite(value) &&
+                 std::fabs(value) >= 9.2e18) ||
+                (format.second == "hex" && !(value > -1.0 && value < 1.8e19) &&
+                 !std::isnan(value))) {
+                continue;
+            }
+            std::string expect = snprintf_format(format.first.c_str(), value);
+            EXPECT_EQ(expect, functions[format_idx](value)) << format.second;
+            char *end = format_buffer(value, buffer);
+            ASSERT_LE(end, buffer + sizeof(buffer));
+            EXPECT_EQ(expect, std::string(buffer, end)) << format.second;
+        }
+    }
+    EXPECT_EQ("inf", geopm::string_format_integer(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ("-inf", geopm::string_format_integer(-std::numeric_limits<double>::infinity()));
+    EXPECT_EQ(nullptr, geopm::string_format_function_to_buffer(
+                           [](double signal) { return std::to_string(signal); }));
+    EXPECT_EQ(geopm::string_format_hex_buffer,
+              geopm::string_format_function_to_buffer(geopm::string_format_name_to_function("hex")));
+}
@@ -8,6 +8,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <unistd.h>
 
 #include "IOUringFallback.hpp"
 #include "geopm_test.hpp"
@@ -15,6 +16,9 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <vector>
+
+#include "geopm/Exception.hpp"
 
 using geopm::IOUring;
 
@@ -23,6 +27,7 @@ class IOUringTest : public ::testing::TestWithParam<std::shared_ptr<IOUring> >
     protected:
         void test_reads(const std::string &context, std::shared_ptr<IOUring> io);
         void test_writes(const std::string &context, std::shared_ptr<IOUring> io);
+        void test_batch(const std::string &context, std::shared_ptr<IOUring> io);
 };
 
 void IOUringTest::test_reads(const std::string &context, std::shared_ptr<IOUring> io)
@@ -83,3 +88,52 @@ TEST_F(IOUringTest, batch_write)
     test_writes("uring", geopm::IOUring::make_unique(2));
     test_writes("fallback", geopm::IOUringFallback::make_unique(2));
 }
+
+void IOUringTest::test_batch(const std::string &context, std::shared_ptr<IOUring> io)
+{
+    int read_only_fd = open("/dev/zero", O_RDONLY);
+    ASSERT_GT(read_only_fd, -1) << context << ": Failed to open /dev/zero for reading";
+    int write_only_fd = open("/dev/null", O_WRONLY);
+    ASSERT_GT(write_only_fd, -1) << context << ": Failed to open /dev/null for writing";
+
+    // More operations than queue entries
+    std::vector<uint64_t> buf(5, 10);
+    std::vector<IOUring::m_operation_s> operations;
+    for (auto &it : buf) {
+        operations.push_back({true, read_only_fd, &it, sizeof(it), 0});
+    }
+    operations.push_back({true, write_only_fd, &buf[0], sizeof(buf[0]), 0});
+    int batch_idx = io->add_batch(operations);
+    std::vector<int> ret(operations.size(), 12345);
+    for (int repeat = 0; repeat != 2; ++repeat) {
+        io->submit_batch(batch_idx, ret.data());
+        for (size_t idx = 0; idx != buf.size(); ++idx) {
+            EXPECT_EQ(static_cast<int>(sizeof(uint64_t)), ret[idx]) << context;
+            EXPECT_EQ(0ULL, buf[idx]) << context;
+        }
+        EXPECT_EQ(-EBADF, ret.back()) << context;
+        buf.assign(buf.size(), 10);
+    }
+
+    // Replace the batch with writes
+    int other_batch_idx = io->add_batch({{false, write_only_fd, &buf[0], sizeof(buf[0]), 0}});
+    EXPECT_NE(batch_idx, other_batch_idx) << context;
+    io->update_batch(batch_idx, {{false, write_only_fd, &buf[0], sizeof(buf[0]), 0},
+                                 {false, read_only_fd, &buf[1], sizeof(buf[1]), 0}});
+    io->submit_batch(batch_idx, ret.data());
+    EXPECT_EQ(static_cast<int>(sizeof(uint64_t)), ret[0]) << context;
+    EXPECT_EQ(-EBADF, ret[1]) << context;
+    io->submit_batch(other_batch_idx, ret.data());
+    EXPECT_EQ(static_cast<int>(sizeof(uint64_t)), ret[0]) << context;
+
+    EXPECT_THROW(io->submit_batch(other_batch_idx + 1, ret.data()), geopm::Exception) << context;
+    close(write_only_fd);
+    close(read_only_fd);
+}
+
+TEST_F(IOUringTest, batch_prepared)
+{
+    // If GEOPM is built without IO uring, these are both the same test.
+    test_batch("uring", geopm::IOUring::make_unique(2));
+    test_batch("fallback", geopm::IOUringFallback::make_unique(2));
+}
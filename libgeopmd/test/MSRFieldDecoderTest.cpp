@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015 - 2024 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "MSRFieldDecoder.hpp"
+#include "MSRFieldSignal.hpp"
+#include "MSR.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_field.h"
+#include "MockSignal.hpp"
+#include "geopm_test.hpp"
+
+using geopm::MSRFieldDecoder;
+using geopm::MSRFieldSignal;
+using geopm::MSR;
+using testing::Invoke;
+
+TEST(MSRFieldDecoderTest, overflow)
+{
+    MSRFieldDecoder decoder;
+    EXPECT_EQ(0, decoder.add_field(0, 0, 3, MSR::M_FUNCTION_OVERFLOW, 1.0));
+    EXPECT_EQ(1, decoder.add_field(0, 4, 7, MSR::M_FUNCTION_SCALE, 2.0));
+    EXPECT_EQ(2, decoder.num_field());
+    std::vector<uint64_t> raw = {0x15, 0x34, 0x5A, 0x71};
+    std::vector<double> expected = {5.0, 20.0, 26.0, 33.0};
+    for (size_t idx = 0; idx < raw.size(); ++idx) {
+        decoder.decode(&raw[idx]);
+        EXPECT_EQ(expected[idx], decoder.value(0));
+        EXPECT_EQ(2.0 * (raw[idx] >> 4), decoder.value(1));
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(decoder.add_field(0, 0, 3, MSR::M_FUNCTION_SCALE, 1.0),
+                               GEOPM_ERROR_INVALID, "cannot add a field after decode()");
+}
+
+TEST(MSRFieldDecoderTest, match_field_signal)
+{
+    struct field_s {
+        int begin_bit;
+        int end_bit;
+        int function;
+        double scalar;
+    };
+    // Includes fields that are too wide for the vector conversion
+    std::vector<field_s> fields = {
+        {16, 23, MSR::M_FUNCTION_SCALE, 1.5},
+        {0, 51, MSR::M_FUNCTION_SCALE, 1e-9},
+        {0, 52, MSR::M_FUNCTION_SCALE, 1e-9},
+        {8, 8, MSR::M_FUNCTION_LOGIC, 1.0},
+        {4, 7, MSR::M_FUNCTION_LOG_HALF, 3.0},
+        {17, 23, MSR::M_FUNCTION_7_BIT_FLOAT, 0.125},
+        {0, 7, MSR::M_FUNCTION_OVERFLOW, 1.0},
+        {0, 47, MSR::M_FUNCTION_OVERFLOW, 0.5},
+        {0, 59, MSR::M_FUNCTION_OVERFLOW, 1.0},
+    };
+    // An odd number of fields in each group exercises the remainder
+    // of the vector loop.
+    const int num_raw = 7;
+    std::vector<uint64_t> raw(num_raw, 0);
+    std::vector<std::shared_ptr<MockSignal> > raw_signal;
+    for (int raw_idx = 0; raw_idx < num_raw; ++raw_idx) {
+        auto sig = std::make_shared<MockSignal>();
+        EXPECT_CALL(*sig, setup_batch()).Times(testing::AnyNumber());
+        EXPECT_CALL(*sig, sample()).WillRepeatedly(Invoke([&raw, raw_idx]() {
+            return geopm_field_to_signal(raw[raw_idx]);
+        }));
+        raw_signal.push_back(sig);
+    }
+    MSRFieldDecoder decoder;
+    std::vector<std::unique_ptr<MSRFieldSignal> > field_signal;
+    std::vector<int> field_idx;
+    for (const auto &field : fields) {
+        for (int raw_idx = 0; raw_idx < num_raw; ++raw_idx) {
+            field_signal.push_back(geopm::make_unique<MSRFieldSignal>(
+                raw_signal[raw_idx], field.begin_bit, field.end_bit,
+                field.function, field.scalar));
+            field_signal.back()->setup_batch();
+            field_idx.push_back(decoder.add_field(raw_idx, field.begin_bit,
+                                                  field.end_bit, field.function,
+                                                  field.scalar));
+        }
+    }
+    std::mt19937_64 generator(42);
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        for (auto &value : raw) {
+            value = generator();
+        }
+        decoder.decode(raw.data());
+        for (size_t sig_idx = 0; sig_idx < field_signal.size(); ++sig_idx) {
+            EXPECT_EQ(field_signal[sig_idx]->sample(),
+                      decoder.value(field_idx[sig_idx]));
+        }
+    }
+}
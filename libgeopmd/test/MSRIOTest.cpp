@@ -3,7 +3,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <functional>
 #include <fcntl.h>
 #include <iterator>
 #include <limits.h>
@@ -11,6 +14,7 @@
 #include <cstdlib>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -19,6 +23,7 @@
 #include <sys/types.h>
 
 #include "IOUring.hpp"
+#include "IOUringFallback.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 #include "MockIOUring.hpp"
@@ -30,6 +35,7 @@ using geopm::MSRIO;
 using geopm::MSRIOImp;
 using geopm::MSRPath;
 using geopm::IOUring;
+using geopm::IOUringFallback;
 using testing::Return;
 using testing::Invoke;
 using testing::_;
@@ -642,6 +648,13 @@ class MSRIOTest : public ::testing ::Test
         std::unique_ptr<MSRIOMockFiles> m_files;
         std::shared_ptr<MockMSRPath> m_path;
         std::shared_ptr<MockIOUring> m_batch_io;
+        /// @brief Emulate the IOUring batch interface by calling
+        ///        functions with the prep_read() and prep_write()
+        ///        signatures for each operation of a submitted batch.
+        void expect_batches(std::function<void(std::shared_ptr<int>, int, void *, unsigned, off_t)> read_func,
+                            std::function<void(std::shared_ptr<int>, int, const void *, unsigned, off_t)> write_func,
+                            int num_submit);
+        std::vector<std::vector<IOUring::m_operation_s> > m_batch;
 };
 
 void MSRIOTest::SetUp(void)
@@ -662,6 +675,31 @@ void MSRIOTest::SetUp(void)
 
 void MSRIOTest::TearDown(void) {}
 
+void MSRIOTest::expect_batches(std::function<void(std::shared_ptr<int>, int, void *, unsigned, off_t)> read_func,
+                               std::function<void(std::shared_ptr<int>, int, const void *, unsigned, off_t)> write_func,
+                               int num_submit)
+{
+    EXPECT_CALL(*m_batch_io, add_batch(_)).WillRepeatedly(
+        Invoke([this](const std::vector<IOUring::m_operation_s> &operations) {
+            m_batch.push_back(operations);
+            return (int)m_batch.size() - 1;
+        }));
+    EXPECT_CALL(*m_batch_io, submit_batch(_, _)).Times(num_submit).WillRepeatedly(
+        Invoke([this, read_func, write_func](int batch_idx, int *ret) {
+            for (const auto &op : m_batch.at(batch_idx)) {
+                auto op_ret = std::make_shared<int>(0);
+                if (op.is_read) {
+                    read_func(op_ret, op.fd, op.buf, op.nbytes, op.offset);
+                }
+                else {
+                    write_func(op_ret, op.fd, op.buf, op.nbytes, op.offset);
+                }
+                *ret = *op_ret;
+                ++ret;
+            }
+        }));
+}
+
 TEST_F(MSRIOTest, read_aligned)
 {
     uint64_t field;
@@ -793,10 +831,10 @@ TEST_F(MSRIOTest, read_batch)
             *ret = nbytes;
         }
     };
-    EXPECT_CALL(*m_batch_io, prep_read(_, _, _, _, _)).WillRepeatedly(
-            Invoke(read_all_bytes));
-    EXPECT_CALL(*m_batch_io, submit()).Times(2);
+    // The batch of each context is prepared once
+    expect_batches(read_all_bytes, nullptr, 3);
 
+    m_msrio->read_batch();
     m_msrio->read_batch();
     // check that sample works with index from add_read (with default batch context)
     ASSERT_EQ(expected0.size(), sample_idx0.size());
@@ -809,6 +847,7 @@ TEST_F(MSRIOTest, read_batch)
     for (size_t ii = 0; ii < sample_idx1.size(); ++ii) {
         EXPECT_EQ(expected1[ii], m_msrio->sample(sample_idx1[ii], sec_batch_ctx));
     }
+    EXPECT_EQ(2u, m_batch.size());
 }
 
 TEST_F(MSRIOTest, write_batch)
@@ -882,9 +921,6 @@ TEST_F(MSRIOTest, write_batch)
             *ret = nbytes;
         }
     };
-    EXPECT_CALL(*m_batch_io, prep_read(_, _, _, _, _)).WillRepeatedly(
-            Invoke(read_all_bytes));
-
     // Take whatever would be written to a file, and put it in the written_words0 vector
     auto write_all_bytes = [&written_words0, &offsets0, &written_words1, &offsets1](
             std::shared_ptr<int> ret, int, const void *buf, unsigned nbytes, off_t offset) {
@@ -906,14 +942,85 @@ TEST_F(MSRIOTest, write_batch)
             *ret = nbytes;
         }
     };
-    EXPECT_CALL(*m_batch_io, prep_write(_, _, _, _, _)).WillRepeatedly(
-            Invoke(write_all_bytes));
-
     // Called twice per write_batch(). Once for read, then again for modified write.
-    EXPECT_CALL(*m_batch_io, submit()).Times(4);
+    expect_batches(read_all_bytes, write_all_bytes, 4);
 
     m_msrio->write_batch();
     m_msrio->write_batch(sec_batch_ctx);
     EXPECT_EQ(end_words0, written_words0);
     EXPECT_EQ(end_words1, written_words1);
+    EXPECT_EQ(4u, m_batch.size());
+}
+
+TEST_F(MSRIOTest, calibrate_backend)
+{
+    // The batch device is a regular file, so the msr-safe ioctl
+    // fails and is excluded.  The mocked io_uring reader is slowed
+    // down so that pread() is the fastest backend.
+    auto path = std::make_shared<MockMSRPath>();
+    for (int cpu_idx = 0; cpu_idx != m_num_cpu; ++cpu_idx) {
+        EXPECT_CALL(*path, msr_path(cpu_idx))
+            .WillOnce(Return(m_files->test_dev_path()[cpu_idx]));
+    }
+    EXPECT_CALL(*path, msr_batch_path())
+        .WillRepeatedly(Return(m_files->test_dev_path()[0]));
+    auto slow_read = [](std::shared_ptr<int> ret, int fd, void *buf, unsigned nbytes, off_t offset) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        *ret = pread(fd, buf, nbytes, offset);
+    };
+    expect_batches(slow_read, nullptr, 3);
+    auto msrio = geopm::make_unique<MSRIOImp>(m_num_cpu, path, m_batch_io, m_batch_io,
+                                              IOUringFallback::make_unique(0));
+    EXPECT_EQ(-1, msrio->batch_backend());
+    GEOPM_EXPECT_THROW_MESSAGE(msrio->calibrate(0), GEOPM_ERROR_INVALID,
+                               "No reads have been added");
+    GEOPM_EXPECT_THROW_MESSAGE(msrio->batch_latency(MSRIO::M_NUM_BACKEND),
+                               GEOPM_ERROR_INVALID, "Backend out of range");
+
+    std::vector<int> sample_idx;
+    for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+        sample_idx.push_back(msrio->add_read(cpu_idx, 0x8));
+    }
+    // Each read_batch() times one backend until every backend that
+    // did not fail has been sampled M_NUM_CALIBRATE_SAMPLE times.
+    int num_read = 0;
+    while (msrio->batch_backend() == -1) {
+        msrio->read_batch();
+        for (int idx : sample_idx) {
+            uint64_t field = msrio->sample(idx);
+            EXPECT_EQ(0, memcmp(&field, "abstract", 8));
+        }
+        ++num_read;
+        ASSERT_GT(10, num_read);
+    }
+    EXPECT_EQ(6, num_read);
+    EXPECT_EQ(MSRIO::M_BACKEND_PREAD, msrio->batch_backend());
+    EXPECT_TRUE(std::isnan(msrio->batch_latency(MSRIO::M_BACKEND_IOCTL)));
+    EXPECT_LT(0.0, msrio->batch_latency(MSRIO::M_BACKEND_PREAD));
+    EXPECT_LT(msrio->batch_latency(MSRIO::M_BACKEND_PREAD),
+              msrio->batch_latency(MSRIO::M_BACKEND_URING));
+    // Later reads only use the selected backend
+    msrio->read_batch();
+    uint64_t field = msrio->sample(sample_idx[0]);
+    EXPECT_EQ(0, memcmp(&field, "abstract", 8));
+    EXPECT_EQ(MSRIO::M_BACKEND_PREAD, msrio->batch_backend());
+}
+
+TEST_F(MSRIOTest, calibrate_explicit)
+{
+    // Without a separate pread() reader only one backend is
+    // available, so it is selected without calibration.
+    EXPECT_EQ(MSRIO::M_BACKEND_PREAD, m_msrio->batch_backend());
+    EXPECT_TRUE(std::isnan(m_msrio->batch_latency(MSRIO::M_BACKEND_PREAD)));
+    int idx = m_msrio->add_read(0, 0x10);
+    auto read_file = [](std::shared_ptr<int> ret, int fd, void *buf, unsigned nbytes, off_t offset) {
+        *ret = pread(fd, buf, nbytes, offset);
+    };
+    expect_batches(read_file, nullptr, 3);
+    // Explicit calibration measures the backend latency
+    m_msrio->calibrate(0);
+    EXPECT_EQ(MSRIO::M_BACKEND_PREAD, m_msrio->batch_backend());
+    EXPECT_LT(0.0, m_msrio->batch_latency(MSRIO::M_BACKEND_PREAD));
+    uint64_t field = m_msrio->sample(idx);
+    EXPECT_EQ(0, memcmp(&field, "academic", 8));
 }
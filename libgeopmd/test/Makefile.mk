@@ -24,7 +24,9 @@ EXTRA_DIST += test/legacy_allowlist.out \
 
 test_geopm_test_SOURCES = test/GPUTopoNullTest.cpp \
                           test/AggTest.cpp \
+                          test/BatchCacheTest.cpp \
                           test/BatchClientTest.cpp \
+                          test/BatchServerTest.cpp \
                           test/BatchStatusTest.cpp \
                           test/CircularBufferTest.cpp \
                           test/CNLIOGroupTest.cpp \
@@ -55,6 +57,7 @@ test_geopm_test_SOURCES = test/GPUTopoNullTest.cpp \
                           test/MSRIOGroupTest.cpp \
                           test/MSRIOTest.cpp \
                           test/MSRFieldControlTest.cpp \
+                          test/MSRFieldDecoderTest.cpp \
                           test/MSRFieldSignalTest.cpp \
                           test/MockCpuid.hpp \
                           test/MockGPUTopo.hpp \
@@ -22,6 +22,12 @@ class MockIOUring : public geopm::IOUring
                     (std::shared_ptr<int> ret, int fd,
                      const void *buf, unsigned nbytes, off_t offset),
                     (override));
+        MOCK_METHOD(int, add_batch,
+                    (const std::vector<m_operation_s> &operations), (override));
+        MOCK_METHOD(void, update_batch,
+                    (int batch_idx, const std::vector<m_operation_s> &operations),
+                    (override));
+        MOCK_METHOD(void, submit_batch, (int batch_idx, int *ret), (override));
 };
 
 #endif /* MOCKIOURING_HPP_INCLUDE */
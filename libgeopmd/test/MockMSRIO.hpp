@@ -33,6 +33,9 @@ class MockMSRIO : public geopm::MSRIO
         MOCK_METHOD(void, write_batch, (), (override));
         MOCK_METHOD(void, write_batch, (int batch_ctx), (override));
         MOCK_METHOD(uint64_t, system_write_mask, (uint64_t offset), (override));
+        MOCK_METHOD(void, calibrate, (int batch_ctx), (override));
+        MOCK_METHOD(int, batch_backend, (), (const, override));
+        MOCK_METHOD(double, batch_latency, (int backend), (const, override));
 };
 
 #endif
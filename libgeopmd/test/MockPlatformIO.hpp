@@ -29,6 +29,9 @@ class MockPlatformIO : public geopm::PlatformIO
                     (const std::string &control_name, int domain_type, int domain_idx),
                     (override));
         MOCK_METHOD(double, sample, (int signal_idx), (override));
+        MOCK_METHOD(void, sample_all,
+                    (const std::vector<int> &signal_idx, double *result),
+                    (override));
         MOCK_METHOD(void, adjust, (int control_idx, double setting), (override));
         MOCK_METHOD(void, read_batch, (), (override));
         MOCK_METHOD(void, write_batch, (), (override));
@@ -22,6 +22,12 @@ class MockSysfsDriver : public geopm::SysfsDriver
         MOCK_METHOD(std::function<double(const std::string &)>, signal_parse,
                     (const std::string &signal_name),
                     (const, override));
+        MOCK_METHOD(double, signal_integer_scale,
+                    (const std::string &signal_name),
+                    (const, override));
+        MOCK_METHOD(int64_t, signal_integer_max,
+                    (const std::string &signal_name),
+                    (const, override));
         MOCK_METHOD(std::function<std::string(double)>, control_gen,
                     (const std::string &control_name),
                     (const, override));
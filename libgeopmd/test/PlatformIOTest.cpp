@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <unistd.h>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -263,9 +264,11 @@ TEST_F(PlatformIOTest, push_signal)
 
     EXPECT_EQ(2, m_platio->num_signal_pushed());
 
-    for (auto iog : m_iogroup_ptr) {
-        EXPECT_CALL(*iog, read_batch());
-    }
+    // Only IOGroups with pushed signals or controls are read
+    EXPECT_CALL(*m_time_iogroup, read_batch());
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    EXPECT_CALL(*m_fallback_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_override_iogroup, read_batch()).Times(0);
     m_platio->read_batch();
     EXPECT_EQ(idx, m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
     GEOPM_EXPECT_THROW_MESSAGE(m_platio->push_signal("MODE", GEOPM_DOMAIN_BOARD, 0),
@@ -452,9 +455,10 @@ TEST_F(PlatformIOTest, sample)
     int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0);
     int time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
 
-    for (auto iog : m_iogroup_ptr) {
-        EXPECT_CALL(*iog, read_batch());
-    }
+    EXPECT_CALL(*m_time_iogroup, read_batch());
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    EXPECT_CALL(*m_fallback_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_override_iogroup, read_batch()).Times(0);
     m_platio->read_batch();
     EXPECT_EQ(0, freq_idx);
     EXPECT_EQ(1, time_idx);
@@ -473,6 +477,112 @@ TEST_F(PlatformIOTest, sample)
     GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample(10), GEOPM_ERROR_INVALID, "signal_idx out of range");
 }
 
+TEST_F(PlatformIOTest, batch_timing)
+{
+    std::list<std::shared_ptr<IOGroup> > iogroup_list(m_iogroup_ptr.begin(),
+                                                      m_iogroup_ptr.end());
+    PlatformIOImp platio(iogroup_list, *m_topo, true);
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, signal_names()).Times(AtLeast(0));
+    }
+    // Timing signals are not provided unless enabled
+    EXPECT_EQ(0u, m_platio->signal_names().count("PLATFORMIO::READ_BATCH_TIME@TIME"));
+    auto names = platio.signal_names();
+    for (const auto &iog : {"TIME", "FALLBACK", "CONTROL", "OVERRIDE"}) {
+        EXPECT_EQ(1u, names.count(std::string("PLATFORMIO::READ_BATCH_TIME@") + iog));
+        EXPECT_EQ(1u, names.count(std::string("PLATFORMIO::WRITE_BATCH_TIME@") + iog));
+    }
+    EXPECT_EQ(GEOPM_DOMAIN_BOARD,
+              platio.signal_domain_type("PLATFORMIO::READ_BATCH_TIME@TIME"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE,
+              platio.signal_behavior("PLATFORMIO::READ_BATCH_TIME@TIME"));
+
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(2);
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", _, _));
+    EXPECT_CALL(*m_time_iogroup, read_signal("TIME", _, _));
+    int time_idx = platio.push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    int read_time_idx = platio.push_signal("PLATFORMIO::READ_BATCH_TIME@TIME",
+                                           GEOPM_DOMAIN_BOARD, 0);
+    int write_time_idx = platio.push_signal("PLATFORMIO::WRITE_BATCH_TIME@FALLBACK",
+                                            GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_EQ(0, time_idx);
+
+    auto sleep_10ms = []() {
+        usleep(10000);
+    };
+    EXPECT_CALL(*m_time_iogroup, read_batch()).Times(2)
+        .WillRepeatedly(testing::Invoke(sleep_10ms));
+    // The timing signals are read before the other IOGroups, so they
+    // include the time up to the end of the previous read_batch().
+    platio.read_batch();
+    EXPECT_EQ(0.0, platio.sample(read_time_idx));
+    platio.read_batch();
+    double read_time = platio.sample(read_time_idx);
+    EXPECT_LE(0.01, read_time);
+    EXPECT_GT(1.0, read_time);
+    EXPECT_LE(0.02, platio.read_signal("PLATFORMIO::READ_BATCH_TIME@TIME",
+                                       GEOPM_DOMAIN_BOARD, 0));
+
+    EXPECT_CALL(*m_fallback_iogroup, write_batch())
+        .WillOnce(testing::Invoke(sleep_10ms));
+    EXPECT_CALL(*m_time_iogroup, write_batch());
+    EXPECT_CALL(*m_control_iogroup, write_batch());
+    EXPECT_CALL(*m_override_iogroup, write_batch());
+    platio.write_batch();
+    EXPECT_EQ(0.0, platio.sample(write_time_idx));
+    EXPECT_LE(0.01, platio.read_signal("PLATFORMIO::WRITE_BATCH_TIME@FALLBACK",
+                                       GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_GT(0.01, platio.read_signal("PLATFORMIO::WRITE_BATCH_TIME@CONTROL",
+                                       GEOPM_DOMAIN_BOARD, 0));
+}
+
+TEST_F(PlatformIOTest, sample_all)
+{
+    EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                          GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return(geopm::Agg::sum));
+    EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, _)).Times(AtMost(1));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(AtLeast(1));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", _, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_time_iogroup, read_signal("TIME", _, _));
+    int freq_pkg_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    int freq_cpu_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 4);
+    int time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+
+    std::vector<int> signal_idx = {time_idx, freq_cpu_idx, freq_pkg_idx};
+    std::vector<double> result(signal_idx.size(), NAN);
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_all(signal_idx, result.data()),
+                               GEOPM_ERROR_RUNTIME, "read_batch() not called prior to call to sample_all()");
+
+    EXPECT_CALL(*m_time_iogroup, read_batch());
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    m_platio->read_batch();
+
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(1.0));
+    double sum = 0.0;
+    for (auto cpu : m_cpu_set0) {
+        int times = cpu == 4 ? 2 : 1;
+        EXPECT_CALL(*m_control_iogroup, sample(cpu))
+            .Times(times)
+            .WillRepeatedly(Return(1e9 * cpu));
+        sum += 1e9 * cpu;
+    }
+    m_platio->sample_all(signal_idx, result.data());
+    EXPECT_DOUBLE_EQ(1.0, result[0]);
+    EXPECT_DOUBLE_EQ(4e9, result[1]);
+    EXPECT_DOUBLE_EQ(sum, result[2]);
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_all({time_idx, 10}, result.data()),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+}
+
 TEST_F(PlatformIOTest, sample_not_active)
 {
     /*EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(2);
@@ -503,9 +613,10 @@ TEST_F(PlatformIOTest, sample_agg)
     }
     int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
 
-    for (auto iog : m_iogroup_ptr) {
-        EXPECT_CALL(*iog, read_batch());
-    }
+    EXPECT_CALL(*m_control_iogroup, read_batch()).Times(2);
+    EXPECT_CALL(*m_time_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_fallback_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_override_iogroup, read_batch()).Times(0);
     m_platio->read_batch();
 
     for (auto cpu : m_cpu_set0) {
@@ -518,6 +629,58 @@ TEST_F(PlatformIOTest, sample_agg)
         sum += cpu;
     }
     EXPECT_DOUBLE_EQ(sum / m_cpu_set0.size(), freq);
+
+    // Read plan is reused and combined operands are resampled
+    m_platio->read_batch();
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu)).WillOnce(Return(2.0 * cpu));
+    }
+    freq = m_platio->sample(freq_idx);
+    EXPECT_DOUBLE_EQ(2.0 * sum / m_cpu_set0.size(), freq);
+}
+
+TEST_F(PlatformIOTest, sample_agg_function)
+{
+    // Aggregation functions without an Agg array form are applied
+    // to the gathered operands by the CombinedSignal.
+    EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                          GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return([](const std::vector<double> &operand) {
+            return operand.back() - operand.front();
+        }));
+    EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, _)).Times(AtMost(1));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    int range_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    m_platio->read_batch();
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu)).WillOnce(Return(3.0 * cpu));
+    }
+    double range = m_platio->sample(range_idx);
+    EXPECT_DOUBLE_EQ(3.0 * (*m_cpu_set0.rbegin() - *m_cpu_set0.begin()), range);
+}
+
+TEST_F(PlatformIOTest, read_batch_control_only)
+{
+    EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(2);
+    EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+    EXPECT_CALL(*m_control_iogroup, write_control("FREQ", GEOPM_DOMAIN_CPU, 0, _));
+    EXPECT_CALL(*m_control_iogroup, push_control("FREQ", _, _));
+    m_platio->push_control("FREQ", GEOPM_DOMAIN_CPU, 0);
+
+    // IOGroups with only controls pushed still take part in read_batch()
+    EXPECT_CALL(*m_control_iogroup, read_batch());
+    EXPECT_CALL(*m_time_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_fallback_iogroup, read_batch()).Times(0);
+    EXPECT_CALL(*m_override_iogroup, read_batch()).Times(0);
+    m_platio->read_batch();
 }
 
 TEST_F(PlatformIOTest, adjust)
@@ -4,6 +4,7 @@
  */
 
 
+#include <errno.h>
 #include <unistd.h>
 #include <limits.h>
 #include <utime.h>
@@ -12,11 +13,13 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
 #include "geopm/Helper.hpp"
+#include "GPUTopoNull.hpp"
 #include "MockGPUTopo.hpp"
 #include "MockServiceProxy.hpp"
 #include "PlatformTopoImp.hpp"
@@ -42,6 +45,12 @@ class PlatformTopoTest : public :: testing :: Test
         void TearDown();
         void write_lscpu(const std::string &lscpu_str);
         void spoof_lscpu(void);
+        /// @brief Write a file below m_sysfs_path, creating the
+        ///        directories as needed.
+        void write_sysfs(const std::string &file_path, const std::string &contents);
+        /// @brief Create a fake sysfs tree with the CPU topology of
+        ///        m_hsw_lscpu_str.
+        void spoof_sysfs_hsw(void);
         void check_bdx_domain_idx(std::string file_name, std::shared_ptr<ServiceProxy> service_proxy);
         std::string m_path_env_save;
         std::string m_lscpu_file_name;
@@ -56,6 +65,9 @@ class PlatformTopoTest : public :: testing :: Test
         std::string m_gpu_str;
         std::string m_gpu_lscpu_str;
         std::string m_lscpu_str;
+        std::string m_hsw_sysfs_str;
+        std::string m_sysfs_path;
+        std::vector<std::string> m_sysfs_created;
         bool m_do_unlink;
 };
 
@@ -333,6 +345,15 @@ void PlatformTopoTest::SetUp()
         "Vulnerability Spectre v2:           Mitigation; CSV2, but not BHB\n"
         "Vulnerability Srbds:                Not affected\n"
         "Vulnerability Tsx async abort:      Not affected\n";
+    m_hsw_sysfs_str =
+        "CPU(s):                2\n"
+        "On-line CPU(s) mask:   0x3\n"
+        "Thread(s) per core:    1\n"
+        "Core(s) per socket:    2\n"
+        "Socket(s):             1\n"
+        "NUMA node(s):          1\n"
+        "NUMA node0 CPU(s):     0x3\n";
+    m_sysfs_path = "PlatformTopoTest-sysfs";
     m_do_unlink = false;
 }
 
@@ -341,6 +362,9 @@ void PlatformTopoTest::TearDown()
     if (m_do_unlink) {
         unlink(m_lscpu_file_name.c_str());
     }
+    for (auto path_it = m_sysfs_created.rbegin(); path_it != m_sysfs_created.rend(); ++path_it) {
+        (void)remove(path_it->c_str());
+    }
     (void)unlink("lscpu");
     (void)setenv("PATH", m_path_env_save.c_str(), 1);
     unsetenv("PLATFORM_TOPO_TEST_LSCPU_ERROR");
@@ -357,6 +381,39 @@ void PlatformTopoTest::write_lscpu(const std::string &lscpu_str)
     chmod(m_lscpu_file_name.c_str(), default_perms);
 }
 
+void PlatformTopoTest::write_sysfs(const std::string &file_path, const std::string &contents)
+{
+    std::string path = m_sysfs_path;
+    if (mkdir(path.c_str(), S_IRWXU) == 0) {
+        m_sysfs_created.push_back(path);
+    }
+    auto dir_list = geopm::string_split(file_path, "/");
+    dir_list.pop_back();
+    for (const auto &dir : dir_list) {
+        path += "/" + dir;
+        if (mkdir(path.c_str(), S_IRWXU) == 0) {
+            m_sysfs_created.push_back(path);
+        }
+    }
+    path = m_sysfs_path + "/" + file_path;
+    std::ofstream(path) << contents;
+    m_sysfs_created.push_back(path);
+}
+
+void PlatformTopoTest::spoof_sysfs_hsw(void)
+{
+    write_sysfs("cpu/present", "0-1\n");
+    write_sysfs("cpu/online", "0-1\n");
+    for (int cpu_idx = 0; cpu_idx != 2; ++cpu_idx) {
+        std::string topo_dir = "cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        write_sysfs(topo_dir + "physical_package_id", "0\n");
+        write_sysfs(topo_dir + "core_id", std::to_string(cpu_idx) + "\n");
+        write_sysfs(topo_dir + "thread_siblings_list", std::to_string(cpu_idx) + "\n");
+    }
+    write_sysfs("node/online", "0\n");
+    write_sysfs("node/node0/cpulist", "0-1\n");
+}
+
 TEST_F(PlatformTopoTest, hsw_num_domain)
 {
     write_lscpu(m_hsw_lscpu_str);
@@ -476,6 +533,87 @@ TEST_F(PlatformTopoTest, no_numa_num_domain)
     EXPECT_EQ(0, topo.num_domain(GEOPM_DOMAIN_PACKAGE_INTEGRATED_MEMORY));
 }
 
+TEST_F(PlatformTopoTest, sysfs_num_domain)
+{
+    // Two packages with two cores each and two hyper-threads per
+    // core.  The last core is offline and there is a memory only
+    // NUMA node.
+    write_sysfs("cpu/present", "0-7\n");
+    write_sysfs("cpu/online", "0-2,4-6\n");
+    for (int cpu_idx : {0, 1, 2, 4, 5, 6}) {
+        int core_idx = cpu_idx % 4;
+        std::string topo_dir = "cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        write_sysfs(topo_dir + "physical_package_id", std::to_string(core_idx / 2) + "\n");
+        write_sysfs(topo_dir + "core_id", std::to_string(core_idx % 2) + "\n");
+        write_sysfs(topo_dir + "thread_siblings_list",
+                    std::to_string(core_idx) + "," + std::to_string(core_idx + 4) + "\n");
+    }
+    write_sysfs("node/online", "0-2\n");
+    write_sysfs("node/node0/cpulist", "0-1,4-5\n");
+    write_sysfs("node/node1/cpulist", "2,6\n");
+    write_sysfs("node/node2/cpulist", "\n");
+
+    std::string expect =
+        "CPU(s):                8\n"
+        "On-line CPU(s) mask:   0x77\n"
+        "Thread(s) per core:    2\n"
+        "Core(s) per socket:    1\n"
+        "Socket(s):             2\n"
+        "NUMA node(s):          3\n"
+        "NUMA node0 CPU(s):     0x33\n"
+        "NUMA node1 CPU(s):     0x44\n"
+        "NUMA node2 CPU(s):     0x0\n";
+    EXPECT_EQ(expect, PlatformTopoImp::sysfs_topo(m_sysfs_path));
+
+    // Bring the last core online
+    write_sysfs("cpu/online", "0-7\n");
+    for (int cpu_idx : {3, 7}) {
+        std::string topo_dir = "cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+        write_sysfs(topo_dir + "physical_package_id", "1\n");
+        write_sysfs(topo_dir + "core_id", "1\n");
+        write_sysfs(topo_dir + "thread_siblings_list", "3,7\n");
+    }
+    write_sysfs("node/node1/cpulist", "2-3,6-7\n");
+    unlink(m_lscpu_file_name.c_str());
+    m_do_unlink = true;
+    PlatformTopoImp topo(m_lscpu_file_name, nullptr, m_sysfs_path);
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_EQ(4, topo.num_domain(GEOPM_DOMAIN_CORE));
+    EXPECT_EQ(8, topo.num_domain(GEOPM_DOMAIN_CPU));
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_MEMORY));
+    EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE_INTEGRATED_MEMORY));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_PACKAGE, 7));
+    EXPECT_EQ(3, topo.domain_idx(GEOPM_DOMAIN_CORE, 7));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_MEMORY, 6));
+    // The cache was created from the fake sysfs
+    EXPECT_TRUE(geopm::string_begins_with(geopm::read_file(m_lscpu_file_name),
+                                          "CPU(s):                8\n"));
+}
+
+TEST_F(PlatformTopoTest, sysfs_error)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(PlatformTopoImp::sysfs_topo(m_sysfs_path),
+                               ENOENT, "could not be opened");
+    write_sysfs("cpu/present", "0-1\n");
+    write_sysfs("cpu/online", "1-0\n");
+    GEOPM_EXPECT_THROW_MESSAGE(PlatformTopoImp::sysfs_topo(m_sysfs_path),
+                               GEOPM_ERROR_RUNTIME, "unable to parse CPU list");
+    write_sysfs("cpu/online", "0-1\n");
+    write_sysfs("cpu/cpu0/topology/physical_package_id", "zero\n");
+    GEOPM_EXPECT_THROW_MESSAGE(PlatformTopoImp::sysfs_topo(m_sysfs_path),
+                               GEOPM_ERROR_RUNTIME, "unable to parse integer");
+    // Missing topology of an online CPU
+    spoof_sysfs_hsw();
+    write_sysfs("cpu/online", "0-2\n");
+    GEOPM_EXPECT_THROW_MESSAGE(PlatformTopoImp::sysfs_topo(m_sysfs_path),
+                               ENOENT, "could not be opened");
+    // No NUMA support
+    write_sysfs("cpu/online", "0-1\n");
+    unlink((m_sysfs_path + "/node/online").c_str());
+    std::string no_numa_str = m_hsw_sysfs_str.substr(0, m_hsw_sysfs_str.find("NUMA"));
+    EXPECT_EQ(no_numa_str, PlatformTopoImp::sysfs_topo(m_sysfs_path));
+}
+
 TEST_F(PlatformTopoTest, construction)
 {
     PlatformTopoImp topo;
@@ -771,6 +909,52 @@ TEST_F(PlatformTopoTest, bdx_domain_nested)
                                     GEOPM_DOMAIN_NIC, 0), Exception);
 }
 
+TEST_F(PlatformTopoTest, gpu_domain_nested)
+{
+    write_lscpu(m_gpu_lscpu_str);
+    PlatformTopoImp topo(m_lscpu_file_name, nullptr);
+
+    std::set<int> expect_cpu;
+    for (int cpu_idx = 0; cpu_idx != 34; ++cpu_idx) {
+        expect_cpu.insert(cpu_idx);
+    }
+    expect_cpu.insert(204);
+    EXPECT_EQ(expect_cpu, topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_GPU, 0));
+    EXPECT_EQ(std::set<int>({2, 3}),
+              topo.domain_nested(GEOPM_DOMAIN_GPU_CHIP, GEOPM_DOMAIN_GPU, 1));
+    EXPECT_EQ(std::set<int>({0}),
+              topo.domain_nested(GEOPM_DOMAIN_GPU, GEOPM_DOMAIN_GPU, 0));
+    EXPECT_EQ(std::set<int>({0, 1}),
+              topo.domain_nested(GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_BOARD, 0));
+    std::set<int> expect_core;
+    for (int core_idx = 52; core_idx != 104; ++core_idx) {
+        expect_core.insert(core_idx);
+    }
+    EXPECT_EQ(expect_core, topo.domain_nested(GEOPM_DOMAIN_CORE, GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_EQ(std::set<int>({1, 105}),
+              topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_CORE, 1));
+    EXPECT_EQ(0, topo.domain_idx(GEOPM_DOMAIN_GPU, 204));
+    EXPECT_EQ(0, topo.domain_idx(GEOPM_DOMAIN_GPU_CHIP, 204));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_GPU_CHIP, 1));
+    EXPECT_EQ(11, topo.domain_idx(GEOPM_DOMAIN_GPU_CHIP, 203));
+    EXPECT_EQ(3, topo.domain_idx(GEOPM_DOMAIN_GPU, 207));
+
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_GPU, 6),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_GPU, -1),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_nested(GEOPM_DOMAIN_GPU, GEOPM_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "is not contained within");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_nested(GEOPM_DOMAIN_NIC, GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "no support yet");
+    GEOPM_EXPECT_THROW_MESSAGE(topo.domain_idx(GEOPM_DOMAIN_PACKAGE_INTEGRATED_GPU, 0),
+                               GEOPM_ERROR_NOT_IMPLEMENTED, "no support yet");
+    EXPECT_FALSE(topo.is_nested_domain(GEOPM_DOMAIN_GPU, GEOPM_DOMAIN_GPU_CHIP));
+    EXPECT_TRUE(topo.is_nested_domain(GEOPM_DOMAIN_PACKAGE_INTEGRATED_GPU, GEOPM_DOMAIN_PACKAGE));
+    EXPECT_TRUE(topo.is_nested_domain(GEOPM_NUM_DOMAIN, GEOPM_DOMAIN_BOARD));
+    EXPECT_FALSE(topo.is_nested_domain(GEOPM_DOMAIN_BOARD, GEOPM_NUM_DOMAIN));
+}
+
 TEST_F(PlatformTopoTest, parse_error)
 {
     std::string lscpu_missing_cpu =
@@ -903,31 +1087,50 @@ TEST_F(PlatformTopoTest, create_cache)
         .WillOnce(Return(std::set<int>{170,172,174,176,178,180,182,184,186,188,190,192,194,196,198,200,202}))
         .WillOnce(Return(std::set<int>{171,173,175,177,179,181,183,185,187,189,191,193,195,197,199,201,203}));
     spoof_lscpu();
+    spoof_sysfs_hsw();
+    geopm::GPUTopoNull gpu_topo_null;
 
-    // Test case: no lscpu error, file does not exist
-    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "", 1);
+    // Test case: file does not exist, topology is read from sysfs
+    // and lscpu is not called, but if it is it will error.
+    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "1", 1);
 
-    PlatformTopoImp::create_cache(cache_file_path, *gpu_topo);
+    PlatformTopoImp::create_cache(cache_file_path, *gpu_topo, m_sysfs_path);
 
     std::ifstream cache_stream(cache_file_path);
     std::string cache_line;
     getline(cache_stream, cache_line);
-    ASSERT_TRUE(geopm::string_begins_with(cache_line, "Architecture:"));
+    ASSERT_TRUE(geopm::string_begins_with(cache_line, "CPU(s):"));
     cache_stream.close();
+    std::string cache_contents = geopm::read_file(cache_file_path);
+    ASSERT_TRUE(geopm::string_begins_with(cache_contents, m_hsw_sysfs_str));
+    EXPECT_NE(std::string::npos, cache_contents.find("GPU chip11 CPU(s): 171,173,"));
 
-    // Test case: file exist, lscpu should not be called, but if it
-    // does it will error.
-    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "1", 1);
-    PlatformTopoImp::create_cache(cache_file_path);
+    // Test case: file exist, neither sysfs nor lscpu is read
+    PlatformTopoImp::create_cache(cache_file_path, gpu_topo_null, m_sysfs_path + "-missing");
+
+    cache_stream.open(cache_file_path);
+    getline(cache_stream, cache_line);
+    ASSERT_TRUE(geopm::string_begins_with(cache_line, "CPU(s):"));
+    cache_stream.close();
+
+    // Test case: file does not exist and sysfs is not available, fall
+    // back to lscpu
+    unlink(cache_file_path.c_str());
+    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "", 1);
+    PlatformTopoImp::create_cache(cache_file_path, gpu_topo_null, m_sysfs_path + "-missing");
 
     cache_stream.open(cache_file_path);
     getline(cache_stream, cache_line);
     ASSERT_TRUE(geopm::string_begins_with(cache_line, "Architecture:"));
     cache_stream.close();
 
-    // Test case: file does not exist and lscpu returns an error code.
+    // Test case: file does not exist, sysfs is not available and
+    // lscpu returns an error code.
     unlink(cache_file_path.c_str());
-    EXPECT_THROW(PlatformTopoImp::create_cache(cache_file_path), geopm::Exception);
+    setenv("PLATFORM_TOPO_TEST_LSCPU_ERROR", "1", 1);
+    EXPECT_THROW(PlatformTopoImp::create_cache(cache_file_path, gpu_topo_null,
+                                               m_sysfs_path + "-missing"),
+                 geopm::Exception);
     for (const auto &file_path : geopm::list_directory_files("./")) {
         EXPECT_THAT(file_path, Not(StartsWith(cache_file_path)))
             << "PlatformTopoImp::create_cache leaked a temporary file";
@@ -985,7 +1188,7 @@ TEST_F(PlatformTopoTest, call_c_wrappers)
 
 TEST_F(PlatformTopoTest, check_file_too_old)
 {
-    spoof_lscpu();
+    spoof_sysfs_hsw();
     write_lscpu(m_hsw_lscpu_str);
 
     struct sysinfo si;
@@ -1004,7 +1207,7 @@ TEST_F(PlatformTopoTest, check_file_too_old)
     stat(m_lscpu_file_name.c_str(), &file_stat);
     ASSERT_EQ(old_time, file_stat.st_mtime);
 
-    PlatformTopoImp topo(m_lscpu_file_name, nullptr);
+    PlatformTopoImp topo(m_lscpu_file_name, nullptr, m_sysfs_path);
 
     // Verify the cache was regenerated because it was too old
     stat(m_lscpu_file_name.c_str(), &file_stat);
@@ -1012,12 +1215,12 @@ TEST_F(PlatformTopoTest, check_file_too_old)
 
     // Verify the new file contents
     std::string new_file_contents = geopm::read_file(m_lscpu_file_name);
-    ASSERT_EQ(m_hsw_lscpu_str, new_file_contents);
+    ASSERT_EQ(m_hsw_sysfs_str, new_file_contents);
 }
 
 TEST_F(PlatformTopoTest, check_file_bad_perms)
 {
-    spoof_lscpu();
+    spoof_sysfs_hsw();
     write_lscpu(m_hsw_lscpu_str);
 
     // Override the permissions to a known bad state: 0o644
@@ -1030,7 +1233,7 @@ TEST_F(PlatformTopoTest, check_file_bad_perms)
     mode_t actual_perms = file_stat.st_mode & ~S_IFMT;
     ASSERT_EQ(bad_perms, actual_perms);
 
-    PlatformTopoImp topo(m_lscpu_file_name, nullptr);
+    PlatformTopoImp topo(m_lscpu_file_name, nullptr, m_sysfs_path);
 
     // Verify that the cache was regenerated because it had the wrong permissions
     stat(m_lscpu_file_name.c_str(), &file_stat);
@@ -1040,5 +1243,5 @@ TEST_F(PlatformTopoTest, check_file_bad_perms)
 
     // Verify the new file contents
     std::string new_file_contents = geopm::read_file(m_lscpu_file_name);
-    ASSERT_EQ(m_hsw_lscpu_str, new_file_contents);
+    ASSERT_EQ(m_hsw_sysfs_str, new_file_contents);
 }
@@ -6,8 +6,11 @@
 #include "SysfsIOGroup.hpp"
 
 #include <algorithm>
+#include <climits>
+#include <cmath>
 #include <cstring>
 #include <memory>
+#include <stdexcept>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -32,6 +35,8 @@ using testing::Throw;
 using testing::InSequence;
 using testing::Invoke;
 using testing::Gt;
+using testing::DoAll;
+using testing::SaveArg;
 
 class SysfsIOGroupTest : public :: testing :: Test
 {
@@ -69,6 +74,8 @@ void SysfsIOGroupTest::SetUp()
     // Mock to make all attributes map to a readable and writable file so they
     // all appear accessible by default.
     ON_CALL(*m_driver, attribute_path(_, _)).WillByDefault(Return("/dev/null"));
+    ON_CALL(*m_driver, signal_integer_scale(_)).WillByDefault(Return(NAN));
+    ON_CALL(*m_driver, signal_integer_max(_)).WillByDefault(Return(INT64_MAX));
 
     m_mock_save_ctl = std::make_shared<MockSaveControl>();
 
@@ -138,20 +145,30 @@ TEST_F(SysfsIOGroupTest, control_domain_type)
 
 TEST_F(SysfsIOGroupTest, batch_reads)
 {
-    auto read_value = [](std::shared_ptr<int> ret, int, void *buf, unsigned nbytes, off_t) {
-        std::strncpy(static_cast<char*>(buf), "1.25", nbytes);
-        if (ret) {
-            *ret = std::min(static_cast<size_t>(nbytes), sizeof "1.25");
+    std::vector<geopm::IOUring::m_operation_s> operations;
+    auto read_value = [&operations](int, int *ret) {
+        for (const auto &op : operations) {
+            std::strncpy(static_cast<char*>(op.buf), "1.25", op.nbytes);
+            *ret = std::min(static_cast<size_t>(op.nbytes), sizeof "1.25");
+            ++ret;
         }
     };
-    // Mock the file read
-    EXPECT_CALL(*m_batch_io, prep_read(_, _, _, _, _)).WillRepeatedly(Invoke(read_value));
+    // Mock the file read: the batch is prepared once and submitted
+    // for each read_batch()
+    EXPECT_CALL(*m_batch_io, add_batch(_))
+        .WillOnce(DoAll(SaveArg<0>(&operations), Return(0)));
+    EXPECT_CALL(*m_batch_io, submit_batch(0, _)).Times(2).WillRepeatedly(Invoke(read_value));
     // Mock the translation from file contents to a number
     EXPECT_CALL(*m_driver, signal_parse("TESTIOGROUP::SIGNAL1"))
         .WillRepeatedly(Return([](const std::string& value)->double {return std::stod(value);}));
     auto signal_idx = m_group->push_signal("TESTIOGROUP::SIGNAL1", GEOPM_DOMAIN_BOARD, 0);
     m_group->read_batch();
     EXPECT_EQ(1.25, m_group->sample(signal_idx));
+    ASSERT_EQ(1u, operations.size());
+    EXPECT_TRUE(operations[0].is_read);
+    EXPECT_EQ(0, operations[0].offset);
+    m_group->read_batch();
+    EXPECT_EQ(1.25, m_group->sample(signal_idx));
 }
 
 TEST_F(SysfsIOGroupTest, batch_writes)
@@ -176,3 +193,120 @@ TEST_F(SysfsIOGroupTest, batch_writes)
     m_group->write_batch();
     EXPECT_EQ("1.25", written);
 }
+
+TEST_F(SysfsIOGroupTest, batch_reads_integer)
+{
+    std::vector<geopm::IOUring::m_operation_s> operations;
+    std::string content;
+    auto read_value = [&operations, &content](int, int *ret) {
+        for (const auto &op : operations) {
+            std::strncpy(static_cast<char*>(op.buf), content.c_str(), op.nbytes);
+            *ret = content.size();
+            ++ret;
+        }
+    };
+    EXPECT_CALL(*m_batch_io, add_batch(_))
+        .WillOnce(DoAll(SaveArg<0>(&operations), Return(0)));
+    EXPECT_CALL(*m_batch_io, submit_batch(0, _)).WillRepeatedly(Invoke(read_value));
+    // The content is parsed in place, not with the parse function
+    EXPECT_CALL(*m_driver, signal_parse("TESTIOGROUP::SIGNAL1"))
+        .WillOnce(Return([](const std::string &) -> double {
+            throw std::runtime_error("unexpected call to parse function");
+        }));
+    EXPECT_CALL(*m_driver, signal_integer_scale("TESTIOGROUP::SIGNAL1"))
+        .WillOnce(Return(1e3));
+    auto signal_idx = m_group->push_signal("TESTIOGROUP::SIGNAL1", GEOPM_DOMAIN_BOARD, 0);
+    std::vector<std::pair<std::string, double> > cases {
+        {"2600000\n", 2.6e9},
+        {"  -42 kHz\n", -42e3},
+        {"+7", 7e3},
+        {"999999999999999999\n", 999999999999999999e3},
+        {"9223372036854775807\n", 9223372036854775807e3},
+        {"-9223372036854775808\n", -9223372036854775808e3},
+        {"9223372036854775808\n", NAN},
+        {"9999999999999999999\n", NAN},
+        {"99999999999999999999\n", NAN},
+        {"<unsupported>\n", NAN},
+        {"-\n", NAN},
+        {"", NAN},
+    };
+    for (const auto &cc : cases) {
+        content = cc.first;
+        m_group->read_batch();
+        if (std::isnan(cc.second)) {
+            EXPECT_TRUE(std::isnan(m_group->sample(signal_idx))) << cc.first;
+        }
+        else {
+            EXPECT_DOUBLE_EQ(cc.second, m_group->sample(signal_idx)) << cc.first;
+        }
+    }
+}
+
+TEST_F(SysfsIOGroupTest, batch_reads_integer_range)
+{
+    std::vector<geopm::IOUring::m_operation_s> operations;
+    std::string content;
+    auto read_value = [&operations, &content](int, int *ret) {
+        for (const auto &op : operations) {
+            std::strncpy(static_cast<char*>(op.buf), content.c_str(), op.nbytes);
+            *ret = content.size();
+            ++ret;
+        }
+    };
+    EXPECT_CALL(*m_batch_io, add_batch(_))
+        .WillOnce(DoAll(SaveArg<0>(&operations), Return(0)));
+    EXPECT_CALL(*m_batch_io, submit_batch(0, _)).WillRepeatedly(Invoke(read_value));
+    EXPECT_CALL(*m_driver, signal_integer_scale("TESTIOGROUP::SIGNAL1"))
+        .WillOnce(Return(1.0));
+    // The driver parses with std::stoi()
+    EXPECT_CALL(*m_driver, signal_integer_max("TESTIOGROUP::SIGNAL1"))
+        .WillOnce(Return(INT_MAX));
+    auto signal_idx = m_group->push_signal("TESTIOGROUP::SIGNAL1", GEOPM_DOMAIN_BOARD, 0);
+    std::vector<std::pair<std::string, double> > cases {
+        {"2147483647\n", 2147483647.0},
+        {"-2147483648\n", -2147483648.0},
+        {"2147483648\n", NAN},
+        {"-2147483649\n", NAN},
+        {"4294967295\n", NAN},
+    };
+    for (const auto &cc : cases) {
+        content = cc.first;
+        m_group->read_batch();
+        if (std::isnan(cc.second)) {
+            EXPECT_TRUE(std::isnan(m_group->sample(signal_idx))) << cc.first;
+        }
+        else {
+            EXPECT_DOUBLE_EQ(cc.second, m_group->sample(signal_idx)) << cc.first;
+        }
+    }
+}
+
+TEST_F(SysfsIOGroupTest, batch_writes_unchanged)
+{
+    std::vector<std::string> written;
+    auto write_value = [&written](std::shared_ptr<int> ret, int, const void *buf, unsigned nbytes, off_t) {
+        written.emplace_back(static_cast<const char*>(buf), nbytes - 1);
+        *ret = nbytes;
+    };
+    // Settings are written in whole units
+    EXPECT_CALL(*m_driver, control_gen("TESTIOGROUP::CONTROL1"))
+        .WillRepeatedly(Return([](double value) {
+            return std::to_string(std::llround(value));
+        }));
+    EXPECT_CALL(*m_batch_io, prep_write(_, _, _, _, _)).WillRepeatedly(Invoke(write_value));
+    EXPECT_CALL(*m_batch_io, submit()).Times(3);
+    auto control_idx = m_group->push_control("TESTIOGROUP::CONTROL1", GEOPM_DOMAIN_BOARD, 0);
+    m_group->adjust(control_idx, 1.0);
+    m_group->write_batch();
+    // Not adjusted since the last write
+    m_group->write_batch();
+    // Adjusted, but the generated setting is the same
+    m_group->adjust(control_idx, 1.2);
+    m_group->write_batch();
+    EXPECT_EQ(std::vector<std::string>({"1"}), written);
+    m_group->adjust(control_idx, 2.0);
+    m_group->write_batch();
+    m_group->adjust(control_idx, 1.0);
+    m_group->write_batch();
+    EXPECT_EQ(std::vector<std::string>({"1", "2", "1"}), written);
+}
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "geopm/PluginFactory.hpp"
 #include "TimeIOGroup.hpp"
@@ -125,6 +127,18 @@ TEST_F(TimeIOGroupTest, sample)
     EXPECT_THROW(m_group.sample(-1), Exception);
 }
 
+TEST_F(TimeIOGroupTest, sample_all)
+{
+    std::vector<double> result(2, NAN);
+    int signal_idx = m_group.push_signal("TIME::ELAPSED", m_time_domain, 0);
+    EXPECT_THROW(m_group.sample_all({signal_idx, signal_idx}, result.data()), Exception);
+    m_group.read_batch();
+    m_group.sample_all({signal_idx, signal_idx}, result.data());
+    EXPECT_EQ(m_group.sample(signal_idx), result[0]);
+    EXPECT_EQ(m_group.sample(signal_idx), result[1]);
+    EXPECT_THROW(m_group.sample_all({signal_idx, 1}, result.data()), Exception);
+}
+
 TEST_F(TimeIOGroupTest, adjust)
 {
     EXPECT_NO_THROW(m_group.write_batch());